@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+/**
+Benchmark helpers
+  - measureMs(fn)   - Median wall time of fn() in milliseconds over several runs, after a warm-up
+  - doNotOptimize   - Keeps a computed value alive so the compiler cannot drop the work
+*/
+
+namespace blkhurst::bench {
+
+template <typename Fn> double measureMs(Fn&& func, int runs = 9, int warmup = 2) {
+  for (int i = 0; i < warmup; ++i) {
+    func();
+  }
+  std::vector<double> samples;
+  samples.reserve(static_cast<std::size_t>(runs));
+  for (int i = 0; i < runs; ++i) {
+    const auto start = std::chrono::steady_clock::now();
+    func();
+    const auto end = std::chrono::steady_clock::now();
+    samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+  }
+  std::nth_element(samples.begin(), samples.begin() + runs / 2, samples.end());
+  return samples[static_cast<std::size_t>(runs / 2)];
+}
+
+template <typename T> void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static volatile const void* sink = nullptr;
+  sink = &value;
+#endif
+}
+
+} // namespace blkhurst::bench
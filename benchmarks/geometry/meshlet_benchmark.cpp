@@ -0,0 +1,91 @@
+#include "benchmark.hpp"
+
+#include <blkhurst/geometry/meshlet.hpp>
+#include <blkhurst/geometry/sphere_geometry.hpp>
+#include <blkhurst/util/frustum.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <numbers>
+
+// Meshlet build time and per-frame cluster culling on a dense model (10M triangles by default).
+// Usage: meshlet_benchmark [triangles]
+
+using namespace blkhurst; // NOLINT
+namespace bench = blkhurst::bench;
+
+namespace {
+
+constexpr int kViews = 8;
+
+struct CullResult {
+  std::size_t visible = 0;
+  std::size_t draws = 0; // After merging adjacent survivors, as Renderer::drawMeshlets does
+};
+
+// Same tests and range merging as the renderer, without the GL submission
+CullResult cull(const MeshletBuildResult& clusters, const Frustum& frustum, const glm::vec3& eye,
+                bool coneCulling) {
+  CullResult result;
+  std::uint32_t rangeEnd = 0;
+  bool open = false;
+  for (const auto& meshlet : clusters.meshlets) {
+    if (!frustum.intersectsSphere(meshlet.center, meshlet.radius) ||
+        (coneCulling && meshlet.backfacing(eye))) {
+      continue;
+    }
+    ++result.visible;
+    if (!open || rangeEnd != meshlet.indexOffset) {
+      ++result.draws;
+    }
+    open = true;
+    rangeEnd = meshlet.indexOffset + meshlet.indexCount;
+  }
+  return result;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const double triangles = argc > 1 ? std::max(1000.0, std::atof(argv[1])) : 10.0e6;
+
+  // Sphere with width = 2 * height segments has about 4 * height^2 triangles
+  const int height = std::max(2, static_cast<int>(std::sqrt(triangles / 4.0)));
+  const MeshData model = SphereGeometry::buildSphere({.widthSegments = height * 2,
+                                                      .heightSegments = height});
+  std::printf("Model: %zu triangles, %zu vertices\n", model.indices.size() / 3,
+              model.positions.size() / 3);
+
+  MeshletBuildResult clusters;
+  const double buildMs =
+      bench::measureMs([&]() { clusters = MeshletBuilder::build(model, model.indices); }, 1, 0);
+  std::printf("Build: %zu meshlets in %.1f ms (%.1f ns/triangle)\n\n", clusters.meshlets.size(),
+              buildMs, buildMs * 1.0e6 / static_cast<double>(model.indices.size() / 3));
+
+  // Close orbit so part of the model is off screen and half faces away
+  const glm::mat4 projection = glm::perspective(glm::radians(60.0F), 16.0F / 9.0F, 0.01F, 100.0F);
+  std::printf("%6s %8s %12s %10s %10s\n", "cone", "view", "cull ms", "visible %", "draws");
+  for (const bool cone : {false, true}) {
+    for (int view = 0; view < kViews; ++view) {
+      const float angle = std::numbers::pi_v<float> * 2.0F * static_cast<float>(view) / kViews;
+      const glm::vec3 eye{std::cos(angle) * 1.6F, 0.4F, std::sin(angle) * 1.6F};
+      const glm::mat4 viewMatrix = glm::lookAt(eye, glm::vec3(0.0F), glm::vec3(0.0F, 1.0F, 0.0F));
+      const Frustum frustum = Frustum::fromMatrix(projection * viewMatrix);
+
+      CullResult result;
+      const double cullMs = bench::measureMs([&]() {
+        result = cull(clusters, frustum, eye, cone);
+        bench::doNotOptimize(result);
+      });
+      std::printf("%6s %8d %12.3f %9.1f%% %10zu\n", cone ? "on" : "off", view, cullMs,
+                  100.0 * static_cast<double>(result.visible) /
+                      static_cast<double>(clusters.meshlets.size()),
+                  result.draws);
+    }
+  }
+  return 0;
+}
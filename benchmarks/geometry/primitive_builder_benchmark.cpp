@@ -0,0 +1,91 @@
+#include "benchmark.hpp"
+
+#include <blkhurst/geometry/capsule_geometry.hpp>
+#include <blkhurst/geometry/cylinder_geometry.hpp>
+#include <blkhurst/geometry/sphere_geometry.hpp>
+#include <blkhurst/geometry/torus_geometry.hpp>
+#include <blkhurst/geometry/torus_knot_geometry.hpp>
+#include <blkhurst/jobs/job_system.hpp>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <thread>
+
+// Primitive builders from 16 to 4096 segments, serial and row-parallel on the JobSystem.
+// The first segment count is N, the second N / 4, so the largest meshes stay a few million
+// vertices. Usage: primitive_builder_benchmark [workers]   (default: hardware threads - 1)
+
+using namespace blkhurst; // NOLINT
+namespace bench = blkhurst::bench;
+
+namespace {
+
+struct Builder {
+  const char* name;
+  std::function<MeshData(int segments, JobSystem* jobs)> build;
+};
+
+int quarter(int segments) {
+  return std::max(2, segments / 4);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int hardware = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+  const int workers = argc > 1 ? std::max(0, std::atoi(argv[1])) : std::max(1, hardware - 1);
+  JobSystem jobs(workers);
+
+  const Builder builders[] = {
+      {"sphere",
+       [](int n, JobSystem* jobs) {
+         return SphereGeometry::buildSphere({.widthSegments = n, .heightSegments = quarter(n)},
+                                            jobs);
+       }},
+      {"torus",
+       [](int n, JobSystem* jobs) {
+         return TorusGeometry::buildTorus({.radialSegments = quarter(n), .tubularSegments = n},
+                                          jobs);
+       }},
+      {"torusKnot",
+       [](int n, JobSystem* jobs) {
+         return TorusKnotGeometry::buildTorusKnot(
+             {.tubularSegments = n, .radialSegments = quarter(n)}, jobs);
+       }},
+      {"cylinder",
+       [](int n, JobSystem* jobs) {
+         return CylinderGeometry::buildCylinder(
+             {.radialSegments = n, .heightSegments = quarter(n)}, jobs);
+       }},
+      {"capsule",
+       [](int n, JobSystem* jobs) {
+         return CapsuleGeometry::buildCapsule(
+             {.capSegments = quarter(n), .radialSegments = n, .heightSegments = quarter(n)}, jobs);
+       }},
+  };
+
+  std::printf("Primitive builders, %d workers for the parallel column\n", workers);
+  std::printf("%10s %9s %12s %12s %12s %9s %10s\n", "builder", "segments", "vertices",
+              "serial ms", "parallel ms", "speedup", "ns/vertex");
+  for (const auto& builder : builders) {
+    for (int segments = 16; segments <= 4096; segments *= 4) {
+      const int runs = segments >= 1024 ? 3 : 9;
+      std::size_t vertices = 0;
+      const double serialMs = bench::measureMs(
+          [&]() {
+            const MeshData mesh = builder.build(segments, nullptr);
+            vertices = mesh.positions.size() / 3;
+            bench::doNotOptimize(mesh);
+          },
+          runs, 1);
+      const double parallelMs = bench::measureMs(
+          [&]() { bench::doNotOptimize(builder.build(segments, &jobs)); }, runs, 1);
+      std::printf("%10s %9d %12zu %12.3f %12.3f %8.2fx %10.2f\n", builder.name, segments,
+                  vertices, serialMs, parallelMs, serialMs / parallelMs,
+                  serialMs * 1.0e6 / static_cast<double>(vertices));
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,69 @@
+#include "benchmark.hpp"
+
+#include <blkhurst/jobs/job_system.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+// Scaling of the JobSystem from the main thread alone up to N workers.
+// Usage: job_system_benchmark [maxWorkers]   (default: hardware threads - 1)
+
+using blkhurst::JobSystem;
+using blkhurst::TaskGroup;
+namespace bench = blkhurst::bench;
+
+namespace {
+
+constexpr std::size_t kElements = std::size_t{1} << 22;
+constexpr int kTasks = 20000;
+
+// Compute-bound range; enough per-index work that scheduling overhead is small
+double parallelForWork(JobSystem& jobs, std::vector<float>& data) {
+  jobs.parallelFor(data.size(), [&data](std::size_t i) {
+    const auto x = static_cast<float>(i);
+    data[i] = std::sqrt(x) * std::sin(x) + std::cos(x * 0.5F);
+  });
+  return data[data.size() / 2];
+}
+
+// Many tiny tasks; measures submit, steal and wait overhead
+int fineGrainedTasks(JobSystem& jobs) {
+  std::atomic<int> counter{0};
+  TaskGroup group;
+  for (int i = 0; i < kTasks; ++i) {
+    jobs.submit(group, [&counter]() { counter.fetch_add(1, std::memory_order_relaxed); });
+  }
+  jobs.wait(group);
+  return counter.load();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int hardware = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+  const int maxWorkers = argc > 1 ? std::max(0, std::atoi(argv[1])) : std::max(1, hardware - 1);
+
+  std::vector<float> data(kElements);
+  double baseline = 0.0;
+
+  std::printf("JobSystem scaling (%d hardware threads)\n", hardware);
+  std::printf("%8s %16s %9s %18s %12s\n", "workers", "parallelFor ms", "speedup", "20k tasks ms",
+              "ns/task");
+  for (int workers = 0; workers <= maxWorkers; ++workers) {
+    JobSystem jobs(workers);
+    const double forMs =
+        bench::measureMs([&]() { bench::doNotOptimize(parallelForWork(jobs, data)); });
+    const double taskMs = bench::measureMs([&]() { bench::doNotOptimize(fineGrainedTasks(jobs)); });
+    if (workers == 0) {
+      baseline = forMs;
+    }
+    std::printf("%8d %16.3f %8.2fx %18.3f %12.1f\n", workers, forMs, baseline / forMs, taskMs,
+                taskMs * 1.0e6 / kTasks);
+  }
+  return 0;
+}
@@ -0,0 +1,147 @@
+#include "benchmark.hpp"
+
+#include <blkhurst/materials/material.hpp>
+#include <glm/glm.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// CPU cost per draw of the resource accessors and uniform names on the draw path: shared_ptr
+// returned by value with std::string uniform names (as before handles), against const& accessors
+// with std::string_view names (as Renderer::renderMesh does now). No GL: Geometry needs a
+// context, so the draw items stand in for Mesh and hold a placeholder in its place.
+// Usage: draw_accessor_benchmark [draws] [materials]   (default: 50000 64)
+
+using namespace blkhurst; // NOLINT
+namespace bench = blkhurst::bench;
+
+namespace {
+
+struct GeometryStandIn {
+  int vertexCount = 0;
+};
+
+// Mesh's resource members and both accessor styles
+class DrawItem {
+public:
+  DrawItem(std::shared_ptr<GeometryStandIn> geometry, std::shared_ptr<Material> material)
+      : geometry_(std::move(geometry)),
+        material_(std::move(material)) {}
+
+  [[nodiscard]] std::shared_ptr<GeometryStandIn> geometryByValue() const {
+    return geometry_;
+  }
+  [[nodiscard]] std::shared_ptr<Material> materialByValue() const {
+    return material_;
+  }
+  [[nodiscard]] const std::shared_ptr<GeometryStandIn>& geometry() const {
+    return geometry_;
+  }
+  [[nodiscard]] const std::shared_ptr<Material>& material() const {
+    return material_;
+  }
+
+  glm::mat4 world{1.0F};
+
+private:
+  std::shared_ptr<GeometryStandIn> geometry_;
+  std::shared_ptr<Material> material_;
+};
+
+// The per-draw uniforms of Renderer::applyPerDrawUniforms; Name is std::string or a literal
+template <typename Name> void setDrawUniforms(Material& material, const DrawItem& item, int id) {
+  material.setUniform(Name("uTime"), 1.0F);
+  material.setUniform(Name("uDelta"), 0.016F);
+  material.setUniform(Name("uMouse"), glm::vec2(0.0F));
+  material.setUniform(Name("uResolution"), glm::vec2(1920.0F, 1080.0F));
+  material.setUniform(Name("uView"), item.world);
+  material.setUniform(Name("uProjection"), item.world);
+  material.setUniform(Name("uCameraPos"), glm::vec3(0.0F));
+  material.setUniform(Name("uIsOrthographic"), 0);
+  material.setUniform(Name("uToneMappingExposure"), 1.0F);
+  material.setUniform(Name("uToneMappingMode"), 0);
+  material.setUniform(Name("uOutputColorSpace"), 0);
+  material.setUniform(Name("uModel"), item.world);
+  material.setUniform(Name("uVertexPulling"), 0);
+  material.setUniform(Name("uObjectId"), id);
+}
+
+// Before: renderMesh copied Geometry and Material, applyPerDrawUniforms copied Material again
+int drawByValue(const DrawItem& item, int id, bool uniforms) {
+  const auto geometry = item.geometryByValue();
+  const auto material = item.materialByValue();
+  if (!geometry || !material) {
+    return 0;
+  }
+  const auto perDraw = item.materialByValue();
+  if (uniforms) {
+    setDrawUniforms<std::string>(*perDraw, item, id);
+  }
+  return geometry->vertexCount;
+}
+
+int drawByReference(const DrawItem& item, int id, bool uniforms) {
+  const GeometryStandIn* geometry = item.geometry().get();
+  Material* material = item.material().get();
+  if ((geometry == nullptr) || (material == nullptr)) {
+    return 0;
+  }
+  Material* perDraw = item.material().get();
+  if (uniforms) {
+    setDrawUniforms<std::string_view>(*perDraw, item, id);
+  }
+  return geometry->vertexCount;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int draws = argc > 1 ? std::max(1, std::atoi(argv[1])) : 50000;
+  const int materialCount = argc > 2 ? std::max(1, std::atoi(argv[2])) : 64;
+  spdlog::set_level(spdlog::level::err); // Materials without a Program warn on construction
+
+  std::vector<std::shared_ptr<Material>> materials;
+  for (int i = 0; i < materialCount; ++i) {
+    materials.push_back(Material::create(nullptr));
+  }
+  std::vector<std::shared_ptr<GeometryStandIn>> geometries;
+  for (int i = 0; i < 256; ++i) {
+    geometries.push_back(std::make_shared<GeometryStandIn>(GeometryStandIn{i}));
+  }
+  std::vector<DrawItem> items;
+  items.reserve(static_cast<std::size_t>(draws));
+  for (int i = 0; i < draws; ++i) {
+    items.emplace_back(geometries[static_cast<std::size_t>(i) % geometries.size()],
+                       materials[static_cast<std::size_t>(i) % materials.size()]);
+  }
+
+  auto frame = [&](auto draw, bool uniforms) {
+    return bench::measureMs([&]() {
+      long total = 0;
+      for (int i = 0; i < draws; ++i) {
+        total += draw(items[static_cast<std::size_t>(i)], i, uniforms);
+      }
+      bench::doNotOptimize(total);
+    });
+  };
+
+  std::printf("%d draws, %d materials\n\n", draws, materialCount);
+  std::printf("%-22s %14s %12s %18s %12s\n", "", "accessors ms", "ns/draw", "+ uniforms ms",
+              "ns/draw");
+  const auto row = [&](const char* name, auto draw) {
+    const double accessorsMs = frame(draw, false);
+    const double uniformsMs = frame(draw, true);
+    std::printf("%-22s %14.3f %12.1f %18.3f %12.1f\n", name, accessorsMs,
+                accessorsMs * 1.0e6 / draws, uniformsMs, uniformsMs * 1.0e6 / draws);
+  };
+  row("by value + std::string", drawByValue);
+  row("const& + string_view", drawByReference);
+  return 0;
+}
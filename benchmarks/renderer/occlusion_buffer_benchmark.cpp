@@ -0,0 +1,100 @@
+#include "benchmark.hpp"
+
+#include <blkhurst/jobs/job_system.hpp>
+#include <blkhurst/renderer/occlusion_buffer.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+
+// Software occlusion throughput: occluder setup, rasterisation and box tests on a random scene
+// at the default 256x128 resolution, on the main thread and with a JobSystem.
+// Usage: occlusion_buffer_benchmark [triangles] [boxes]   (default: 100000 100000)
+
+using namespace blkhurst; // NOLINT
+namespace bench = blkhurst::bench;
+
+int main(int argc, char** argv) {
+  const int triangles = argc > 1 ? std::max(1, std::atoi(argv[1])) : 100000;
+  const int boxes = argc > 2 ? std::max(1, std::atoi(argv[2])) : 100000;
+  const int hardware = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+
+  const glm::mat4 projection = glm::perspective(glm::radians(60.0F), 2.0F, 0.1F, 200.0F);
+  const glm::mat4 view = glm::lookAt(glm::vec3(0.0F, 2.0F, 0.0F), glm::vec3(0.0F, 1.0F, -10.0F),
+                                     glm::vec3(0.0F, 1.0F, 0.0F));
+  const glm::mat4 viewProjection = projection * view;
+
+  // Occluders as small triangles spread through the view, boxes scattered behind and among them
+  std::mt19937 random(1);
+  auto uniform = [&](float low, float high) {
+    return std::uniform_real_distribution<float>(low, high)(random);
+  };
+  std::vector<float> positions;
+  positions.reserve(static_cast<std::size_t>(triangles) * 9);
+  for (int triangle = 0; triangle < triangles; ++triangle) {
+    const glm::vec3 centre(uniform(-30.0F, 30.0F), uniform(-5.0F, 15.0F), -uniform(5.0F, 60.0F));
+    for (int vertex = 0; vertex < 3; ++vertex) {
+      positions.insert(positions.end(), {centre[0] + uniform(-2.0F, 2.0F),
+                                         centre[1] + uniform(-2.0F, 2.0F),
+                                         centre[2] + uniform(-0.5F, 0.5F)});
+    }
+  }
+  std::vector<Aabb> bounds;
+  bounds.reserve(static_cast<std::size_t>(boxes));
+  for (int box = 0; box < boxes; ++box) {
+    const glm::vec3 centre(uniform(-40.0F, 40.0F), uniform(-8.0F, 20.0F), -uniform(5.0F, 80.0F));
+    const glm::vec3 half(uniform(0.1F, 1.5F));
+    bounds.push_back({.min = centre - half, .max = centre + half});
+  }
+
+  const OcclusionBuffer::Adjacency adjacency = OcclusionBuffer::buildAdjacency(positions, {});
+
+  std::printf("SIMD path: %s, %d triangles, %d boxes\n\n", OcclusionBuffer::simdPath(), triangles,
+              boxes);
+  std::printf("%8s %12s %14s %12s %10s\n", "workers", "setup ms", "rasterize ms", "test ms",
+              "hidden %");
+  std::vector<int> rows{0}; // The main thread alone, then every hardware thread
+  if (hardware > 1) {
+    rows.push_back(hardware - 1);
+  }
+  for (const int workers : rows) {
+    JobSystem jobs(workers);
+    JobSystem* scheduler = workers > 0 ? &jobs : nullptr;
+
+    OcclusionBuffer buffer;
+    const double setupMs = bench::measureMs([&]() {
+      buffer.clear();
+      buffer.addOccluder(positions, {}, viewProjection, &adjacency);
+    });
+    const double rasterizeMs = bench::measureMs([&]() {
+      buffer.clear();
+      buffer.addOccluder(positions, {}, viewProjection, &adjacency);
+      buffer.rasterize(scheduler);
+    }) - setupMs;
+
+    std::vector<std::uint8_t> hidden(bounds.size());
+    auto test = [&](std::size_t begin, std::size_t end) {
+      for (std::size_t i = begin; i < end; ++i) {
+        hidden[i] = buffer.occluded(bounds[i], viewProjection) ? 1 : 0;
+      }
+    };
+    const double testMs = bench::measureMs([&]() {
+      if (scheduler != nullptr) {
+        scheduler->parallelFor(bounds.size(), 256, test);
+      } else {
+        test(0, bounds.size());
+      }
+      bench::doNotOptimize(hidden);
+    });
+    const auto hiddenCount = std::count(hidden.begin(), hidden.end(), std::uint8_t{1});
+    std::printf("%8d %12.3f %14.3f %12.3f %9.1f%%\n", workers, setupMs, rasterizeMs, testMs,
+                100.0 * static_cast<double>(hiddenCount) / static_cast<double>(boxes));
+  }
+  return 0;
+}
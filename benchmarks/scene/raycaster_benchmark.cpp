@@ -0,0 +1,98 @@
+#include "benchmark.hpp"
+
+#include <blkhurst/geometry/bvh.hpp>
+#include <blkhurst/geometry/sphere_geometry.hpp>
+#include <blkhurst/jobs/job_system.hpp>
+#include <blkhurst/scene/raycaster.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <optional>
+#include <random>
+#include <thread>
+#include <vector>
+
+// MeshBvh build time and batched nearest-hit throughput through Raycaster over a grid of sphere
+// instances, on the main thread and with a JobSystem. No GL: the BVHs are built from MeshData.
+// Usage: raycaster_benchmark [triangles per mesh] [rays]   (default: 100000 1000000)
+
+using namespace blkhurst; // NOLINT
+namespace bench = blkhurst::bench;
+
+namespace {
+
+constexpr int kGrid = 8; // kGrid x kGrid instances
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const double triangles = argc > 1 ? std::max(100.0, std::atof(argv[1])) : 100000.0;
+  const int rayCount = argc > 2 ? std::max(1, std::atoi(argv[2])) : 1000000;
+  const int hardware = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+
+  // Sphere with width = 2 * height segments has about 4 * height^2 triangles
+  const int height = std::max(2, static_cast<int>(std::sqrt(triangles / 4.0)));
+  const MeshData model = SphereGeometry::buildSphere({.widthSegments = height * 2,
+                                                      .heightSegments = height});
+
+  // Rays from a point above the grid towards random points on the ground plane
+  std::mt19937 random(1);
+  auto uniform = [&](float low, float high) {
+    return std::uniform_real_distribution<float>(low, high)(random);
+  };
+  const float extent = static_cast<float>(kGrid) * 1.5F;
+  std::vector<Ray> rays;
+  rays.reserve(static_cast<std::size_t>(rayCount));
+  for (int i = 0; i < rayCount; ++i) {
+    const glm::vec3 origin(uniform(-2.0F, 2.0F), 20.0F, uniform(-2.0F, 2.0F));
+    const glm::vec3 target(uniform(-extent, extent), 0.0F, uniform(-extent, extent));
+    rays.push_back({.origin = origin, .direction = glm::normalize(target - origin)});
+  }
+  std::vector<std::optional<RaycastHit>> hits(rays.size());
+
+  std::printf("Model: %zu triangles, %d instances, %d rays\n\n", model.indices.size() / 3,
+              kGrid * kGrid, rayCount);
+  std::printf("%8s %12s %12s %14s %8s\n", "workers", "build ms", "query ms", "Mrays/s", "hit %");
+  std::vector<int> rows{0}; // The main thread alone, then every hardware thread
+  if (hardware > 1) {
+    rows.push_back(hardware - 1);
+  }
+  for (const int workers : rows) {
+    JobSystem jobs(workers);
+    JobSystem* scheduler = workers > 0 ? &jobs : nullptr;
+
+    std::shared_ptr<const MeshBvh> bvh;
+    const double buildMs = bench::measureMs(
+        [&]() {
+          bvh = MeshBvh::build(model.positions, model.indices, scheduler);
+          bench::doNotOptimize(bvh);
+        },
+        3, 1);
+
+    std::vector<RaycastTarget> targets;
+    for (int x = 0; x < kGrid; ++x) {
+      for (int z = 0; z < kGrid; ++z) {
+        const glm::vec3 offset(static_cast<float>(x - (kGrid / 2)) * 3.0F, 0.0F,
+                               static_cast<float>(z - (kGrid / 2)) * 3.0F);
+        targets.push_back({.bvh = bvh, .world = glm::translate(glm::mat4(1.0F), offset)});
+      }
+    }
+    Raycaster raycaster(scheduler);
+    raycaster.build(targets);
+
+    const double queryMs = bench::measureMs([&]() {
+      raycaster.intersectNearest(rays, hits);
+      bench::doNotOptimize(hits);
+    });
+    const auto hitCount =
+        std::count_if(hits.begin(), hits.end(), [](const auto& hit) { return hit.has_value(); });
+    std::printf("%8d %12.3f %12.3f %14.2f %7.1f%%\n", workers, buildMs, queryMs,
+                static_cast<double>(rayCount) / (queryMs * 1000.0),
+                100.0 * static_cast<double>(hitCount) / static_cast<double>(rayCount));
+  }
+  return 0;
+}
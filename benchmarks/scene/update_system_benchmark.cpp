@@ -0,0 +1,106 @@
+#include "benchmark.hpp"
+#include "scene/update_system.hpp"
+
+#include <blkhurst/engine/config/update.hpp>
+#include <blkhurst/engine/root_state.hpp>
+#include <blkhurst/jobs/job_system.hpp>
+#include <blkhurst/objects/object3d.hpp>
+#include <blkhurst/scene/scene.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+
+// Scaling of the parallel scene update from the serial path up to N workers.
+// Usage: update_system_benchmark [maxWorkers]   (default: hardware threads - 1)
+
+using namespace blkhurst; // NOLINT
+namespace bench = blkhurst::bench;
+
+namespace {
+
+constexpr int kSubtrees = 64;
+constexpr int kNodesPerSubtree = 128;
+constexpr int kFrames = 10;
+
+// Touches only itself; stands in for per-object gameplay logic
+class Spinner : public Object3D {
+public:
+  explicit Spinner(float phase)
+      : phase_(phase) {
+    setThreadSafeUpdate(true);
+  }
+
+  void onUpdate(const RootState& state) override {
+    float accumulator = phase_;
+    for (int i = 0; i < 64; ++i) {
+      accumulator = std::sin(accumulator + state.elapsed) * 0.5F + phase_;
+    }
+    phase_ = accumulator;
+    rotateY(state.delta);
+  }
+
+private:
+  float phase_;
+};
+
+void buildScene(Scene& scene) {
+  for (int group = 0; group < kSubtrees; ++group) {
+    auto* root = scene.addChild<Object3D>();
+    Object3D* parent = root;
+    for (int node = 0; node < kNodesPerSubtree; ++node) {
+      // Alternate wide and deep so propagation walks real chains
+      auto* spinner = parent->addChild<Spinner>(static_cast<float>(group * node));
+      spinner->translateX(1.0F);
+      if (node % 8 == 0) {
+        parent = spinner;
+      }
+    }
+  }
+}
+
+double runFrames(UpdateSystem& updates, Scene& scene, RootState& state) {
+  for (int frame = 0; frame < kFrames; ++frame) {
+    state.delta = 1.0F / 60.0F;
+    state.elapsed += state.delta;
+    updates.update(scene, state);
+  }
+  return static_cast<double>(state.elapsed);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+  const int hardware = static_cast<int>(std::max(1U, std::thread::hardware_concurrency()));
+  const int maxWorkers = argc > 1 ? std::max(0, std::atoi(argv[1])) : std::max(1, hardware - 1);
+
+  Scene scene;
+  buildScene(scene);
+  const UpdateConfig config{};
+
+  std::printf("Scene update scaling: %d subtrees x %d thread-safe nodes, %d frames per sample\n",
+              kSubtrees, kNodesPerSubtree, kFrames);
+  std::printf("%10s %10s %12s %9s\n", "mode", "workers", "ms/frame", "speedup");
+
+  double baseline = 0.0;
+  {
+    JobSystem jobs(0);
+    UpdateSystem updates(jobs, false, config);
+    RootState state{.jobs = &jobs};
+    baseline = bench::measureMs([&]() { bench::doNotOptimize(runFrames(updates, scene, state)); }) /
+               kFrames;
+    std::printf("%10s %10d %12.3f %8.2fx\n", "serial", 0, baseline, 1.0);
+  }
+  for (int workers = 0; workers <= maxWorkers; ++workers) {
+    JobSystem jobs(workers);
+    UpdateSystem updates(jobs, true, config);
+    RootState state{.jobs = &jobs};
+    const double frameMs =
+        bench::measureMs([&]() { bench::doNotOptimize(runFrames(updates, scene, state)); }) /
+        kFrames;
+    std::printf("%10s %10d %12.3f %8.2fx\n", "parallel", workers, frameMs, baseline / frameMs);
+  }
+  return 0;
+}
@@ -3,6 +3,8 @@
 #include "blkhurst/engine/config/assets.hpp"
 #include "blkhurst/engine/config/ui.hpp"
 #include <blkhurst/engine/config/logger.hpp>
+#include <blkhurst/engine/config/threading.hpp>
+#include <blkhurst/engine/config/update.hpp>
 #include <blkhurst/engine/config/window.hpp>
 
 namespace blkhurst {
@@ -12,6 +14,8 @@ struct EngineConfig {
   LoggerConfig loggerConfig{};
   WindowConfig windowConfig{};
   UiConfig uiConfig{};
+  ThreadingConfig threadingConfig{};
+  UpdateConfig updateConfig{};
 };
 
 } // namespace blkhurst
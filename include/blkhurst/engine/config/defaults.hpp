@@ -25,6 +25,17 @@ inline constexpr bool vSync = true;
 inline constexpr glm::vec4 clearColor = {0.1F, 0.1F, 0.1F, 1.0F};
 } // namespace window
 
+namespace threading {
+inline constexpr int workerThreads = -1;
+inline constexpr bool parallelUpdate = false;
+} // namespace threading
+
+namespace update {
+inline constexpr int slicedBudget = 512;
+inline constexpr float lodDistance = 25.0F;
+inline constexpr int maxLodInterval = 8;
+} // namespace update
+
 namespace ui {
 inline constexpr const char* title = "Blkhurst";
 
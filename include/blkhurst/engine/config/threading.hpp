@@ -0,0 +1,12 @@
+#pragma once
+
+#include <blkhurst/engine/config/defaults.hpp>
+
+namespace blkhurst {
+
+struct ThreadingConfig {
+  int workerThreads = defaults::threading::workerThreads; // < 0: hardware threads - 1
+  bool parallelUpdate = defaults::threading::parallelUpdate;
+};
+
+} // namespace blkhurst
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <blkhurst/engine/config/defaults.hpp>
+
+namespace blkhurst {
+
+// Time-sliced updates (Object3D::setUpdateInterval / setDistanceUpdateLod)
+struct UpdateConfig {
+  int slicedBudget = defaults::update::slicedBudget; // onUpdate calls per frame; <= 0: unlimited
+  float lodDistance = defaults::update::lodDistance; // Interval grows by 1 per lodDistance
+  int maxLodInterval = defaults::update::maxLodInterval;
+};
+
+} // namespace blkhurst
@@ -2,8 +2,8 @@
 
 #include <blkhurst/events/event_bus.hpp>
 #include <glm/glm.hpp>
+#include <span>
 #include <string>
-#include <vector>
 
 namespace blkhurst {
 
@@ -11,6 +11,8 @@ class Renderer;
 class Camera;
 class Scene;
 class Input;
+class JobSystem;
+class FrameArena;
 
 struct RootState {
   float delta = 0.0F;
@@ -19,15 +21,18 @@ struct RootState {
   float ms = 0.0F;
 
   glm::vec2 windowFramebufferSize{0.0F};
+  float resolutionScale = 1.0F; // Renderer dynamic resolution, per axis; 1 when off
 
   Renderer* renderer = nullptr;
   Camera* camera = nullptr;
   Input* input = nullptr;
   Scene* scene = nullptr;
   EventBus* events = nullptr;
+  JobSystem* jobs = nullptr;
+  FrameArena* frameArena = nullptr; // Reset each frame; for transient std::pmr containers
 
   int currentSceneIndex = -1;
-  std::vector<std::string> sceneNames;
+  std::span<const std::string> sceneNames; // View of SceneManager names
 };
 
 } // namespace blkhurst
@@ -3,6 +3,7 @@
 #include <atomic>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <typeindex>
 #include <unordered_map>
@@ -17,6 +18,7 @@ EventBus
 
   - Thread-safe
   - Synchronous delivery, in registration order
+  - Listener lists are copy-on-write; post() takes a reference, it does not allocate
   - Subscription destructor unsubscribes (RAII)
 */
 
@@ -114,11 +116,14 @@ public:
       func(*static_cast<const T*>(eventPointer));
     };
 
-    // Thread-safe store listener for this event type
+    // Thread-safe store listener for this event type (copy-on-write)
     {
       std::scoped_lock lock(mutex_);
       auto& list = listenersByType_[key];
-      list.push_back(Listener{listenerId, std::move(erased)});
+      auto updated =
+          list ? std::make_shared<ListenerList>(*list) : std::make_shared<ListenerList>();
+      updated->push_back(Listener{listenerId, std::move(erased)});
+      list = std::move(updated);
     }
 
     // Return Subscription, caller responsible for keep-alive
@@ -128,8 +133,8 @@ public:
   template <class T> void post(const T& event) const {
     const std::type_index key{typeid(T)};
 
-    // Copy listeners to allow unsubscribe during iteration
-    std::vector<Listener> snapshot;
+    // Hold the current list; unsubscribe during iteration replaces it rather than mutating
+    std::shared_ptr<const ListenerList> snapshot;
     {
       std::scoped_lock lock(mutex_);
       auto foundType = listenersByType_.find(key);
@@ -141,7 +146,7 @@ public:
     }
 
     // Deliver event to each listener
-    for (const auto& listener : snapshot) {
+    for (const auto& listener : *snapshot) {
       listener.function(&event);
     }
   }
@@ -170,7 +175,8 @@ private:
     std::uint64_t id;
     ErasedFunction function;
   };
-  std::unordered_map<std::type_index, std::vector<Listener>> listenersByType_;
+  using ListenerList = std::vector<Listener>;
+  std::unordered_map<std::type_index, std::shared_ptr<const ListenerList>> listenersByType_;
 };
 
 } // namespace blkhurst
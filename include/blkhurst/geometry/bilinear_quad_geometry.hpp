@@ -1,9 +1,11 @@
 // NOLINTBEGIN(readability-identifier-length)
 #pragma once
 #include <blkhurst/geometry/geometry.hpp>
+#include <blkhurst/geometry/geometry_cache.hpp>
 #include <glm/geometric.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
+#include <tuple>
 
 namespace blkhurst {
 
@@ -17,11 +19,21 @@ struct BilinearQuadGeometryDesc {
   glm::vec3 v3 = {-1.0, 1.0, 0.0};
   int widthSegments = kDefaultWidthSegments;
   int heightSegments = kDefaultHeightSegments;
+
+  bool operator==(const BilinearQuadGeometryDesc&) const = default;
+  [[nodiscard]] auto fields() const {
+    return std::tie(v0, v1, v2, v3, widthSegments, heightSegments);
+  }
 };
 
 struct BilinearQuadGeometry {
+  // Shared with every other create() for an equal desc (GeometryCache)
   static std::shared_ptr<Geometry> create(const BilinearQuadGeometryDesc& desc = {}) {
+    return GeometryCache::instance().getOrCreate(desc, createUnique);
+  }
 
+  // Private instance; use when the Geometry will be modified
+  static std::shared_ptr<Geometry> createUnique(const BilinearQuadGeometryDesc& desc = {}) {
     return Geometry::from(buildBilinearQuad(desc));
   }
 
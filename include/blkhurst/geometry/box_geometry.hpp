@@ -1,7 +1,9 @@
 #pragma once
 #include <blkhurst/geometry/geometry.hpp>
+#include <blkhurst/geometry/geometry_cache.hpp>
 #include <glm/glm.hpp>
 #include <memory>
+#include <tuple>
 
 namespace blkhurst {
 
@@ -12,10 +14,21 @@ struct BoxGeometryDesc {
   int widthSegments = 1;
   int heightSegments = 1;
   int depthSegments = 1;
+
+  bool operator==(const BoxGeometryDesc&) const = default;
+  [[nodiscard]] auto fields() const {
+    return std::tie(width, height, depth, widthSegments, heightSegments, depthSegments);
+  }
 };
 
 struct BoxGeometry {
+  // Shared with every other create() for an equal desc (GeometryCache)
   static std::shared_ptr<Geometry> create(const BoxGeometryDesc& desc = {}) {
+    return GeometryCache::instance().getOrCreate(desc, createUnique);
+  }
+
+  // Private instance; use when the Geometry will be modified
+  static std::shared_ptr<Geometry> createUnique(const BoxGeometryDesc& desc = {}) {
     return Geometry::from(buildBox(desc));
   }
 
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <blkhurst/util/aabb.hpp>
+#include <blkhurst/util/ray.hpp>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+Bvh (bounding volume hierarchy)
+  - Binned SAH build over primitive bounds; subtrees below kParallelPrimitives build as
+    JobSystem tasks and are stitched into one node array
+  - Interior nodes keep both children adjacent (left at first, right at first + 1)
+  - Leaves cover a range of primitives() (primitive ids in build order)
+  - MeshBvh: triangles of one Geometry (object space). Raycaster: a Bvh over mesh world bounds
+*/
+
+namespace blkhurst {
+
+class JobSystem;
+
+struct BvhNode {
+  Aabb bounds;
+  std::uint32_t first = 0; // Leaf: first slot in primitives(). Interior: left child
+  std::uint32_t count = 0; // Leaf primitive count; 0 for interior nodes
+
+  [[nodiscard]] bool leaf() const {
+    return count > 0;
+  }
+};
+
+class Bvh {
+public:
+  static constexpr std::uint32_t kMaxLeafSize = 8;
+  static constexpr std::size_t kParallelPrimitives = 1U << 14U;
+  static constexpr int kMaxDepth = 60; // Traversal stack bound
+
+  static Bvh build(std::span<const Aabb> primitiveBounds, JobSystem* jobs = nullptr);
+
+  // visit(slot, tMax) for every leaf slot the ray reaches, near child first; visit returns the
+  // (possibly shortened) tMax so nearest-hit queries skip farther subtrees
+  template <typename Visit> void traverse(const Ray& ray, float tMax, Visit&& visit) const;
+
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] Aabb bounds() const;
+  [[nodiscard]] std::span<const BvhNode> nodes() const;
+  [[nodiscard]] std::span<const std::uint32_t> primitives() const; // slot -> primitive id
+
+private:
+  std::vector<BvhNode> nodes_;
+  std::vector<std::uint32_t> primitives_;
+};
+
+struct TriangleHit {
+  float distance = 0.0F;        // Along the ray, in units of its direction
+  glm::vec3 barycentric{0.0F};  // Weights of the triangle's corners
+  std::uint32_t triangle = 0;   // Index into the source triangle list
+};
+
+class MeshBvh {
+public:
+  // Triangles of indices (or consecutive positions when empty); positions xyz
+  static std::shared_ptr<const MeshBvh> build(std::span<const float> positions,
+                                              std::span<const std::uint32_t> indices,
+                                              JobSystem* jobs = nullptr);
+
+  // Both faces; false if nothing is hit before tMax
+  [[nodiscard]] bool intersectNearest(const Ray& ray, float tMax, TriangleHit& hit) const;
+  // Appends every hit before tMax, unordered
+  void intersectAll(const Ray& ray, float tMax, std::vector<TriangleHit>& hits) const;
+
+  [[nodiscard]] Aabb bounds() const;
+  [[nodiscard]] std::size_t triangleCount() const;
+  [[nodiscard]] const Bvh& bvh() const;
+
+private:
+  // Precomputed edges (Moller-Trumbore), stored in Bvh slot order for locality
+  struct Triangle {
+    glm::vec3 v0;
+    glm::vec3 edge1;
+    glm::vec3 edge2;
+  };
+
+  [[nodiscard]] bool intersectTriangle_(const Ray& ray, std::uint32_t slot, float tMax,
+                                        TriangleHit& hit) const;
+
+  Bvh bvh_;
+  std::vector<Triangle> triangles_;
+};
+
+template <typename Visit> void Bvh::traverse(const Ray& ray, float tMax, Visit&& visit) const {
+  if (nodes_.empty()) {
+    return;
+  }
+  const glm::vec3 invDirection = 1.0F / ray.direction;
+
+  // (node, entry distance); entries beyond a shortened tMax are skipped when popped
+  std::pair<std::uint32_t, float> stack[(kMaxDepth * 2) + 2]; // NOLINT
+  int size = 0;
+  float rootEntry = 0.0F;
+  if (nodes_[0].bounds.intersect(ray.origin, invDirection, tMax, rootEntry)) {
+    stack[size++] = {0, rootEntry};
+  }
+  while (size > 0) {
+    const auto [index, entry] = stack[--size];
+    if (entry > tMax) {
+      continue;
+    }
+    const BvhNode& node = nodes_[index];
+    if (node.leaf()) {
+      for (std::uint32_t slot = node.first; slot < node.first + node.count; ++slot) {
+        tMax = visit(slot, tMax);
+      }
+      continue;
+    }
+
+    float leftEntry = 0.0F;
+    float rightEntry = 0.0F;
+    const bool hitLeft =
+        nodes_[node.first].bounds.intersect(ray.origin, invDirection, tMax, leftEntry);
+    const bool hitRight =
+        nodes_[node.first + 1].bounds.intersect(ray.origin, invDirection, tMax, rightEntry);
+    // Far child first so the near one pops next
+    if (hitLeft && hitRight) {
+      if (leftEntry <= rightEntry) {
+        stack[size++] = {node.first + 1, rightEntry};
+        stack[size++] = {node.first, leftEntry};
+      } else {
+        stack[size++] = {node.first, leftEntry};
+        stack[size++] = {node.first + 1, rightEntry};
+      }
+    } else if (hitLeft) {
+      stack[size++] = {node.first, leftEntry};
+    } else if (hitRight) {
+      stack[size++] = {node.first + 1, rightEntry};
+    }
+  }
+}
+
+} // namespace blkhurst
@@ -1,12 +1,15 @@
 #pragma once
 #include <algorithm>
 #include <blkhurst/geometry/geometry.hpp>
+#include <blkhurst/geometry/geometry_cache.hpp>
+#include <blkhurst/geometry/mesh_builder.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/gtx/norm.hpp>
 #include <memory>
-#include <vector>
+#include <numbers>
+#include <tuple>
 
 namespace blkhurst {
 
@@ -18,123 +21,152 @@ struct CapsuleGeometryDesc {
   int capSegments = 4;                  // Number of curve segments used to build each cap (>=1).
   int radialSegments = kRadialSegments; // Number of segmented faces around the circumference (>=3).
   int heightSegments = 1;               // Number of rows along the middle section (>=1).
+
+  bool operator==(const CapsuleGeometryDesc&) const = default;
+  [[nodiscard]] auto fields() const {
+    return std::tie(radius, height, capSegments, radialSegments, heightSegments);
+  }
 };
 
 struct CapsuleGeometry {
+  // Shared with every other create() for an equal desc (GeometryCache)
   static std::shared_ptr<Geometry> create(const CapsuleGeometryDesc& desc = {}) {
+    return GeometryCache::instance().getOrCreate(desc, createUnique);
+  }
+
+  // Private instance; use when the Geometry will be modified
+  static std::shared_ptr<Geometry> createUnique(const CapsuleGeometryDesc& desc = {}) {
     return Geometry::from(buildCapsule(desc));
   }
 
-  static MeshData buildCapsule(const CapsuleGeometryDesc& inDesc) {
-    using glm::pi;
-    using glm::vec2;
-    using glm::vec3;
+  static MeshData buildCapsule(const CapsuleGeometryDesc& inDesc, JobSystem* jobs = nullptr) {
+    const auto desc = sanitize(inDesc);
+    auto out = mesh_builder::allocate(counts(desc));
+    writeCapsule(desc, mesh_builder::spans(out), jobs);
+    return out;
+  }
 
-    // Ensure Valid Parameters
-    CapsuleGeometryDesc desc = inDesc;
+  // Ensure Valid Parameters
+  static constexpr CapsuleGeometryDesc sanitize(CapsuleGeometryDesc desc) {
     desc.height = std::max(0.0F, desc.height);
     desc.capSegments = std::max(1, desc.capSegments);
     desc.radialSegments = std::max(3, desc.radialSegments);
     desc.heightSegments = std::max(1, desc.heightSegments);
+    return desc;
+  }
+
+  static constexpr MeshCounts counts(const CapsuleGeometryDesc& desc) {
+    const auto rows = static_cast<std::size_t>(verticalSegments(desc));
+    const auto radial = static_cast<std::size_t>(desc.radialSegments);
+    return {(rows + 1) * (radial + 1), rows * radial * 6};
+  }
+
+  // Writes counts(desc) vertices/indices; rows run on jobs for large capsules
+  static constexpr void writeCapsule(const CapsuleGeometryDesc& desc, const MeshSpans& out,
+                                     JobSystem* jobs = nullptr) {
+    const int rows = verticalSegments(desc) + 1;
+    if (std::is_constant_evaluated() || jobs == nullptr) {
+      for (int iy = 0; iy < rows; ++iy) {
+        writeRow(desc, out, iy);
+      }
+      return;
+    }
+    mesh_builder::forEachRow(rows, counts(desc).vertices, jobs,
+                             [&](int iy) { writeRow(desc, out, iy); });
+  }
+
+private:
+  static constexpr int verticalSegments(const CapsuleGeometryDesc& desc) {
+    return desc.capSegments * 2 + desc.heightSegments;
+  }
+
+  // Vertex row iy, plus the quads joining it to row iy - 1
+  static constexpr void writeRow(const CapsuleGeometryDesc& desc, const MeshSpans& out, int iy) {
+    constexpr float kHalfPi = std::numbers::pi_v<float> * 0.5F;
 
     const float halfHeight = desc.height * 0.5F;
-    const float capArcLength = (pi<float>() * 0.5F) * desc.radius;
+    const float capArcLength = kHalfPi * desc.radius;
     const float cylinderPartLength = desc.height;
     const float totalArcLength = 2.0F * capArcLength + cylinderPartLength;
 
-    const int numVerticalSegments = desc.capSegments * 2 + desc.heightSegments;
+    const int numVerticalSegments = verticalSegments(desc);
     const int verticesPerRow = desc.radialSegments + 1;
 
-    MeshData out;
-
-    for (int iy = 0; iy <= numVerticalSegments; ++iy) {
-      float currentArcLength = 0.0F;
-      float profileY = 0.0F;
-      float profileRadius = 0.0F;
-      float normalYComponent = 0.0F;
-
-      if (iy <= desc.capSegments) {
-        // bottom cap
-        const float segmentProgress = static_cast<float>(iy) / static_cast<float>(desc.capSegments);
-        const float angle = segmentProgress * (pi<float>() * 0.5F);
-        profileY = -halfHeight - desc.radius * std::cos(angle);
-        profileRadius = desc.radius * std::sin(angle);
-        normalYComponent = -desc.radius * std::cos(angle);
-        currentArcLength = segmentProgress * capArcLength;
-      } else if (iy <= desc.capSegments + desc.heightSegments) {
-        // middle section
-        const float segmentProgress =
-            static_cast<float>(iy - desc.capSegments) / static_cast<float>(desc.heightSegments);
-        profileY = -halfHeight + segmentProgress * desc.height;
-        profileRadius = desc.radius;
-        normalYComponent = 0.0F;
-        currentArcLength = capArcLength + segmentProgress * cylinderPartLength;
-      } else {
-        // top cap
-        const float segmentProgress =
-            static_cast<float>(iy - desc.capSegments - desc.heightSegments) /
-            static_cast<float>(desc.capSegments);
-        const float angle = segmentProgress * (pi<float>() * 0.5F);
-        profileY = halfHeight + desc.radius * std::sin(angle);
-        profileRadius = desc.radius * std::cos(angle);
-        normalYComponent = desc.radius * std::sin(angle);
-        currentArcLength = capArcLength + cylinderPartLength + segmentProgress * capArcLength;
-      }
+    float currentArcLength = 0.0F;
+    float profileY = 0.0F;
+    float profileRadius = 0.0F;
+    float normalYComponent = 0.0F;
+
+    if (iy <= desc.capSegments) {
+      // bottom cap
+      const float segmentProgress = static_cast<float>(iy) / static_cast<float>(desc.capSegments);
+      const float angle = segmentProgress * kHalfPi;
+      profileY = -halfHeight - desc.radius * mesh_builder::cos(angle);
+      profileRadius = desc.radius * mesh_builder::sin(angle);
+      normalYComponent = -desc.radius * mesh_builder::cos(angle);
+      currentArcLength = segmentProgress * capArcLength;
+    } else if (iy <= desc.capSegments + desc.heightSegments) {
+      // middle section
+      const float segmentProgress =
+          static_cast<float>(iy - desc.capSegments) / static_cast<float>(desc.heightSegments);
+      profileY = -halfHeight + segmentProgress * desc.height;
+      profileRadius = desc.radius;
+      normalYComponent = 0.0F;
+      currentArcLength = capArcLength + segmentProgress * cylinderPartLength;
+    } else {
+      // top cap
+      const float segmentProgress =
+          static_cast<float>(iy - desc.capSegments - desc.heightSegments) /
+          static_cast<float>(desc.capSegments);
+      const float angle = segmentProgress * kHalfPi;
+      profileY = halfHeight + desc.radius * mesh_builder::sin(angle);
+      profileRadius = desc.radius * mesh_builder::cos(angle);
+      normalYComponent = desc.radius * mesh_builder::sin(angle);
+      currentArcLength = capArcLength + cylinderPartLength + segmentProgress * capArcLength;
+    }
 
-      const float vCoord = std::clamp(currentArcLength / totalArcLength, 0.0F, 1.0F);
+    const float vCoord = std::clamp(currentArcLength / totalArcLength, 0.0F, 1.0F);
 
-      // special case for the poles
-      float uOffset = 0.0F;
-      const float UvPoleOffset = 0.5F;
-      if (iy == 0) {
-        uOffset = UvPoleOffset / static_cast<float>(desc.radialSegments);
-      } else if (iy == numVerticalSegments) {
-        uOffset = -UvPoleOffset / static_cast<float>(desc.radialSegments);
-      }
+    // special case for the poles
+    float uOffset = 0.0F;
+    const float UvPoleOffset = 0.5F;
+    if (iy == 0) {
+      uOffset = UvPoleOffset / static_cast<float>(desc.radialSegments);
+    } else if (iy == numVerticalSegments) {
+      uOffset = -UvPoleOffset / static_cast<float>(desc.radialSegments);
+    }
 
-      for (int ix = 0; ix <= desc.radialSegments; ++ix) {
-        const float uCoord = static_cast<float>(ix) / static_cast<float>(desc.radialSegments);
-        const float theta = uCoord * pi<float>() * 2.0F;
-        const float sinTheta = std::sin(theta);
-        const float cosTheta = std::cos(theta);
-
-        // vertex
-        const vec3 vertex{
-            -profileRadius * cosTheta,
-            profileY,
-            profileRadius * sinTheta,
-        };
-        out.positions.insert(out.positions.end(), {vertex[0], vertex[1], vertex[2]});
-
-        // normal
-        vec3 normal{
-            -profileRadius * cosTheta,
-            normalYComponent,
-            profileRadius * sinTheta,
-        };
-        normal = glm::normalize(normal);
-        out.normals.insert(out.normals.end(), {normal[0], normal[1], normal[2]});
-
-        // uv
-        out.uvs.push_back(uCoord + uOffset);
-        out.uvs.push_back(vCoord);
-      }
+    for (int ix = 0; ix <= desc.radialSegments; ++ix) {
+      const float uCoord = static_cast<float>(ix) / static_cast<float>(desc.radialSegments);
+      const float theta = uCoord * std::numbers::pi_v<float> * 2.0F;
+      const float sinTheta = mesh_builder::sin(theta);
+      const float cosTheta = mesh_builder::cos(theta);
+
+      const float vertex[3] = {-profileRadius * cosTheta, profileY, profileRadius * sinTheta};
+      float normal[3] = {-profileRadius * cosTheta, normalYComponent, profileRadius * sinTheta};
+      mesh_builder::normalize(normal);
+      const float uv[2] = {uCoord + uOffset, vCoord};
+      mesh_builder::writeVertex(out, static_cast<std::size_t>((iy * verticesPerRow) + ix), vertex,
+                                normal, uv);
+    }
 
-      if (iy > 0) {
-        const int prevIndexRow = (iy - 1) * verticesPerRow;
-        for (int ix = 0; ix < desc.radialSegments; ++ix) {
-          const unsigned idxTopLeft = prevIndexRow + ix;
-          const unsigned idxTopRight = prevIndexRow + ix + 1;
-          const unsigned idxBottomLeft = iy * verticesPerRow + ix;
-          const unsigned idxBottomRight = iy * verticesPerRow + ix + 1;
-
-          out.indices.insert(out.indices.end(), {idxTopLeft, idxTopRight, idxBottomLeft});
-          out.indices.insert(out.indices.end(), {idxTopRight, idxBottomRight, idxBottomLeft});
-        }
+    if (iy == 0) {
+      return;
+    }
+    const auto radial = static_cast<std::size_t>(desc.radialSegments);
+    auto cursor = static_cast<std::size_t>(iy - 1) * radial * 6;
+    const int prevIndexRow = (iy - 1) * verticesPerRow;
+    for (int ix = 0; ix < desc.radialSegments; ++ix) {
+      const auto idxTopLeft = static_cast<std::uint32_t>(prevIndexRow + ix);
+      const auto idxTopRight = static_cast<std::uint32_t>(prevIndexRow + ix + 1);
+      const auto idxBottomLeft = static_cast<std::uint32_t>((iy * verticesPerRow) + ix);
+      const auto idxBottomRight = static_cast<std::uint32_t>((iy * verticesPerRow) + ix + 1);
+
+      for (auto index :
+           {idxTopLeft, idxTopRight, idxBottomLeft, idxTopRight, idxBottomRight, idxBottomLeft}) {
+        out.indices[cursor++] = index;
       }
     }
-
-    return out;
   }
 };
 
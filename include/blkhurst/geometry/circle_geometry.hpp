@@ -2,9 +2,11 @@
 #pragma once
 #include <algorithm>
 #include <blkhurst/geometry/geometry.hpp>
+#include <blkhurst/geometry/geometry_cache.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <memory>
+#include <tuple>
 #include <vector>
 
 namespace blkhurst {
@@ -23,11 +25,22 @@ struct CircleGeometryDesc {
   int segments = 32;                        // Number of segments (>=3).
   float thetaStart = 0.0F;                  // Start angle in radians.
   float thetaLength = glm::two_pi<float>(); // Central angle (default full circle).
+
+  bool operator==(const CircleGeometryDesc&) const = default;
+  [[nodiscard]] auto fields() const {
+    return std::tie(radius, segments, thetaStart, thetaLength);
+  }
 };
 // NOLINTEND(readability-magic-numbers)
 
 struct CircleGeometry {
+  // Shared with every other create() for an equal desc (GeometryCache)
   static std::shared_ptr<Geometry> create(const CircleGeometryDesc& desc = {}) {
+    return GeometryCache::instance().getOrCreate(desc, createUnique);
+  }
+
+  // Private instance; use when the Geometry will be modified
+  static std::shared_ptr<Geometry> createUnique(const CircleGeometryDesc& desc = {}) {
     return Geometry::from(buildCircle(desc));
   }
 
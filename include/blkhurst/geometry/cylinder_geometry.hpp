@@ -2,10 +2,12 @@
 #pragma once
 #include <algorithm>
 #include <blkhurst/geometry/geometry.hpp>
+#include <blkhurst/geometry/geometry_cache.hpp>
+#include <blkhurst/geometry/mesh_builder.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <memory>
-#include <vector>
+#include <tuple>
 
 namespace blkhurst {
 
@@ -19,152 +21,180 @@ struct CylinderGeometryDesc {
   bool openEnded = false;
   float thetaStart = 0.0F;
   float thetaLength = glm::two_pi<float>();
+
+  bool operator==(const CylinderGeometryDesc&) const = default;
+  [[nodiscard]] auto fields() const {
+    return std::tie(radiusTop, radiusBottom, height, radialSegments, heightSegments, openEnded,
+                    thetaStart, thetaLength);
+  }
 };
 // NOLINTEND(readability-magic-numbers)
 
 struct CylinderGeometry {
+  // Shared with every other create() for an equal desc (GeometryCache)
   static std::shared_ptr<Geometry> create(const CylinderGeometryDesc& desc = {}) {
+    return GeometryCache::instance().getOrCreate(desc, createUnique);
+  }
+
+  // Private instance; use when the Geometry will be modified
+  static std::shared_ptr<Geometry> createUnique(const CylinderGeometryDesc& desc = {}) {
     return Geometry::from(buildCylinder(desc));
   }
 
-  static MeshData buildCylinder(CylinderGeometryDesc desc) {
-    using glm::vec2;
-    using glm::vec3;
+  static MeshData buildCylinder(const CylinderGeometryDesc& inDesc, JobSystem* jobs = nullptr) {
+    const auto desc = sanitize(inDesc);
+    auto out = mesh_builder::allocate(counts(desc));
+    writeCylinder(desc, mesh_builder::spans(out), jobs);
+    return out;
+  }
 
-    // three.js floors these; we ensure minimums here
+  // three.js floors these; we ensure minimums here
+  static constexpr CylinderGeometryDesc sanitize(CylinderGeometryDesc desc) {
     desc.radialSegments = std::max(3, desc.radialSegments);
     desc.heightSegments = std::max(1, desc.heightSegments);
+    return desc;
+  }
 
-    MeshData out;
-
-    int index = 0;                            // running vertex index
-    std::vector<std::vector<int>> indexArray; // [y][x]
-    const float halfHeight = desc.height * 0.5F;
-
-    generateTorso(out, desc, index, indexArray, halfHeight);
+  // Torso, then a top and a bottom cap (each: one centre vertex per segment plus a rim)
+  static constexpr MeshCounts counts(const CylinderGeometryDesc& desc) {
+    const auto radial = static_cast<std::size_t>(desc.radialSegments);
+    const auto height = static_cast<std::size_t>(desc.heightSegments);
+    std::size_t torsoTriangles = 2 * radial * height;
+    torsoTriangles -= desc.radiusTop > 0.0F ? 0 : radial;
+    torsoTriangles -= desc.radiusBottom > 0.0F ? 0 : radial;
+
+    MeshCounts sizes{(radial + 1) * (height + 1), torsoTriangles * 3};
+    const std::size_t caps = (hasCap(desc, true) ? 1 : 0) + (hasCap(desc, false) ? 1 : 0);
+    sizes.vertices += caps * ((2 * radial) + 1);
+    sizes.indices += caps * radial * 3;
+    return sizes;
+  }
 
-    if (!desc.openEnded) {
-      if (desc.radiusTop > 0.0F) {
-        generateCap(out, desc, /*top=*/true, index, halfHeight);
-      }
-      if (desc.radiusBottom > 0.0F) {
-        generateCap(out, desc, /*top=*/false, index, halfHeight);
+  // Writes counts(desc) vertices/indices; torso rows run on jobs for large cylinders
+  static constexpr void writeCylinder(const CylinderGeometryDesc& desc, const MeshSpans& out,
+                                      JobSystem* jobs = nullptr) {
+    const int rows = desc.heightSegments + 1;
+    if (std::is_constant_evaluated() || jobs == nullptr) {
+      for (int y = 0; y < rows; ++y) {
+        writeTorsoRow(desc, out, y);
       }
+    } else {
+      mesh_builder::forEachRow(rows, counts(desc).vertices, jobs,
+                               [&](int y) { writeTorsoRow(desc, out, y); });
     }
 
-    return out;
+    // Caps follow the torso in both buffers
+    const auto radial = static_cast<std::size_t>(desc.radialSegments);
+    auto torso = desc;
+    torso.openEnded = true;
+    MeshCounts cursor = counts(torso);
+    for (const bool top : {true, false}) {
+      if (hasCap(desc, top)) {
+        writeCap(desc, out, top, cursor);
+        cursor.vertices += (2 * radial) + 1;
+        cursor.indices += radial * 3;
+      }
+    }
   }
 
 private:
-  // Push one vertex (position/normal/uv) and increment index
-  // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-  static inline void pushVertex(MeshData& out, const glm::vec3& p, const glm::vec3& n,
-                                const glm::vec2& uv, int& index) {
-    out.positions.insert(out.positions.end(), {p[0], p[1], p[2]});
-    out.normals.insert(out.normals.end(), {n[0], n[1], n[2]});
-    out.uvs.insert(out.uvs.end(), {uv[0], uv[1]});
-    ++index;
+  static constexpr bool hasCap(const CylinderGeometryDesc& d, bool top) {
+    return !d.openEnded && (top ? d.radiusTop : d.radiusBottom) > 0.0F;
   }
 
-  static void generateTorso(MeshData& out, const CylinderGeometryDesc& d, int& index,
-                            std::vector<std::vector<int>>& indexArray, float halfHeight) {
-    using glm::vec2;
-    using glm::vec3;
+  // Vertex row y, plus the quads between it and row y + 1
+  static constexpr void writeTorsoRow(const CylinderGeometryDesc& d, const MeshSpans& out, int y) {
+    const int stride = d.radialSegments + 1;
+    const float halfHeight = d.height * 0.5F;
 
     // matches three.js: slope = (rb - rt) / height
     const float slope = (d.radiusBottom - d.radiusTop) / d.height;
 
     // vertices, normals, uvs
-    for (int y = 0; y <= d.heightSegments; ++y) {
-      std::vector<int> row;
-      const float v = static_cast<float>(y) / static_cast<float>(d.heightSegments);
-      const float radius = v * (d.radiusBottom - d.radiusTop) + d.radiusTop;
-
-      for (int x = 0; x <= d.radialSegments; ++x) {
-        const float u = static_cast<float>(x) / static_cast<float>(d.radialSegments);
-        const float theta = u * d.thetaLength + d.thetaStart;
-
-        const float s = std::sin(theta);
-        const float c = std::cos(theta);
-
-        glm::vec3 pos{radius * s, -v * d.height + halfHeight, radius * c};
-        glm::vec3 nrm = glm::normalize(glm::vec3{s, slope, c});
-        glm::vec2 uv{u, 1.0F - v};
+    const float v = static_cast<float>(y) / static_cast<float>(d.heightSegments);
+    const float radius = v * (d.radiusBottom - d.radiusTop) + d.radiusTop;
+    for (int x = 0; x <= d.radialSegments; ++x) {
+      const float u = static_cast<float>(x) / static_cast<float>(d.radialSegments);
+      const float theta = u * d.thetaLength + d.thetaStart;
 
-        pushVertex(out, pos, nrm, uv, index);
-        row.push_back(index - 1);
-      }
+      const float s = mesh_builder::sin(theta);
+      const float c = mesh_builder::cos(theta);
 
-      indexArray.push_back(std::move(row));
+      const float pos[3] = {radius * s, -v * d.height + halfHeight, radius * c};
+      float nrm[3] = {s, slope, c};
+      mesh_builder::normalize(nrm);
+      const float uv[2] = {u, 1.0F - v};
+      mesh_builder::writeVertex(out, static_cast<std::size_t>((y * stride) + x), pos, nrm, uv);
     }
 
-    // indices (same pattern as three.js)
+    // indices (three.js pattern, row-major so rows are independent)
+    if (y >= d.heightSegments) {
+      return;
+    }
+    const bool writeUpper = d.radiusTop > 0.0F || y != 0;
+    const bool writeLower = d.radiusBottom > 0.0F || y != d.heightSegments - 1;
+    const auto radial = static_cast<std::size_t>(d.radialSegments);
+    std::size_t cursor = 6 * radial * static_cast<std::size_t>(y);
+    if (y > 0 && d.radiusTop <= 0.0F) {
+      cursor -= 3 * radial;
+    }
     for (int x = 0; x < d.radialSegments; ++x) {
-      for (int y = 0; y < d.heightSegments; ++y) {
-        const unsigned a = indexArray[y][x];
-        const unsigned b = indexArray[y + 1][x];
-        const unsigned c = indexArray[y + 1][x + 1];
-        const unsigned e = indexArray[y][x + 1];
-
-        if (d.radiusTop > 0.0F || y != 0) {
-          out.indices.insert(out.indices.end(), {a, b, e});
-        }
-        if (d.radiusBottom > 0.0F || y != d.heightSegments - 1) {
-          out.indices.insert(out.indices.end(), {b, c, e});
-        }
+      const auto a = static_cast<std::uint32_t>((y * stride) + x);
+      const auto b = static_cast<std::uint32_t>(((y + 1) * stride) + x);
+      const auto c = static_cast<std::uint32_t>(((y + 1) * stride) + x + 1);
+      const auto e = static_cast<std::uint32_t>((y * stride) + x + 1);
+
+      if (writeUpper) {
+        out.indices[cursor++] = a;
+        out.indices[cursor++] = b;
+        out.indices[cursor++] = e;
+      }
+      if (writeLower) {
+        out.indices[cursor++] = b;
+        out.indices[cursor++] = c;
+        out.indices[cursor++] = e;
       }
     }
   }
 
-  static void generateCap(MeshData& out, const CylinderGeometryDesc& d, bool top, int& index,
-                          float halfHeight) {
-    using glm::vec2;
-    using glm::vec3;
-
+  static constexpr void writeCap(const CylinderGeometryDesc& d, const MeshSpans& out, bool top,
+                                 const MeshCounts& start) {
+    const float halfHeight = d.height * 0.5F;
     const float radius = top ? d.radiusTop : d.radiusBottom;
     const float sign = top ? 1.0F : -1.0F;
-
-    // save index of the first center vertex
-    const int centerIndexStart = index;
+    const float nrm[3] = {0.0F, sign, 0.0F};
 
     // we generate a center vertex per segment (like three.js)
-    for (int x = 1; x <= d.radialSegments; ++x) {
-      glm::vec3 pos{0.0F, halfHeight * sign, 0.0F};
-      glm::vec3 nrm{0.0F, sign, 0.0F};
-      glm::vec2 uv{0.5F, 0.5F};
-      pushVertex(out, pos, nrm, uv, index);
+    const std::size_t centerIndexStart = start.vertices;
+    for (int x = 0; x < d.radialSegments; ++x) {
+      const float pos[3] = {0.0F, halfHeight * sign, 0.0F};
+      const float uv[2] = {0.5F, 0.5F};
+      mesh_builder::writeVertex(out, centerIndexStart + x, pos, nrm, uv);
     }
 
-    // last center vertex index
-    const int centerIndexEnd = index;
-
     // rim vertices
+    const std::size_t centerIndexEnd = centerIndexStart + d.radialSegments;
     for (int x = 0; x <= d.radialSegments; ++x) {
       const float u = static_cast<float>(x) / static_cast<float>(d.radialSegments);
       const float theta = u * d.thetaLength + d.thetaStart;
 
-      const float c = std::cos(theta);
-      const float s = std::sin(theta);
+      const float c = mesh_builder::cos(theta);
+      const float s = mesh_builder::sin(theta);
 
-      glm::vec3 pos{radius * s, halfHeight * sign, radius * c};
-      glm::vec3 nrm{0.0F, sign, 0.0F};
-      glm::vec2 uv{(c * 0.5F) + 0.5F, (s * 0.5F * sign) + 0.5F};
-
-      pushVertex(out, pos, nrm, uv, index);
+      const float pos[3] = {radius * s, halfHeight * sign, radius * c};
+      const float uv[2] = {(c * 0.5F) + 0.5F, (s * 0.5F * sign) + 0.5F};
+      mesh_builder::writeVertex(out, centerIndexEnd + x, pos, nrm, uv);
     }
 
-    // indices (fan per segment)
+    // indices (fan per segment); top faces up, bottom faces down
+    std::size_t cursor = start.indices;
     for (int x = 0; x < d.radialSegments; ++x) {
-      const unsigned c = centerIndexStart + x;
-      const unsigned i = centerIndexEnd + x;
-
-      if (top) {
-        // face top
-        out.indices.insert(out.indices.end(), {i, i + 1, c});
-      } else {
-        // face bottom
-        out.indices.insert(out.indices.end(), {i + 1, i, c});
-      }
+      const auto c = static_cast<std::uint32_t>(centerIndexStart + x);
+      const auto i = static_cast<std::uint32_t>(centerIndexEnd + x);
+
+      out.indices[cursor++] = top ? i : i + 1;
+      out.indices[cursor++] = top ? i + 1 : i;
+      out.indices[cursor++] = c;
     }
   }
 };
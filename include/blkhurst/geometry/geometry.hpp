@@ -1,8 +1,15 @@
 #pragma once
 
 #include <blkhurst/geometry/mesh_data.hpp>
+#include <blkhurst/geometry/mesh_optimizer.hpp>
+#include <blkhurst/geometry/meshlet.hpp>
+#include <blkhurst/geometry/vertex_layout.hpp>
+#include <blkhurst/geometry/vertex_pool.hpp>
 #include <blkhurst/graphics/buffer.hpp>
+#include <blkhurst/graphics/stream_buffer.hpp>
 #include <blkhurst/graphics/vertex_array.hpp>
+#include <blkhurst/util/handle.hpp>
+#include <glm/glm.hpp>
 
 #include <cstdint>
 #include <memory>
@@ -18,17 +25,37 @@ struct DrawRange {
   int count = 0;
 };
 
-// Tangent Unused, TBN calculated via dFdx/dfdy
-enum class Attrib : std::uint8_t {
-  Position = 0,
-  Color = 1,
-  Uv = 2,
-  Normal = 3,
-  InstanceColor = 4,
-  InstanceMatrix = 5,
+enum class IndexType : std::uint8_t { Uint16, Uint32 };
+
+// Level of detail; an index range into the shared index buffer
+struct GeometryLod {
+  DrawRange range;
+  float error = 0.0F; // Object-space deviation from level 0
+};
+
+struct BoundingSphere {
+  glm::vec3 center{0.0F};
+  float radius = 0.0F;
+};
+
+// Geometry::from options
+struct GeometryDesc {
+  VertexLayout layout = VertexLayout::standard();
+  bool optimize = false; // Run MeshOptimizer on a copy of the MeshData before upload
+  MeshOptimizerOptions optimizer{};
+  int lodLevels = 0;         // Simplified levels after level 0; each ~half the triangles
+  float lodMaxError = 0.05F; // Relative to mesh extent; stops the chain early
+  bool meshlets = false;     // Cluster level 0 for per-meshlet culling
+  MeshletLimits meshletLimits{};
+  bool vertexPulling = false;  // Upload into the shared VertexPool; layout is ignored
+  bool bvh = false;            // Build a MeshBvh of level 0 for raycasting (no readback later)
+  bool positionStream = false; // Also packed positions for depth-only passes; not when pooled
 };
 
-class Geometry {
+class JobSystem;
+class MeshBvh;
+
+class Geometry : public Handled<Geometry> {
 public:
   Geometry();
   virtual ~Geometry();
@@ -40,8 +67,30 @@ public:
 
   static std::shared_ptr<Geometry> create();
 
-  void setAttribute(Attrib attrib, std::span<const float> data, int componentCount);
+  // Replaces any previous buffer for attrib
+  void setAttribute(Attrib attrib, std::span<const float> data, int componentCount,
+                    BufferUsage usage = BufferUsage::Static);
+  // Writes into the existing storage; offset in floats. Attributes set with setAttribute update
+  // their own buffer (orphaned on whole rewrites, ring-advanced when Stream); Float attributes of
+  // the interleaved stream are written through a mapped range. A successful Position write is
+  // then mirrored into the position stream, decoded as the layout stores it (a stream it cannot
+  // follow is dropped). Bounds are not recomputed
+  bool updateAttribute(Attrib attrib, std::span<const float> data, std::size_t offset = 0);
+  // Single interleaved stream; replaces any previous interleaved stream
+  void setVertices(std::span<const std::byte> data, const VertexLayout& layout);
   void setIndex(std::span<const unsigned> indices);
+  void setIndex(std::span<const std::uint16_t> indices);
+  // Packed Float3 positions in their own buffer and VertexArray (sharing the index buffer), so
+  // depth-only passes fetch 12 bytes per vertex instead of the whole interleaved vertex. Must
+  // decode to the same values as the main stream; kept in sync by setAttribute/updateAttribute
+  // on Position and dropped by setVertices
+  void setPositionStream(std::span<const float> positions);
+
+  // Level 0 first; the draw range resets to level 0
+  void setLods(std::vector<GeometryLod> lods);
+  void setBoundingSphere(const BoundingSphere& sphere);
+  // Ranges into the index buffer; empty disables meshlet culling
+  void setMeshlets(std::vector<Meshlet> meshlets);
 
   void setPrimitive(PrimitiveMode mode);
   void setDrawRange(int start, int count);
@@ -50,20 +99,69 @@ public:
   [[nodiscard]] PrimitiveMode primitive() const;
   [[nodiscard]] DrawRange drawRange() const;
   [[nodiscard]] bool isIndexed() const;
+  [[nodiscard]] IndexType indexType() const;
+  [[nodiscard]] std::size_t indexSize() const; // Bytes per index
+  [[nodiscard]] std::size_t byteSize() const;  // Vertex + index buffer bytes
   [[nodiscard]] const VertexArray& vertexArray() const;
-
-  static std::shared_ptr<Geometry> from(const MeshData& meshData);
+  [[nodiscard]] const VertexArray* positionArray() const; // Null without a position stream
+  [[nodiscard]] int lodCount() const; // 0 without LODs
+  [[nodiscard]] const GeometryLod& lod(int level) const;
+  [[nodiscard]] const BoundingSphere& boundingSphere() const;
+  [[nodiscard]] std::span<const Meshlet> meshlets() const;
+  // Pooled geometry draws from the VertexPool VAO with base vertex/index offsets; its own
+  // vertexArray() is empty and setAttribute/updateAttribute do not reach the pool
+  [[nodiscard]] bool isPooled() const;
+  [[nodiscard]] const VertexPool* vertexPool() const;
+  [[nodiscard]] const VertexPoolAllocation& poolAllocation() const;
+  // GPU readback of level 0 (positions, normals, uvs, indices); stalls, so load-time only.
+  // Stream attributes are not read
+  [[nodiscard]] MeshData readMeshData() const;
+
+  // Level 0 triangles in object space; null until built
+  [[nodiscard]] const std::shared_ptr<const MeshBvh>& bvh() const;
+  void setBvh(std::shared_ptr<const MeshBvh> bvh);
+  // Builds from readMeshData() when missing (GL thread; jobs parallelise the build)
+  const MeshBvh* ensureBvh(JobSystem* jobs = nullptr);
+
+  // Interleaves into desc.layout; 16-bit indices when every index fits. LOD index lists are
+  // appended to one index buffer over the shared vertices
+  static std::shared_ptr<Geometry> from(const MeshData& meshData, const GeometryDesc& desc = {});
 
 private:
   VertexArray vao_;
-  // Geometry owns Buffer; one attribute per Buffer
-  std::vector<std::unique_ptr<Buffer>> vbos_;
+  // setAttribute storage; one Buffer (Static/Dynamic) or StreamBuffer (Stream) per attribute
+  struct AttributeBuffer {
+    Attrib attrib;
+    int componentCount = 0;
+    std::unique_ptr<Buffer> buffer;
+    std::unique_ptr<StreamBuffer> stream;
+  };
+
+  bool updateInterleaved_(Attrib attrib, std::span<const float> data, std::size_t offset);
+  void updatePositionStream_(std::span<const float> data, std::size_t offset, int components,
+                             const VertexLayout& layout);
+  void setPooled_(const MeshData& meshData, std::span<const std::uint32_t> indices);
+
+  // Geometry owns Buffer; one attribute per Buffer (setAttribute), or one interleaved Buffer
+  std::vector<AttributeBuffer> attributes_;
+  std::unique_ptr<Buffer> interleaved_;
+  VertexLayout layout_;
   std::unique_ptr<Buffer> ebo_;
+  std::unique_ptr<Buffer> positionStream_;
+  std::unique_ptr<VertexArray> positionVao_;
+  IndexType indexType_ = IndexType::Uint32;
+  std::shared_ptr<VertexPool> pool_; // Vertex pulling; replaces the buffers above
+  VertexPoolAllocation poolAllocation_;
 
   PrimitiveMode primitive_ = PrimitiveMode::Triangles;
   DrawRange drawRange_;
   bool isIndexed_ = false;
 
+  std::vector<GeometryLod> lods_;
+  BoundingSphere boundingSphere_;
+  std::vector<Meshlet> meshlets_;
+  std::shared_ptr<const MeshBvh> bvh_;
+
   // Cache for clearDrawRange
   int vertexCount_ = 0;
   int indexCount_ = 0;
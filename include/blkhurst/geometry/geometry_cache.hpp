@@ -0,0 +1,110 @@
+#pragma once
+
+#include <blkhurst/geometry/geometry.hpp>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <typeindex>
+#include <unordered_map>
+
+/**
+GeometryCache (hash-consing for primitive builders)
+  - Keyed by desc type (one per builder) and a hash of desc.fields(); equality confirms hits
+  - Weakly held: a Geometry is freed with its last Mesh; the expired entry is pruned later
+  - XGeometry::create() shares through the cache; createUnique() when the Geometry is modified
+  - Not thread-safe; Geometry is created on the GL thread
+*/
+
+namespace blkhurst {
+
+namespace geometry_cache {
+inline void hashCombine(std::size_t& seed, std::size_t value) {
+  seed ^= value + 0x9E3779B97F4A7C15ULL + (seed << 6U) + (seed >> 2U); // NOLINT
+}
+
+template <typename T> std::size_t hashValue(const T& value) {
+  return std::hash<T>{}(value); // std::hash<float> equates 0 and -0, matching ==
+}
+
+inline std::size_t hashValue(const glm::vec3& value) {
+  std::size_t seed = 0;
+  for (int axis = 0; axis < 3; ++axis) {
+    hashCombine(seed, std::hash<float>{}(value[axis]));
+  }
+  return seed;
+}
+
+// Desc types expose fields() (std::tie of every member) and a defaulted operator==
+template <typename Desc> std::size_t hashDesc(const Desc& desc) {
+  std::size_t seed = std::type_index(typeid(Desc)).hash_code();
+  std::apply([&](const auto&... field) { (hashCombine(seed, hashValue(field)), ...); },
+             desc.fields());
+  return seed;
+}
+} // namespace geometry_cache
+
+struct GeometryCacheStats {
+  std::size_t hits = 0;
+  std::size_t misses = 0;
+  std::size_t live = 0; // Entries whose Geometry is still alive
+};
+
+class GeometryCache {
+public:
+  static GeometryCache& instance();
+
+  // Shared Geometry for desc; build(desc) runs on a miss
+  template <typename Desc, typename Build>
+  std::shared_ptr<Geometry> getOrCreate(const Desc& desc, Build&& build);
+
+  [[nodiscard]] GeometryCacheStats stats() const;
+  void clear(); // Forget all entries; live Geometry stays with its owners
+
+private:
+  struct Entry {
+    std::type_index type;
+    std::shared_ptr<const void> desc;
+    std::weak_ptr<Geometry> geometry;
+  };
+
+  void pruneExpired_();
+
+  std::unordered_multimap<std::size_t, Entry> entries_;
+  std::size_t pruneThreshold_ = 64;
+  std::size_t hits_ = 0;
+  std::size_t misses_ = 0;
+};
+
+template <typename Desc, typename Build>
+std::shared_ptr<Geometry> GeometryCache::getOrCreate(const Desc& desc, Build&& build) {
+  const std::size_t hash = geometry_cache::hashDesc(desc);
+  auto [first, last] = entries_.equal_range(hash);
+  for (auto it = first; it != last; ++it) {
+    auto& entry = it->second;
+    if (entry.type != std::type_index(typeid(Desc)) ||
+        !(*static_cast<const Desc*>(entry.desc.get()) == desc)) {
+      continue;
+    }
+    if (auto geometry = entry.geometry.lock()) {
+      ++hits_;
+      return geometry;
+    }
+    entries_.erase(it); // Expired; rebuild below
+    break;
+  }
+
+  ++misses_;
+  std::shared_ptr<Geometry> geometry = std::forward<Build>(build)(desc);
+  entries_.emplace(hash, Entry{std::type_index(typeid(Desc)), std::make_shared<Desc>(desc),
+                               geometry});
+  if (entries_.size() >= pruneThreshold_) {
+    pruneExpired_();
+  }
+  return geometry;
+}
+
+} // namespace blkhurst
@@ -0,0 +1,158 @@
+#pragma once
+
+#include <blkhurst/geometry/mesh_data.hpp>
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <numbers>
+#include <span>
+#include <type_traits>
+
+/**
+Primitive builder support
+  - MeshCounts    - Exact vertex/index counts; builders size every buffer once
+  - MeshSpans     - Caller-owned destination (MeshData, FixedMeshData, mapped buffers)
+  - FixedMeshData - std::array storage for compile-time generation (buildFixed)
+  - forEachRow    - Rows on a JobSystem once a mesh is large enough to pay for it
+  - sin/cos/sqrt  - constexpr-capable; std:: at runtime, series in constant evaluation
+*/
+
+namespace blkhurst {
+
+class JobSystem;
+
+struct MeshCounts {
+  std::size_t vertices = 0;
+  std::size_t indices = 0;
+};
+
+// Empty spans are skipped (e.g. tangents)
+struct MeshSpans {
+  std::span<float> positions; // 3 per vertex
+  std::span<float> normals;   // 3 per vertex
+  std::span<float> uvs;       // 2 per vertex
+  std::span<float> tangents;  // 3 per vertex
+  std::span<std::uint32_t> indices;
+};
+
+template <std::size_t VertexCount, std::size_t IndexCount, bool Tangents = false>
+struct FixedMeshData {
+  std::array<float, VertexCount * 3> positions{};
+  std::array<float, VertexCount * 3> normals{};
+  std::array<float, VertexCount * 2> uvs{};
+  std::array<float, Tangents ? VertexCount * 3 : 0> tangents{};
+  std::array<std::uint32_t, IndexCount> indices{};
+
+  constexpr MeshSpans spans() {
+    return {positions, normals, uvs, tangents, indices};
+  }
+
+  [[nodiscard]] MeshData toMeshData() const {
+    MeshData out;
+    out.positions.assign(positions.begin(), positions.end());
+    out.normals.assign(normals.begin(), normals.end());
+    out.uvs.assign(uvs.begin(), uvs.end());
+    out.tangents.assign(tangents.begin(), tangents.end());
+    out.indices.assign(indices.begin(), indices.end());
+    return out;
+  }
+};
+
+namespace mesh_builder {
+
+constexpr std::size_t kParallelVertexThreshold = std::size_t{1} << 16U;
+
+// Sized (not reserved) for counts; tangents only when requested
+MeshData allocate(const MeshCounts& counts, bool tangents = false);
+MeshSpans spans(MeshData& meshData);
+
+// row(index) for every row in [0, rows); parallel when jobs is set and vertices is large
+void forEachRow(int rows, std::size_t vertices, JobSystem* jobs,
+                const std::function<void(int)>& row);
+
+// Writes one vertex; index is the vertex number
+constexpr void writeVertex(const MeshSpans& out, std::size_t index, const float (&position)[3],
+                           const float (&normal)[3], const float (&uv)[2]) {
+  for (std::size_t axis = 0; axis < 3; ++axis) {
+    out.positions[(index * 3) + axis] = position[axis];
+    out.normals[(index * 3) + axis] = normal[axis];
+  }
+  out.uvs[index * 2] = uv[0];
+  out.uvs[(index * 2) + 1] = uv[1];
+}
+
+constexpr double reduceAngle(double angle) {
+  constexpr double kTwoPi = 2.0 * std::numbers::pi;
+  const auto turns = static_cast<long long>(angle / kTwoPi);
+  angle -= static_cast<double>(turns) * kTwoPi;
+  if (angle > std::numbers::pi) {
+    angle -= kTwoPi;
+  } else if (angle < -std::numbers::pi) {
+    angle += kTwoPi;
+  }
+  return angle;
+}
+
+// Taylor series on [-pi, pi]; well inside float precision by the last term
+constexpr double sinSeries(double angle) {
+  constexpr int kTerms = 12;
+  const double x = reduceAngle(angle);
+  double term = x;
+  double sum = x;
+  for (int n = 1; n < kTerms; ++n) {
+    term *= -x * x / static_cast<double>((2 * n) * ((2 * n) + 1));
+    sum += term;
+  }
+  return sum;
+}
+
+constexpr float sin(float angle) {
+  if (std::is_constant_evaluated()) {
+    return static_cast<float>(sinSeries(angle));
+  }
+  return std::sin(angle);
+}
+
+constexpr float cos(float angle) {
+  if (std::is_constant_evaluated()) {
+    return static_cast<float>(sinSeries(static_cast<double>(angle) + (std::numbers::pi / 2.0)));
+  }
+  return std::cos(angle);
+}
+
+constexpr float sqrt(float value) {
+  if (std::is_constant_evaluated()) {
+    if (value <= 0.0F) {
+      return 0.0F;
+    }
+    double estimate = value >= 1.0F ? value : 1.0;
+    for (int i = 0; i < 64; ++i) {
+      const double next = 0.5 * (estimate + (value / estimate));
+      if (next == estimate) {
+        break;
+      }
+      estimate = next;
+    }
+    return static_cast<float>(estimate);
+  }
+  return std::sqrt(value);
+}
+
+// In place; zero vectors are left as is
+constexpr void normalize(float (&vector)[3]) {
+  const float lengthSq =
+      (vector[0] * vector[0]) + (vector[1] * vector[1]) + (vector[2] * vector[2]);
+  const float length = mesh_builder::sqrt(lengthSq);
+  if (length > 0.0F) {
+    vector[0] /= length;
+    vector[1] /= length;
+    vector[2] /= length;
+  }
+}
+
+} // namespace mesh_builder
+
+} // namespace blkhurst
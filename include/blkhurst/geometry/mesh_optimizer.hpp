@@ -0,0 +1,56 @@
+#pragma once
+
+#include <blkhurst/geometry/mesh_data.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/**
+MeshOptimizer (triangle lists)
+  - weld()                - Merge bit-identical vertices (all present attributes)
+  - optimizeVertexCache() - Tipsify triangle order for the post-transform cache
+  - optimizeOverdraw()    - Reorder Tipsify clusters front-facing-outwards first
+  - optimizeVertexFetch() - Renumber vertices in first-use order; drops unreferenced vertices
+  - analyzeVertexCache()  - FIFO cache simulation; ACMR and ATVR
+
+  - Attributes are optional; one is kept if its size matches the position count
+*/
+
+namespace blkhurst {
+
+struct VertexCacheStats {
+  std::size_t transformed = 0; // Cache misses
+  float acmr = 0.0F;           // Transformed per triangle (0.5 ideal on regular grids, 3 worst)
+  float atvr = 0.0F;           // Transformed per vertex (1 ideal)
+};
+
+struct MeshOptimizerOptions {
+  bool weld = true;
+  bool vertexCache = true;
+  bool overdraw = false;
+  float overdrawThreshold = 1.05F; // Max ACMR growth accepted for overdraw ordering
+  bool vertexFetch = true;
+  int cacheSize = 16;
+};
+
+struct MeshOptimizerResult {
+  std::size_t verticesBefore = 0;
+  std::size_t verticesAfter = 0;
+  VertexCacheStats before;
+  VertexCacheStats after;
+};
+
+struct MeshOptimizer {
+  static MeshOptimizerResult optimize(MeshData& meshData, const MeshOptimizerOptions& options = {});
+
+  static void weld(MeshData& meshData);
+  static void optimizeVertexCache(MeshData& meshData, int cacheSize = 16);
+  static void optimizeOverdraw(MeshData& meshData, int cacheSize = 16, float threshold = 1.05F);
+  static void optimizeVertexFetch(MeshData& meshData);
+
+  static VertexCacheStats analyzeVertexCache(std::span<const std::uint32_t> indices,
+                                             std::size_t vertexCount, int cacheSize = 16);
+};
+
+} // namespace blkhurst
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <blkhurst/geometry/mesh_data.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+MeshSimplifier (triangle lists)
+  - Quadric error metric edge collapse (Garland & Heckbert); vertices collapse onto a
+    neighbour, never move, so every level indexes the original vertex buffer
+  - Border and attribute-seam vertices (edges used by one triangle) are locked
+  - Error is relative to the mesh bounding extent (0.01 = 1% of extent)
+*/
+
+namespace blkhurst {
+
+struct SimplifyResult {
+  std::vector<std::uint32_t> indices;
+  float error = 0.0F; // Relative; multiply by extent() for object space
+};
+
+struct MeshSimplifier {
+  static SimplifyResult simplify(const MeshData& meshData, std::span<const std::uint32_t> indices,
+                                 std::size_t targetIndexCount, float targetError);
+
+  // Largest bounding-box side of the positions; scale of relative errors
+  static float extent(const MeshData& meshData);
+};
+
+} // namespace blkhurst
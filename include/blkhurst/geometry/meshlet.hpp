@@ -0,0 +1,56 @@
+#pragma once
+
+#include <blkhurst/geometry/mesh_data.hpp>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+Meshlets (triangle lists)
+  - Small clusters of adjacent triangles (<= 64 vertices / 124 triangles by default)
+  - Each has a bounding sphere and a normal cone for per-cluster frustum/backface culling
+  - Clusters are contiguous ranges of one reordered index buffer (global vertex indices),
+    so survivors draw with plain glMultiDrawElements
+*/
+
+namespace blkhurst {
+
+struct Meshlet {
+  std::uint32_t indexOffset = 0; // First index in the Geometry index buffer
+  std::uint32_t indexCount = 0;
+  std::uint32_t vertexCount = 0; // Unique vertices referenced
+
+  glm::vec3 center{0.0F}; // Bounding sphere (object space)
+  float radius = 0.0F;
+  glm::vec3 coneAxis{0.0F, 0.0F, 1.0F};
+  float coneCutoff = 1.0F; // Sine of the normal spread; 1 disables cone culling
+
+  // Every triangle faces away from a viewer at eye (same space as the bounds)
+  [[nodiscard]] bool backfacing(const glm::vec3& eye) const {
+    const glm::vec3 toCenter = center - eye;
+    return glm::dot(toCenter, coneAxis) >= (coneCutoff * glm::length(toCenter)) + radius;
+  }
+};
+
+struct MeshletLimits {
+  int maxVertices = 64;
+  int maxTriangles = 124;
+};
+
+struct MeshletBuildResult {
+  std::vector<Meshlet> meshlets;
+  std::vector<std::uint32_t> indices; // Input triangles, reordered cluster by cluster
+};
+
+struct MeshletBuilder {
+  // Greedy growth over shared vertices; offsets are relative to the returned indices
+  static MeshletBuildResult build(const MeshData& meshData, std::span<const std::uint32_t> indices,
+                                  const MeshletLimits& limits = {});
+
+  static void computeBounds(const MeshData& meshData, std::span<const std::uint32_t> indices,
+                            Meshlet& meshlet);
+};
+
+} // namespace blkhurst
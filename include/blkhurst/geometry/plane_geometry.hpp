@@ -1,9 +1,10 @@
 // NOLINTBEGIN(readability-identifier-length)
 #pragma once
+#include <algorithm>
 #include <blkhurst/geometry/geometry.hpp>
-#include <glm/geometric.hpp>
-#include <glm/glm.hpp>
-#include <glm/gtc/constants.hpp>
+#include <blkhurst/geometry/geometry_cache.hpp>
+#include <blkhurst/geometry/mesh_builder.hpp>
+#include <tuple>
 
 namespace blkhurst {
 
@@ -12,73 +13,120 @@ struct PlaneGeometryDesc {
   float height = 1.0F;
   int widthSegments = 1;
   int heightSegments = 1;
+
+  bool operator==(const PlaneGeometryDesc&) const = default;
+  [[nodiscard]] auto fields() const {
+    return std::tie(width, height, widthSegments, heightSegments);
+  }
 };
 
 struct PlaneGeometry {
+  // Shared with every other create() for an equal desc (GeometryCache)
   static std::shared_ptr<Geometry> create(const PlaneGeometryDesc& desc = {}) {
+    return GeometryCache::instance().getOrCreate(desc, createUnique);
+  }
 
+  // Private instance; use when the Geometry will be modified
+  static std::shared_ptr<Geometry> createUnique(const PlaneGeometryDesc& desc = {}) {
     return Geometry::from(buildPlane(desc));
   }
 
   // Planar Mesh Using Linear Interpolation
-  static MeshData buildPlane(const PlaneGeometryDesc& desc) {
-    using namespace glm;
+  static MeshData buildPlane(const PlaneGeometryDesc& inDesc, JobSystem* jobs = nullptr) {
+    const auto desc = sanitize(inDesc);
+    auto out = mesh_builder::allocate(counts(desc), /*tangents=*/true);
+    writePlane(desc, mesh_builder::spans(out), jobs);
+    return out;
+  }
+
+  // e.g. constexpr auto quad = PlaneGeometry::buildFixed<1, 1>(2.0F, 2.0F);
+  template <int WidthSegments, int HeightSegments>
+  static constexpr auto buildFixed(float width = 1.0F, float height = 1.0F) {
+    constexpr auto sizes =
+        counts(sanitize({.widthSegments = WidthSegments, .heightSegments = HeightSegments}));
+    FixedMeshData<sizes.vertices, sizes.indices, /*Tangents=*/true> out;
+    writePlane(sanitize({width, height, WidthSegments, HeightSegments}), out.spans());
+    return out;
+  }
+
+  static constexpr PlaneGeometryDesc sanitize(PlaneGeometryDesc desc) {
+    desc.widthSegments = std::max(1, desc.widthSegments);
+    desc.heightSegments = std::max(1, desc.heightSegments);
+    return desc;
+  }
+
+  static constexpr MeshCounts counts(const PlaneGeometryDesc& desc) {
+    const auto segmentsX = static_cast<std::size_t>(desc.widthSegments);
+    const auto segmentsY = static_cast<std::size_t>(desc.heightSegments);
+    return {(segmentsX + 1) * (segmentsY + 1), segmentsX * segmentsY * 6};
+  }
 
-    MeshData out;
+  // Writes counts(desc) vertices/indices (with tangents); rows run on jobs for large planes
+  static constexpr void writePlane(const PlaneGeometryDesc& desc, const MeshSpans& out,
+                                   JobSystem* jobs = nullptr) {
+    const int rows = desc.heightSegments + 1;
+    if (std::is_constant_evaluated() || jobs == nullptr) {
+      for (int row = 0; row < rows; ++row) {
+        writeRow(desc, out, row);
+      }
+      return;
+    }
+    mesh_builder::forEachRow(rows, counts(desc).vertices, jobs,
+                             [&](int row) { writeRow(desc, out, row); });
+  }
 
-    //
-    const int segmentsX = std::max(1, desc.widthSegments);
-    const int segmentsY = std::max(1, desc.heightSegments);
+private:
+  static constexpr void writeRow(const PlaneGeometryDesc& desc, const MeshSpans& out, int row) {
+    const int segmentsX = desc.widthSegments;
+    const int segmentsY = desc.heightSegments;
     const float widthHalf = desc.width * 0.5F;
     const float heightHalf = desc.height * 0.5F;
     const int stride = segmentsX + 1;
 
-    // Plane Corners
-    vec3 v0 = vec3(-widthHalf, -heightHalf, 0.0F); // 0    3   2
-    vec3 v1 = vec3(widthHalf, -heightHalf, 0.0F);  // 1    |
-    vec3 v3 = vec3(-widthHalf, heightHalf, 0.0F);  // 3    0---1
-
     // Row & Column Step Calculated By Number Of Segments
-    vec3 rowStep = (v3 - v0) / static_cast<float>(segmentsY); // 0 -> 3
-    vec3 colStep = (v1 - v0) / static_cast<float>(segmentsX); // 0 -> 1
-
-    // Generate A Grid Of Vertex Points
-    for (int row = 0; row <= segmentsY; ++row) {
-      for (int col = 0; col <= segmentsX; ++col) {
-        auto rowFloat = static_cast<float>(row);
-        auto colFloat = static_cast<float>(col);
-
-        // Position
-        vec3 currentVec = v0 + (colStep * colFloat) + (rowStep * rowFloat);
-        out.positions.insert(out.positions.end(), {currentVec[0], currentVec[1], currentVec[2]});
-
-        // Indices
-        if (row < segmentsY && col < segmentsX) {
-          int index_in_grid = row * stride + col;
-          out.indices.push_back(index_in_grid);              // 0    3---2   3---2
-          out.indices.push_back(index_in_grid + stride + 1); // 2    | '     |   |
-          out.indices.push_back(index_in_grid + stride);     // 3    0       0---1
-
-          out.indices.push_back(index_in_grid);              // 0        2   3---2
-          out.indices.push_back(index_in_grid + 1);          // 1      ' |   |   |
-          out.indices.push_back(index_in_grid + stride + 1); // 2    0---1   0---1
+    const float rowStep = desc.height / static_cast<float>(segmentsY); // 0 -> 3 (+Y)
+    const float colStep = desc.width / static_cast<float>(segmentsX);  // 0 -> 1 (+X)
+
+    // Normals (constant planar); tangent X ->, bitangent Y ^, normal = tangent x bitangent
+    const float tangentX = desc.width < 0.0F ? -1.0F : 1.0F;
+    const float bitangentY = desc.height < 0.0F ? -1.0F : 1.0F;
+    const float tangent[3] = {tangentX, 0.0F, 0.0F};
+    const float normal[3] = {0.0F, 0.0F, tangentX * bitangentY};
+
+    const auto rowFloat = static_cast<float>(row);
+    for (int col = 0; col <= segmentsX; ++col) {
+      const auto colFloat = static_cast<float>(col);
+      const auto vertex = static_cast<std::size_t>((row * stride) + col);
+
+      // Position, Texture UVs
+      const float position[3] = {-widthHalf + (colStep * colFloat),
+                                 -heightHalf + (rowStep * rowFloat), 0.0F};
+      const float uv[2] = {colFloat / static_cast<float>(segmentsX),
+                           rowFloat / static_cast<float>(segmentsY)};
+      mesh_builder::writeVertex(out, vertex, position, normal, uv);
+      if (!out.tangents.empty()) {
+        for (std::size_t axis = 0; axis < 3; ++axis) {
+          out.tangents[(vertex * 3) + axis] = tangent[axis];
         }
-
-        // Texture UVs
-        out.uvs.push_back(colFloat / static_cast<float>(segmentsX)); // U
-        out.uvs.push_back(rowFloat / static_cast<float>(segmentsY)); // V
-
-        // Normals (constant planar)
-        vec3 tangent = normalize(colStep);   // X ->
-        vec3 bitangent = normalize(rowStep); // Y ^
-        vec3 normal = normalize(cross(tangent, bitangent));
-
-        out.tangents.insert(out.tangents.end(), {tangent[0], tangent[1], tangent[2]});
-        out.normals.insert(out.normals.end(), {normal[0], normal[1], normal[2]});
       }
     }
 
-    return out;
+    // Indices
+    if (row >= segmentsY) {
+      return;
+    }
+    auto cursor = static_cast<std::size_t>(row) * static_cast<std::size_t>(segmentsX) * 6;
+    for (int col = 0; col < segmentsX; ++col) {
+      const auto index_in_grid = static_cast<std::uint32_t>((row * stride) + col);
+      const auto up = static_cast<std::uint32_t>(stride);
+      out.indices[cursor++] = index_in_grid;          // 0    3---2   3---2
+      out.indices[cursor++] = index_in_grid + up + 1; // 2    | '     |   |
+      out.indices[cursor++] = index_in_grid + up;     // 3    0       0---1
+
+      out.indices[cursor++] = index_in_grid;          // 0        2   3---2
+      out.indices[cursor++] = index_in_grid + 1;      // 1      ' |   |   |
+      out.indices[cursor++] = index_in_grid + up + 1; // 2    0---1   0---1
+    }
   }
 };
 
@@ -2,12 +2,13 @@
 #pragma once
 #include <algorithm>
 #include <blkhurst/geometry/geometry.hpp>
+#include <blkhurst/geometry/geometry_cache.hpp>
+#include <blkhurst/geometry/mesh_builder.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <memory>
-#include <vector>
-#define GLM_ENABLE_EXPERIMENTAL
-#include <glm/gtx/norm.hpp>
+#include <numbers>
+#include <tuple>
 
 namespace blkhurst {
 
@@ -20,87 +21,148 @@ struct SphereGeometryDesc {
   float phiLength = glm::two_pi<float>(); // horizontal sweep
   float thetaStart = 0.0F;                // vertical start angle
   float thetaLength = glm::pi<float>();   // vertical sweep
+
+  bool operator==(const SphereGeometryDesc&) const = default;
+  [[nodiscard]] auto fields() const {
+    return std::tie(radius, widthSegments, heightSegments, phiStart, phiLength, thetaStart,
+                    thetaLength);
+  }
 };
 // NOLINTEND(readability-magic-numbers)
 
 struct SphereGeometry {
+  // Shared with every other create() for an equal desc (GeometryCache)
   static std::shared_ptr<Geometry> create(const SphereGeometryDesc& desc = {}) {
+    return GeometryCache::instance().getOrCreate(desc, createUnique);
+  }
+
+  // Private instance; use when the Geometry will be modified
+  static std::shared_ptr<Geometry> createUnique(const SphereGeometryDesc& desc = {}) {
     return Geometry::from(buildSphere(desc));
   }
 
-  static MeshData buildSphere(SphereGeometryDesc desc) {
-    using glm::vec2;
-    using glm::vec3;
+  static MeshData buildSphere(const SphereGeometryDesc& inDesc, JobSystem* jobs = nullptr) {
+    const auto desc = sanitize(inDesc);
+    auto out = mesh_builder::allocate(counts(desc));
+    writeSphere(desc, mesh_builder::spans(out), jobs);
+    return out;
+  }
 
+  // Full sphere at compile time, e.g. constexpr auto s = SphereGeometry::buildFixed<16, 8>();
+  template <int WidthSegments, int HeightSegments>
+  static constexpr auto buildFixed(float radius = 1.0F) {
+    constexpr auto desc = sanitize({.widthSegments = WidthSegments,
+                                    .heightSegments = HeightSegments});
+    constexpr auto sizes = counts(desc);
+    FixedMeshData<sizes.vertices, sizes.indices> out;
+    auto sized = desc;
+    sized.radius = radius;
+    writeSphere(sized, out.spans());
+    return out;
+  }
+
+  static constexpr SphereGeometryDesc sanitize(SphereGeometryDesc desc) {
     desc.widthSegments = std::max(3, desc.widthSegments);
     desc.heightSegments = std::max(2, desc.heightSegments);
+    return desc;
+  }
 
-    const float thetaEnd = std::min(desc.thetaStart + desc.thetaLength, glm::pi<float>());
-
-    MeshData out;
-
-    int runningIndex = 0;
-    std::vector<std::vector<int>> grid;
-
-    // generate vertices, normals and uvs
-    for (int iy = 0; iy <= desc.heightSegments; ++iy) {
-      std::vector<int> verticesRow;
-      const float v = static_cast<float>(iy) / static_cast<float>(desc.heightSegments);
+  // Exact sizes for a sanitized desc; pole rows emit one triangle per quad
+  static constexpr MeshCounts counts(const SphereGeometryDesc& desc) {
+    const auto width = static_cast<std::size_t>(desc.widthSegments);
+    const auto height = static_cast<std::size_t>(desc.heightSegments);
+    std::size_t triangles = 2 * width * height;
+    triangles -= skipsFirstRow(desc) ? width : 0;
+    triangles -= skipsLastRow(desc) ? width : 0;
+    return {(width + 1) * (height + 1), triangles * 3};
+  }
 
-      // special case for the poles
-      float uOffset = 0.0F;
-      const float kUvPoleOffset = 0.5F;
-      if (iy == 0 && desc.thetaStart == 0.0F) {
-        uOffset = kUvPoleOffset / static_cast<float>(desc.widthSegments);
-      } else if (iy == desc.heightSegments && thetaEnd == glm::pi<float>()) {
-        uOffset = -kUvPoleOffset / static_cast<float>(desc.widthSegments);
+  // Writes counts(desc) vertices/indices; rows run on jobs for large spheres
+  static constexpr void writeSphere(const SphereGeometryDesc& desc, const MeshSpans& out,
+                                    JobSystem* jobs = nullptr) {
+    const int rows = desc.heightSegments + 1;
+    if (std::is_constant_evaluated() || jobs == nullptr) {
+      for (int iy = 0; iy < rows; ++iy) {
+        writeRow(desc, out, iy);
       }
+      return;
+    }
+    mesh_builder::forEachRow(rows, counts(desc).vertices, jobs,
+                             [&](int iy) { writeRow(desc, out, iy); });
+  }
 
-      for (int ix = 0; ix <= desc.widthSegments; ++ix) {
-        const float u = static_cast<float>(ix) / static_cast<float>(desc.widthSegments);
-
-        // vertex
-        const float phi = desc.phiStart + u * desc.phiLength;
-        const float theta = desc.thetaStart + v * desc.thetaLength;
-
-        glm::vec3 vertex{
-            -desc.radius * std::cos(phi) * std::sin(theta),
-            desc.radius * std::cos(theta),
-            desc.radius * std::sin(phi) * std::sin(theta),
-        };
-        out.positions.insert(out.positions.end(), {vertex[0], vertex[1], vertex[2]});
-
-        // normal
-        glm::vec3 normal = glm::normalize(vertex);
-        out.normals.insert(out.normals.end(), {normal[0], normal[1], normal[2]});
-
-        // uv
-        out.uvs.insert(out.uvs.end(), {u + uOffset, 1.0F - v});
+private:
+  static constexpr float thetaEnd(const SphereGeometryDesc& desc) {
+    return std::min(desc.thetaStart + desc.thetaLength, std::numbers::pi_v<float>);
+  }
+  static constexpr bool skipsFirstRow(const SphereGeometryDesc& desc) {
+    return desc.thetaStart <= 0.0F;
+  }
+  static constexpr bool skipsLastRow(const SphereGeometryDesc& desc) {
+    return thetaEnd(desc) >= std::numbers::pi_v<float>;
+  }
 
-        verticesRow.push_back(runningIndex++);
-      }
+  // Vertex row iy, plus the quads between it and row iy + 1
+  static constexpr void writeRow(const SphereGeometryDesc& desc, const MeshSpans& out, int iy) {
+    const int stride = desc.widthSegments + 1;
+    const float v = static_cast<float>(iy) / static_cast<float>(desc.heightSegments);
+
+    // special case for the poles
+    float uOffset = 0.0F;
+    const float kUvPoleOffset = 0.5F;
+    if (iy == 0 && desc.thetaStart == 0.0F) {
+      uOffset = kUvPoleOffset / static_cast<float>(desc.widthSegments);
+    } else if (iy == desc.heightSegments && thetaEnd(desc) == std::numbers::pi_v<float>) {
+      uOffset = -kUvPoleOffset / static_cast<float>(desc.widthSegments);
+    }
 
-      grid.push_back(std::move(verticesRow));
+    // vertices, normals and uvs
+    for (int ix = 0; ix <= desc.widthSegments; ++ix) {
+      const float u = static_cast<float>(ix) / static_cast<float>(desc.widthSegments);
+      const float phi = desc.phiStart + u * desc.phiLength;
+      const float theta = desc.thetaStart + v * desc.thetaLength;
+      const float sinTheta = mesh_builder::sin(theta);
+
+      const float vertex[3] = {
+          -desc.radius * mesh_builder::cos(phi) * sinTheta,
+          desc.radius * mesh_builder::cos(theta),
+          desc.radius * mesh_builder::sin(phi) * sinTheta,
+      };
+      float normal[3] = {vertex[0], vertex[1], vertex[2]};
+      mesh_builder::normalize(normal);
+      const float uv[2] = {u + uOffset, 1.0F - v};
+      mesh_builder::writeVertex(out, static_cast<std::size_t>((iy * stride) + ix), vertex, normal,
+                                uv);
     }
 
-    // indices
-    for (int iy = 0; iy < desc.heightSegments; ++iy) {
-      for (int ix = 0; ix < desc.widthSegments; ++ix) {
-        const unsigned a = grid[iy][ix + 1];
-        const unsigned b = grid[iy][ix];
-        const unsigned c = grid[iy + 1][ix];
-        const unsigned d = grid[iy + 1][ix + 1];
-
-        if (iy != 0 || desc.thetaStart > 0.0F) {
-          out.indices.insert(out.indices.end(), {a, b, d});
-        }
-        if (iy != desc.heightSegments - 1 || thetaEnd < glm::pi<float>()) {
-          out.indices.insert(out.indices.end(), {b, c, d});
-        }
+    // indices; rows before iy hold 6 per quad except a skipped first row
+    if (iy >= desc.heightSegments) {
+      return;
+    }
+    const bool writeUpper = iy != 0 || !skipsFirstRow(desc);
+    const bool writeLower = iy != desc.heightSegments - 1 || !skipsLastRow(desc);
+    const auto width = static_cast<std::size_t>(desc.widthSegments);
+    std::size_t cursor = 6 * width * static_cast<std::size_t>(iy);
+    if (iy > 0 && skipsFirstRow(desc)) {
+      cursor -= 3 * width;
+    }
+    for (int ix = 0; ix < desc.widthSegments; ++ix) {
+      const auto a = static_cast<std::uint32_t>((iy * stride) + ix + 1);
+      const auto b = static_cast<std::uint32_t>((iy * stride) + ix);
+      const auto c = static_cast<std::uint32_t>(((iy + 1) * stride) + ix);
+      const auto d = static_cast<std::uint32_t>(((iy + 1) * stride) + ix + 1);
+
+      if (writeUpper) {
+        out.indices[cursor++] = a;
+        out.indices[cursor++] = b;
+        out.indices[cursor++] = d;
+      }
+      if (writeLower) {
+        out.indices[cursor++] = b;
+        out.indices[cursor++] = c;
+        out.indices[cursor++] = d;
       }
     }
-
-    return out;
   }
 };
 
@@ -2,10 +2,13 @@
 #pragma once
 #include <algorithm>
 #include <blkhurst/geometry/geometry.hpp>
+#include <blkhurst/geometry/geometry_cache.hpp>
+#include <blkhurst/geometry/mesh_builder.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <memory>
-#include <vector>
+#include <numbers>
+#include <tuple>
 
 namespace blkhurst {
 
@@ -16,64 +19,99 @@ struct TorusGeometryDesc {
   int radialSegments = 12;          // segments around cross-section
   int tubularSegments = 48;         // segments around center ring
   float arc = glm::two_pi<float>(); // central angle
+
+  bool operator==(const TorusGeometryDesc&) const = default;
+  [[nodiscard]] auto fields() const {
+    return std::tie(radius, tube, radialSegments, tubularSegments, arc);
+  }
 };
 // NOLINTEND(readability-magic-numbers)
 
 struct TorusGeometry {
+  // Shared with every other create() for an equal desc (GeometryCache)
   static std::shared_ptr<Geometry> create(const TorusGeometryDesc& desc = {}) {
+    return GeometryCache::instance().getOrCreate(desc, createUnique);
+  }
+
+  // Private instance; use when the Geometry will be modified
+  static std::shared_ptr<Geometry> createUnique(const TorusGeometryDesc& desc = {}) {
     return Geometry::from(buildTorus(desc));
   }
 
-  static MeshData buildTorus(TorusGeometryDesc desc) {
-    using glm::vec3;
+  static MeshData buildTorus(const TorusGeometryDesc& inDesc, JobSystem* jobs = nullptr) {
+    const auto desc = sanitize(inDesc);
+    auto out = mesh_builder::allocate(counts(desc));
+    writeTorus(desc, mesh_builder::spans(out), jobs);
+    return out;
+  }
 
+  static constexpr TorusGeometryDesc sanitize(TorusGeometryDesc desc) {
     desc.radialSegments = std::max(3, desc.radialSegments);
     desc.tubularSegments = std::max(3, desc.tubularSegments);
+    return desc;
+  }
 
-    MeshData out;
+  static constexpr MeshCounts counts(const TorusGeometryDesc& desc) {
+    const auto radial = static_cast<std::size_t>(desc.radialSegments);
+    const auto tubular = static_cast<std::size_t>(desc.tubularSegments);
+    return {(radial + 1) * (tubular + 1), radial * tubular * 6};
+  }
 
-    // generate vertices, normals and uvs
-    for (int j = 0; j <= desc.radialSegments; ++j) {
-      for (int i = 0; i <= desc.tubularSegments; ++i) {
-        const float u =
-            (static_cast<float>(i) / static_cast<float>(desc.tubularSegments)) * desc.arc;
-        const float v = (static_cast<float>(j) / static_cast<float>(desc.radialSegments)) *
-                        glm::two_pi<float>();
-
-        // vertex
-        glm::vec3 vertex{
-            (desc.radius + desc.tube * std::cos(v)) * std::cos(u),
-            (desc.radius + desc.tube * std::cos(v)) * std::sin(u),
-            desc.tube * std::sin(v),
-        };
-        out.positions.insert(out.positions.end(), {vertex[0], vertex[1], vertex[2]});
-
-        // normal
-        glm::vec3 center{desc.radius * std::cos(u), desc.radius * std::sin(u), 0.0F};
-        glm::vec3 normal = glm::normalize(vertex - center);
-        out.normals.insert(out.normals.end(), {normal[0], normal[1], normal[2]});
-
-        // uv
-        out.uvs.insert(out.uvs.end(),
-                       {static_cast<float>(i) / static_cast<float>(desc.tubularSegments),
-                        static_cast<float>(j) / static_cast<float>(desc.radialSegments)});
+  // Writes counts(desc) vertices/indices; rings run on jobs for large tori
+  static constexpr void writeTorus(const TorusGeometryDesc& desc, const MeshSpans& out,
+                                   JobSystem* jobs = nullptr) {
+    const int rows = desc.radialSegments + 1;
+    if (std::is_constant_evaluated() || jobs == nullptr) {
+      for (int j = 0; j < rows; ++j) {
+        writeRow(desc, out, j);
       }
+      return;
+    }
+    mesh_builder::forEachRow(rows, counts(desc).vertices, jobs,
+                             [&](int j) { writeRow(desc, out, j); });
+  }
+
+private:
+  // Vertex ring j, plus the quads joining it to ring j - 1
+  static constexpr void writeRow(const TorusGeometryDesc& desc, const MeshSpans& out, int j) {
+    const int stride = desc.tubularSegments + 1;
+
+    // generate vertices, normals and uvs
+    for (int i = 0; i <= desc.tubularSegments; ++i) {
+      const float u = (static_cast<float>(i) / static_cast<float>(desc.tubularSegments)) * desc.arc;
+      const float v = (static_cast<float>(j) / static_cast<float>(desc.radialSegments)) *
+                      (2.0F * std::numbers::pi_v<float>);
+      const float cosU = mesh_builder::cos(u);
+      const float sinU = mesh_builder::sin(u);
+      const float ring = desc.radius + (desc.tube * mesh_builder::cos(v));
+
+      // vertex; normal points from the tube centre
+      const float vertex[3] = {ring * cosU, ring * sinU, desc.tube * mesh_builder::sin(v)};
+      float normal[3] = {vertex[0] - (desc.radius * cosU), vertex[1] - (desc.radius * sinU),
+                         vertex[2]};
+      mesh_builder::normalize(normal);
+      const float uv[2] = {static_cast<float>(i) / static_cast<float>(desc.tubularSegments),
+                           static_cast<float>(j) / static_cast<float>(desc.radialSegments)};
+      mesh_builder::writeVertex(out, static_cast<std::size_t>((j * stride) + i), vertex, normal,
+                                uv);
     }
 
     // indices
-    for (int j = 1; j <= desc.radialSegments; ++j) {
-      for (int i = 1; i <= desc.tubularSegments; ++i) {
-        const unsigned a = (desc.tubularSegments + 1) * j + i - 1;
-        const unsigned b = (desc.tubularSegments + 1) * (j - 1) + i - 1;
-        const unsigned c = (desc.tubularSegments + 1) * (j - 1) + i;
-        const unsigned d = (desc.tubularSegments + 1) * j + i;
-
-        out.indices.insert(out.indices.end(), {a, b, d});
-        out.indices.insert(out.indices.end(), {b, c, d});
-      }
+    if (j == 0) {
+      return;
     }
+    const auto tubular = static_cast<std::size_t>(desc.tubularSegments);
+    auto cursor = static_cast<std::size_t>(j - 1) * tubular * 6;
+    for (int i = 1; i <= desc.tubularSegments; ++i) {
+      const auto a = static_cast<std::uint32_t>((stride * j) + i - 1);
+      const auto b = static_cast<std::uint32_t>((stride * (j - 1)) + i - 1);
+      const auto c = static_cast<std::uint32_t>((stride * (j - 1)) + i);
+      const auto d = static_cast<std::uint32_t>((stride * j) + i);
 
-    return out;
+      for (auto index : {a, b, d, b, c, d}) {
+        out.indices[cursor++] = index;
+      }
+    }
   }
 };
 
@@ -2,10 +2,13 @@
 #pragma once
 #include <algorithm>
 #include <blkhurst/geometry/geometry.hpp>
+#include <blkhurst/geometry/geometry_cache.hpp>
+#include <blkhurst/geometry/mesh_builder.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/constants.hpp>
 #include <memory>
-#include <vector>
+#include <numbers>
+#include <tuple>
 
 namespace blkhurst {
 
@@ -16,104 +19,143 @@ struct TorusKnotGeometryDesc {
   int radialSegments = 8;
   int p = 2;
   int q = 3;
+
+  bool operator==(const TorusKnotGeometryDesc&) const = default;
+  [[nodiscard]] auto fields() const {
+    return std::tie(radius, tube, tubularSegments, radialSegments, p, q);
+  }
 };
 
 struct TorusKnotGeometry {
+  // Shared with every other create() for an equal desc (GeometryCache)
   static std::shared_ptr<Geometry> create(const TorusKnotGeometryDesc& desc = {}) {
+    return GeometryCache::instance().getOrCreate(desc, createUnique);
+  }
+
+  // Private instance; use when the Geometry will be modified
+  static std::shared_ptr<Geometry> createUnique(const TorusKnotGeometryDesc& desc = {}) {
     return Geometry::from(buildTorusKnot(desc));
   }
 
-  static MeshData buildTorusKnot(TorusKnotGeometryDesc desc) {
-    using glm::vec2;
-    using glm::vec3;
+  static MeshData buildTorusKnot(const TorusKnotGeometryDesc& inDesc, JobSystem* jobs = nullptr) {
+    const auto desc = sanitize(inDesc);
+    auto out = mesh_builder::allocate(counts(desc));
+    writeTorusKnot(desc, mesh_builder::spans(out), jobs);
+    return out;
+  }
 
+  static constexpr TorusKnotGeometryDesc sanitize(TorusKnotGeometryDesc desc) {
     desc.tubularSegments = std::max(3, desc.tubularSegments);
     desc.radialSegments = std::max(3, desc.radialSegments);
+    return desc;
+  }
+
+  static constexpr MeshCounts counts(const TorusKnotGeometryDesc& desc) {
+    const auto tubular = static_cast<std::size_t>(desc.tubularSegments);
+    const auto radial = static_cast<std::size_t>(desc.radialSegments);
+    return {(tubular + 1) * (radial + 1), tubular * radial * 6};
+  }
 
-    MeshData out;
-
-    vec3 P1;
-    vec3 P2;
-    vec3 B;
-    vec3 T;
-    vec3 N;
-    vec3 vertex;
-    vec3 normal;
-
-    // generate vertices, normals, uvs
-    for (int i = 0; i <= desc.tubularSegments; ++i) {
-      // Radian "u" is used to calculate position on the torus curve of the current tubular segment
-      const float u = static_cast<float>(i) / static_cast<float>(desc.tubularSegments) *
-                      static_cast<float>(desc.p) * glm::two_pi<float>();
-
-      // now we calculate two points. P1 is our current position on the curve, P2 is a little
-      // farther ahead. these points are used to create a special "coordinate space", which is
-      // necessary to calculate the correct vertex positions
-      calculatePositionOnCurve(u, desc.p, desc.q, desc.radius, P1);
-      calculatePositionOnCurve(u + 0.01F, desc.p, desc.q, desc.radius, P2);
-
-      // calculate orthonormal basis
-      T = P2 - P1;
-      N = P2 + P1;
-      B = glm::cross(T, N);
-      N = glm::cross(B, T);
-
-      // normalize B, N. T can be ignored, we don't use it
-      B = glm::normalize(B);
-      N = glm::normalize(N);
-
-      for (int j = 0; j <= desc.radialSegments; ++j) {
-        // now calculate the vertices. they are nothing more than an extrusion of the torus curve.
-        // because we extrude a shape in the xy-plane, there is no need to calculate a z-value.
-        const float v =
-            static_cast<float>(j) / static_cast<float>(desc.radialSegments) * glm::two_pi<float>();
-        const float cx = -desc.tube * std::cos(v);
-        const float cy = desc.tube * std::sin(v);
-
-        // Position - First we orient the extrusion with our basis vectors, then we add it to the
-        // current position on the curve
-        vertex = P1 + (cx * N + cy * B);
-        out.positions.insert(out.positions.end(), {vertex[0], vertex[1], vertex[2]});
-
-        // Normal - (P1 is always the center/origin of the extrusion, thus we can use it to
-        // calculate the normal)
-        normal = glm::normalize(vertex - P1);
-        out.normals.insert(out.normals.end(), {normal[0], normal[1], normal[2]});
-
-        // uv
-        out.uvs.insert(out.uvs.end(),
-                       {static_cast<float>(i) / static_cast<float>(desc.tubularSegments),
-                        static_cast<float>(j) / static_cast<float>(desc.radialSegments)});
+  // Writes counts(desc) vertices/indices; tubular rings run on jobs for large knots
+  static constexpr void writeTorusKnot(const TorusKnotGeometryDesc& desc, const MeshSpans& out,
+                                       JobSystem* jobs = nullptr) {
+    const int rows = desc.tubularSegments + 1;
+    if (std::is_constant_evaluated() || jobs == nullptr) {
+      for (int i = 0; i < rows; ++i) {
+        writeRow(desc, out, i);
       }
+      return;
+    }
+    mesh_builder::forEachRow(rows, counts(desc).vertices, jobs,
+                             [&](int i) { writeRow(desc, out, i); });
+  }
+
+private:
+  struct Point {
+    float x = 0.0F;
+    float y = 0.0F;
+    float z = 0.0F;
+  };
+
+  // Ring i of the tube, plus the quads joining it to ring i - 1
+  static constexpr void writeRow(const TorusKnotGeometryDesc& desc, const MeshSpans& out, int i) {
+    constexpr float kTwoPi = 2.0F * std::numbers::pi_v<float>;
+    const int stride = desc.radialSegments + 1;
+
+    // Radian "u" is used to calculate position on the torus curve of the current tubular segment
+    const float u = static_cast<float>(i) / static_cast<float>(desc.tubularSegments) *
+                    static_cast<float>(desc.p) * kTwoPi;
+
+    // now we calculate two points. P1 is our current position on the curve, P2 is a little
+    // farther ahead. these points are used to create a special "coordinate space", which is
+    // necessary to calculate the correct vertex positions
+    const Point P1 = calculatePositionOnCurve(u, desc.p, desc.q, desc.radius);
+    const Point P2 = calculatePositionOnCurve(u + 0.01F, desc.p, desc.q, desc.radius);
+
+    // calculate orthonormal basis; T is not needed after N and B
+    const float T[3] = {P2.x - P1.x, P2.y - P1.y, P2.z - P1.z};
+    float N[3] = {P2.x + P1.x, P2.y + P1.y, P2.z + P1.z};
+    float B[3] = {};
+    cross(T, N, B);
+    cross(B, T, N);
+    mesh_builder::normalize(B);
+    mesh_builder::normalize(N);
+
+    for (int j = 0; j <= desc.radialSegments; ++j) {
+      // now calculate the vertices. they are nothing more than an extrusion of the torus curve.
+      // because we extrude a shape in the xy-plane, there is no need to calculate a z-value.
+      const float v = static_cast<float>(j) / static_cast<float>(desc.radialSegments) * kTwoPi;
+      const float cx = -desc.tube * mesh_builder::cos(v);
+      const float cy = desc.tube * mesh_builder::sin(v);
+
+      // Position - First we orient the extrusion with our basis vectors, then we add it to the
+      // current position on the curve. Normal - P1 is always the center of the extrusion
+      float normal[3] = {(cx * N[0]) + (cy * B[0]), (cx * N[1]) + (cy * B[1]),
+                         (cx * N[2]) + (cy * B[2])};
+      const float vertex[3] = {P1.x + normal[0], P1.y + normal[1], P1.z + normal[2]};
+      mesh_builder::normalize(normal);
+      const float uv[2] = {static_cast<float>(i) / static_cast<float>(desc.tubularSegments),
+                           static_cast<float>(j) / static_cast<float>(desc.radialSegments)};
+      mesh_builder::writeVertex(out, static_cast<std::size_t>((i * stride) + j), vertex, normal,
+                                uv);
     }
 
     // indices
-    for (int j = 1; j <= desc.tubularSegments; ++j) {
-      for (int i = 1; i <= desc.radialSegments; ++i) {
-        const unsigned a = (desc.radialSegments + 1) * (j - 1) + (i - 1);
-        const unsigned b = (desc.radialSegments + 1) * j + (i - 1);
-        const unsigned c = (desc.radialSegments + 1) * j + i;
-        const unsigned d = (desc.radialSegments + 1) * (j - 1) + i;
-
-        out.indices.insert(out.indices.end(), {a, b, d});
-        out.indices.insert(out.indices.end(), {b, c, d});
+    if (i == 0) {
+      return;
+    }
+    const auto radial = static_cast<std::size_t>(desc.radialSegments);
+    auto cursor = static_cast<std::size_t>(i - 1) * radial * 6;
+    for (int j = 1; j <= desc.radialSegments; ++j) {
+      const auto a = static_cast<std::uint32_t>((stride * (i - 1)) + (j - 1));
+      const auto b = static_cast<std::uint32_t>((stride * i) + (j - 1));
+      const auto c = static_cast<std::uint32_t>((stride * i) + j);
+      const auto d = static_cast<std::uint32_t>((stride * (i - 1)) + j);
+
+      for (auto index : {a, b, d, b, c, d}) {
+        out.indices[cursor++] = index;
       }
     }
+  }
 
-    return out;
+  static constexpr void cross(const float (&lhs)[3], const float (&rhs)[3], float (&out)[3]) {
+    const float x = (lhs[1] * rhs[2]) - (lhs[2] * rhs[1]);
+    const float y = (lhs[2] * rhs[0]) - (lhs[0] * rhs[2]);
+    const float z = (lhs[0] * rhs[1]) - (lhs[1] * rhs[0]);
+    out[0] = x;
+    out[1] = y;
+    out[2] = z;
   }
 
-private:
   // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-  static void calculatePositionOnCurve(float u, int p, int q, float radius, glm::vec3& position) {
-    const float cu = std::cos(u);
-    const float su = std::sin(u);
+  static constexpr Point calculatePositionOnCurve(float u, int p, int q, float radius) {
+    const float cu = mesh_builder::cos(u);
+    const float su = mesh_builder::sin(u);
     const float quOverP = static_cast<float>(q) / static_cast<float>(p) * u;
-    const float cs = std::cos(quOverP);
+    const float cs = mesh_builder::cos(quOverP);
 
-    position[0] = radius * (2.0F + cs) * 0.5F * cu;
-    position[1] = radius * (2.0F + cs) * 0.5F * su;
-    position[2] = radius * std::sin(quOverP) * 0.5F;
+    return {radius * (2.0F + cs) * 0.5F * cu, radius * (2.0F + cs) * 0.5F * su,
+            radius * mesh_builder::sin(quOverP) * 0.5F};
   }
 };
 
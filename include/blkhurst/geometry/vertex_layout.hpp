@@ -0,0 +1,75 @@
+#pragma once
+
+#include <blkhurst/geometry/mesh_data.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace blkhurst {
+
+// Tangent Unused, TBN calculated via dFdx/dfdy
+enum class Attrib : std::uint8_t {
+  Position = 0,
+  Color = 1,
+  Uv = 2,
+  Normal = 3,
+  InstanceColor = 4,
+  InstanceMatrix = 5,
+};
+
+// Storage format of one vertex element; the shader always sees floats
+enum class VertexFormat : std::uint8_t {
+  Float1,
+  Float2,
+  Float3,
+  Float4,
+  Half2,        // 16-bit float
+  Half4,        // 16-bit float (w = 1 for positions)
+  Unorm8x4,     // Colors; [0, 1]
+  Snorm1010102, // Normals; xyz in [-1, 1], 4 bytes
+};
+
+struct VertexElement {
+  Attrib attrib = Attrib::Position;
+  VertexFormat format = VertexFormat::Float3;
+  std::uint32_t offset = 0; // Bytes from vertex start
+};
+
+// Interleaved vertex layout; one buffer, one stride
+struct VertexLayout {
+  std::vector<VertexElement> elements;
+  std::uint32_t stride = 0;
+
+  VertexLayout& add(Attrib attrib, VertexFormat format);
+  [[nodiscard]] const VertexElement* find(Attrib attrib) const;
+
+  // Float3 position, Float2 uv, Snorm1010102 normal (24 B; lossless positions/uvs)
+  static VertexLayout standard();
+  // Half4 position, Half2 uv, Snorm1010102 normal (16 B; half the bytes of separate floats).
+  // Half positions suit unit-scale meshes; large or finely detailed meshes should use standard()
+  static VertexLayout compact();
+
+  static std::uint32_t formatSize(VertexFormat format);
+  static int componentCount(VertexFormat format);
+};
+
+namespace vertex_encode {
+[[nodiscard]] std::uint16_t toHalf(float value);
+[[nodiscard]] std::uint32_t toSnorm1010102(float x, float y, float z);
+[[nodiscard]] std::uint32_t toUnorm8x4(float r, float g, float b, float a);
+
+// Interleave MeshData into layout; elements without source data are zero (Color: white)
+[[nodiscard]] std::vector<std::byte> interleave(const MeshData& meshData,
+                                                const VertexLayout& layout);
+[[nodiscard]] float fromHalf(std::uint16_t half);
+
+// Inverse of interleave for Position/Uv/Normal; lossy formats decode to their stored precision
+[[nodiscard]] MeshData deinterleave(std::span<const std::byte> vertices,
+                                    const VertexLayout& layout);
+// Narrow indices if every value fits; false (out untouched) otherwise
+bool narrowIndices(std::span<const std::uint32_t> indices, std::vector<std::uint16_t>& out);
+} // namespace vertex_encode
+
+} // namespace blkhurst
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <blkhurst/geometry/mesh_data.hpp>
+#include <blkhurst/graphics/buffer.hpp>
+#include <blkhurst/graphics/vertex_array.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <span>
+
+/**
+VertexPool (programmable vertex pulling)
+  - One vertex SSBO and one index buffer shared by every pooled Geometry
+  - Vertices are 8 floats (position xyz, normal xyz, uv); io_vertex fetches them by gl_VertexID
+    when uVertexPulling is set. Base vertex draws make gl_VertexID absolute
+  - A single VAO with no attributes (only the index buffer) serves every pooled draw
+  - First-fit free lists; buffers double when full (existing ranges keep their offsets)
+  - Shared while any pooled Geometry lives, so GL objects are freed before the context
+*/
+
+namespace blkhurst {
+
+struct VertexPoolRange {
+  std::uint32_t first = 0;
+  std::uint32_t count = 0;
+};
+
+struct VertexPoolAllocation {
+  VertexPoolRange vertices;
+  VertexPoolRange indices; // Values relative to vertices.first
+};
+
+class VertexPool {
+public:
+  static constexpr int kFloatsPerVertex = 8;
+  static constexpr std::uint32_t kInitialVertices = 1U << 16U;
+  static constexpr std::uint32_t kInitialIndices = 1U << 18U;
+
+  VertexPool();
+  ~VertexPool();
+
+  VertexPool(const VertexPool&) = delete;
+  VertexPool(VertexPool&&) = delete;
+  VertexPool& operator=(const VertexPool&) = delete;
+  VertexPool& operator=(VertexPool&&) = delete;
+
+  // The pool new pooled Geometry uploads into; created on first use
+  static std::shared_ptr<VertexPool> shared();
+
+  // Missing normals/uvs upload as zeros
+  [[nodiscard]] VertexPoolAllocation allocate(const MeshData& meshData,
+                                              std::span<const std::uint32_t> indices);
+  void release(const VertexPoolAllocation& allocation);
+  // GPU readback of an allocation (positions, normals, uvs, indices)
+  [[nodiscard]] MeshData read(const VertexPoolAllocation& allocation) const;
+
+  // VAO (index buffer only) and the vertex SSBO at UniformBinding::Vertices
+  void bind() const;
+  [[nodiscard]] const VertexArray& vertexArray() const;
+
+  [[nodiscard]] std::uint32_t vertexCapacity() const;
+  [[nodiscard]] std::uint32_t indexCapacity() const;
+  [[nodiscard]] std::uint32_t usedVertices() const;
+  [[nodiscard]] std::uint32_t usedIndices() const;
+
+private:
+  // Free spans keyed by first element; neighbours merge on release
+  class FreeList {
+  public:
+    explicit FreeList(std::uint32_t capacity);
+    [[nodiscard]] std::optional<std::uint32_t> allocate(std::uint32_t count);
+    void release(std::uint32_t first, std::uint32_t count);
+    void grow(std::uint32_t newCapacity);
+    [[nodiscard]] std::uint32_t capacity() const {
+      return capacity_;
+    }
+    [[nodiscard]] std::uint32_t used() const {
+      return used_;
+    }
+
+  private:
+    std::map<std::uint32_t, std::uint32_t> free_;
+    std::uint32_t capacity_ = 0;
+    std::uint32_t used_ = 0;
+  };
+
+  static std::uint32_t reserve_(FreeList& list, std::unique_ptr<Buffer>& buffer,
+                                std::uint32_t count, std::size_t elementBytes);
+
+  VertexArray vao_;
+  std::unique_ptr<Buffer> vertices_;
+  std::unique_ptr<Buffer> indices_;
+  FreeList freeVertices_{kInitialVertices};
+  FreeList freeIndices_{kInitialIndices};
+};
+
+} // namespace blkhurst
@@ -5,6 +5,9 @@
 
 namespace blkhurst {
 
+// Static: written once. Dynamic: rewritten in place. Stream: persistent-mapped ring (StreamBuffer)
+enum class BufferUsage : std::uint8_t { Static, Dynamic, Stream };
+
 class Buffer {
 public:
   Buffer(const void* data, intptr_t sizeBytes, bool dynamic = false);
@@ -17,6 +20,13 @@ public:
 
   void setData(const void* data, intptr_t sizeBytes, bool dynamic = false);
   void setSubData(intptr_t offsetBytes, const void* data, intptr_t sizeBytes);
+  // Detach the old storage (same size/usage) so a full rewrite never waits on pending draws
+  void orphan();
+  // Write-only map of a range; contents outside the written bytes are preserved
+  [[nodiscard]] void* mapRange(intptr_t offsetBytes, intptr_t sizeBytes);
+  void unmap();
+  // Synchronous readback; waits for pending GPU writes
+  void getSubData(intptr_t offsetBytes, void* data, intptr_t sizeBytes) const;
 
   // Convenience using std::span
   template <class T>
@@ -40,6 +50,7 @@ public:
 private:
   unsigned int id_ = 0;
   intptr_t size_ = 0;
+  bool dynamic_ = false;
 };
 
 } // namespace blkhurst
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <blkhurst/util/handle.hpp>
+#include <blkhurst/util/transparent_string_hash.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include <functional>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -22,7 +25,7 @@ struct ProgramDesc {
 
 enum class SourceKind { Source, Registry, File };
 
-class Program {
+class Program : public Handled<Program> {
 public:
   Program(ProgramDesc desc);
   virtual ~Program();
@@ -42,6 +45,9 @@ public:
   void addDefine(const std::string& define);
   void removeDefine(const std::string& define);
   void setDefines(std::vector<std::string> defines);
+  // Same sources with extra defines (space separated), built on first use and cached; kept in
+  // step with this Program's own defines. Used by Renderer passes that need another output
+  [[nodiscard]] Program& variant(std::string_view defines);
 
   void setUniform(std::string_view name, int value);
   void setUniform(std::string_view name, float value);
@@ -76,12 +82,20 @@ protected:
 
 private:
   mutable unsigned id_ = 0;
-  mutable std::unordered_map<std::string, int> uniformCache_;
+  mutable std::unordered_map<std::string, int, TransparentStringHash, std::equal_to<>>
+      uniformCache_;
 
   ProgramDesc desc_;
   SourceKind sourceKind_ = SourceKind::Source;
 
   mutable bool needsUpdate_ = true;
+  struct Variant {
+    std::vector<std::string> defines; // Extra, on top of desc_.defines
+    std::unique_ptr<Program> program;
+  };
+  std::unordered_map<std::string, Variant, TransparentStringHash, std::equal_to<>> variants_;
+
+  void refreshVariants_();
   void ensureBuilt_() const;
   void buildFromStrings_(std::string_view vert, std::string_view frag, std::string_view tesc,
                          std::string_view tese) const;
@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/**
+StreamBuffer (per-frame CPU writes)
+  - glBufferStorage, persistent + coherent write mapping; no map/unmap per update
+  - regionCount regions (triple-buffered by default); the first write after a draw moves to the
+    next region, later writes before the next draw patch it in place. Draws are signalled by
+    StreamBuffer::markDrawn() (every Renderer draw call), so a draw never sees a later write
+  - A CPU copy of the current region supplies the bytes a partial write carries over
+  - The region left behind is fenced (glFenceSync); reusing it waits on that fence, so the CPU
+    never overwrites data a previous frame's draws still read
+  - Bind with offset() after each write
+*/
+
+namespace blkhurst {
+
+class StreamBuffer {
+public:
+  static constexpr int kDefaultRegions = 3;
+
+  // data (may be null) fills the first region
+  StreamBuffer(const void* data, intptr_t regionBytes, int regionCount = kDefaultRegions);
+  ~StreamBuffer();
+
+  StreamBuffer(const StreamBuffer&) = delete;
+  StreamBuffer(StreamBuffer&&) = delete;
+  StreamBuffer& operator=(const StreamBuffer&) = delete;
+  StreamBuffer& operator=(StreamBuffer&&) = delete;
+
+  // First write after a draw moves to the next region; bytes outside [offset, offset + size) are
+  // carried over from the CPU copy (whole-region writes skip it)
+  void write(intptr_t offsetBytes, const void* data, intptr_t sizeBytes);
+
+  // A draw was submitted and may read any current region; GL thread
+  static void markDrawn();
+
+  [[nodiscard]] unsigned int id() const {
+    return id_;
+  }
+  [[nodiscard]] intptr_t size() const { // One region
+    return regionSize_;
+  }
+  [[nodiscard]] intptr_t offset() const { // Byte offset of the current region
+    return regionStride_ * current_;
+  }
+  [[nodiscard]] std::size_t stalls() const { // Writes that had to wait on the GPU
+    return stalls_;
+  }
+
+private:
+  void rotate_();
+  void waitRegion_(int region);
+  std::byte* region_(int region) const;
+
+  unsigned int id_ = 0;
+  std::byte* mapped_ = nullptr;
+  intptr_t regionSize_ = 0;
+  intptr_t regionStride_ = 0; // regionSize_ rounded up for binding alignment
+  int regionCount_ = 0;
+  int current_ = 0;
+  std::uint64_t writtenEpoch_ = UINT64_MAX; // Draw epoch of the last rotation; first write rotates
+  std::vector<void*> fences_;     // GLsync per region; null when unfenced
+  std::vector<std::byte> shadow_; // Current region's bytes
+  std::size_t stalls_ = 0;
+};
+
+} // namespace blkhurst
@@ -21,6 +21,9 @@ public:
                         int stride) const;
   void linkAttribFloat(unsigned int attribIndex, unsigned int bindingIndex, int componentCount,
                        bool normalised = false, unsigned int relativeOffset = 0) const;
+  // Any GL component type (e.g. GL_HALF_FLOAT, GL_INT_2_10_10_10_REV); read as float in shaders
+  void linkAttribFormat(unsigned int attribIndex, unsigned int bindingIndex, int componentCount,
+                        unsigned int glType, bool normalised, unsigned int relativeOffset) const;
   void setElementBuffer(unsigned int bufferId);
 
   // Convenience; single attribute per binding, packed floats
@@ -0,0 +1,137 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+JobSystem
+  - submit(task)              - Run on any worker (work-stealing)
+  - submit(group, task)       - As above, counted by a TaskGroup
+  - submitMainThread(task)    - Run on the main (GL) thread during runMainThreadTasks()
+  - parallelFor(count, fn)    - Split a range into tasks; blocks until done
+  - wait(group)               - Block until group completes; the caller executes tasks meanwhile
+
+  - One deque per worker; owner pops newest (LIFO), thieves steal oldest (FIFO)
+  - Submissions from non-worker threads go to a shared injection deque
+  - Owned by Engine, sized via ThreadingConfig, reachable from scenes through RootState::jobs
+*/
+
+namespace blkhurst {
+
+class JobSystem;
+
+enum class TaskAffinity { Any, MainThread };
+
+// Counts outstanding tasks; optional continuation fires once the count reaches zero.
+// State is shared with queued tasks, so a group may be destroyed before they finish.
+class TaskGroup {
+public:
+  TaskGroup();
+  ~TaskGroup() = default;
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+  TaskGroup(TaskGroup&&) = delete;
+  TaskGroup& operator=(TaskGroup&&) = delete;
+
+  // Call after submitting; fires immediately if the group has already completed
+  void then(std::function<void()> continuation, TaskAffinity affinity = TaskAffinity::Any);
+
+  [[nodiscard]] bool done() const;
+
+private:
+  friend class JobSystem;
+
+  struct State {
+    std::atomic<int> pending{0};
+    std::atomic<JobSystem*> system{nullptr};
+
+    std::mutex continuationMutex;
+    std::function<void()> continuation;
+    TaskAffinity continuationAffinity = TaskAffinity::Any;
+  };
+
+  std::shared_ptr<State> state_;
+
+  static void onTaskFinished_(State& state);
+  static void dispatch_(JobSystem* system, std::function<void()> continuation,
+                        TaskAffinity affinity);
+};
+
+class JobSystem {
+public:
+  using Task = std::function<void()>;
+
+  // Workers in addition to the main thread; 0 runs every task on the main thread, in wait() or
+  // runMainThreadTasks(). Tasks still queued at destruction run in the destructor
+  explicit JobSystem(int workerThreads);
+  ~JobSystem();
+
+  JobSystem(const JobSystem&) = delete;
+  JobSystem& operator=(const JobSystem&) = delete;
+  JobSystem(JobSystem&&) = delete;
+  JobSystem& operator=(JobSystem&&) = delete;
+
+  void submit(Task task);
+  void submit(TaskGroup& group, Task task);
+  void submitMainThread(Task task);
+  void submitMainThread(TaskGroup& group, Task task);
+
+  void wait(TaskGroup& group);
+
+  // fn(begin, end) over chunks of at most `grain` indices
+  void parallelFor(std::size_t count, std::size_t grain,
+                   const std::function<void(std::size_t, std::size_t)>& func);
+  // fn(index), one chunk per worker-ish
+  void parallelFor(std::size_t count, const std::function<void(std::size_t)>& func);
+
+  // Called by Engine once per frame; also while the main thread waits. With no workers it also
+  // runs the submit()ed tasks queued before the call
+  void runMainThreadTasks();
+
+  [[nodiscard]] int workerCount() const;
+  [[nodiscard]] bool isMainThread() const;
+
+private:
+  struct Job {
+    Task task;
+    std::shared_ptr<TaskGroup::State> group;
+  };
+
+  struct WorkQueue {
+    std::mutex mutex;
+    std::deque<Job> jobs;
+  };
+
+  std::thread::id mainThreadId_;
+  std::vector<std::thread> workers_;
+  // [0, workers) owned by workers; last is the shared injection queue
+  std::vector<std::unique_ptr<WorkQueue>> queues_;
+
+  std::mutex mainQueueMutex_;
+  std::vector<Job> mainQueue_;
+
+  std::atomic<int> queuedJobs_{0};
+  std::mutex sleepMutex_;
+  std::condition_variable wakeCv_;
+  bool stopping_ = false;
+
+  void push_(Job job);
+  static std::shared_ptr<TaskGroup::State> join_(TaskGroup& group, JobSystem* system);
+  bool tryRunOne_(std::size_t selfIndex);
+  bool popOwn_(std::size_t selfIndex, Job& out);
+  bool steal_(std::size_t selfIndex, Job& out);
+  static void run_(Job& job);
+  void workerLoop_(std::size_t index);
+  [[nodiscard]] std::size_t injectionIndex_() const;
+  [[nodiscard]] std::size_t currentIndex_() const;
+};
+
+} // namespace blkhurst
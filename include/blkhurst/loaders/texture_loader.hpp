@@ -1,12 +1,14 @@
 #pragma once
 
 #include <blkhurst/textures/texture.hpp>
+#include <functional>
 #include <memory>
 #include <string>
 
 namespace blkhurst {
 
 class Texture;
+class JobSystem;
 
 struct TextureLoaderDesc {
   bool srgb = false; // Linear / SRGB (ignored for HDR)
@@ -35,10 +37,20 @@ struct TextureLoader {
 public:
   static std::shared_ptr<Texture> load(const std::string& path, const TextureLoaderDesc& desc = {});
 
-  // If desiredChannels is 0, file channels are used.
+  // Decodes on a worker; creates the Texture and calls onLoaded on the main thread.
+  // On failure onLoaded receives the fallback texture.
+  static void loadAsync(JobSystem& jobs, const std::string& path,
+                        std::function<void(std::shared_ptr<Texture>)> onLoaded,
+                        const TextureLoaderDesc& desc = {});
+
+  // If desiredChannels is 0, file channels are used. Thread-safe (flip state is per thread).
   static LoadedPixels readPixels(const std::string& absPath, bool flipY, int desiredChannels);
 
 private:
+  // Upload decoded pixels (GL thread); frees pixels.
+  static std::shared_ptr<Texture> createTexture_(LoadedPixels& pixels, const std::string& absPath,
+                                                 const TextureLoaderDesc& desc);
+
   // Create a 2×2 fallback checker.
   static std::shared_ptr<Texture> makeFallback_();
 };
@@ -3,10 +3,14 @@
 #include <blkhurst/graphics/program.hpp>
 #include <blkhurst/materials/pipeline_state.hpp>
 #include <blkhurst/textures/texture.hpp>
+#include <blkhurst/util/handle.hpp>
+#include <blkhurst/util/transparent_string_hash.hpp>
 
 #include <glm/glm.hpp>
 #include <memory>
+#include <functional>
 #include <string>
+#include <string_view>
 #include <unordered_map>
 #include <variant>
 
@@ -15,7 +19,7 @@ namespace blkhurst {
 using UniformValue =
     std::variant<int, float, glm::vec2, glm::vec3, glm::vec4, glm::mat2, glm::mat3, glm::mat4>;
 
-class Material {
+class Material : public Handled<Material> {
 public:
   Material(std::shared_ptr<Program> prog);
   virtual ~Material();
@@ -28,24 +32,27 @@ public:
   static std::shared_ptr<Material> create(std::shared_ptr<Program> prog);
 
   void useProgram() const;
+  // Program::variant for Renderer passes; uniforms then apply to it. Empty for the own Program
+  void useProgram(std::string_view variantDefines) const;
   void applyUniformsAndResources();
 
-  [[nodiscard]] std::shared_ptr<Program> program() const;
+  [[nodiscard]] const std::shared_ptr<Program>& program() const;
   [[nodiscard]] const PipelineState& pipeline() const;
   void setDepthTest(bool enabled);
   void setDepthWrite(bool enabled);
   void setDepthFunc(DepthFunc func);
   void setBlend(bool enabled);
   void setCullFace(CullFace face);
+  void setDepthPrepass(bool enabled);
 
-  void setUniform(const std::string& name, int value);
-  void setUniform(const std::string& name, float value);
-  void setUniform(const std::string& name, const glm::vec2& value);
-  void setUniform(const std::string& name, const glm::vec3& value);
-  void setUniform(const std::string& name, const glm::vec4& value);
-  void setUniform(const std::string& name, const glm::mat3& value);
-  void setUniform(const std::string& name, const glm::mat2& value);
-  void setUniform(const std::string& name, const glm::mat4& value);
+  void setUniform(std::string_view name, int value);
+  void setUniform(std::string_view name, float value);
+  void setUniform(std::string_view name, const glm::vec2& value);
+  void setUniform(std::string_view name, const glm::vec3& value);
+  void setUniform(std::string_view name, const glm::vec4& value);
+  void setUniform(std::string_view name, const glm::mat3& value);
+  void setUniform(std::string_view name, const glm::mat2& value);
+  void setUniform(std::string_view name, const glm::mat4& value);
 
   void setDefine(const std::string& def, bool enabled);
   void setDefines(std::vector<std::string> defs);
@@ -56,13 +63,16 @@ protected:
   void applyUniforms() const;
   virtual void applyResources() {};
 
-  void bindTextureUnit(const std::shared_ptr<Texture>& tex, const std::string& uniformName,
+  void bindTextureUnit(const std::shared_ptr<Texture>& tex, std::string_view uniformName,
                        int slot);
 
 private:
   PipelineState pipeline_;
   std::shared_ptr<Program> program_;
-  std::unordered_map<std::string, UniformValue> uniforms_;
+  mutable Program* activeProgram_ = nullptr; // Last useProgram; program_ or a variant of it
+  std::unordered_map<std::string, UniformValue, TransparentStringHash, std::equal_to<>> uniforms_;
+
+  void storeUniform_(std::string_view name, const UniformValue& value);
 
   static void applyUniform(Program& prog, const std::string& name, const UniformValue& uniform);
 };
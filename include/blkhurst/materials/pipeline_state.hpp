@@ -22,6 +22,7 @@ struct PipelineDefaults {
   static constexpr bool blend = false;
   static constexpr CullFace cull = CullFace::Back;
   static constexpr DepthFunc depthFunc = DepthFunc::Less;
+  static constexpr bool depthPrepass = true;
 };
 
 struct PipelineState {
@@ -30,6 +31,9 @@ struct PipelineState {
   bool blend = PipelineDefaults::blend;
   CullFace cull = PipelineDefaults::cull;
   DepthFunc depthFunc = PipelineDefaults::depthFunc;
+  // Eligible for Renderer::setDepthPrepass when opaque; clear for vertex stages that move
+  // vertices, since the pre-pass only sees the plain model transform
+  bool depthPrepass = PipelineDefaults::depthPrepass;
 };
 
 } // namespace blkhurst
@@ -70,6 +70,9 @@ constexpr const char* EnvModeReflection = "ENV_MODE_REFLECTION";
 constexpr const char* UseFlatShading = "FLAT_SHADING";
 constexpr const char* UseVertexColor = "USE_VERTEX_COLOR";
 constexpr const char* UseInstanceColor = "USE_INSTANCE_COLOR";
+// Renderer pass variants (Program::variant)
+constexpr const char* WeightedBlendedOit = "WEIGHTED_BLENDED_OIT";
+constexpr const char* ToneMappingPass = "TONE_MAPPING_PASS";
 } // namespace defines
 
 } // namespace blkhurst
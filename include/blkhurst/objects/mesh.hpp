@@ -3,11 +3,22 @@
 #include <blkhurst/geometry/geometry.hpp>
 #include <blkhurst/materials/material.hpp>
 #include <blkhurst/objects/object3d.hpp>
+#include <blkhurst/util/aabb.hpp>
 
 #include <memory>
+#include <optional>
 
 namespace blkhurst {
 
+class Camera;
+
+// Screen-space LOD selection for Geometry with LOD levels
+struct LodPolicy {
+  bool enabled = true;
+  float maxPixelError = 1.0F; // Coarsest level whose projected error stays under this
+  int forcedLevel = -1;       // >= 0 pins a level (debugging)
+};
+
 class Mesh : public Object3D {
 public:
   Mesh(std::shared_ptr<Geometry> geometry, std::shared_ptr<Material> material);
@@ -27,15 +38,30 @@ public:
     return NodeKind::Mesh;
   }
 
-  [[nodiscard]] std::shared_ptr<Geometry> geometry() const;
-  [[nodiscard]] std::shared_ptr<Material> material() const;
+  // By reference; the draw path does not touch reference counts
+  [[nodiscard]] const std::shared_ptr<Geometry>& geometry() const;
+  [[nodiscard]] const std::shared_ptr<Material>& material() const;
   [[nodiscard]] int instanceCount() const;
   [[nodiscard]] bool wireframe() const;
+  [[nodiscard]] const LodPolicy& lodPolicy() const;
+  // Merged into a Scene static batch; the Renderer skips it except in object id renders (picking)
+  [[nodiscard]] bool batched() const;
+  // Rasterised into the Renderer's software occlusion buffer (setSoftwareOcclusion); suits
+  // large, closed, mostly static meshes. Geometry is read back once per Geometry
+  [[nodiscard]] bool occluder() const;
+  // Level for this frame; 0 without LODs
+  [[nodiscard]] int selectLod(const Camera& camera, float viewportHeight) const;
+  // Geometry bounding sphere as a world box; null when bounds cannot cull it (instanced, or
+  // Geometry without bounds)
+  [[nodiscard]] std::optional<Aabb> worldBounds() const;
 
   void setGeometry(std::shared_ptr<Geometry> geometry);
   void setMaterial(std::shared_ptr<Material> material);
   void setInstanceCount(int count);
   void setWireframe(bool enabled);
+  void setLodPolicy(const LodPolicy& policy);
+  void setBatched(bool batched); // Set by Scene::bakeStatic
+  void setOccluder(bool occluder);
 
   std::unique_ptr<Mesh> clone(bool recursive = true) const;
 
@@ -44,6 +70,9 @@ private:
   std::shared_ptr<Material> material_;
   int instanceCount_ = 1;
   bool wireframe_ = false;
+  LodPolicy lodPolicy_;
+  bool batched_ = false;
+  bool occluder_ = false;
 };
 
 } // namespace blkhurst
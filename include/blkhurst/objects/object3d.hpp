@@ -25,17 +25,38 @@ public:
   Object3D& operator=(Object3D&&) = delete;
 
   Object3D* parent() const;
+  Object3D* root();
   const std::vector<std::unique_ptr<Object3D>>& children() const;
 
   template <class T> T* addChild(std::unique_ptr<T> child);
   template <class T, class... Args> T* addChild(Args&&... args);
+  std::unique_ptr<Object3D> removeChild(Object3D* child);
 
   virtual void onUpdate(const RootState& /*state*/);
 
+  // Only update-enabled nodes are ticked by the Engine; addChild enables overriders of onUpdate
+  bool updateEnabled() const;
+  void setUpdateEnabled(bool enabled);
+
+  // Thread-safe onUpdate may run on a worker; it must only touch this node and its descendants
+  bool threadSafeUpdate() const;
+  void setThreadSafeUpdate(bool enabled);
+
+  // Update-rate LOD: sliced nodes run every N frames on the main thread within a per-frame
+  // budget; state.delta is then the time since the node's previous update
+  int updateInterval() const;
+  void setUpdateInterval(int frames);
+  // Scale the interval with distance to the active camera (UpdateConfig::lodDistance)
+  bool distanceUpdateLod() const;
+  void setDistanceUpdateLod(bool enabled);
+  bool slicedUpdate() const;
+
   std::uint64_t uuid() const;
   const std::string& name() const;
   virtual NodeKind kind() const;
   bool visible() const;
+  // Never moves after load; Scene::bakeStatic merges static meshes
+  bool isStatic() const;
 
   // Getters
   const glm::vec3& position() const;
@@ -51,6 +72,7 @@ public:
   // Setters
   void setName(std::string n);
   void setVisible(bool visible);
+  void setStatic(bool enabled);
 
   void setPosition(const glm::vec3& position);
   void setRotation(const glm::quat& quat);
@@ -72,11 +94,27 @@ public:
   void lookAt(const glm::vec3& target);
 
   void needsUpdate();
+  void updateWorldMatrix() const;
   void traverse(const std::function<void(Object3D&)>& func);
   std::unique_ptr<Object3D> clone(bool recursive = true) const;
 
 protected:
   Object3D* addChild_(std::unique_ptr<Object3D> child);
+  // Raises onNodeBoundsChanged_ for this node only (e.g. Mesh geometry swapped)
+  void boundsChanged_();
+
+  // Graph hooks; invoked on the root of the graph a descendant belongs to (e.g. Scene indices)
+  virtual void onNodeAttached_(Object3D& /*node*/) {
+  }
+  virtual void onNodeDetached_(Object3D& /*node*/) {
+  }
+  virtual void onNodeRenamed_(Object3D& /*node*/, const std::string& /*previousName*/) {
+  }
+  virtual void onNodeUpdateChanged_(Object3D& /*node*/) {
+  }
+  // Transform (self or an ancestor) or bounds changed; may come from a thread-safe onUpdate worker
+  virtual void onNodeBoundsChanged_(Object3D& /*node*/) {
+  }
 
 private:
   Object3D* parent_ = nullptr;
@@ -85,6 +123,11 @@ private:
   std::uint64_t uuid_{0};
   std::string name_;
   bool visible_ = true;
+  bool static_ = false;
+  bool updateEnabled_ = false;
+  bool threadSafeUpdate_ = false;
+  int updateInterval_ = 1;
+  bool distanceUpdateLod_ = false;
 
   // TRS
   glm::vec3 position_{0.0F, 0.0F, 0.0F};
@@ -96,21 +139,34 @@ private:
 
   mutable bool needsUpdate_ = true;
   void calculateMatrices() const;
+  void markDirty_(Object3D& graphRoot);
 
   static std::uint64_t make_uuid_();
 };
 
+// True if T, or a base between T and Object3D, overrides onUpdate.
+// Only the static type is visible; nodes passed as a base pointer must opt in explicitly.
+template <class T>
+inline constexpr bool kOverridesOnUpdate =
+    !std::is_same_v<decltype(&T::onUpdate), void (Object3D::*)(const RootState&)>;
+
 // Template Definition
 // Create, Move ownership, Return reference
 template <class T, class... Args> T* Object3D::addChild(Args&&... args) {
   auto object = std::make_unique<T>(std::forward<Args>(args)...);
   auto* rawPtr = object.get();
+  if constexpr (kOverridesOnUpdate<T>) {
+    rawPtr->setUpdateEnabled(true);
+  }
   addChild_(std::move(object));
   return rawPtr;
 }
 // Move ownership, Return reference
 template <class T> T* Object3D::addChild(std::unique_ptr<T> child) {
   static_assert(std::is_base_of_v<Object3D, T>, "T must derive from Object3D");
+  if constexpr (kOverridesOnUpdate<T>) {
+    child->setUpdateEnabled(true);
+  }
   return static_cast<T*>(addChild_(std::move(child)));
 }
 
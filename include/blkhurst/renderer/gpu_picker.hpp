@@ -0,0 +1,71 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+GpuPicker (object id readback)
+  - Render into a RenderTarget with objectIdAttachment; each draw writes its object id (R32UI)
+  - request() copies a small square around the cursor into a pixel pack buffer and fences it;
+    nothing waits on the GPU
+  - poll() maps finished reads only, so results arrive a frame or two after their request
+  - The nearest non-zero id to the requested pixel wins (forgiving on thin or edge geometry),
+    mapped to Object3D::uuid() through the Renderer::objectIds() captured with the request
+*/
+
+namespace blkhurst {
+
+class RenderTarget;
+
+struct PickResult {
+  std::uint64_t uuid = 0; // Object3D::uuid(); 0 when nothing was under the cursor
+  glm::ivec2 pixel{0};    // As requested
+};
+
+class GpuPicker {
+public:
+  static constexpr int kSlots = 3; // Requests in flight
+  static constexpr int kDefaultRadius = 2;
+
+  explicit GpuPicker(int radius = kDefaultRadius);
+  ~GpuPicker();
+
+  GpuPicker(const GpuPicker&) = delete;
+  GpuPicker(GpuPicker&&) = delete;
+  GpuPicker& operator=(const GpuPicker&) = delete;
+  GpuPicker& operator=(GpuPicker&&) = delete;
+
+  // After Renderer::render into target; pixel has its origin at the bottom left (GL convention).
+  // False when the target has no object id attachment, pixel is outside it or every slot is busy
+  bool request(const RenderTarget& target, std::span<const std::uint64_t> objectIds,
+               glm::ivec2 pixel);
+  // Newest result finished since the last poll; never blocks
+  [[nodiscard]] std::optional<PickResult> poll();
+
+  [[nodiscard]] int pending() const;
+
+private:
+  struct Slot {
+    unsigned pbo = 0U;
+    void* fence = nullptr; // GLsync; null when free
+    std::uint64_t sequence = 0;
+    glm::ivec2 pixel{0};
+    glm::ivec2 origin{0}; // Region bottom left in target pixels
+    glm::ivec2 size{0};
+    std::vector<std::uint64_t> objectIds;
+  };
+
+  [[nodiscard]] PickResult resolve_(const Slot& slot) const;
+
+  int radius_ = kDefaultRadius;
+  std::array<Slot, kSlots> slots_;
+  std::uint64_t nextSequence_ = 1;
+  std::uint64_t lastReturned_ = 0;
+};
+
+} // namespace blkhurst
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <blkhurst/util/aabb.hpp>
+#include <glm/glm.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+OcclusionBuffer (CPU software occlusion)
+  - Low resolution depth buffer (NDC z, nearest wins) that designated occluders are rasterised
+    into on the CPU; boxes are then tested against it before any draw is submitted
+  - Conservative: an occluder only writes pixels it covers entirely, at the farthest depth it
+    reaches over each of them, so a box is never reported hidden behind a gap or an edge.
+    Lone triangles are inset by half a pixel. Triangles sharing edges (matched by vertex
+    position, see Adjacency) merge: a pixel is written when its centre is inside the occluder
+    and none of its silhouette edges crosses it, at the farthest depth of every triangle it
+    touches, so tessellated occluders stay solid. Closed meshes keep only counter-clockwise
+    triangles, which cover the outline on their own
+  - addOccluder() transforms, near-clips and sets up triangles; rasterize() bins them into
+    horizontal bands that run on the JobSystem, then reduces 8x4 tiles to their farthest depth
+  - occluded() projects a box to a screen rectangle at its nearest depth: tiles whose farthest
+    depth is nearer reject it wholesale, the rest are scanned per pixel. Read-only, so any
+    number of threads may test at once after rasterize()
+  - Edge functions and depth are evaluated 8 pixels at a time with AVX2 (BLKHURST_AVX2), 4 with
+    SSE2, or per pixel elsewhere; simdPath() reports which one was compiled in
+*/
+
+namespace blkhurst {
+
+class JobSystem;
+
+class OcclusionBuffer {
+public:
+  static constexpr int kDefaultWidth = 256;
+  static constexpr int kDefaultHeight = 128;
+  static constexpr int kTileWidth = 8;
+  static constexpr int kTileHeight = 4;
+  static constexpr int kBandHeight = 2 * kTileHeight; // Rows per rasterize job
+
+  explicit OcclusionBuffer(int width = kDefaultWidth, int height = kDefaultHeight);
+
+  // Rounded up to whole tiles; clears
+  void resize(int width, int height);
+  // Drops triangles and resets every pixel to empty (infinitely far)
+  void clear();
+
+  // Which triangles of an occluder continue across each other's edges. Vertices at the same
+  // position are welded first, so meshes split for normals or uvs still count as closed
+  struct Adjacency {
+    static constexpr std::uint32_t kOpen = 0xFFFFFFFFU;
+    std::vector<std::uint32_t> across; // Per triangle edge (opposite corner i): the neighbour's
+                                       // vertex facing it, or kOpen
+    std::vector<std::uint32_t> weld;   // Per vertex: the first vertex at the same position
+    bool closed = false;               // Each edge has one neighbour running it the other way
+  };
+  [[nodiscard]] static Adjacency buildAdjacency(std::span<const float> positions,
+                                                std::span<const std::uint32_t> indices);
+
+  // positions: xyz per vertex; indices: triangle list, empty for unindexed positions.
+  // adjacency: from buildAdjacency for the same mesh, or null to build it on every call
+  void addOccluder(std::span<const float> positions, std::span<const std::uint32_t> indices,
+                   const glm::mat4& modelViewProjection, const Adjacency* adjacency = nullptr);
+  // Fills the buffer from the added triangles; bands run in parallel when jobs is set
+  void rasterize(JobSystem* jobs = nullptr);
+
+  // True only when every pixel the box touches holds an occluder nearer than the box. Boxes
+  // crossing the near plane, or off screen, are never reported occluded
+  [[nodiscard]] bool occluded(const Aabb& bounds, const glm::mat4& viewProjection) const;
+
+  [[nodiscard]] int width() const;
+  [[nodiscard]] int height() const;
+  [[nodiscard]] float depth(int xpos, int ypos) const; // Infinity where nothing was drawn
+  [[nodiscard]] std::size_t triangleCount() const;     // After near clipping
+  [[nodiscard]] static const char* simdPath();
+
+private:
+  // What lies beyond edge i of a triangle (the one opposite vertex i)
+  struct EdgeNeighbour {
+    enum class Kind : std::uint8_t {
+      Open,     // Nothing
+      Across,   // A neighbour whose facing vertex is `across`, unless it folds back on screen
+      Coplanar, // Another piece of the same near-clipped triangle
+    };
+    Kind kind = Kind::Open;
+    glm::vec4 across{}; // Clip space
+  };
+
+  // Screen space setup; edges are oriented so inside is >= 0 for either winding, sampled at
+  // pixel centres. A lone triangle writes pixels clearing every edge by its inset, wholly
+  // inside; a merged one gathers into the occluder's band scratch
+  struct Triangle {
+    glm::vec3 edgeX; // Edge i = edgeX[i] * x + edgeY[i] * y + edgeC[i]
+    glm::vec3 edgeY;
+    glm::vec3 edgeC;
+    glm::vec3 inset; // Largest drop of each edge from a pixel centre to a corner
+    glm::vec3 depth; // Farthest z over the pixel at x, y = depth[0] * x + depth[1] * y + depth[2]
+    float farthest;  // Farthest vertex z; clamps depth
+    std::uint32_t occluder;
+    bool merged;
+    glm::ivec4 bounds; // Inclusive pixel rectangle: x0, y0, x1, y1
+  };
+  // Edge of a merged triangle with nothing beyond it on screen
+  struct Silhouette {
+    glm::vec2 from;
+    glm::vec2 to;
+    std::uint32_t occluder;
+  };
+  // One merged occluder at a time: farthest depth, centre coverage and silhouette masks
+  struct BandScratch {
+    std::vector<float> farthest;
+    std::vector<float> centre;
+    std::vector<float> blocked;
+  };
+
+  void addTriangle_(const std::array<glm::vec4, 3>& clip,
+                    const std::array<EdgeNeighbour, 3>& edges, bool frontOnly);
+  void setupTriangle_(const std::array<glm::vec4, 3>& clip,
+                      const std::array<EdgeNeighbour, 3>& edges, bool frontOnly);
+  void rasterizeBand_(int band);
+  void rasterizeRow_(const Triangle& triangle, int row, int x0, int x1);
+  void mergeRow_(const Triangle& triangle, int row, int x0, int x1, float* farthest,
+                 float* centre);
+  void block_(const Silhouette& silhouette, int firstRow, int lastRow, float* blocked) const;
+  void resolve_(int firstRow, int lastRow, int x0, int x1, BandScratch& scratch);
+  void reduceTiles_(int band);
+  [[nodiscard]] bool rowOccluded_(int row, int x0, int x1, float nearest) const;
+
+  int width_ = 0; // Whole tiles, so SIMD spans never run past a row
+  int height_ = 0;
+  int tilesX_ = 0;
+  int tilesY_ = 0;
+  std::vector<float> depth_;
+  std::vector<float> tileMax_; // Farthest depth per tile
+  std::vector<Triangle> triangles_;
+  std::vector<Silhouette> silhouettes_;
+  std::vector<std::vector<std::uint32_t>> bins_;           // Triangle indices per band
+  std::vector<std::vector<std::uint32_t>> silhouetteBins_; // Likewise
+  std::vector<BandScratch> scratch_;                       // Per band
+  std::uint32_t occluderCount_ = 0;
+  std::vector<glm::vec4> clipScratch_;                     // addOccluder vertices, for capacity
+  Adjacency adjacencyScratch_;                             // When addOccluder is given none
+};
+
+} // namespace blkhurst
@@ -29,15 +29,20 @@ struct DepthAttachmentDesc {
 struct RenderTargetDesc {
   int colorAttachmentCount = 1;
   ColorAttachmentDesc colorDesc;
+  std::vector<TextureFormat> colorFormats; // Per attachment where set; colorDesc.format otherwise
   DepthAttachmentDesc depthDesc;
 
   bool depthAttachment = true;
+  bool objectIdAttachment = false; // R32UI at kObjectIdLocation; written by Renderer (GpuPicker)
   // TODO: samples (MSAA)
 };
 
 // Wrapper for OpenGl Framebuffer
 class RenderTarget {
 public:
+  // Fragment output and draw buffer of the object id attachment (FragObjectId in io_fragment)
+  static constexpr int kObjectIdLocation = 7;
+
   RenderTarget(int width, int height, const RenderTargetDesc& desc);
   ~RenderTarget();
 
@@ -56,6 +61,7 @@ public:
 
   [[nodiscard]] std::shared_ptr<Texture> texture() const;
   [[nodiscard]] std::shared_ptr<Texture> depthTexture() const;
+  [[nodiscard]] std::shared_ptr<Texture> objectIdTexture() const; // Null unless requested
   [[nodiscard]] const std::vector<std::shared_ptr<Texture>>& textures() const;
 
 private:
@@ -66,6 +72,7 @@ private:
   RenderTargetDesc desc_;
   std::vector<std::shared_ptr<Texture>> textures_;
   std::shared_ptr<Texture> depthTexture_;
+  std::shared_ptr<Texture> objectIdTexture_;
 
   void rebuildAttachments_();
 };
@@ -7,18 +7,62 @@
 #include <blkhurst/objects/mesh.hpp>
 #include <blkhurst/objects/object3d.hpp>
 #include <blkhurst/renderer/cube_render_target.hpp>
+#include <blkhurst/renderer/occlusion_buffer.hpp>
 #include <blkhurst/renderer/render_target.hpp>
 #include <blkhurst/renderer/uniform_blocks.hpp>
+#include <blkhurst/util/frame_arena.hpp>
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace blkhurst {
 
+class JobSystem;
+class TaskGroup;
+class OitCompositeMaterial;
+class ToneMappingMaterial;
+
 enum class ToneMappingMode : int { None = 0, Linear = 1, Neutral = 2, ACES = 3 };
 enum class OutputColorSpace : int { Linear = 0, SRGB = 1 };
 
+// Counters since the last resetStats (Engine resets once per frame)
+struct RenderStats {
+  int drawCalls = 0;
+  std::size_t triangles = 0;           // Submitted, instances included
+  std::size_t trianglesSavedByLod = 0; // Level 0 triangles minus the selected level's
+  std::size_t meshletsTested = 0;
+  std::size_t meshletsCulled = 0; // Frustum or normal cone
+  int vertexArrayBinds = 0;       // Pooled geometry shares one VAO
+  std::size_t meshesCulled = 0;   // Outside the frustum (Scene spatial index)
+  std::size_t meshesOccluded = 0; // Hidden by their last query; drawn under conditional render
+  std::size_t occlusionQueries = 0;
+  std::size_t meshesSoftwareOccluded = 0; // Behind occluders in the CPU occlusion buffer
+  std::size_t occluderTriangles = 0;      // Rasterised into it
+  int depthPrepassDraws = 0;              // Also counted in drawCalls
+  int weightedBlendedDraws = 0;           // TransparencyMode::WeightedBlended meshes
+  // Pipeline statistics (setPipelineStatistics); results arrive a frame or two late
+  std::uint64_t fragmentInvocations = 0;
+  float gpuFrameMs = 0.0F; // Scene target renders (dynamic resolution); a frame or two late
+};
+
+// Renderer::setDynamicResolution
+struct DynamicResolutionDesc {
+  bool enabled = false;
+  float targetFrameMs = 1000.0F / 60.0F; // Budget the scale is steered towards
+  float minScale = 0.5F;                 // Per axis, of the backbuffer
+  float maxScale = 1.0F;                 // At most 1; the scene target is allocated at this
+};
+
 class Renderer {
 public:
   Renderer();
-  ~Renderer() = default;
+  ~Renderer();
 
   Renderer(const Renderer&) = delete;
   Renderer& operator=(const Renderer&) = delete;
@@ -38,6 +82,8 @@ public:
   void clearStencil();
 
   void setDefaultFramebufferSize(int width, int height); // Set by engine
+  void setFrameArena(FrameArena* arena);                  // Set by engine
+  void setJobSystem(JobSystem* jobs);                     // Set by engine
   void setViewport(int xpos, int ypos, int width, int height);
   void setScissor(int xpos, int ypos, int width, int height);
   void setScissorTest(bool enabled);
@@ -45,29 +91,197 @@ public:
   void setToneMappingExposure(float exposure);
   void setToneMappingMode(ToneMappingMode mode);
   void setOutputColorSpace(OutputColorSpace space);
+  // Renders into the window backbuffer go through an RGBA16F scene target, then tone mapping and
+  // the output colour space are applied once per pixel in a fullscreen pass. Materials compile a
+  // TONE_MAPPING_PASS variant that leaves both out; off by default
+  void setToneMappingPass(bool enabled);
+  // Renders into the window backbuffer go through the scene target at a fraction of its size per
+  // axis, upscaled bilinearly to the backbuffer (the UI, drawn afterwards, stays native).
+  // Scissor rectangles are not scaled; off by default
+  void setDynamicResolution(const DynamicResolutionDesc& desc);
+  // Once per frame before rendering (Engine): moves the scale towards the frame budget, measured
+  // by GPU timer queries over the scene target, or frameMs (CPU) until results arrive
+  void updateDynamicResolution(float frameMs);
+  [[nodiscard]] float resolutionScale() const; // 1 when dynamic resolution is off
+  // Geometry with meshlets: clusters are frustum culled, and normal cone culled for back-face
+  // culling, filled, unmirrored materials; on by default
+  void setMeshletCulling(bool enabled);
+  // Scenes draw what their spatial index finds in the camera frustum instead of walking the
+  // graph, in graph order (Scene::drawOrder); static batches are tested on their bounds. On by
+  // default
+  void setFrustumCulling(bool enabled);
+  // Hardware occlusion queries on world bounds with temporal coherence; off by default. State is
+  // kept per mesh, so one camera per Renderer
+  void setOcclusionCulling(bool enabled);
+  // Opaque meshes are first drawn depth-only (through Geometry position streams where present),
+  // then shaded with depth writes off and DepthFunc::Lequal, so hidden fragments are never
+  // shaded. Instanced and wireframe meshes, and materials opted out with setDepthPrepass(false),
+  // draw as usual. Not applied under occlusion culling; off by default
+  void setDepthPrepass(bool enabled);
+  // Counts fragment shader invocations per outermost render() into
+  // RenderStats::fragmentInvocations, without stalling; needs GL 4.6 or
+  // ARB_pipeline_statistics_query. Off by default
+  void setPipelineStatistics(bool enabled);
+  // CPU occlusion: Mesh::occluder() meshes are rasterised into an OcclusionBuffer on the
+  // JobSystem, and the world bounds of everything else are tested against it before submission;
+  // off by default. Occluders themselves are always drawn
+  void setSoftwareOcclusion(bool enabled);
+  // Snapshots the occluders in camera's view and starts rasterising them; the Engine calls this
+  // before the scene update so both run at once. render() with the same camera uses the result,
+  // and rasterises again itself when nothing was prepared, the camera moved, or an occluder was
+  // moved, hidden, given other Geometry or detached since (checked through Scene::findByUuid;
+  // other roots always rasterise again). Occluders that entered the view meanwhile are missed
+  // for a frame, which only lets more through
+  void prepareSoftwareOcclusion(Object3D& root, const Camera& camera);
+  // Valid between render() calls
+  [[nodiscard]] const OcclusionBuffer& occlusionBuffer() const;
+
+  // Object3D::uuid() of each object id (index id - 1) written by the last render() into a target
+  // with an object id attachment. Such renders draw static (batched) meshes one by one instead of
+  // their batches so they stay pickable; keep id targets to a dedicated picking pass. See GpuPicker
+  [[nodiscard]] std::span<const std::uint64_t> objectIds() const;
   // TODO: setAnimationLoop, copyFrameBufferToTexture
 
   void resetState();
 
+  [[nodiscard]] const RenderStats& stats() const;
+  void resetStats();
+
 private:
   FrameUniforms frameUniforms_{};
 
+  FrameArena* frameArena_ = nullptr; // Transient per-render lists; heap if unset
+
   bool autoClear_ = true;
   bool scissorTestEnabled_ = false;
 
   glm::vec4 clearColor_ = defaults::window::clearColor;
 
   glm::ivec2 framebufferSize_ = {0, 0}; // Window Backbuffer
+  glm::ivec4 viewport_ = {0, 0, 0, 0};   // Last setViewport; LOD projection
+
+  const RenderTarget* renderTarget_ = nullptr; // Null for the backbuffer and cube targets
+  std::vector<std::uint64_t> objectIds_;
+  bool writeObjectIds_ = false; // Current render() target has an object id attachment
+
+  RenderStats stats_;
+  bool meshletCulling_ = true;
+  bool frustumCulling_ = true;
+
+  static constexpr std::uint64_t kVisibleRetestInterval = 4;
+  static constexpr std::uint64_t kOcclusionPruneInterval = 120; // Frames
+  struct OcclusionState {
+    unsigned query = 0U;
+    bool visible = true;  // Last read result
+    bool pending = false; // Issued, result not read yet
+    std::uint64_t lastFrame = 0;
+  };
+  bool occlusionCulling_ = false;
+  std::uint64_t occlusionFrame_ = 0;
+  std::unordered_map<std::uint64_t, OcclusionState> occlusionStates_; // By Object3D::uuid()
+  std::shared_ptr<Geometry> occlusionBox_;
+  std::shared_ptr<Material> occlusionMaterial_;
+  const VertexArray* boundVertexArray_ = nullptr; // Reset at the start and end of render()
+
+  bool depthPrepass_ = false;
+  bool prepassShading_ = false; // Shading after a pre-pass; eligible meshes test Lequal, no writes
+  std::shared_ptr<Material> depthMaterial_;
+
+  static constexpr std::size_t kStatisticsQueries = 4; // In flight
+  struct PendingQuery {
+    unsigned query = 0U;
+    bool pending = false;
+  };
+  bool pipelineStatistics_ = false;
+  bool statisticsActive_ = false; // A query spans the current render()
+  std::array<PendingQuery, kStatisticsQueries> statisticsQueries_{};
+  std::uint64_t lastFragmentInvocations_ = 0;
+
+  // Weighted blended transparency (Scene::setTransparency): accumulation and revealage over a
+  // copy of the current depth, composited back over it
+  bool weightedBlendedPass_ = false;
+  // Program::variant of the current pass, from passDefinesBegin_ (nested render() calls append
+  // theirs after the outer ones); empty for the own Program
+  std::string passDefines_;
+  std::size_t passDefinesBegin_ = 0;
+  std::shared_ptr<RenderTarget> oitTarget_;
+  std::optional<TextureFormat> oitDepthFormat_; // Of oitTarget_; matches the blit source
+  std::shared_ptr<OitCompositeMaterial> oitComposite_;
+  std::shared_ptr<Geometry> fullscreenQuad_;
+
+  struct OccluderSource {
+    MeshData data;
+    OcclusionBuffer::Adjacency adjacency; // Built once with the read back
+  };
+  struct OccluderDraw {
+    std::shared_ptr<const OccluderSource> source;
+    glm::mat4 modelViewProjection{1.0F};
+    std::uint64_t uuid = 0; // What the snapshot saw, to notice changes made by the update
+    glm::mat4 world{1.0F};
+    Handle<Geometry> geometry;
+  };
+  JobSystem* jobs_ = nullptr;
+  bool softwareOcclusion_ = false;
+  bool occlusionPrepared_ = false; // Rasterising (or done) for occlusionCamera_, not yet used
+  const Camera* occlusionCamera_ = nullptr;
+  glm::mat4 occlusionViewProjection_{1.0F};
+  OcclusionBuffer occlusionBuffer_;
+  // CPU copies; generation-checked keys never match a later Geometry at the same address
+  std::unordered_map<Handle<Geometry>, std::shared_ptr<const OccluderSource>> occluderSources_;
+  std::vector<OccluderDraw> occluderDraws_; // Snapshot read by the rasterising task
+  std::unique_ptr<TaskGroup> occlusionTask_;
+
+  bool toneMappingPass_ = false;
+  bool defaultFramebuffer_ = true; // setRenderTarget(nullptr); the scene target while it is bound
+  bool sceneTargetBound_ = false;  // An outermost render() into sceneTarget_ is in progress
+  std::shared_ptr<RenderTarget> sceneTarget_; // Backbuffer times maxScale; RGBA16F for HDR
+  std::shared_ptr<ToneMappingMaterial> toneMappingMaterial_;
+  glm::ivec4 outerViewport_ = {0, 0, 0, 0}; // Backbuffer viewport while the scene target is bound
+  glm::ivec4 sceneViewport_ = {0, 0, 0, 0}; // Its scaled counterpart in the scene target
+
+  static constexpr std::size_t kTimerQueries = 4; // In flight
+  DynamicResolutionDesc dynamicResolution_{};
+  float resolutionScale_ = 1.0F;
+  bool gpuTimer_ = false;    // GL_TIME_ELAPSED has counter bits
+  float gpuFrameMs_ = -1.0F; // Latest timer result; negative until one arrives
+  std::array<PendingQuery, kTimerQueries> timerQueries_{};
 
   float toneMappingExposure_ = 1.0F;
   ToneMappingMode toneMappingMode_ = ToneMappingMode::None;
   OutputColorSpace outputColorSpace_ = OutputColorSpace::SRGB;
 
-  void renderMesh(const Mesh& mesh, const Camera& camera);
+  void renderMesh(const Mesh& mesh, const Camera& camera, int objectId = 0);
   static void applyPipeline(const PipelineState& state, bool wireframe);
   void applyPerFrameUniforms(const Camera& camera);
-  void applyPerDrawUniforms(const Mesh& mesh, const Camera& camera) const;
-  static void drawGeometry(const Geometry& geom, int instanceCount);
+  void applyPerDrawUniforms(const Mesh& mesh, const Camera& camera, int objectId) const;
+  void bindGeometry(const Geometry& geom);
+  void drawGeometry(const Geometry& geom, DrawRange range, int instanceCount);
+  void drawMeshlets(const Geometry& geom, DrawRange range, const Mesh& mesh,
+                    const Camera& camera);
+  int nextObjectId_(const Mesh& mesh);
+  void sortByDrawOrder_(std::pmr::vector<Mesh*>& meshes, const Scene& scene) const;
+  void drawLevel_(const Mesh& mesh, const Geometry& geometry, const Camera& camera,
+                  bool countLodSavings);
+  void renderOcclusionCulled_(std::span<Mesh* const> meshes, const Camera& camera);
+  void renderDepthPrepass_(std::span<Mesh* const> meshes, const Camera& camera);
+  void renderWeightedBlended_(std::span<Mesh* const> meshes, const Camera& camera);
+  void drawFullscreen_(Material& material);
+  void bindDefaultFramebuffer_();
+  void beginSceneTarget_();
+  void resolveSceneTarget_();
+  [[nodiscard]] bool usesSceneTarget_() const;
+  bool beginTimer_();
+  void releaseTimerQueries_();
+  static bool prepassEligible_(const Mesh& mesh);
+  bool beginStatistics_();
+  void releaseStatisticsQueries_();
+  void releaseOcclusionQueries_();
+  std::shared_ptr<const OccluderSource> occluderSource_(const std::shared_ptr<Geometry>& geometry);
+  [[nodiscard]] bool occludersChanged_(const Object3D& root) const;
+  void cullSoftwareOccluded_(std::pmr::vector<Mesh*>& meshes, Object3D& root,
+                             const Camera& camera);
+  void waitSoftwareOcclusion_();
+  std::pmr::memory_resource* frameResource_() const;
 
   std::unique_ptr<Mesh> skyboxMesh_;
   void renderBackground(Scene& scene, Camera& camera);
@@ -12,6 +12,7 @@ enum class UniformBinding {
   Draw = 1,     // Per-draw UBO (Unused but kept for prosperity)
   Lights = 2,   // Lights SSBO
   Instance = 3, // Instance SSBO
+  Vertices = 4, // VertexPool SSBO (vertex pulling)
 };
 
 struct alignas(kCpuAlignment) FrameUniforms {
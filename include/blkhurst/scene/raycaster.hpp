@@ -0,0 +1,89 @@
+#pragma once
+
+#include <blkhurst/geometry/bvh.hpp>
+#include <blkhurst/util/ray.hpp>
+#include <glm/glm.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <span>
+#include <vector>
+
+/**
+Raycaster (picking, line of sight)
+  - build(root) snapshots visible triangle meshes: each Geometry's MeshBvh (built once and
+    cached on the Geometry) plus a top-level Bvh over the meshes' world-space bounds.
+    build(targets) takes MeshBvhs built elsewhere and needs no GL
+  - Rays are tested in object space per mesh, so distances stay in world units
+  - Level 0 geometry; batched static meshes are hit through their original nodes
+  - Rebuild after objects move; queries are const and safe to run from several threads
+*/
+
+namespace blkhurst {
+
+class Camera;
+class JobSystem;
+class Mesh;
+class Object3D;
+
+struct RaycastHit {
+  Mesh* mesh = nullptr;
+  float distance = 0.0F; // World units from the ray origin
+  glm::vec3 point{0.0F}; // World space
+  glm::vec3 barycentric{0.0F};
+  std::uint32_t triangle = 0; // Level 0 triangle of the Geometry's index buffer
+};
+
+// A mesh for Raycaster::build without a scene: object-space triangles and where they are
+struct RaycastTarget {
+  Mesh* mesh = nullptr; // Reported in hits; may be null
+  std::shared_ptr<const MeshBvh> bvh;
+  glm::mat4 world{1.0F};
+};
+
+class Raycaster {
+public:
+  static constexpr float kInfinity = std::numeric_limits<float>::infinity();
+
+  explicit Raycaster(JobSystem* jobs = nullptr);
+
+  // GL thread on first use of a Geometry (its BVH is built from a readback)
+  void build(Object3D& root);
+  void build(std::span<const RaycastTarget> targets);
+
+  void setRay(const Ray& ray); // Direction normalised here
+  // ndc in [-1, 1]; from the near plane through the far plane
+  void setFromCamera(const glm::vec2& ndc, const Camera& camera);
+  [[nodiscard]] const Ray& ray() const;
+
+  [[nodiscard]] std::optional<RaycastHit> intersectNearest(float maxDistance = kInfinity) const;
+  // Sorted by distance
+  [[nodiscard]] std::vector<RaycastHit> intersectAll(float maxDistance = kInfinity) const;
+  // Nearest hit per ray (directions normalised by the caller); parallel over rays with jobs
+  void intersectNearest(std::span<const Ray> rays, std::span<std::optional<RaycastHit>> hits,
+                        float maxDistance = kInfinity) const;
+
+  [[nodiscard]] std::size_t meshCount() const;
+
+private:
+  struct Entry {
+    Mesh* mesh = nullptr;
+    std::shared_ptr<const MeshBvh> bvh;
+    glm::mat4 objectToWorld{1.0F};
+    glm::mat4 worldToObject{1.0F};
+  };
+
+  [[nodiscard]] std::optional<RaycastHit> nearest_(const Ray& ray, float maxDistance) const;
+  [[nodiscard]] static Ray toObject_(const Entry& entry, const Ray& ray);
+  [[nodiscard]] static RaycastHit toHit_(const Entry& entry, const Ray& ray,
+                                         const TriangleHit& hit);
+
+  JobSystem* jobs_ = nullptr;
+  Ray ray_;
+  std::vector<Entry> entries_;
+  Bvh topLevel_;
+};
+
+} // namespace blkhurst
@@ -3,13 +3,24 @@
 #include <blkhurst/cameras/ortho_camera.hpp>
 #include <blkhurst/controllers/controller.hpp>
 #include <blkhurst/engine/config/defaults.hpp>
+#include <blkhurst/geometry/geometry.hpp>
+#include <blkhurst/objects/mesh.hpp>
 #include <blkhurst/objects/object3d.hpp>
+#include <blkhurst/scene/spatial_index.hpp>
 #include <blkhurst/textures/cube_texture.hpp>
 #include <blkhurst/textures/texture.hpp>
 #include <blkhurst/ui/ui_entry.hpp>
+#include <blkhurst/util/transparent_string_hash.hpp>
 
+#include <atomic>
+#include <cstdint>
+#include <functional>
 #include <glm/glm.hpp>
 #include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace blkhurst {
@@ -26,6 +37,19 @@ struct SceneBackground {
   float intensity = 1.0F;
 };
 
+// How the Renderer draws meshes whose Material blends
+enum class TransparencyMode : std::uint8_t {
+  Blended,        // In draw order with SrcAlpha/OneMinusSrcAlpha; sort them yourself
+  WeightedBlended // Order independent (weighted blended OIT): after all opaque meshes, unsorted
+};
+
+// Scene::bakeStatic options
+struct StaticBatchDesc {
+  std::uint32_t maxVertices = 1U << 20U; // A group splits into further batches past this
+  float maxExtent = 32.0F; // World units; wider groups split spatially so batches cull. <= 0: off
+  GeometryDesc geometry{.meshlets = true}; // Meshlets keep per-cluster culling inside a batch
+};
+
 // struct SceneEnvironment {
 //   std::shared_ptr<CubeTexture> cubemap; // PMREM
 //   glm::mat3 rotation{1.0F};
@@ -55,6 +79,9 @@ public:
   void setBackground(std::shared_ptr<Texture> equirect);
   void setBackgroundIntensity(float intensity);
 
+  [[nodiscard]] TransparencyMode transparency() const;
+  void setTransparency(TransparencyMode mode);
+
   // Sets environment for PBR children only
   // [[nodiscard]] const SceneEnvironment& environment() const;
   // void setEnvironment(std::shared_ptr<Texture> equirect, bool setBackground = true);
@@ -69,8 +96,70 @@ public:
   void setActiveController(std::shared_ptr<Controller> controller);
   void addUiEntry(std::shared_ptr<UiEntry> entry);
 
+  // Constant-time lookup of descendants (the Scene itself is not indexed)
+  [[nodiscard]] Object3D* findByUuid(std::uint64_t uuid) const;
+  [[nodiscard]] Object3D* findByName(std::string_view name) const;
+  [[nodiscard]] const std::vector<Object3D*>& findAllByName(std::string_view name) const;
+
+  // Merges visible static meshes (single instance, triangles) sharing a Material and wireframe
+  // mode into batches with baked world transforms; each group is split at the median along its
+  // widest axis until every batch fits StaticBatchDesc limits. Replaces previous batches.
+  // Originals stay in the graph (picking, lookup) but are skipped by the Renderer. Rebake after
+  // moving, hiding or detaching a batched mesh. Returns the batch count
+  int bakeStatic(const StaticBatchDesc& desc = {});
+  void clearStaticBatches();
+  [[nodiscard]] const std::vector<std::unique_ptr<Mesh>>& staticBatches() const;
+
+  // Descendant meshes by Mesh::worldBounds(), kept current from transform dirty flags: moved
+  // meshes are refitted, not the whole index. Call before querying (the Renderer does when
+  // frustum culling); large attaches are bulk loaded. Meshes without bounds are kept in
+  // unboundedMeshes() instead. Visibility is not filtered
+  void updateSpatialIndex();
+  [[nodiscard]] const SpatialIndex& spatialIndex() const;
+  [[nodiscard]] const std::vector<Mesh*>& unboundedMeshes() const;
+  // Position of a descendant Mesh in traverse() order, as of the last updateSpatialIndex();
+  // spatial queries return meshes in tree order, sort by this to restore draw order
+  [[nodiscard]] std::uint32_t drawOrder(const Mesh& mesh) const;
+
+  // Descendants with updateEnabled(); ticked by the Engine instead of traversing the graph
+  [[nodiscard]] const std::vector<Object3D*>& updateList() const;
+  // Incremented whenever the update list or a member's update flags change
+  [[nodiscard]] std::uint64_t updateListVersion() const;
+
+protected:
+  void onNodeAttached_(Object3D& node) override;
+  void onNodeDetached_(Object3D& node) override;
+  void onNodeRenamed_(Object3D& node, const std::string& previousName) override;
+  void onNodeUpdateChanged_(Object3D& node) override;
+  void onNodeBoundsChanged_(Object3D& node) override;
+
 private:
+  std::unordered_map<std::uint64_t, Object3D*> uuidIndex_;
+  std::unordered_map<std::string, std::vector<Object3D*>, TransparentStringHash, std::equal_to<>>
+      nameIndex_;
+  std::vector<Object3D*> updateList_;
+  std::uint64_t updateListVersion_ = 0;
+  std::vector<std::unique_ptr<Mesh>> staticBatches_; // Not graph nodes
+
+  // Per descendant Mesh; queued marks a pending refit. Update workers flip it concurrently
+  // (exchange), so only the first bounds change per node between updates takes the queue lock
+  struct SpatialEntry {
+    int proxy = SpatialIndex::kNull;
+    std::uint32_t drawOrder = 0;
+    std::atomic<bool> queued{false};
+  };
+  std::unordered_map<const Object3D*, SpatialEntry> spatialEntries_;
+  bool drawOrderDirty_ = false; // Meshes attached or detached since the last renumbering
+  std::vector<Mesh*> spatialQueue_;
+  std::mutex spatialQueueMutex_;
+  SpatialIndex spatialIndex_;
+  std::vector<Mesh*> unboundedMeshes_;
+
+  void indexName_(Object3D& node, const std::string& name);
+  void unindexName_(Object3D& node, const std::string& name);
+
   SceneBackground background_{};
+  TransparencyMode transparency_ = TransparencyMode::Blended;
   // SceneEnvironment environment_{};
 
   std::shared_ptr<Camera> activeCamera_ = std::make_shared<OrthoCamera>();
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <blkhurst/util/aabb.hpp>
+#include <blkhurst/util/frustum.hpp>
+#include <glm/glm.hpp>
+
+#include <cstddef>
+#include <span>
+#include <utility>
+#include <vector>
+
+/**
+SpatialIndex (dynamic AABB tree)
+  - One leaf (proxy) per object; leaves keep the object's bounds and a fattened copy that the
+    tree is built over, so motion within the fat box costs nothing
+  - Insertion descends by surface-area cost; AVL-style rotations keep the tree balanced
+  - rebuild() reloads every leaf top-down (median split on the longest axis) for bulk or static
+    content; proxies stay valid
+  - Frustum queries stop testing planes below nodes entirely inside; leaves report on their
+    own bounds, never the fat ones
+  - Scene keeps one over its meshes, refitted from transform dirty flags (updateSpatialIndex)
+*/
+
+namespace blkhurst {
+
+class Object3D;
+
+class SpatialIndex {
+public:
+  static constexpr int kNull = -1;
+  static constexpr float kMarginFraction = 0.1F; // Fat box growth per side, of the largest extent
+  static constexpr float kMinMargin = 1e-3F;
+
+  [[nodiscard]] int insert(const Aabb& bounds, Object3D* object);
+  // Many at once: leaves are added without incremental insertion, then the tree is rebuilt.
+  // proxies receives one id per object
+  void insert(std::span<const Aabb> bounds, std::span<Object3D* const> objects,
+              std::span<int> proxies);
+  void remove(int proxy);
+  // True when the leaf had to be reinserted (bounds left the fat box, or it became far too loose)
+  bool move(int proxy, const Aabb& bounds);
+  void rebuild();
+  void clear();
+
+  [[nodiscard]] Object3D* object(int proxy) const;
+  [[nodiscard]] const Aabb& bounds(int proxy) const;
+  [[nodiscard]] const Aabb& fatBounds(int proxy) const;
+  [[nodiscard]] std::size_t size() const; // Proxies
+  [[nodiscard]] int height() const;       // 0 for a single leaf, -1 when empty
+
+  // visit(Object3D*, proxy) per overlapping leaf
+  template <typename Visit> void query(const Aabb& box, Visit&& visit) const;
+  template <typename Visit> void query(const Frustum& frustum, Visit&& visit) const;
+  template <typename Visit>
+  void querySphere(const glm::vec3& center, float radius, Visit&& visit) const;
+
+private:
+  struct Node {
+    Aabb fat;   // Leaves: tree bounds. Interior: union of the children
+    Aabb tight; // Leaves only
+    Object3D* object = nullptr;
+    int parent = kNull; // Next free node while on the free list
+    int child1 = kNull;
+    int child2 = kNull;
+    int height = -1; // 0 for leaves; -1 while free
+
+    [[nodiscard]] bool leaf() const {
+      return child1 == kNull;
+    }
+  };
+
+  int allocateLeaf_(const Aabb& bounds, Object3D* object);
+  int allocateNode_();
+  void freeNode_(int index);
+  void insertLeaf_(int leaf);
+  void removeLeaf_(int leaf);
+  void refitUpwards_(int index);
+  int balance_(int index);
+  int buildTopDown_(std::vector<int>& leaves, std::size_t begin, std::size_t end);
+  static Aabb fatten_(const Aabb& bounds, float scale);
+
+  // Shared descent; overlapsNode(fat) prunes, acceptsLeaf(tight) reports
+  template <typename Overlaps, typename Accepts, typename Visit>
+  void descend_(Overlaps&& overlapsNode, Accepts&& acceptsLeaf, Visit&& visit) const;
+
+  std::vector<Node> nodes_;
+  int root_ = kNull;
+  int freeList_ = kNull;
+  std::size_t proxyCount_ = 0;
+};
+
+template <typename Overlaps, typename Accepts, typename Visit>
+void SpatialIndex::descend_(Overlaps&& overlapsNode, Accepts&& acceptsLeaf, Visit&& visit) const {
+  if (root_ == kNull) {
+    return;
+  }
+  std::vector<int> stack;
+  stack.reserve(64);
+  stack.push_back(root_);
+  while (!stack.empty()) {
+    const int index = stack.back();
+    stack.pop_back();
+    const Node& node = nodes_[index];
+    if (node.leaf()) {
+      if (acceptsLeaf(node.tight)) {
+        visit(node.object, index);
+      }
+      continue;
+    }
+    if (overlapsNode(node.fat)) {
+      stack.push_back(node.child1);
+      stack.push_back(node.child2);
+    }
+  }
+}
+
+template <typename Visit> void SpatialIndex::query(const Aabb& box, Visit&& visit) const {
+  auto overlaps = [&](const Aabb& bounds) { return bounds.overlaps(box); };
+  descend_(overlaps, overlaps, visit);
+}
+
+template <typename Visit>
+void SpatialIndex::querySphere(const glm::vec3& center, float radius, Visit&& visit) const {
+  auto overlaps = [&](const Aabb& bounds) {
+    const glm::vec3 offset = glm::clamp(center, bounds.min, bounds.max) - center;
+    return glm::dot(offset, offset) <= radius * radius;
+  };
+  descend_(overlaps, overlaps, visit);
+}
+
+template <typename Visit> void SpatialIndex::query(const Frustum& frustum, Visit&& visit) const {
+  if (root_ == kNull) {
+    return;
+  }
+  // (node, entirely inside): inside subtrees report without further plane tests
+  std::vector<std::pair<int, bool>> stack;
+  stack.reserve(64);
+  stack.emplace_back(root_, false);
+  while (!stack.empty()) {
+    const auto [index, inside] = stack.back();
+    stack.pop_back();
+    const Node& node = nodes_[index];
+    if (node.leaf()) {
+      if (inside || frustum.intersectsBox(node.tight.min, node.tight.max)) {
+        visit(node.object, index);
+      }
+      continue;
+    }
+    bool childrenInside = inside;
+    if (!inside) {
+      if (!frustum.intersectsBox(node.fat.min, node.fat.max)) {
+        continue;
+      }
+      childrenInside = frustum.containsBox(node.fat.min, node.fat.max);
+    }
+    stack.emplace_back(node.child1, childrenInside);
+    stack.emplace_back(node.child2, childrenInside);
+  }
+}
+
+} // namespace blkhurst
@@ -39,6 +39,7 @@ void main() {
 
   vec4 toneMapped = toneMapping(accumulated);
   FragColor = linearToOutput(toneMapped);
+  FragObjectId = uint(uObjectId);
 }
 
 )GLSL";
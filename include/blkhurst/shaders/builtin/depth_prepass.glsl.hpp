@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+
+namespace blkhurst::shaders {
+
+// Renderer depth pre-pass; positions only. gl_Position is computed exactly as io_vertex does and
+// both are invariant, so the shading pass meets the same depths
+inline const std::string depth_prepass_vert = R"GLSL(
+
+layout(location = 0) in vec3 aPosition;
+
+// Vertex pulling (VertexPool); position is the first 3 of 8 floats
+layout(std430, binding = 4) readonly buffer PulledVertices {
+  float pulledVertices[];
+};
+uniform bool uVertexPulling;
+
+uniform mat4 uModel;
+uniform mat4 uView;
+uniform mat4 uProjection;
+
+invariant gl_Position;
+
+void main() {
+  vec3 position = aPosition;
+  if (uVertexPulling) {
+    int base = gl_VertexID * 8;
+    position = vec3(pulledVertices[base], pulledVertices[base + 1], pulledVertices[base + 2]);
+  }
+  vec4 worldPosition = uModel * vec4(position, 1.0);
+  vec4 viewPosition = uView * worldPosition;
+  gl_Position = uProjection * viewPosition;
+}
+
+)GLSL";
+
+inline const std::string depth_prepass_frag = R"GLSL(
+
+void main() {
+}
+
+)GLSL";
+
+} // namespace blkhurst::shaders
@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+
+namespace blkhurst::shaders {
+
+// Renderer occlusion queries; a unit cube scaled onto world bounds, depth test only
+inline const std::string occlusion_box_vert = R"GLSL(
+
+layout(location = 0) in vec3 aPosition;
+
+uniform mat4 uModel;
+uniform mat4 uView;
+uniform mat4 uProjection;
+
+void main() {
+  gl_Position = uProjection * uView * uModel * vec4(aPosition, 1.0);
+}
+
+)GLSL";
+
+inline const std::string occlusion_box_frag = R"GLSL(
+
+void main() {
+}
+
+)GLSL";
+
+} // namespace blkhurst::shaders
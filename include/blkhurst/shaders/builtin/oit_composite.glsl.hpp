@@ -0,0 +1,28 @@
+#pragma once
+#include <string>
+
+namespace blkhurst::shaders {
+
+// Resolves the weighted blended transparency pass over the opaque result; drawn with the usual
+// SrcAlpha/OneMinusSrcAlpha blend, so alpha carries the coverage (one minus revealage)
+inline const std::string oit_composite_frag = R"GLSL(
+
+#include "io_fragment"
+
+uniform sampler2D uAccumulation;
+uniform sampler2D uRevealage;
+
+void main() {
+  float revealage = texture(uRevealage, vUv).r;
+  if (revealage >= 1.0) {
+    discard; // Nothing transparent here
+  }
+  vec4 accumulation = texture(uAccumulation, vUv);
+  vec3 average = accumulation.rgb / clamp(accumulation.a, 1e-4, 5e4);
+  FragColor = vec4(average, 1.0 - revealage);
+  FragObjectId = 0u; // Masked off by the Renderer
+}
+
+)GLSL";
+
+} // namespace blkhurst::shaders
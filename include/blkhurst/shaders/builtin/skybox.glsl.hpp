@@ -29,7 +29,8 @@ inline const std::string skybox_frag = R"GLSL(
 #include "tonemapping_fragment"
 #include "colorspace_fragment"
 
-out vec4 FragColor;
+layout(location = 0) out vec4 FragColor;
+layout(location = 7) out uint FragObjectId; // Background picks as nothing
 
 in vec3 vPosition;
 
@@ -46,6 +47,7 @@ void main() {
 
   vec4 toneMapped = toneMapping(sampleColor);
   FragColor = linearToOutput(toneMapped);
+  FragObjectId = 0u;
 }
 
 )GLSL";
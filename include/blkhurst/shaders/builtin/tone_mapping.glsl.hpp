@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+
+namespace blkhurst::shaders {
+
+// Renderer scene target resolve (setToneMappingPass, setDynamicResolution): bilinear upscale of
+// the rendered region, then tone mapping and output colour space once per pixel
+inline const std::string tone_mapping_frag = R"GLSL(
+
+#include "io_fragment"
+#include "tonemapping_fragment"
+#include "colorspace_fragment"
+
+uniform sampler2D uSceneColor;
+uniform vec4 uSourceRegion; // Rendered region of uSceneColor: offset, size (texture coordinates)
+uniform vec2 uSourceTexel;  // 1 / texture size
+
+void main() {
+  // Half a texel inside the region, so the unrendered rest of the target never bleeds in
+  vec2 uv = uSourceRegion.xy + vUv * uSourceRegion.zw;
+  uv = clamp(uv, uSourceRegion.xy + 0.5 * uSourceTexel,
+             uSourceRegion.xy + uSourceRegion.zw - 0.5 * uSourceTexel);
+  vec4 linear = texture(uSceneColor, uv);
+  vec4 toneMapped = toneMapping(linear);
+  FragColor = linearToOutput(toneMapped);
+  FragObjectId = 0u;
+}
+
+)GLSL";
+
+} // namespace blkhurst::shaders
@@ -5,11 +5,13 @@ namespace blkhurst::shaders {
 
 inline const std::string colorspace_fragment = R"GLSL(
 
+#ifndef TONE_MAPPING_PASS
 uniform int uOutputColorSpace;
 
 // OutputColorSpace Enum
 const int kOutputColorSpace_Linear = 0;
 const int kOutputColorSpace_SRGB = 1;
+#endif
 
 vec4 sRGBToLinear(in vec4 srgb) {
   bvec3 cutoff = lessThanEqual(srgb.rgb, vec3(0.04045));
@@ -25,6 +27,12 @@ vec4 linearToSRGB(in vec4 linear) {
   return vec4(mix(high, low, cutoff), linear.a);
 }
 
+#ifdef TONE_MAPPING_PASS
+// Renderer::setToneMappingPass converts once per pixel
+vec4 linearToOutput(vec4 linear) {
+  return linear;
+}
+#else
 vec4 linearToOutput(vec4 linear) {
   if (uOutputColorSpace == kOutputColorSpace_Linear)
     return linear;
@@ -33,6 +41,7 @@ vec4 linearToOutput(vec4 linear) {
 
   return linear; // Fallback
 }
+#endif
 
 )GLSL";
 
@@ -5,8 +5,35 @@ namespace blkhurst::shaders {
 
 inline const std::string io_fragment = R"GLSL(
 
+#ifdef WEIGHTED_BLENDED_OIT
+// Renderer weighted blended transparency pass (McGuire & Bavoil 2013). This main() wraps the
+// material's own, renamed by the define below, and turns its FragColor into weighted premultiplied
+// accumulation (attachment 0, blended One/One) and revealage (attachment 1, Zero/OneMinusSrcColor)
+layout(location = 0) out vec4 OitAccumulation;
+layout(location = 1) out float OitRevealage;
+vec4 FragColor;
+uint FragObjectId; // Transparent surfaces are not pickable in this pass
+
+void oitMaterialMain();
+
+void main() {
+  oitMaterialMain();
+  float alpha = clamp(FragColor.a, 0.0, 1.0);
+  // Depth weight (eq. 10 of the paper on window depth), bounded to stay within half floats
+  float coverage = pow(min(1.0, alpha * 10.0) + 0.01, 3.0);
+  float depth = pow(1.0 - gl_FragCoord.z * 0.9, 3.0);
+  float weight = clamp(coverage * 1e8 * depth, 1e-2, 3e3);
+  OitAccumulation = vec4(FragColor.rgb * alpha, alpha) * weight;
+  OitRevealage = alpha;
+}
+
+#define main oitMaterialMain
+#else
 // TODO: Extract when adding MRT (Multiple Render Target) support
 layout(location = 0) out vec4 FragColor;
+// RenderTarget::kObjectIdLocation; discarded unless the target has an object id attachment
+layout(location = 7) out uint FragObjectId;
+#endif
 
 in vec2 vUv;
 in vec4 vColor;
@@ -21,8 +21,30 @@ out vec3 vWorldPosition;
 out vec3 vViewPosition;
 out vec4 vInstanceColor;
 
+// Depth pre-pass positions must match bit for bit (depth_prepass_vert)
+invariant gl_Position;
+
 uniform mat3 uUvTransform;
 
+// Vertex pulling (VertexPool); 8 floats per vertex, gl_VertexID includes the base vertex
+layout(std430, binding = 4) readonly buffer PulledVertices {
+  float pulledVertices[];
+};
+uniform bool uVertexPulling;
+
+void fetchVertex(out vec3 position, out vec3 normal, out vec2 uv) {
+  if (uVertexPulling) {
+    int base = gl_VertexID * 8;
+    position = vec3(pulledVertices[base], pulledVertices[base + 1], pulledVertices[base + 2]);
+    normal = vec3(pulledVertices[base + 3], pulledVertices[base + 4], pulledVertices[base + 5]);
+    uv = vec2(pulledVertices[base + 6], pulledVertices[base + 7]);
+  } else {
+    position = aPosition;
+    normal = aNormal;
+    uv = aUv;
+  }
+}
+
 // Extract to uv_vertex when supporting multiple maps
 vec2 computeUv(vec2 uv) {
 #ifdef USE_UV_TRANSFORM
@@ -39,16 +61,21 @@ void io_vertex(in mat4 model, in mat4 view, in mat4 projection) {
   model = model;
 #endif
 
+  vec3 position;
+  vec3 normal;
+  vec2 uv;
+  fetchVertex(position, normal, uv);
+
   // Positions
-  vec4 worldPosition = model * vec4(aPosition, 1.0);
+  vec4 worldPosition = model * vec4(position, 1.0);
   vec4 viewPosition = view * worldPosition;
 
   // Normals
   mat3 worldNormalMatrix = mat3(transpose(inverse(model)));
-  vec3 worldNormal = normalize(worldNormalMatrix * aNormal);
+  vec3 worldNormal = normalize(worldNormalMatrix * normal);
 
   // Out
-  vUv = computeUv(aUv);
+  vUv = computeUv(uv);
   vColor = aColor;
   vWorldPosition = worldPosition.xyz;
   vViewPosition = viewPosition.xyz;
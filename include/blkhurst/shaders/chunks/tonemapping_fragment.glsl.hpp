@@ -5,6 +5,16 @@ namespace blkhurst::shaders {
 
 inline const std::string tonemapping_fragment = R"GLSL(
 
+#ifdef TONE_MAPPING_PASS
+// Renderer::setToneMappingPass: materials output linear HDR, tone mapped once per pixel later
+vec3 toneMapping(vec3 linearRGB) {
+  return linearRGB;
+}
+
+vec4 toneMapping(vec4 linearRGBA) {
+  return linearRGBA;
+}
+#else
 uniform int uToneMappingMode;
 uniform float uToneMappingExposure;
 
@@ -91,6 +101,7 @@ vec4 toneMapping(vec4 linearRGBA) {
   vec3 mapped = toneMapping(linearRGBA.rgb);
   return vec4(mapped, linearRGBA.a);
 }
+#endif
 
 
 )GLSL";
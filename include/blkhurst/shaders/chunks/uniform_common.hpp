@@ -19,6 +19,7 @@ uniform bool uIsOrthographic;
 
 // DrawUniforms
 uniform mat4 uModel;
+uniform int uObjectId; // Renderer::objectIds() index + 1; 0 for none
 
 )GLSL";
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <blkhurst/util/handle.hpp>
 #include <cstdint>
 #include <memory>
 
@@ -25,6 +26,8 @@ enum class TextureFormat : std::uint8_t {
   SRGB8,
   SRGB8_ALPHA8,
 
+  R32UI, // Unsigned integer (object ids); Nearest filtering only
+
   Depth16,
   Depth24,
   Depth32F,
@@ -44,7 +47,7 @@ struct TextureDesc {
   bool generateMipmaps = true;
 };
 
-class Texture {
+class Texture : public Handled<Texture> {
 public:
   Texture(int width, int height, const TextureDesc& desc);
   virtual ~Texture();
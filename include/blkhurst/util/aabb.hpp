@@ -0,0 +1,42 @@
+#pragma once
+
+#include <algorithm>
+#include <glm/glm.hpp>
+#include <limits>
+
+namespace blkhurst {
+
+// Axis-aligned box; default constructed empty (min > max) so expand() works from nothing
+struct Aabb {
+  glm::vec3 min{std::numeric_limits<float>::max()};
+  glm::vec3 max{std::numeric_limits<float>::lowest()};
+
+  void expand(const glm::vec3& point);
+  void expand(const Aabb& box);
+
+  [[nodiscard]] bool empty() const;
+  [[nodiscard]] glm::vec3 center() const;
+  [[nodiscard]] glm::vec3 extent() const;
+  [[nodiscard]] float surfaceArea() const;
+  [[nodiscard]] bool overlaps(const Aabb& box) const;
+  [[nodiscard]] bool contains(const Aabb& box) const;
+  // Bounds of the eight transformed corners
+  [[nodiscard]] Aabb transformed(const glm::mat4& matrix) const;
+
+  // Slab test against [0, tMax]; invDirection = 1 / ray direction. Inline for BVH traversal
+  [[nodiscard]] bool intersect(const glm::vec3& origin, const glm::vec3& invDirection, float tMax,
+                               float& tEntry) const {
+    float entry = 0.0F;
+    float exit = tMax;
+    for (int axis = 0; axis < 3; ++axis) {
+      const float t0 = (min[axis] - origin[axis]) * invDirection[axis];
+      const float t1 = (max[axis] - origin[axis]) * invDirection[axis];
+      entry = std::max(entry, std::min(t0, t1));
+      exit = std::min(exit, std::max(t0, t1));
+    }
+    tEntry = entry;
+    return entry <= exit;
+  }
+};
+
+} // namespace blkhurst
@@ -0,0 +1,16 @@
+#pragma once
+
+#include <cstdint>
+
+/**
+ * Global heap allocation counter.
+ *  - Built with BLKHURST_TRACK_ALLOCATIONS, the library replaces global operator new/delete and
+ *    counts every allocation; the Engine then asserts steady-state frames allocate nothing.
+ *  - Otherwise enabled() is false and count() is always 0.
+ */
+namespace blkhurst::allocation_counter {
+
+[[nodiscard]] bool enabled();
+[[nodiscard]] std::uint64_t count();
+
+} // namespace blkhurst::allocation_counter
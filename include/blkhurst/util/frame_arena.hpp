@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <vector>
+
+namespace blkhurst {
+
+/**
+ * Per-frame linear (bump) allocator, usable as a std::pmr::memory_resource.
+ *  - reset() at the start of each frame invalidates everything allocated from it.
+ *  - Deallocation is a no-op; memory is reclaimed by reset().
+ *  - When a frame overflows the block, extra blocks come from the upstream resource and the
+ *    next reset() grows the block to the frame's high-water mark, so steady state is heap-free.
+ *  - Not thread-safe; owned by the Engine and used on the main thread (RootState::frameArena).
+ */
+class FrameArena : public std::pmr::memory_resource {
+public:
+  explicit FrameArena(std::size_t initialCapacity,
+                      std::pmr::memory_resource* upstream = std::pmr::new_delete_resource());
+  ~FrameArena() override;
+
+  FrameArena(const FrameArena&) = delete;
+  FrameArena& operator=(const FrameArena&) = delete;
+  FrameArena(FrameArena&&) = delete;
+  FrameArena& operator=(FrameArena&&) = delete;
+
+  void reset();
+
+  [[nodiscard]] std::size_t bytesUsed() const;
+  [[nodiscard]] std::size_t capacity() const;
+  [[nodiscard]] std::size_t highWaterMark() const;
+
+private:
+  struct Block {
+    std::byte* data = nullptr;
+    std::size_t size = 0;
+  };
+
+  std::pmr::memory_resource* upstream_;
+  Block block_;
+  std::size_t offset_ = 0;
+
+  // Overflow blocks for the current frame, released (and folded into block_) on reset()
+  std::vector<Block> overflow_;
+  std::size_t overflowOffset_ = 0;
+  std::size_t frameBytes_ = 0;
+  std::size_t highWater_ = 0;
+
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override;
+  [[nodiscard]] bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override;
+
+  static void* bump_(Block& block, std::size_t& offset, std::size_t bytes, std::size_t alignment);
+};
+
+} // namespace blkhurst
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <array>
+#include <glm/glm.hpp>
+
+namespace blkhurst {
+
+// Six normalised planes (xyz normal, w distance); inside when dot(n, p) + w >= 0
+struct Frustum {
+  std::array<glm::vec4, 6> planes{};
+
+  // Planes of a clip-space matrix; pass projection * view * model for object-space planes
+  static Frustum fromMatrix(const glm::mat4& clip);
+
+  [[nodiscard]] bool intersectsSphere(const glm::vec3& center, float radius) const;
+  [[nodiscard]] bool intersectsBox(const glm::vec3& min, const glm::vec3& max) const;
+  // Entirely inside every plane; hierarchical culling skips the subtree's tests
+  [[nodiscard]] bool containsBox(const glm::vec3& min, const glm::vec3& max) const;
+};
+
+} // namespace blkhurst
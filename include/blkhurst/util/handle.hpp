@@ -0,0 +1,154 @@
+#pragma once
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+/**
+ * Generation-checked resource handles.
+ *  - Handle<T>: 32 bits (20-bit slot index, 12-bit generation); 0 is the null handle.
+ *  - HandlePool<T>::get() returns nullptr once the resource is destroyed, even if the slot
+ *    has been reused (until the generation wraps after 4095 reuses of that slot).
+ *  - Handled<T>: base that registers `this` for the resource lifetime (Geometry, Material,
+ *    Texture, Program). Ownership stays with the user's shared_ptr; handles never own.
+ *  - Keys for caches that must not confuse a destroyed resource with a later one at the same
+ *    address (Renderer occluder sources).
+ *  - The pool is locked; Material and Program may be created off the GL thread.
+ */
+
+namespace blkhurst {
+
+template <class T> class Handle {
+public:
+  static constexpr std::uint32_t kIndexBits = 20;
+  static constexpr std::uint32_t kIndexMask = (1U << kIndexBits) - 1U;
+  static constexpr std::uint32_t kGenerationMask = (1U << (32U - kIndexBits)) - 1U;
+
+  Handle() = default;
+  Handle(std::uint32_t index, std::uint32_t generation)
+      : value_((generation << kIndexBits) | (index & kIndexMask)) {
+  }
+
+  [[nodiscard]] std::uint32_t index() const {
+    return value_ & kIndexMask;
+  }
+  [[nodiscard]] std::uint32_t generation() const {
+    return value_ >> kIndexBits;
+  }
+  [[nodiscard]] std::uint32_t value() const {
+    return value_;
+  }
+  [[nodiscard]] bool valid() const {
+    return value_ != 0U;
+  }
+
+  bool operator==(const Handle&) const = default;
+
+private:
+  std::uint32_t value_ = 0U;
+};
+
+template <class T> class HandlePool {
+public:
+  static HandlePool& instance() {
+    static HandlePool pool;
+    return pool;
+  }
+
+  Handle<T> acquire(T* resource) {
+    std::scoped_lock lock(mutex_);
+    std::uint32_t index = 0;
+    if (!freeSlots_.empty()) {
+      index = freeSlots_.back();
+      freeSlots_.pop_back();
+    } else {
+      index = static_cast<std::uint32_t>(slots_.size());
+      assert(index <= Handle<T>::kIndexMask && "HandlePool slot index overflow");
+      slots_.push_back({});
+    }
+    slots_[index].resource = resource;
+    return {index, slots_[index].generation};
+  }
+
+  void release(Handle<T> handle) {
+    std::scoped_lock lock(mutex_);
+    if (get_(handle) == nullptr) {
+      return;
+    }
+    auto& slot = slots_[handle.index()];
+    slot.resource = nullptr;
+    // Generation 0 is reserved so a live handle is never 0
+    slot.generation = (slot.generation % Handle<T>::kGenerationMask) + 1U;
+    freeSlots_.push_back(handle.index());
+  }
+
+  [[nodiscard]] T* get(Handle<T> handle) const {
+    std::scoped_lock lock(mutex_);
+    return get_(handle);
+  }
+
+  [[nodiscard]] std::size_t liveCount() const {
+    std::scoped_lock lock(mutex_);
+    return slots_.size() - freeSlots_.size();
+  }
+
+private:
+  struct Slot {
+    T* resource = nullptr;
+    std::uint32_t generation = 1U;
+  };
+
+  mutable std::mutex mutex_;
+  std::vector<Slot> slots_;
+  std::vector<std::uint32_t> freeSlots_;
+
+  [[nodiscard]] T* get_(Handle<T> handle) const {
+    const auto index = handle.index();
+    if (!handle.valid() || index >= slots_.size()) {
+      return nullptr;
+    }
+    const auto& slot = slots_[index];
+    return slot.generation == handle.generation() ? slot.resource : nullptr;
+  }
+};
+
+// CRTP base; registers the derived resource for its lifetime
+template <class T> class Handled {
+public:
+  [[nodiscard]] Handle<T> handle() const {
+    return handle_;
+  }
+
+  // nullptr if the resource has been destroyed
+  static T* fromHandle(Handle<T> handle) {
+    return HandlePool<T>::instance().get(handle);
+  }
+
+protected:
+  Handled()
+      : handle_(HandlePool<T>::instance().acquire(static_cast<T*>(this))) {
+  }
+  ~Handled() {
+    HandlePool<T>::instance().release(handle_);
+  }
+
+public:
+  Handled(const Handled&) = delete;
+  Handled& operator=(const Handled&) = delete;
+  Handled(Handled&&) = delete;
+  Handled& operator=(Handled&&) = delete;
+
+private:
+  Handle<T> handle_;
+};
+
+} // namespace blkhurst
+
+template <class T> struct std::hash<blkhurst::Handle<T>> {
+  std::size_t operator()(blkhurst::Handle<T> handle) const noexcept {
+    return std::hash<std::uint32_t>{}(handle.value());
+  }
+};
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+namespace blkhurst {
+
+// Hit distances are in units of direction; normalise it for world-space distances
+struct Ray {
+  glm::vec3 origin{0.0F};
+  glm::vec3 direction{0.0F, 0.0F, -1.0F};
+
+  [[nodiscard]] glm::vec3 at(float distance) const {
+    return origin + (direction * distance);
+  }
+};
+
+} // namespace blkhurst
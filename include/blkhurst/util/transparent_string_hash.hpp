@@ -0,0 +1,19 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string_view>
+
+namespace blkhurst {
+
+// Heterogeneous lookup for std::string keys: with std::equal_to<>, find() takes a string_view or
+// a literal without building a std::string
+struct TransparentStringHash {
+  using is_transparent = void;
+
+  std::size_t operator()(std::string_view text) const {
+    return std::hash<std::string_view>{}(text);
+  }
+};
+
+} // namespace blkhurst
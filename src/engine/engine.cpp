@@ -1,6 +1,7 @@
 #include "engine/clock.hpp"
 #include "logging/logger.hpp"
 #include "scene/scene_manager.hpp"
+#include "scene/update_system.hpp"
 #include "ui/ui_manager.hpp"
 #include "window/glfw_callbacks.hpp"
 #include "window/window_manager.hpp"
@@ -10,13 +11,23 @@
 #include <blkhurst/events/event_bus.hpp>
 #include <blkhurst/events/events.hpp>
 #include <blkhurst/input/input.hpp>
+#include <blkhurst/jobs/job_system.hpp>
 #include <blkhurst/renderer/renderer.hpp>
 #include <blkhurst/renderer/uniform_blocks.hpp>
 #include <blkhurst/shaders/shader_registry.hpp>
+#include <blkhurst/util/allocation_counter.hpp>
 #include <blkhurst/util/assets.hpp>
+#include <blkhurst/util/frame_arena.hpp>
 
+#include <cassert>
 #include <spdlog/spdlog.h>
 #include <spdlog/stopwatch.h>
+#include <thread>
+
+namespace {
+constexpr std::size_t kFrameArenaBytes = 256 * 1024; // Grows to the high-water mark if exceeded
+constexpr int kAllocationWarmupFrames = 120;         // Frames after start/scene change not checked
+} // namespace
 
 namespace blkhurst {
 
@@ -25,6 +36,9 @@ class Engine::Impl {
 public:
   explicit Impl(const EngineConfig& cfg)
       : config_(cfg),
+        jobs_(resolveWorkerCount(cfg.threadingConfig)),
+        frameArena_(kFrameArenaBytes),
+        updates_(jobs_, cfg.threadingConfig.parallelUpdate, cfg.updateConfig),
         window_(cfg.windowConfig),
         ui_(cfg.uiConfig, events_, window_),
         input_(events_) {
@@ -37,17 +51,29 @@ public:
     // Trigger FramebufferResized Event; Set Renderers Default Framebuffer Size
     auto windowFramebufferSize = window_.getFramebufferResolution();
     input_.pushFramebufferSize(windowFramebufferSize.width, windowFramebufferSize.height);
+
+    renderer_.setFrameArena(&frameArena_);
+    renderer_.setJobSystem(&jobs_);
   }
 
   void run() {
     while (!window_.shouldClose()) {
+      // Frame-scoped temporaries from the previous frame are released here
+      frameArena_.reset();
+      checkFrameAllocations();
+      renderer_.resetStats();
+
       // Poll Events & Input
       input_.beginFrame();
       window_.pollEvents();
       input_.endFrame();
 
+      // Completions from background jobs (e.g. async texture uploads)
+      jobs_.runMainThreadTasks();
+
       // Gather Frame State
       const auto tick = clock_.tick();
+      renderer_.updateDynamicResolution(tick.ms);
       auto* currentScene = scene_.currentScene();
       bool availableScene = (currentScene != nullptr);
       auto* currentCamera = availableScene ? currentScene->activeCamera() : nullptr;
@@ -74,8 +100,11 @@ public:
       auto frameUniforms = buildFrameUniforms(input_, tick, currentCamera);
       renderer_.setFrameUniforms(frameUniforms);
 
+      // Software occlusion rasterises on workers while the scene updates
+      renderer_.prepareSoftwareOcclusion(*currentScene, *currentCamera);
+
       // Update Scene (May call renderer.render)
-      currentScene->traverse([&](Object3D& node) { node.onUpdate(rootState); });
+      updates_.update(*currentScene, rootState);
 
       // Render
       renderer_.render(*currentScene, *currentCamera);
@@ -94,11 +123,14 @@ public:
         .fps = tick.fps,
         .ms = tick.ms,
         .windowFramebufferSize = input_.framebufferSize(),
+        .resolutionScale = renderer_.resolutionScale(),
         .renderer = &renderer_,
         .camera = currentCam,
         .input = &input_,
         .scene = currentScene,
         .events = &events_,
+        .jobs = &jobs_,
+        .frameArena = &frameArena_,
         .currentSceneIndex = scene_.currentIndex(),
         .sceneNames = scene_.names(),
     };
@@ -131,14 +163,37 @@ public:
     ui_.endFrame();
   }
 
+  // BLKHURST_TRACK_ALLOCATIONS: steady-state frames (previous frame, start to start) must not
+  // touch the global heap
+  void checkFrameAllocations() {
+    if (!allocation_counter::enabled()) {
+      return;
+    }
+    const auto count = allocation_counter::count();
+    const auto frameAllocations = count - lastAllocationCount_;
+    lastAllocationCount_ = count;
+    if (allocationWarmup_ > 0) {
+      --allocationWarmup_;
+      return;
+    }
+    if (frameAllocations != 0) {
+      spdlog::error("Engine frame performed {} heap allocations", frameAllocations);
+      assert(frameAllocations == 0 && "steady-state frame allocated");
+      allocationWarmup_ = kAllocationWarmupFrames; // Do not re-report the logging allocations
+    }
+  }
+
   void registerSceneFactory(const std::string& name,
                             std::function<std::unique_ptr<Scene>()> factory) {
     scene_.registerFactory(name, std::move(factory));
   }
 
 private:
-  // Initialisation order (ui_ must be after window_)
+  // Initialisation order (ui_ must be after window_, updates_ after jobs_)
   EngineConfig config_;
+  JobSystem jobs_;
+  FrameArena frameArena_;
+  UpdateSystem updates_;
   Clock clock_;
   EventBus events_;
   WindowManager window_;
@@ -149,11 +204,15 @@ private:
 
   std::vector<Subscription> subscriptions_;
 
+  std::uint64_t lastAllocationCount_ = 0;
+  int allocationWarmup_ = kAllocationWarmupFrames;
+
   void registerEvents() {
     using namespace events;
     on<SceneChange>([this](const SceneChange& scene) {
       renderer_.resetState();
       scene_.setScene(scene.index);
+      allocationWarmup_ = kAllocationWarmupFrames; // Scene construction allocates
     });
     on<ToggleFullscreen>(
         [this](const ToggleFullscreen& fullscreen) { window_.useFullscreen(fullscreen.enabled); });
@@ -162,6 +221,14 @@ private:
     });
   }
 
+  static int resolveWorkerCount(const ThreadingConfig& threading) {
+    if (threading.workerThreads >= 0) {
+      return threading.workerThreads;
+    }
+    const int hardwareThreads = static_cast<int>(std::thread::hardware_concurrency());
+    return std::max(0, hardwareThreads - 1); // Main thread participates
+  }
+
   // registerEvents helper
   template <class T, class Fn> void on(Fn&& callback) {
     subscriptions_.push_back(events_.subscribe<T>(std::forward<Fn>(callback)));
@@ -20,18 +20,20 @@ bool EventBus::unsubscribe(std::type_index type, std::uint64_t listenerId) {
     return false;
   }
 
-  // Iterate listeners and remove by id
-  auto& listeners = foundType->second;
+  // Copy listeners and remove by id; in-flight posts keep the previous list
+  auto listeners = std::make_shared<ListenerList>(*foundType->second);
   const auto removed = std::erase_if(
-      listeners, [listenerId](const Listener& listener) { return listener.id == listenerId; });
+      *listeners, [listenerId](const Listener& listener) { return listener.id == listenerId; });
 
   if (removed == 0) {
     return false;
   }
 
   // Drop the type key if no listeners remain
-  if (listeners.empty()) {
+  if (listeners->empty()) {
     listenersByType_.erase(foundType);
+  } else {
+    foundType->second = std::move(listeners);
   }
 
   spdlog::trace("EventBus unsubscribed id={} type={}", listenerId, type.name());
@@ -41,14 +43,14 @@ bool EventBus::unsubscribe(std::type_index type, std::uint64_t listenerId) {
 std::size_t EventBus::listenerCount(std::type_index type) const {
   std::scoped_lock lock(mutex_);
   auto foundType = listenersByType_.find(type);
-  return (foundType == listenersByType_.end()) ? 0U : foundType->second.size();
+  return (foundType == listenersByType_.end()) ? 0U : foundType->second->size();
 }
 
 std::size_t EventBus::totalListenerCount() const {
   std::scoped_lock lock(mutex_);
   std::size_t total = 0;
   for (const auto& typeAndListener : listenersByType_) {
-    total += typeAndListener.second.size();
+    total += typeAndListener.second->size();
   }
   return total;
 }
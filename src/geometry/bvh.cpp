@@ -0,0 +1,316 @@
+#include <blkhurst/geometry/bvh.hpp>
+#include <blkhurst/jobs/job_system.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace {
+using blkhurst::Aabb;
+using blkhurst::Bvh;
+using blkhurst::BvhNode;
+
+constexpr int kBins = 12;
+constexpr float kTraversalCost = 1.0F; // Relative to one primitive test
+
+struct BuildInput {
+  std::span<const Aabb> bounds;
+  std::vector<glm::vec3> centroids;
+  std::span<std::uint32_t> primitives; // Partitioned in place; subtrees own disjoint ranges
+};
+
+// Deferred subtree; built into its own node list, root first
+struct Subtree {
+  std::uint32_t node = 0;
+  std::uint32_t begin = 0;
+  std::uint32_t end = 0;
+  int depth = 0;
+  std::vector<BvhNode> nodes;
+};
+
+struct Split {
+  int axis = -1;
+  int bin = 0; // Primitives in bins [0, bin) go left
+  float cost = 0.0F;
+};
+
+int binOf(float centroid, float lo, float scale) {
+  return std::clamp(static_cast<int>((centroid - lo) * scale), 0, kBins - 1);
+}
+
+// Cheapest binned SAH split of [begin, end); axis -1 when the centroids do not separate
+Split findSplit(const BuildInput& input, std::uint32_t begin, std::uint32_t end,
+                const Aabb& centroidBounds, float parentArea) {
+  Split best;
+  best.cost = std::numeric_limits<float>::max();
+  for (int axis = 0; axis < 3; ++axis) {
+    const float lo = centroidBounds.min[axis];
+    const float hi = centroidBounds.max[axis];
+    if (!(hi > lo)) {
+      continue;
+    }
+    const float scale = static_cast<float>(kBins) / (hi - lo);
+
+    Aabb binBounds[kBins]; // NOLINT
+    std::uint32_t binCounts[kBins] = {};  // NOLINT
+    for (std::uint32_t slot = begin; slot < end; ++slot) {
+      const std::uint32_t primitive = input.primitives[slot];
+      const int bin = binOf(input.centroids[primitive][axis], lo, scale);
+      binBounds[bin].expand(input.bounds[primitive]);
+      ++binCounts[bin];
+    }
+
+    // Right-to-left sweep for suffix areas, then left-to-right for the costs
+    float rightArea[kBins] = {};          // NOLINT
+    std::uint32_t rightCount[kBins] = {}; // NOLINT
+    Aabb accumulated;
+    std::uint32_t count = 0;
+    for (int bin = kBins - 1; bin > 0; --bin) {
+      accumulated.expand(binBounds[bin]);
+      count += binCounts[bin];
+      rightArea[bin] = accumulated.surfaceArea();
+      rightCount[bin] = count;
+    }
+    accumulated = {};
+    count = 0;
+    for (int bin = 1; bin < kBins; ++bin) {
+      accumulated.expand(binBounds[bin - 1]);
+      count += binCounts[bin - 1];
+      if (count == 0 || rightCount[bin] == 0) {
+        continue;
+      }
+      const float cost =
+          kTraversalCost + (((accumulated.surfaceArea() * static_cast<float>(count)) +
+                             (rightArea[bin] * static_cast<float>(rightCount[bin]))) /
+                            parentArea);
+      if (cost < best.cost) {
+        best = {axis, bin, cost};
+      }
+    }
+  }
+  return best;
+}
+
+// Fills nodes[nodeIndex] for [begin, end) and appends its descendants. With deferred set,
+// ranges of at most kParallelPrimitives are recorded instead of built
+void buildNode(BuildInput& input, std::vector<BvhNode>& nodes, std::uint32_t nodeIndex,
+               std::uint32_t begin, std::uint32_t end, int depth,
+               std::vector<Subtree>* deferred) {
+  const std::uint32_t count = end - begin;
+  if (deferred != nullptr && count <= Bvh::kParallelPrimitives) {
+    deferred->push_back({nodeIndex, begin, end, depth, {}});
+    return;
+  }
+
+  Aabb bounds;
+  Aabb centroidBounds;
+  for (std::uint32_t slot = begin; slot < end; ++slot) {
+    const std::uint32_t primitive = input.primitives[slot];
+    bounds.expand(input.bounds[primitive]);
+    centroidBounds.expand(input.centroids[primitive]);
+  }
+  nodes[nodeIndex] = {bounds, begin, count};
+  if (count <= 2 || depth >= Bvh::kMaxDepth) {
+    return;
+  }
+
+  const float parentArea = std::max(bounds.surfaceArea(), std::numeric_limits<float>::min());
+  const Split split = findSplit(input, begin, end, centroidBounds, parentArea);
+  std::uint32_t middle = begin;
+  if (split.axis >= 0 && (split.cost < static_cast<float>(count) || count > Bvh::kMaxLeafSize)) {
+    const float lo = centroidBounds.min[split.axis];
+    const float scale = static_cast<float>(kBins) / (centroidBounds.max[split.axis] - lo);
+    auto* first = input.primitives.data() + begin;
+    auto* pivot = std::partition(first, input.primitives.data() + end, [&](std::uint32_t prim) {
+      return binOf(input.centroids[prim][split.axis], lo, scale) < split.bin;
+    });
+    middle = begin + static_cast<std::uint32_t>(pivot - first);
+  } else if (count > Bvh::kMaxLeafSize) {
+    middle = begin + (count / 2); // Coincident centroids; any halving will do
+  } else {
+    return; // Leaf is cheaper than any split
+  }
+
+  const auto left = static_cast<std::uint32_t>(nodes.size());
+  nodes.emplace_back();
+  nodes.emplace_back();
+  nodes[nodeIndex].first = left;
+  nodes[nodeIndex].count = 0;
+  buildNode(input, nodes, left, begin, middle, depth + 1, deferred);
+  buildNode(input, nodes, left + 1, middle, end, depth + 1, deferred);
+}
+} // namespace
+
+namespace blkhurst {
+
+Bvh Bvh::build(std::span<const Aabb> primitiveBounds, JobSystem* jobs) {
+  Bvh bvh;
+  const auto count = static_cast<std::uint32_t>(primitiveBounds.size());
+  if (count == 0) {
+    return bvh;
+  }
+
+  bvh.primitives_.resize(count);
+  for (std::uint32_t primitive = 0; primitive < count; ++primitive) {
+    bvh.primitives_[primitive] = primitive;
+  }
+  BuildInput input{primitiveBounds, std::vector<glm::vec3>(count), bvh.primitives_};
+  for (std::uint32_t primitive = 0; primitive < count; ++primitive) {
+    input.centroids[primitive] = primitiveBounds[primitive].center();
+  }
+
+  // Top levels serially; the remaining subtrees are independent ranges of primitives_
+  std::vector<Subtree> deferred;
+  bvh.nodes_.reserve(static_cast<std::size_t>(count) * 2);
+  bvh.nodes_.emplace_back();
+  const bool parallel = jobs != nullptr && jobs->workerCount() > 0;
+  buildNode(input, bvh.nodes_, 0, 0, count, 0, parallel ? &deferred : nullptr);
+  if (deferred.empty()) {
+    return bvh;
+  }
+
+  auto buildSubtree = [&input](Subtree& subtree) {
+    subtree.nodes.reserve(static_cast<std::size_t>(subtree.end - subtree.begin) * 2);
+    subtree.nodes.emplace_back();
+    buildNode(input, subtree.nodes, 0, subtree.begin, subtree.end, subtree.depth, nullptr);
+  };
+  jobs->parallelFor(deferred.size(), [&](std::size_t index) { buildSubtree(deferred[index]); });
+
+  // Stitch: subtree root into its reserved slot, the rest appended with shifted child indices
+  for (auto& subtree : deferred) {
+    const auto offset = static_cast<std::uint32_t>(bvh.nodes_.size()) - 1;
+    auto relocate = [offset](BvhNode node) {
+      if (!node.leaf()) {
+        node.first += offset;
+      }
+      return node;
+    };
+    bvh.nodes_[subtree.node] = relocate(subtree.nodes.front());
+    for (std::size_t index = 1; index < subtree.nodes.size(); ++index) {
+      bvh.nodes_.push_back(relocate(subtree.nodes[index]));
+    }
+  }
+  return bvh;
+}
+
+bool Bvh::empty() const {
+  return nodes_.empty();
+}
+
+Aabb Bvh::bounds() const {
+  return nodes_.empty() ? Aabb{} : nodes_.front().bounds;
+}
+
+std::span<const BvhNode> Bvh::nodes() const {
+  return nodes_;
+}
+
+std::span<const std::uint32_t> Bvh::primitives() const {
+  return primitives_;
+}
+
+// ------- MeshBvh -------
+std::shared_ptr<const MeshBvh> MeshBvh::build(std::span<const float> positions,
+                                              std::span<const std::uint32_t> indices,
+                                              JobSystem* jobs) {
+  const std::size_t vertexCount = positions.size() / 3;
+  const std::size_t triangleCount = (indices.empty() ? vertexCount : indices.size()) / 3;
+  auto corner = [&](std::size_t triangle, std::size_t vertex) {
+    const std::size_t index = indices.empty() ? (triangle * 3) + vertex
+                                              : indices[(triangle * 3) + vertex];
+    const float* position = positions.data() + (index * 3);
+    return glm::vec3(position[0], position[1], position[2]);
+  };
+
+  std::vector<Aabb> bounds(triangleCount);
+  auto boundRange = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t triangle = begin; triangle < end; ++triangle) {
+      for (std::size_t vertex = 0; vertex < 3; ++vertex) {
+        bounds[triangle].expand(corner(triangle, vertex));
+      }
+    }
+  };
+  constexpr std::size_t kGrain = 1U << 14U;
+  if (jobs != nullptr && triangleCount > kGrain) {
+    jobs->parallelFor(triangleCount, kGrain, boundRange);
+  } else {
+    boundRange(0, triangleCount);
+  }
+
+  auto meshBvh = std::make_shared<MeshBvh>();
+  meshBvh->bvh_ = Bvh::build(bounds, jobs);
+  const auto order = meshBvh->bvh_.primitives();
+  meshBvh->triangles_.resize(order.size());
+  for (std::size_t slot = 0; slot < order.size(); ++slot) {
+    const glm::vec3 v0 = corner(order[slot], 0);
+    meshBvh->triangles_[slot] = {v0, corner(order[slot], 1) - v0, corner(order[slot], 2) - v0};
+  }
+  spdlog::debug("MeshBvh built: {} triangles, {} nodes", triangleCount,
+                meshBvh->bvh_.nodes().size());
+  return meshBvh;
+}
+
+bool MeshBvh::intersectNearest(const Ray& ray, float tMax, TriangleHit& hit) const {
+  bool found = false;
+  bvh_.traverse(ray, tMax, [&](std::uint32_t slot, float currentMax) {
+    if (intersectTriangle_(ray, slot, currentMax, hit)) {
+      found = true;
+      return hit.distance;
+    }
+    return currentMax;
+  });
+  return found;
+}
+
+void MeshBvh::intersectAll(const Ray& ray, float tMax, std::vector<TriangleHit>& hits) const {
+  bvh_.traverse(ray, tMax, [&](std::uint32_t slot, float currentMax) {
+    TriangleHit hit;
+    if (intersectTriangle_(ray, slot, currentMax, hit)) {
+      hits.push_back(hit);
+    }
+    return currentMax;
+  });
+}
+
+Aabb MeshBvh::bounds() const {
+  return bvh_.bounds();
+}
+
+std::size_t MeshBvh::triangleCount() const {
+  return triangles_.size();
+}
+
+const Bvh& MeshBvh::bvh() const {
+  return bvh_;
+}
+
+// Moller-Trumbore; both faces
+bool MeshBvh::intersectTriangle_(const Ray& ray, std::uint32_t slot, float tMax,
+                                 TriangleHit& hit) const {
+  constexpr float kParallelEpsilon = 1e-12F;
+  const Triangle& triangle = triangles_[slot];
+  const glm::vec3 pvec = glm::cross(ray.direction, triangle.edge2);
+  const float det = glm::dot(triangle.edge1, pvec);
+  if (std::abs(det) < kParallelEpsilon) {
+    return false;
+  }
+  const float invDet = 1.0F / det;
+  const glm::vec3 tvec = ray.origin - triangle.v0;
+  const float u = glm::dot(tvec, pvec) * invDet;
+  if (u < 0.0F || u > 1.0F) {
+    return false;
+  }
+  const glm::vec3 qvec = glm::cross(tvec, triangle.edge1);
+  const float v = glm::dot(ray.direction, qvec) * invDet;
+  if (v < 0.0F || u + v > 1.0F) {
+    return false;
+  }
+  const float distance = glm::dot(triangle.edge2, qvec) * invDet;
+  if (distance < 0.0F || distance > tMax) {
+    return false;
+  }
+  hit = {distance, glm::vec3(1.0F - u - v, u, v), bvh_.primitives()[slot]};
+  return true;
+}
+
+} // namespace blkhurst
@@ -1,13 +1,109 @@
 #include <algorithm>
+#include <blkhurst/geometry/bvh.hpp>
 #include <blkhurst/geometry/geometry.hpp>
+#include <blkhurst/geometry/mesh_simplifier.hpp>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <glad/gl.h>
 #include <glm/gtc/type_ptr.hpp>
 #include <span>
 #include <spdlog/spdlog.h>
 
 namespace {
 constexpr bool kDynamic = false;
+constexpr unsigned kInterleavedBinding = 15; // Clear of per-attribute bindings (0-8)
+
+struct GlFormat {
+  GLenum type;
+  bool normalised;
+};
+
+GlFormat toGlFormat(blkhurst::VertexFormat format) {
+  using blkhurst::VertexFormat;
+  switch (format) {
+  case VertexFormat::Half2:
+  case VertexFormat::Half4:
+    return {GL_HALF_FLOAT, false};
+  case VertexFormat::Unorm8x4:
+    return {GL_UNSIGNED_BYTE, true};
+  case VertexFormat::Snorm1010102:
+    return {GL_INT_2_10_10_10_REV, true};
+  default:
+    return {GL_FLOAT, false};
+  }
+}
+
+// Centre of the bounding box; radius to the farthest position
+blkhurst::BoundingSphere computeBoundingSphere(const std::vector<float>& positions) {
+  if (positions.size() < 3) {
+    return {};
+  }
+  glm::vec3 lo(positions[0], positions[1], positions[2]);
+  glm::vec3 hi = lo;
+  for (std::size_t i = 0; i + 2 < positions.size(); i += 3) {
+    const glm::vec3 point(positions[i], positions[i + 1], positions[i + 2]);
+    lo = glm::min(lo, point);
+    hi = glm::max(hi, point);
+  }
+  const glm::vec3 center = (lo + hi) * 0.5F;
+  float radiusSq = 0.0F;
+  for (std::size_t i = 0; i + 2 < positions.size(); i += 3) {
+    const glm::vec3 offset = glm::vec3(positions[i], positions[i + 1], positions[i + 2]) - center;
+    radiusSq = std::max(radiusSq, glm::dot(offset, offset));
+  }
+  return {center, std::sqrt(radiusSq)};
+}
+
+bool halfPositions(const blkhurst::VertexLayout& layout) {
+  const blkhurst::VertexElement* element = layout.find(blkhurst::Attrib::Position);
+  return element != nullptr && (element->format == blkhurst::VertexFormat::Half4 ||
+                                element->format == blkhurst::VertexFormat::Half2);
+}
+
+// Positions as the interleaved stream decodes them; depth passes must match it bit for bit
+std::vector<float> streamPositions(std::span<const float> positions,
+                                   const blkhurst::VertexLayout& layout) {
+  std::vector<float> out(positions.begin(), positions.end());
+  if (halfPositions(layout)) {
+    for (float& value : out) {
+      value = blkhurst::vertex_encode::fromHalf(blkhurst::vertex_encode::toHalf(value));
+    }
+  }
+  return out;
+}
+
+// indices holds level 0; each simplified level is appended after it
+std::vector<blkhurst::GeometryLod> appendLodChain(const blkhurst::MeshData& meshData,
+                                                  const blkhurst::GeometryDesc& desc,
+                                                  std::vector<std::uint32_t>& indices) {
+  using blkhurst::MeshSimplifier;
+  constexpr float kMinReduction = 0.9F; // Stop once a level saves under 10%
+
+  std::vector<blkhurst::GeometryLod> lods;
+  lods.push_back({{0, static_cast<int>(indices.size())}, 0.0F});
+
+  const float extent = MeshSimplifier::extent(meshData);
+  std::size_t previousCount = meshData.indices.size();
+  for (int level = 1; level <= desc.lodLevels; ++level) {
+    // Simplify from the source each time so errors are measured against level 0
+    const std::size_t target = (previousCount / 2 / 3) * 3;
+    auto simplified =
+        MeshSimplifier::simplify(meshData, meshData.indices, target, desc.lodMaxError);
+    if (simplified.indices.empty() || static_cast<float>(simplified.indices.size()) >
+                                           kMinReduction * static_cast<float>(previousCount)) {
+      break;
+    }
+    lods.push_back({{static_cast<int>(indices.size()), static_cast<int>(simplified.indices.size())},
+                    simplified.error * extent});
+    indices.insert(indices.end(), simplified.indices.begin(), simplified.indices.end());
+    previousCount = simplified.indices.size();
+  }
+  spdlog::debug("Geometry LOD chain: {} levels, {} -> {} indices", lods.size(),
+                meshData.indices.size(), previousCount);
+  return lods;
 }
+} // namespace
 
 namespace blkhurst {
 
@@ -16,6 +112,9 @@ Geometry::Geometry() {
 }
 
 Geometry::~Geometry() {
+  if (pool_) {
+    pool_->release(poolAllocation_);
+  }
   spdlog::trace("Geometry destroyed");
 }
 
@@ -23,14 +122,39 @@ std::shared_ptr<Geometry> Geometry::create() {
   return std::make_shared<Geometry>();
 }
 
-void Geometry::setAttribute(Attrib attrib, std::span<const float> data, int componentCount) {
+void Geometry::setAttribute(Attrib attrib, std::span<const float> data, int componentCount,
+                            BufferUsage usage) {
+  if (pool_) {
+    spdlog::warn("Geometry setAttribute {} ignored by pooled geometry", static_cast<int>(attrib));
+    return;
+  }
   const auto attribIndex = static_cast<unsigned int>(attrib);
 
-  auto vbo = std::make_unique<Buffer>(data, kDynamic);
-  vao_.linkPackedFloatBuffer(attribIndex, vbo->id(), componentCount);
-  vbos_.push_back(std::move(vbo));
+  auto existing = std::ranges::find(attributes_, attrib, &AttributeBuffer::attrib);
+  AttributeBuffer& entry =
+      existing != attributes_.end() ? *existing : attributes_.emplace_back(AttributeBuffer{attrib});
+  entry.componentCount = componentCount;
+  entry.buffer.reset();
+  entry.stream.reset();
+
+  if (usage == BufferUsage::Stream) {
+    const auto stride = static_cast<int>(componentCount * sizeof(float));
+    entry.stream = std::make_unique<StreamBuffer>(data.data(),
+                                                  static_cast<intptr_t>(data.size_bytes()));
+    vao_.bindVertexBuffer(attribIndex, entry.stream->id(), entry.stream->offset(), stride);
+    vao_.linkAttribFloat(attribIndex, attribIndex, componentCount);
+  } else {
+    entry.buffer = std::make_unique<Buffer>(data, usage == BufferUsage::Dynamic);
+    vao_.linkPackedFloatBuffer(attribIndex, entry.buffer->id(), componentCount);
+  }
 
   if (attrib == Attrib::Position) {
+    if (positionVao_ && componentCount == 3) {
+      setPositionStream(data);
+    } else {
+      positionVao_.reset();
+      positionStream_.reset();
+    }
     const int vertexCount = static_cast<int>(data.size() / componentCount);
     vertexCount_ = vertexCount;
 
@@ -42,17 +166,217 @@ void Geometry::setAttribute(Attrib attrib, std::span<const float> data, int comp
   // TODO: Attribute count mismatch
 }
 
+bool Geometry::updateAttribute(Attrib attrib, std::span<const float> data, std::size_t offset) {
+  auto entry = std::ranges::find(attributes_, attrib, &AttributeBuffer::attrib);
+  if (entry == attributes_.end()) {
+    if (!updateInterleaved_(attrib, data, offset)) {
+      return false;
+    }
+    if (attrib == Attrib::Position && positionStream_) {
+      const VertexElement* element = layout_.find(Attrib::Position);
+      updatePositionStream_(data, offset, VertexLayout::componentCount(element->format), layout_);
+    }
+    return true;
+  }
+
+  const auto offsetBytes = static_cast<intptr_t>(offset * sizeof(float));
+  const auto sizeBytes = static_cast<intptr_t>(data.size_bytes());
+  if (entry->stream) {
+    if (offsetBytes + sizeBytes > entry->stream->size()) {
+      spdlog::error("Geometry updateAttribute {} out of range", static_cast<int>(attrib));
+      return false;
+    }
+    entry->stream->write(offsetBytes, data.data(), sizeBytes);
+    const auto stride = static_cast<int>(entry->componentCount * sizeof(float));
+    vao_.bindVertexBuffer(static_cast<unsigned>(attrib), entry->stream->id(),
+                          entry->stream->offset(), stride);
+  } else {
+    auto& buffer = *entry->buffer;
+    if (offsetBytes + sizeBytes > buffer.size()) {
+      spdlog::error("Geometry updateAttribute {} out of range", static_cast<int>(attrib));
+      return false;
+    }
+    if (offsetBytes == 0 && sizeBytes == buffer.size()) {
+      buffer.orphan(); // Whole rewrite; no wait on draws still reading the old storage
+    }
+    buffer.setSubData(offsetBytes, data.data(), sizeBytes);
+  }
+  if (attrib == Attrib::Position && positionStream_) {
+    updatePositionStream_(data, offset, entry->componentCount, {});
+  }
+  return true;
+}
+
+// Mirrors a Position write into the packed Float3 stream, decoded as layout stores it. offset
+// is in floats of the source attribute (components per vertex); the stream drops w
+void Geometry::updatePositionStream_(std::span<const float> data, std::size_t offset,
+                                     int components, const VertexLayout& layout) {
+  const auto sourceComponents = static_cast<std::size_t>(components);
+  if (sourceComponents == 3 && !halfPositions(layout)) {
+    // Already what the stream holds; written straight through
+    const auto offsetBytes = static_cast<intptr_t>(offset * sizeof(float));
+    if (offsetBytes + static_cast<intptr_t>(data.size_bytes()) <= positionStream_->size()) {
+      positionStream_->setSubData(offsetBytes, data.data(),
+                                  static_cast<intptr_t>(data.size_bytes()));
+      return;
+    }
+  } else if (sourceComponents >= 3 && offset % sourceComponents == 0) {
+    const std::size_t vertexCount = data.size() / sourceComponents;
+    std::vector<float> packed;
+    packed.reserve(vertexCount * 3);
+    for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+      const float* source = data.data() + (vertex * sourceComponents);
+      packed.insert(packed.end(), source, source + 3);
+    }
+    packed = streamPositions(packed, layout);
+    const auto offsetBytes =
+        static_cast<intptr_t>((offset / sourceComponents) * 3 * sizeof(float));
+    const auto sizeBytes = static_cast<intptr_t>(packed.size() * sizeof(float));
+    if (offsetBytes + sizeBytes <= positionStream_->size()) {
+      positionStream_->setSubData(offsetBytes, packed.data(), sizeBytes);
+      return;
+    }
+  }
+  // Cannot follow the main stream; depth passes fall back to the full vertex array
+  spdlog::warn("Geometry updateAttribute Position: position stream out of sync, dropped");
+  positionVao_.reset();
+  positionStream_.reset();
+}
+
+// Strided writes into the interleaved Buffer; Float formats only
+bool Geometry::updateInterleaved_(Attrib attrib, std::span<const float> data,
+                                  std::size_t offset) {
+  const VertexElement* element = interleaved_ ? layout_.find(attrib) : nullptr;
+  if (element == nullptr) {
+    spdlog::error("Geometry updateAttribute {}: attribute not set", static_cast<int>(attrib));
+    return false;
+  }
+  const auto components = static_cast<std::size_t>(VertexLayout::componentCount(element->format));
+  const bool isFloat = element->format == VertexFormat::Float1 ||
+                       element->format == VertexFormat::Float2 ||
+                       element->format == VertexFormat::Float3 ||
+                       element->format == VertexFormat::Float4;
+  if (!isFloat || offset % components != 0 || data.size() % components != 0) {
+    spdlog::error("Geometry updateAttribute {}: interleaved attribute is not float-aligned",
+                  static_cast<int>(attrib));
+    return false;
+  }
+
+  const std::size_t firstVertex = offset / components;
+  const std::size_t vertexCount = data.size() / components;
+  if (vertexCount == 0) {
+    return true;
+  }
+  const std::size_t stride = layout_.stride;
+  const auto rangeBytes = static_cast<intptr_t>(((vertexCount - 1) * stride) + element->offset +
+                                                (components * sizeof(float)));
+  const auto rangeOffset = static_cast<intptr_t>(firstVertex * stride);
+  if (rangeOffset + rangeBytes > interleaved_->size()) {
+    spdlog::error("Geometry updateAttribute {} out of range", static_cast<int>(attrib));
+    return false;
+  }
+
+  auto* mapped = static_cast<std::byte*>(interleaved_->mapRange(rangeOffset, rangeBytes));
+  if (mapped == nullptr) {
+    spdlog::error("Geometry updateAttribute {}: map failed", static_cast<int>(attrib));
+    return false;
+  }
+  for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+    std::memcpy(mapped + (vertex * stride) + element->offset, data.data() + (vertex * components),
+                components * sizeof(float));
+  }
+  interleaved_->unmap();
+  return true;
+}
+
+void Geometry::setVertices(std::span<const std::byte> data, const VertexLayout& layout) {
+  if (layout.stride == 0) {
+    spdlog::error("Geometry setVertices with empty layout");
+    return;
+  }
+
+  interleaved_ = std::make_unique<Buffer>(data, kDynamic);
+  layout_ = layout;
+  positionVao_.reset(); // New positions; from() re-adds the stream afterwards
+  positionStream_.reset();
+  vao_.bindVertexBuffer(kInterleavedBinding, interleaved_->id(), 0,
+                        static_cast<int>(layout_.stride));
+  for (const auto& element : layout_.elements) {
+    const auto format = toGlFormat(element.format);
+    vao_.linkAttribFormat(static_cast<unsigned>(element.attrib), kInterleavedBinding,
+                          VertexLayout::componentCount(element.format), format.type,
+                          format.normalised, element.offset);
+  }
+
+  vertexCount_ = static_cast<int>(data.size() / layout_.stride);
+  if (!isIndexed_) {
+    drawRange_.count = vertexCount_;
+  }
+}
+
 void Geometry::setIndex(std::span<const unsigned> indices) {
   ebo_ = std::make_unique<Buffer>(indices, kDynamic);
   vao_.setElementBuffer(ebo_->id());
+  if (positionVao_) {
+    positionVao_->setElementBuffer(ebo_->id());
+  }
+
+  isIndexed_ = true;
+  indexType_ = IndexType::Uint32;
+  const int indexCount = static_cast<int>(indices.size());
+  indexCount_ = indexCount;
+  drawRange_.start = 0;
+  drawRange_.count = indexCount;
+}
+
+void Geometry::setIndex(std::span<const std::uint16_t> indices) {
+  ebo_ = std::make_unique<Buffer>(indices, kDynamic);
+  vao_.setElementBuffer(ebo_->id());
+  if (positionVao_) {
+    positionVao_->setElementBuffer(ebo_->id());
+  }
 
   isIndexed_ = true;
+  indexType_ = IndexType::Uint16;
   const int indexCount = static_cast<int>(indices.size());
   indexCount_ = indexCount;
   drawRange_.start = 0;
   drawRange_.count = indexCount;
 }
 
+void Geometry::setPositionStream(std::span<const float> positions) {
+  if (pool_) {
+    spdlog::warn("Geometry setPositionStream ignored by pooled geometry");
+    return;
+  }
+  positionStream_ = std::make_unique<Buffer>(positions, kDynamic);
+  positionVao_ = std::make_unique<VertexArray>();
+  positionVao_->linkPackedFloatBuffer(static_cast<unsigned>(Attrib::Position),
+                                      positionStream_->id(), 3);
+  if (ebo_) {
+    positionVao_->setElementBuffer(ebo_->id());
+  }
+  spdlog::trace("Geometry setPositionStream {} vertices", positions.size() / 3);
+}
+
+void Geometry::setLods(std::vector<GeometryLod> lods) {
+  lods_ = std::move(lods);
+  if (!lods_.empty()) {
+    indexCount_ = lods_.front().range.count; // clearDrawRange restores level 0, not the chain
+    drawRange_ = lods_.front().range;
+  }
+  spdlog::trace("Geometry setLods {}", lods_.size());
+}
+
+void Geometry::setBoundingSphere(const BoundingSphere& sphere) {
+  boundingSphere_ = sphere;
+}
+
+void Geometry::setMeshlets(std::vector<Meshlet> meshlets) {
+  meshlets_ = std::move(meshlets);
+  spdlog::trace("Geometry setMeshlets {}", meshlets_.size());
+}
+
 void Geometry::setPrimitive(PrimitiveMode mode) {
   primitive_ = mode;
   spdlog::trace("Geometry setPrimitive {}", static_cast<int>(mode));
@@ -83,17 +407,210 @@ bool Geometry::isIndexed() const {
   return isIndexed_;
 }
 
+IndexType Geometry::indexType() const {
+  return indexType_;
+}
+
+std::size_t Geometry::indexSize() const {
+  return indexType_ == IndexType::Uint16 ? sizeof(std::uint16_t) : sizeof(std::uint32_t);
+}
+
+std::size_t Geometry::byteSize() const {
+  std::size_t total = 0;
+  for (const auto& attribute : attributes_) {
+    if (attribute.buffer) {
+      total += static_cast<std::size_t>(attribute.buffer->size());
+    }
+    if (attribute.stream) {
+      total += static_cast<std::size_t>(attribute.stream->size()) * StreamBuffer::kDefaultRegions;
+    }
+  }
+  if (interleaved_) {
+    total += static_cast<std::size_t>(interleaved_->size());
+  }
+  if (ebo_) {
+    total += static_cast<std::size_t>(ebo_->size());
+  }
+  if (positionStream_) {
+    total += static_cast<std::size_t>(positionStream_->size());
+  }
+  if (pool_) {
+    total += (static_cast<std::size_t>(poolAllocation_.vertices.count) *
+              VertexPool::kFloatsPerVertex * sizeof(float)) +
+             (static_cast<std::size_t>(poolAllocation_.indices.count) * sizeof(std::uint32_t));
+  }
+  return total;
+}
+
 const VertexArray& Geometry::vertexArray() const {
   return vao_;
 }
 
-std::shared_ptr<Geometry> Geometry::from(const MeshData& meshData) {
+const VertexArray* Geometry::positionArray() const {
+  return positionVao_.get();
+}
+
+int Geometry::lodCount() const {
+  return static_cast<int>(lods_.size());
+}
+
+const GeometryLod& Geometry::lod(int level) const {
+  assert(level >= 0 && level < lodCount());
+  return lods_[level];
+}
+
+const BoundingSphere& Geometry::boundingSphere() const {
+  return boundingSphere_;
+}
+
+std::span<const Meshlet> Geometry::meshlets() const {
+  return meshlets_;
+}
+
+bool Geometry::isPooled() const {
+  return pool_ != nullptr;
+}
+
+const VertexPool* Geometry::vertexPool() const {
+  return pool_.get();
+}
+
+const VertexPoolAllocation& Geometry::poolAllocation() const {
+  return poolAllocation_;
+}
+
+MeshData Geometry::readMeshData() const {
+  MeshData meshData;
+  if (pool_) {
+    meshData = pool_->read(poolAllocation_);
+  } else if (interleaved_) {
+    std::vector<std::byte> vertices(static_cast<std::size_t>(interleaved_->size()));
+    interleaved_->getSubData(0, vertices.data(), interleaved_->size());
+    meshData = vertex_encode::deinterleave(vertices, layout_);
+  }
+
+  // Separate attribute buffers (setAttribute) override the interleaved stream
+  for (const auto& attribute : attributes_) {
+    std::vector<float>* target = nullptr;
+    switch (attribute.attrib) {
+    case Attrib::Position:
+      target = &meshData.positions;
+      break;
+    case Attrib::Uv:
+      target = &meshData.uvs;
+      break;
+    case Attrib::Normal:
+      target = &meshData.normals;
+      break;
+    default:
+      break;
+    }
+    if (target == nullptr || !attribute.buffer) {
+      continue;
+    }
+    target->resize(static_cast<std::size_t>(attribute.buffer->size()) / sizeof(float));
+    attribute.buffer->getSubData(0, target->data(), attribute.buffer->size());
+  }
+
+  // Level 0 only; LOD levels follow it in the index buffer
+  if (ebo_ && indexCount_ > 0) {
+    const auto count = static_cast<std::size_t>(indexCount_);
+    meshData.indices.resize(count);
+    if (indexType_ == IndexType::Uint16) {
+      std::vector<std::uint16_t> indices16(count);
+      ebo_->getSubData(0, indices16.data(), static_cast<intptr_t>(count * sizeof(std::uint16_t)));
+      std::copy(indices16.begin(), indices16.end(), meshData.indices.begin());
+    } else {
+      ebo_->getSubData(0, meshData.indices.data(),
+                       static_cast<intptr_t>(count * sizeof(std::uint32_t)));
+    }
+  } else if (pool_) {
+    meshData.indices.resize(static_cast<std::size_t>(indexCount_));
+  }
+  return meshData;
+}
+
+const std::shared_ptr<const MeshBvh>& Geometry::bvh() const {
+  return bvh_;
+}
+
+void Geometry::setBvh(std::shared_ptr<const MeshBvh> bvh) {
+  bvh_ = std::move(bvh);
+}
+
+const MeshBvh* Geometry::ensureBvh(JobSystem* jobs) {
+  if (!bvh_ && primitive_ == PrimitiveMode::Triangles) {
+    const MeshData meshData = readMeshData();
+    bvh_ = MeshBvh::build(meshData.positions, meshData.indices, jobs);
+  }
+  return bvh_.get();
+}
+
+void Geometry::setPooled_(const MeshData& meshData, std::span<const std::uint32_t> indices) {
+  pool_ = VertexPool::shared();
+  poolAllocation_ = pool_->allocate(meshData, indices);
+
+  vertexCount_ = static_cast<int>(poolAllocation_.vertices.count);
+  indexCount_ = static_cast<int>(poolAllocation_.indices.count);
+  isIndexed_ = indexCount_ > 0;
+  indexType_ = IndexType::Uint32; // Pool indices are always 32-bit
+  drawRange_ = {0, isIndexed_ ? indexCount_ : vertexCount_};
+}
+
+std::shared_ptr<Geometry> Geometry::from(const MeshData& meshData, const GeometryDesc& desc) {
+  if (desc.optimize) {
+    MeshData optimized = meshData;
+    MeshOptimizer::optimize(optimized, desc.optimizer);
+    GeometryDesc uploadDesc = desc;
+    uploadDesc.optimize = false;
+    return from(optimized, uploadDesc);
+  }
+
   auto geometry = Geometry::create();
 
-  geometry->setIndex(meshData.indices);
-  geometry->setAttribute(Attrib::Position, meshData.positions, 3);
-  geometry->setAttribute(Attrib::Uv, meshData.uvs, 2);
-  geometry->setAttribute(Attrib::Normal, meshData.normals, 3);
+  // Level 0 in meshlet order when clustering; LOD levels follow it in the same buffer
+  std::vector<std::uint32_t> indices;
+  std::vector<Meshlet> meshlets;
+  const bool triangles = meshData.indices.size() >= 3;
+  if (desc.meshlets && triangles) {
+    auto built = MeshletBuilder::build(meshData, meshData.indices, desc.meshletLimits);
+    indices = std::move(built.indices);
+    meshlets = std::move(built.meshlets);
+  } else {
+    indices = meshData.indices;
+  }
+  std::shared_ptr<const MeshBvh> bvh;
+  if (desc.bvh && triangles) {
+    bvh = MeshBvh::build(meshData.positions, indices); // Level 0, in uploaded order
+  }
+  std::vector<GeometryLod> lods;
+  if (desc.lodLevels > 0 && triangles) {
+    lods = appendLodChain(meshData, desc, indices);
+  }
+
+  std::vector<std::uint16_t> indices16;
+  if (desc.vertexPulling) {
+    geometry->setPooled_(meshData, indices);
+  } else if (indices.empty()) {
+    // Non-indexed; draw range follows vertex count
+  } else if (vertex_encode::narrowIndices(indices, indices16)) {
+    geometry->setIndex(std::span<const std::uint16_t>(indices16));
+  } else {
+    geometry->setIndex(indices);
+  }
+  if (!desc.vertexPulling) {
+    const auto vertices = vertex_encode::interleave(meshData, desc.layout);
+    geometry->setVertices(vertices, desc.layout);
+    if (desc.positionStream) {
+      geometry->setPositionStream(streamPositions(meshData.positions, desc.layout));
+    }
+  }
+  geometry->setBoundingSphere(computeBoundingSphere(meshData.positions));
+  if (lods.size() > 1) {
+    geometry->setLods(std::move(lods));
+  }
+  geometry->setMeshlets(std::move(meshlets));
+  geometry->setBvh(std::move(bvh));
 
   return geometry;
 }
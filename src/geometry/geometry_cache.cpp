@@ -0,0 +1,34 @@
+#include <blkhurst/geometry/geometry_cache.hpp>
+
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace blkhurst {
+
+GeometryCache& GeometryCache::instance() {
+  static GeometryCache cache;
+  return cache;
+}
+
+GeometryCacheStats GeometryCache::stats() const {
+  GeometryCacheStats stats{.hits = hits_, .misses = misses_};
+  for (const auto& [hash, entry] : entries_) {
+    stats.live += entry.geometry.expired() ? 0 : 1;
+  }
+  return stats;
+}
+
+void GeometryCache::clear() {
+  entries_.clear();
+  spdlog::debug("GeometryCache cleared");
+}
+
+// Amortised: runs when the table doubles since the last prune
+void GeometryCache::pruneExpired_() {
+  std::erase_if(entries_, [](const auto& item) { return item.second.geometry.expired(); });
+  constexpr std::size_t kMinThreshold = 64;
+  pruneThreshold_ = std::max(kMinThreshold, entries_.size() * 2);
+  spdlog::trace("GeometryCache pruned to {} entries", entries_.size());
+}
+
+} // namespace blkhurst
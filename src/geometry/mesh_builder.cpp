@@ -0,0 +1,35 @@
+#include <blkhurst/geometry/mesh_builder.hpp>
+#include <blkhurst/jobs/job_system.hpp>
+
+namespace blkhurst::mesh_builder {
+
+MeshData allocate(const MeshCounts& counts, bool tangents) {
+  MeshData out;
+  out.positions.resize(counts.vertices * 3);
+  out.normals.resize(counts.vertices * 3);
+  out.uvs.resize(counts.vertices * 2);
+  if (tangents) {
+    out.tangents.resize(counts.vertices * 3);
+  }
+  out.indices.resize(counts.indices);
+  return out;
+}
+
+MeshSpans spans(MeshData& meshData) {
+  return {meshData.positions, meshData.normals, meshData.uvs, meshData.tangents,
+          meshData.indices};
+}
+
+void forEachRow(int rows, std::size_t vertices, JobSystem* jobs,
+                const std::function<void(int)>& row) {
+  if (jobs == nullptr || vertices < kParallelVertexThreshold || rows < 2) {
+    for (int index = 0; index < rows; ++index) {
+      row(index);
+    }
+    return;
+  }
+  jobs->parallelFor(static_cast<std::size_t>(rows),
+                    [&](std::size_t index) { row(static_cast<int>(index)); });
+}
+
+} // namespace blkhurst::mesh_builder
@@ -0,0 +1,379 @@
+#include <blkhurst/geometry/mesh_optimizer.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <numeric>
+#include <unordered_map>
+#include <vector>
+
+namespace blkhurst {
+
+namespace {
+constexpr std::uint32_t kInvalid = ~0U;
+
+std::size_t vertexCountOf(const MeshData& meshData) {
+  return meshData.positions.size() / 3;
+}
+
+// Calls fn(data, components) for each attribute stream that matches the vertex count
+template <class Fn> void forEachAttribute(MeshData& meshData, Fn&& func) {
+  const std::size_t vertexCount = vertexCountOf(meshData);
+  auto visit = [&](std::vector<float>& data, std::size_t components) {
+    if (!data.empty() && data.size() == vertexCount * components) {
+      func(data, components);
+    }
+  };
+  visit(meshData.positions, 3);
+  visit(meshData.uvs, 2);
+  visit(meshData.normals, 3);
+  visit(meshData.tangents, 3);
+}
+
+// remap[old] = new (or kInvalid to drop); newCount vertices remain
+void remapVertices(MeshData& meshData, const std::vector<std::uint32_t>& remap,
+                   std::size_t newCount) {
+  forEachAttribute(meshData, [&](std::vector<float>& data, std::size_t components) {
+    std::vector<float> out(newCount * components);
+    for (std::size_t vertex = 0; vertex < remap.size(); ++vertex) {
+      if (remap[vertex] != kInvalid) {
+        std::copy_n(data.begin() + static_cast<std::ptrdiff_t>(vertex * components), components,
+                    out.begin() + static_cast<std::ptrdiff_t>(remap[vertex] * components));
+      }
+    }
+    data = std::move(out);
+  });
+  for (auto& index : meshData.indices) {
+    index = remap[index];
+  }
+}
+
+struct TipsifyOutput {
+  std::vector<std::uint32_t> indices;
+  std::vector<std::size_t> clusterStarts; // Triangle offsets where Tipsify hit a dead end
+};
+
+// Sander, Nehab, Barczak 2007: "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw"
+TipsifyOutput tipsify(std::span<const std::uint32_t> indices, std::size_t vertexCount,
+                      int cacheSize) {
+  const std::size_t triangleCount = indices.size() / 3;
+  const auto cache = static_cast<std::int64_t>(cacheSize);
+
+  // Vertex -> triangle adjacency (CSR)
+  std::vector<std::uint32_t> liveCount(vertexCount, 0);
+  for (auto index : indices) {
+    ++liveCount[index];
+  }
+  std::vector<std::uint32_t> offsets(vertexCount + 1, 0);
+  for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+    offsets[vertex + 1] = offsets[vertex] + liveCount[vertex];
+  }
+  std::vector<std::uint32_t> adjacency(indices.size());
+  {
+    std::vector<std::uint32_t> fill(offsets.begin(), offsets.end() - 1);
+    for (std::size_t i = 0; i < indices.size(); ++i) {
+      adjacency[fill[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+    }
+  }
+
+  TipsifyOutput out;
+  out.indices.reserve(indices.size());
+  out.clusterStarts.push_back(0);
+
+  std::vector<std::int64_t> timeStamp(vertexCount, 0);
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<std::uint32_t> deadEnd;
+  std::vector<std::uint32_t> candidates;
+  std::int64_t time = cache + 1;
+  std::size_t cursor = 0;
+
+  auto skipDeadEnd = [&]() -> std::uint32_t {
+    while (!deadEnd.empty()) {
+      const auto vertex = deadEnd.back();
+      deadEnd.pop_back();
+      if (liveCount[vertex] > 0) {
+        return vertex;
+      }
+    }
+    while (cursor < vertexCount) {
+      if (liveCount[cursor] > 0) {
+        return static_cast<std::uint32_t>(cursor);
+      }
+      ++cursor;
+    }
+    return kInvalid;
+  };
+
+  std::uint32_t fanning = vertexCount > 0 ? 0U : kInvalid;
+  if (fanning != kInvalid && liveCount[fanning] == 0) {
+    fanning = skipDeadEnd();
+  }
+
+  while (fanning != kInvalid) {
+    candidates.clear();
+    for (std::uint32_t a = offsets[fanning]; a < offsets[fanning + 1]; ++a) {
+      const auto triangle = adjacency[a];
+      if (emitted[triangle]) {
+        continue;
+      }
+      for (int corner = 0; corner < 3; ++corner) {
+        const auto vertex = indices[(triangle * 3) + corner];
+        out.indices.push_back(vertex);
+        deadEnd.push_back(vertex);
+        candidates.push_back(vertex);
+        --liveCount[vertex];
+        if (time - timeStamp[vertex] > cache) {
+          timeStamp[vertex] = time++;
+        }
+      }
+      emitted[triangle] = true;
+    }
+
+    // Next fanning vertex: live candidate still in cache after its remaining fans, oldest first
+    std::uint32_t next = kInvalid;
+    std::int64_t best = -1;
+    for (auto vertex : candidates) {
+      if (liveCount[vertex] == 0) {
+        continue;
+      }
+      std::int64_t priority = 0;
+      if (time - timeStamp[vertex] + (2 * static_cast<std::int64_t>(liveCount[vertex])) <= cache) {
+        priority = time - timeStamp[vertex];
+      }
+      if (priority > best) {
+        best = priority;
+        next = vertex;
+      }
+    }
+    if (next == kInvalid) {
+      next = skipDeadEnd();
+      if (next != kInvalid) {
+        out.clusterStarts.push_back(out.indices.size() / 3);
+      }
+    }
+    fanning = next;
+  }
+  return out;
+}
+} // namespace
+
+MeshOptimizerResult MeshOptimizer::optimize(MeshData& meshData,
+                                            const MeshOptimizerOptions& options) {
+  MeshOptimizerResult result;
+  result.verticesBefore = vertexCountOf(meshData);
+  result.before =
+      analyzeVertexCache(meshData.indices, result.verticesBefore, options.cacheSize);
+  if (meshData.indices.empty()) {
+    // Triangle soup; every corner is transformed
+    result.before = {result.verticesBefore, 3.0F, 1.0F};
+  }
+
+  if (options.weld) {
+    weld(meshData);
+  }
+  if (options.overdraw) {
+    optimizeOverdraw(meshData, options.cacheSize, options.overdrawThreshold);
+  } else if (options.vertexCache) {
+    optimizeVertexCache(meshData, options.cacheSize);
+  }
+  if (options.vertexFetch) {
+    optimizeVertexFetch(meshData);
+  }
+
+  result.verticesAfter = vertexCountOf(meshData);
+  result.after = analyzeVertexCache(meshData.indices, result.verticesAfter, options.cacheSize);
+  spdlog::debug("MeshOptimizer vertices {} -> {}, ACMR {:.3f} -> {:.3f}, ATVR {:.3f} -> {:.3f}",
+                result.verticesBefore, result.verticesAfter, result.before.acmr,
+                result.after.acmr, result.before.atvr, result.after.atvr);
+  return result;
+}
+
+void MeshOptimizer::weld(MeshData& meshData) {
+  const std::size_t vertexCount = vertexCountOf(meshData);
+  if (vertexCount == 0) {
+    return;
+  }
+
+  // Key: concatenated attribute bits of one vertex
+  std::vector<std::pair<const std::vector<float>*, std::size_t>> streams;
+  forEachAttribute(meshData, [&](std::vector<float>& data, std::size_t components) {
+    streams.emplace_back(&data, components);
+  });
+  std::size_t keyFloats = 0;
+  for (const auto& stream : streams) {
+    keyFloats += stream.second;
+  }
+
+  std::vector<std::uint32_t> keys(vertexCount * keyFloats);
+  for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+    std::uint32_t* key = keys.data() + (vertex * keyFloats);
+    for (const auto& [data, components] : streams) {
+      std::memcpy(key, data->data() + (vertex * components), components * sizeof(float));
+      key += components;
+    }
+  }
+
+  auto keyOf = [&](std::uint32_t vertex) {
+    return std::span<const std::uint32_t>(keys.data() + (vertex * keyFloats), keyFloats);
+  };
+  auto hash = [&](std::uint32_t vertex) {
+    std::size_t seed = 0;
+    for (auto word : keyOf(vertex)) {
+      seed ^= word + 0x9E3779B9U + (seed << 6U) + (seed >> 2U);
+    }
+    return seed;
+  };
+  auto equal = [&](std::uint32_t lhs, std::uint32_t rhs) {
+    return std::ranges::equal(keyOf(lhs), keyOf(rhs));
+  };
+  std::unordered_map<std::uint32_t, std::uint32_t, decltype(hash), decltype(equal)> unique(
+      vertexCount, hash, equal);
+
+  std::vector<std::uint32_t> remap(vertexCount);
+  std::uint32_t nextVertex = 0;
+  for (std::uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+    auto [found, inserted] = unique.try_emplace(vertex, nextVertex);
+    remap[vertex] = found->second;
+    if (inserted) {
+      ++nextVertex;
+    }
+  }
+  if (nextVertex == vertexCount) {
+    return;
+  }
+
+  // Unindexed input becomes indexed
+  if (meshData.indices.empty()) {
+    meshData.indices.resize(vertexCount);
+    std::iota(meshData.indices.begin(), meshData.indices.end(), 0U);
+  }
+  remapVertices(meshData, remap, nextVertex);
+}
+
+void MeshOptimizer::optimizeVertexCache(MeshData& meshData, int cacheSize) {
+  if (meshData.indices.size() < 3) {
+    return;
+  }
+  meshData.indices = tipsify(meshData.indices, vertexCountOf(meshData), cacheSize).indices;
+}
+
+void MeshOptimizer::optimizeOverdraw(MeshData& meshData, int cacheSize, float threshold) {
+  if (meshData.indices.size() < 3) {
+    return;
+  }
+  const std::size_t vertexCount = vertexCountOf(meshData);
+  auto tipsified = tipsify(meshData.indices, vertexCount, cacheSize);
+  const auto& indices = tipsified.indices;
+  const auto& positions = meshData.positions;
+
+  auto position = [&](std::uint32_t vertex) {
+    return std::array<float, 3>{positions[(vertex * 3) + 0], positions[(vertex * 3) + 1],
+                                positions[(vertex * 3) + 2]};
+  };
+
+  // Cluster centroid and (area-weighted) normal
+  const std::size_t clusterCount = tipsified.clusterStarts.size();
+  const std::size_t triangleCount = indices.size() / 3;
+  std::vector<std::array<float, 3>> centroid(clusterCount, {0.0F, 0.0F, 0.0F});
+  std::vector<std::array<float, 3>> normal(clusterCount, {0.0F, 0.0F, 0.0F});
+  std::array<float, 3> meshCentroid = {0.0F, 0.0F, 0.0F};
+
+  for (std::size_t cluster = 0; cluster < clusterCount; ++cluster) {
+    const std::size_t begin = tipsified.clusterStarts[cluster];
+    const std::size_t end =
+        cluster + 1 < clusterCount ? tipsified.clusterStarts[cluster + 1] : triangleCount;
+    for (std::size_t triangle = begin; triangle < end; ++triangle) {
+      const auto p0 = position(indices[(triangle * 3) + 0]);
+      const auto p1 = position(indices[(triangle * 3) + 1]);
+      const auto p2 = position(indices[(triangle * 3) + 2]);
+      const std::array<float, 3> e1 = {p1[0] - p0[0], p1[1] - p0[1], p1[2] - p0[2]};
+      const std::array<float, 3> e2 = {p2[0] - p0[0], p2[1] - p0[1], p2[2] - p0[2]};
+      const std::array<float, 3> cross = {(e1[1] * e2[2]) - (e1[2] * e2[1]),
+                                          (e1[2] * e2[0]) - (e1[0] * e2[2]),
+                                          (e1[0] * e2[1]) - (e1[1] * e2[0])};
+      for (int axis = 0; axis < 3; ++axis) {
+        const float center = (p0[axis] + p1[axis] + p2[axis]) / 3.0F;
+        centroid[cluster][axis] += center;
+        meshCentroid[axis] += center;
+        normal[cluster][axis] += cross[axis];
+      }
+    }
+    const auto count = static_cast<float>(std::max<std::size_t>(1, end - begin));
+    for (int axis = 0; axis < 3; ++axis) {
+      centroid[cluster][axis] /= count;
+    }
+  }
+  for (int axis = 0; axis < 3; ++axis) {
+    meshCentroid[axis] /= static_cast<float>(std::max<std::size_t>(1, triangleCount));
+  }
+
+  // Outward-facing clusters first; they tend to occlude the rest
+  std::vector<float> score(clusterCount);
+  for (std::size_t cluster = 0; cluster < clusterCount; ++cluster) {
+    float dot = 0.0F;
+    for (int axis = 0; axis < 3; ++axis) {
+      dot += (centroid[cluster][axis] - meshCentroid[axis]) * normal[cluster][axis];
+    }
+    score[cluster] = dot;
+  }
+  std::vector<std::size_t> order(clusterCount);
+  std::iota(order.begin(), order.end(), 0U);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t lhs, std::size_t rhs) { return score[lhs] > score[rhs]; });
+
+  std::vector<std::uint32_t> sorted;
+  sorted.reserve(indices.size());
+  for (auto cluster : order) {
+    const std::size_t begin = tipsified.clusterStarts[cluster] * 3;
+    const std::size_t end = cluster + 1 < clusterCount
+                                ? tipsified.clusterStarts[cluster + 1] * 3
+                                : indices.size();
+    sorted.insert(sorted.end(), indices.begin() + static_cast<std::ptrdiff_t>(begin),
+                  indices.begin() + static_cast<std::ptrdiff_t>(end));
+  }
+
+  // Keep overdraw order only while vertex cache efficiency stays within threshold
+  const auto cacheOnly = analyzeVertexCache(indices, vertexCount, cacheSize);
+  const auto withOverdraw = analyzeVertexCache(sorted, vertexCount, cacheSize);
+  meshData.indices = withOverdraw.acmr <= cacheOnly.acmr * threshold ? std::move(sorted)
+                                                                     : std::move(tipsified.indices);
+}
+
+void MeshOptimizer::optimizeVertexFetch(MeshData& meshData) {
+  const std::size_t vertexCount = vertexCountOf(meshData);
+  if (meshData.indices.empty() || vertexCount == 0) {
+    return;
+  }
+  std::vector<std::uint32_t> remap(vertexCount, kInvalid);
+  std::uint32_t nextVertex = 0;
+  for (auto index : meshData.indices) {
+    if (remap[index] == kInvalid) {
+      remap[index] = nextVertex++;
+    }
+  }
+  remapVertices(meshData, remap, nextVertex);
+}
+
+VertexCacheStats MeshOptimizer::analyzeVertexCache(std::span<const std::uint32_t> indices,
+                                                   std::size_t vertexCount, int cacheSize) {
+  VertexCacheStats stats;
+  if (indices.size() < 3 || vertexCount == 0) {
+    return stats;
+  }
+
+  // FIFO: a vertex is cached if it entered within the last cacheSize misses
+  std::vector<std::int64_t> entered(vertexCount, -1);
+  std::int64_t misses = 0;
+  for (auto index : indices) {
+    if (entered[index] < 0 || misses - entered[index] > cacheSize) {
+      entered[index] = misses++;
+    }
+  }
+  stats.transformed = static_cast<std::size_t>(misses);
+  stats.acmr = static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+  stats.atvr = static_cast<float>(misses) / static_cast<float>(vertexCount);
+  return stats;
+}
+
+} // namespace blkhurst
@@ -0,0 +1,261 @@
+#include <blkhurst/geometry/mesh_simplifier.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <unordered_map>
+
+namespace blkhurst {
+
+namespace {
+using Vec3 = std::array<double, 3>;
+
+// Symmetric 4x4 plane quadric
+struct Quadric {
+  double a2 = 0, ab = 0, ac = 0, ad = 0, b2 = 0, bc = 0, bd = 0, c2 = 0, cd = 0, d2 = 0;
+  double weight = 0;
+
+  static Quadric fromPlane(double a, double b, double c, double d, double weight) {
+    return {weight * a * a, weight * a * b, weight * a * c, weight * a * d, weight * b * b,
+            weight * b * c, weight * b * d, weight * c * c, weight * c * d, weight * d * d,
+            weight};
+  }
+
+  Quadric& operator+=(const Quadric& other) {
+    a2 += other.a2, ab += other.ab, ac += other.ac, ad += other.ad, b2 += other.b2;
+    bc += other.bc, bd += other.bd, c2 += other.c2, cd += other.cd, d2 += other.d2;
+    weight += other.weight;
+    return *this;
+  }
+
+  // Area-weighted mean squared distance to the accumulated planes
+  [[nodiscard]] double error(const Vec3& p) const {
+    if (weight <= 0.0) {
+      return 0.0;
+    }
+    const double x = p[0];
+    const double y = p[1];
+    const double z = p[2];
+    return ((a2 * x * x) + (2 * ab * x * y) + (2 * ac * x * z) + (2 * ad * x) + (b2 * y * y) +
+            (2 * bc * y * z) + (2 * bd * y) + (c2 * z * z) + (2 * cd * z) + d2) /
+           weight;
+  }
+};
+
+Vec3 sub(const Vec3& lhs, const Vec3& rhs) {
+  return {lhs[0] - rhs[0], lhs[1] - rhs[1], lhs[2] - rhs[2]};
+}
+Vec3 cross(const Vec3& lhs, const Vec3& rhs) {
+  return {(lhs[1] * rhs[2]) - (lhs[2] * rhs[1]), (lhs[2] * rhs[0]) - (lhs[0] * rhs[2]),
+          (lhs[0] * rhs[1]) - (lhs[1] * rhs[0])};
+}
+double dot(const Vec3& lhs, const Vec3& rhs) {
+  return (lhs[0] * rhs[0]) + (lhs[1] * rhs[1]) + (lhs[2] * rhs[2]);
+}
+
+std::uint64_t edgeKey(std::uint32_t v0, std::uint32_t v1) {
+  return (static_cast<std::uint64_t>(std::min(v0, v1)) << 32U) | std::max(v0, v1);
+}
+
+struct Collapse {
+  std::uint32_t from;
+  std::uint32_t to;
+  double cost;
+};
+} // namespace
+
+float MeshSimplifier::extent(const MeshData& meshData) {
+  const auto& positions = meshData.positions;
+  if (positions.size() < 3) {
+    return 0.0F;
+  }
+  std::array<float, 3> lo = {positions[0], positions[1], positions[2]};
+  std::array<float, 3> hi = lo;
+  for (std::size_t i = 0; i + 2 < positions.size(); i += 3) {
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      lo[axis] = std::min(lo[axis], positions[i + axis]);
+      hi[axis] = std::max(hi[axis], positions[i + axis]);
+    }
+  }
+  return std::max({hi[0] - lo[0], hi[1] - lo[1], hi[2] - lo[2]});
+}
+
+SimplifyResult MeshSimplifier::simplify(const MeshData& meshData,
+                                        std::span<const std::uint32_t> indices,
+                                        std::size_t targetIndexCount, float targetError) {
+  SimplifyResult result;
+  result.indices.assign(indices.begin(), indices.end());
+
+  const std::size_t vertexCount = meshData.positions.size() / 3;
+  const float meshExtent = extent(meshData);
+  if (vertexCount == 0 || indices.size() < 3 || meshExtent <= 0.0F) {
+    return result;
+  }
+
+  // Positions normalised to unit extent; errors are then relative
+  const double invExtent = 1.0 / meshExtent;
+  std::vector<Vec3> position(vertexCount);
+  for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+    for (std::size_t axis = 0; axis < 3; ++axis) {
+      position[vertex][axis] = meshData.positions[(vertex * 3) + axis] * invExtent;
+    }
+  }
+
+  // Per-vertex quadrics from area-weighted triangle planes
+  std::vector<Quadric> quadric(vertexCount);
+  std::unordered_map<std::uint64_t, int> edgeUse;
+  edgeUse.reserve(indices.size());
+  for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+    const std::array<std::uint32_t, 3> tri = {indices[i], indices[i + 1], indices[i + 2]};
+    const Vec3 normal =
+        cross(sub(position[tri[1]], position[tri[0]]), sub(position[tri[2]], position[tri[0]]));
+    const double length = std::sqrt(dot(normal, normal));
+    if (length > 0.0) {
+      const Vec3 unit = {normal[0] / length, normal[1] / length, normal[2] / length};
+      const auto plane = Quadric::fromPlane(unit[0], unit[1], unit[2], -dot(unit, position[tri[0]]),
+                                            length * 0.5);
+      for (auto vertex : tri) {
+        quadric[vertex] += plane;
+      }
+    }
+    for (int corner = 0; corner < 3; ++corner) {
+      ++edgeUse[edgeKey(tri[corner], tri[(corner + 1) % 3])];
+    }
+  }
+
+  // Open borders and attribute seams keep the silhouette and UV layout intact
+  std::vector<bool> locked(vertexCount, false);
+  for (const auto& [key, uses] : edgeUse) {
+    if (uses == 1) {
+      locked[key >> 32U] = true;
+      locked[key & 0xFFFFFFFFU] = true;
+    }
+  }
+
+  const double maxCost = static_cast<double>(targetError) * targetError;
+  std::vector<std::uint32_t> remap(vertexCount);
+  std::vector<bool> touched(vertexCount);
+  std::vector<std::vector<std::uint32_t>> vertexTriangles(vertexCount);
+  std::vector<Collapse> collapses;
+  double worstCost = 0.0;
+
+  auto& current = result.indices;
+  while (current.size() > targetIndexCount) {
+    // Vertex -> triangles for flip checks
+    for (auto& list : vertexTriangles) {
+      list.clear();
+    }
+    for (std::uint32_t i = 0; i + 2 < current.size(); i += 3) {
+      for (int corner = 0; corner < 3; ++corner) {
+        vertexTriangles[current[i + corner]].push_back(i);
+      }
+    }
+
+    // Cheapest direction of every edge
+    collapses.clear();
+    for (std::size_t i = 0; i + 2 < current.size(); i += 3) {
+      for (int corner = 0; corner < 3; ++corner) {
+        const auto v0 = current[i + corner];
+        const auto v1 = current[i + ((corner + 1) % 3)];
+        if (v0 > v1 && !locked[v0] && !locked[v1]) {
+          continue; // Interior edges are seen twice; evaluate once
+        }
+        Quadric merged = quadric[v0];
+        merged += quadric[v1];
+        Collapse best{0, 0, std::numeric_limits<double>::max()};
+        if (!locked[v0]) {
+          best = {v0, v1, merged.error(position[v1])};
+        }
+        if (!locked[v1]) {
+          const double cost = merged.error(position[v0]);
+          if (cost < best.cost) {
+            best = {v1, v0, cost};
+          }
+        }
+        best.cost = std::max(best.cost, 0.0); // Rounding
+        if (best.cost <= maxCost) {
+          collapses.push_back(best);
+        }
+      }
+    }
+    if (collapses.empty()) {
+      break;
+    }
+    std::sort(collapses.begin(), collapses.end(),
+              [](const Collapse& lhs, const Collapse& rhs) { return lhs.cost < rhs.cost; });
+
+    // Greedy independent collapses; ~2 triangles removed each
+    for (std::uint32_t vertex = 0; vertex < vertexCount; ++vertex) {
+      remap[vertex] = vertex;
+    }
+    std::fill(touched.begin(), touched.end(), false);
+    std::size_t removable = (current.size() - targetIndexCount) / 3;
+    std::size_t applied = 0;
+
+    for (const auto& collapse : collapses) {
+      if (removable == 0) {
+        break;
+      }
+      if (touched[collapse.from] || touched[collapse.to]) {
+        continue;
+      }
+
+      // Reject collapses that flip a surviving triangle
+      bool flips = false;
+      for (auto tri : vertexTriangles[collapse.from]) {
+        std::array<std::uint32_t, 3> corners = {current[tri], current[tri + 1], current[tri + 2]};
+        if (std::ranges::find(corners, collapse.to) != corners.end()) {
+          continue; // Degenerates; removed
+        }
+        const Vec3 before = cross(sub(position[corners[1]], position[corners[0]]),
+                                  sub(position[corners[2]], position[corners[0]]));
+        std::ranges::replace(corners, collapse.from, collapse.to);
+        const Vec3 after = cross(sub(position[corners[1]], position[corners[0]]),
+                                 sub(position[corners[2]], position[corners[0]]));
+        if (dot(before, after) <= 0.0) {
+          flips = true;
+          break;
+        }
+      }
+      if (flips) {
+        continue;
+      }
+
+      // Lock the one-ring so this pass's collapses stay independent
+      for (auto tri : vertexTriangles[collapse.from]) {
+        for (int corner = 0; corner < 3; ++corner) {
+          touched[current[tri + corner]] = true;
+        }
+      }
+      remap[collapse.from] = collapse.to;
+      quadric[collapse.to] += quadric[collapse.from];
+      worstCost = std::max(worstCost, collapse.cost);
+      removable = removable > 2 ? removable - 2 : 0;
+      ++applied;
+    }
+    if (applied == 0) {
+      break;
+    }
+
+    // Rewrite and drop degenerate triangles
+    std::size_t write = 0;
+    for (std::size_t i = 0; i + 2 < current.size(); i += 3) {
+      const auto v0 = remap[current[i]];
+      const auto v1 = remap[current[i + 1]];
+      const auto v2 = remap[current[i + 2]];
+      if (v0 == v1 || v1 == v2 || v0 == v2) {
+        continue;
+      }
+      current[write++] = v0;
+      current[write++] = v1;
+      current[write++] = v2;
+    }
+    current.resize(write);
+  }
+
+  result.error = static_cast<float>(std::sqrt(worstCost));
+  return result;
+}
+
+} // namespace blkhurst
@@ -0,0 +1,186 @@
+#include <blkhurst/geometry/meshlet.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <spdlog/spdlog.h>
+
+namespace blkhurst {
+
+namespace {
+constexpr float kMinConeDot = 0.1F; // Wider spreads (~84 deg) rarely cull; disable the cone
+
+glm::vec3 positionAt(const MeshData& meshData, std::uint32_t vertex) {
+  const std::size_t base = static_cast<std::size_t>(vertex) * 3;
+  return {meshData.positions[base], meshData.positions[base + 1], meshData.positions[base + 2]};
+}
+} // namespace
+
+MeshletBuildResult MeshletBuilder::build(const MeshData& meshData,
+                                         std::span<const std::uint32_t> indices,
+                                         const MeshletLimits& limits) {
+  MeshletBuildResult result;
+  const std::size_t triangleCount = indices.size() / 3;
+  const std::size_t vertexCount = meshData.positions.size() / 3;
+  if (triangleCount == 0 || vertexCount == 0) {
+    return result;
+  }
+  const auto maxVertices = static_cast<std::uint32_t>(std::max(3, limits.maxVertices));
+  const auto maxTriangles = static_cast<std::uint32_t>(std::max(1, limits.maxTriangles));
+
+  // Vertex -> triangle adjacency (CSR)
+  std::vector<std::uint32_t> adjacencyOffset(vertexCount + 1, 0);
+  for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+    ++adjacencyOffset[indices[i] + 1];
+  }
+  for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+    adjacencyOffset[vertex + 1] += adjacencyOffset[vertex];
+  }
+  std::vector<std::uint32_t> adjacency(triangleCount * 3);
+  {
+    std::vector<std::uint32_t> cursor(adjacencyOffset.begin(), adjacencyOffset.end() - 1);
+    for (std::size_t i = 0; i < triangleCount * 3; ++i) {
+      adjacency[cursor[indices[i]]++] = static_cast<std::uint32_t>(i / 3);
+    }
+  }
+
+  result.indices.reserve(triangleCount * 3);
+  result.meshlets.reserve((triangleCount / maxTriangles) + 1);
+
+  std::vector<bool> emitted(triangleCount, false);
+  std::vector<std::uint32_t> vertexMeshlet(vertexCount, 0);      // Meshlet id + 1 using the vertex
+  std::vector<std::uint32_t> candidateMeshlet(triangleCount, 0); // Meshlet id + 1 listing it
+  std::vector<std::uint32_t> candidates;
+  std::size_t seedCursor = 0;
+
+  Meshlet current;
+  auto currentId = [&] { return static_cast<std::uint32_t>(result.meshlets.size() + 1); };
+  auto newVertices = [&](std::size_t triangle) {
+    const auto id = currentId();
+    std::uint32_t count = 0;
+    for (std::size_t corner = 0; corner < 3; ++corner) {
+      count += vertexMeshlet[indices[(triangle * 3) + corner]] != id ? 1U : 0U;
+    }
+    return count;
+  };
+  auto flush = [&] {
+    if (current.indexCount == 0) {
+      return;
+    }
+    computeBounds(meshData,
+                  std::span(result.indices).subspan(current.indexOffset, current.indexCount),
+                  current);
+    result.meshlets.push_back(current);
+    current = {};
+    current.indexOffset = static_cast<std::uint32_t>(result.indices.size());
+    candidates.clear();
+  };
+  auto append = [&](std::size_t triangle) {
+    emitted[triangle] = true;
+    for (std::size_t corner = 0; corner < 3; ++corner) {
+      const auto vertex = indices[(triangle * 3) + corner];
+      if (vertexMeshlet[vertex] != currentId()) {
+        vertexMeshlet[vertex] = currentId();
+        ++current.vertexCount;
+      }
+      result.indices.push_back(vertex);
+      for (auto offset = adjacencyOffset[vertex]; offset < adjacencyOffset[vertex + 1]; ++offset) {
+        const auto neighbour = adjacency[offset];
+        if (!emitted[neighbour] && candidateMeshlet[neighbour] != currentId()) {
+          candidateMeshlet[neighbour] = currentId();
+          candidates.push_back(neighbour);
+        }
+      }
+    }
+    current.indexCount += 3;
+  };
+
+  for (std::size_t written = 0; written < triangleCount; ++written) {
+    // Best adjacent triangle: fewest vertices new to this meshlet
+    std::size_t best = triangleCount;
+    std::uint32_t bestCost = 4;
+    std::size_t keep = 0;
+    for (auto triangle : candidates) {
+      if (emitted[triangle]) {
+        continue;
+      }
+      candidates[keep++] = triangle;
+      if (bestCost == 0) {
+        continue; // Closes a fan; nothing scores better, just compact the rest
+      }
+      const auto cost = newVertices(triangle);
+      if (cost < bestCost) {
+        best = triangle;
+        bestCost = cost;
+      }
+    }
+    candidates.resize(keep);
+
+    const bool full = current.indexCount / 3 >= maxTriangles;
+    if (full || best == triangleCount || current.vertexCount + bestCost > maxVertices) {
+      flush();
+      while (emitted[seedCursor]) {
+        ++seedCursor;
+      }
+      best = seedCursor;
+    }
+    append(best);
+  }
+  flush();
+
+  spdlog::debug("MeshletBuilder: {} triangles -> {} meshlets", triangleCount,
+                result.meshlets.size());
+  return result;
+}
+
+void MeshletBuilder::computeBounds(const MeshData& meshData,
+                                   std::span<const std::uint32_t> indices, Meshlet& meshlet) {
+  if (indices.size() < 3) {
+    return;
+  }
+
+  // Sphere: box centre, farthest vertex
+  glm::vec3 lo = positionAt(meshData, indices[0]);
+  glm::vec3 hi = lo;
+  for (auto vertex : indices) {
+    const glm::vec3 point = positionAt(meshData, vertex);
+    lo = glm::min(lo, point);
+    hi = glm::max(hi, point);
+  }
+  meshlet.center = (lo + hi) * 0.5F;
+  float radiusSq = 0.0F;
+  for (auto vertex : indices) {
+    const glm::vec3 offset = positionAt(meshData, vertex) - meshlet.center;
+    radiusSq = std::max(radiusSq, glm::dot(offset, offset));
+  }
+  meshlet.radius = std::sqrt(radiusSq);
+
+  // Cone: mean face normal; cutoff from the widest deviation
+  std::vector<glm::vec3> normals;
+  normals.reserve(indices.size() / 3);
+  glm::vec3 axis(0.0F);
+  for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+    const glm::vec3 p0 = positionAt(meshData, indices[i]);
+    const glm::vec3 normal = glm::cross(positionAt(meshData, indices[i + 1]) - p0,
+                                        positionAt(meshData, indices[i + 2]) - p0);
+    const float length = glm::length(normal);
+    if (length > 0.0F) {
+      normals.push_back(normal / length);
+      axis += normals.back();
+    }
+  }
+  meshlet.coneCutoff = 1.0F;
+  const float axisLength = glm::length(axis);
+  if (normals.empty() || axisLength <= 0.0F) {
+    return;
+  }
+  meshlet.coneAxis = axis / axisLength;
+  float minDot = 1.0F;
+  for (const auto& normal : normals) {
+    minDot = std::min(minDot, glm::dot(normal, meshlet.coneAxis));
+  }
+  if (minDot > kMinConeDot) {
+    meshlet.coneCutoff = std::sqrt(1.0F - (minDot * minDot));
+  }
+}
+
+} // namespace blkhurst
@@ -0,0 +1,315 @@
+#include <blkhurst/geometry/vertex_layout.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+namespace blkhurst {
+
+VertexLayout& VertexLayout::add(Attrib attrib, VertexFormat format) {
+  elements.push_back({attrib, format, stride});
+  stride += formatSize(format);
+  return *this;
+}
+
+const VertexElement* VertexLayout::find(Attrib attrib) const {
+  auto found = std::ranges::find(elements, attrib, &VertexElement::attrib);
+  return found == elements.end() ? nullptr : &*found;
+}
+
+VertexLayout VertexLayout::standard() {
+  VertexLayout layout;
+  layout.add(Attrib::Position, VertexFormat::Float3)
+      .add(Attrib::Uv, VertexFormat::Float2)
+      .add(Attrib::Normal, VertexFormat::Snorm1010102);
+  return layout;
+}
+
+VertexLayout VertexLayout::compact() {
+  VertexLayout layout;
+  layout.add(Attrib::Position, VertexFormat::Half4)
+      .add(Attrib::Uv, VertexFormat::Half2)
+      .add(Attrib::Normal, VertexFormat::Snorm1010102);
+  return layout;
+}
+
+std::uint32_t VertexLayout::formatSize(VertexFormat format) {
+  switch (format) {
+  case VertexFormat::Float1:
+    return 4;
+  case VertexFormat::Float2:
+    return 8;
+  case VertexFormat::Float3:
+    return 12;
+  case VertexFormat::Float4:
+    return 16;
+  case VertexFormat::Half2:
+    return 4;
+  case VertexFormat::Half4:
+    return 8;
+  case VertexFormat::Unorm8x4:
+  case VertexFormat::Snorm1010102:
+    return 4;
+  }
+  return 0;
+}
+
+int VertexLayout::componentCount(VertexFormat format) {
+  switch (format) {
+  case VertexFormat::Float1:
+    return 1;
+  case VertexFormat::Float2:
+  case VertexFormat::Half2:
+    return 2;
+  case VertexFormat::Float3:
+    return 3;
+  case VertexFormat::Float4:
+  case VertexFormat::Half4:
+  case VertexFormat::Unorm8x4:
+  case VertexFormat::Snorm1010102:
+    return 4;
+  }
+  return 0;
+}
+
+namespace vertex_encode {
+
+// Round-to-nearest-even float -> IEEE half
+std::uint16_t toHalf(float value) {
+  const auto bits = std::bit_cast<std::uint32_t>(value);
+  const auto sign = static_cast<std::uint16_t>((bits >> 16U) & 0x8000U);
+  const std::uint32_t absBits = bits & 0x7FFFFFFFU;
+
+  if (absBits >= 0x7F800000U) { // Inf / NaN
+    return sign | 0x7C00U | (absBits > 0x7F800000U ? 0x0200U : 0U);
+  }
+  if (absBits >= 0x477FF000U) { // >= 65520 rounds to Inf
+    return sign | 0x7C00U;
+  }
+  if (absBits < 0x38800000U) { // Below 2^-14; half subnormal or zero
+    if (absBits < 0x33000000U) {
+      return sign;
+    }
+    const std::uint32_t exponent = absBits >> 23U;
+    const std::uint32_t mantissa = (absBits & 0x7FFFFFU) | 0x800000U;
+    const std::uint32_t shift = 126U - exponent;
+    std::uint32_t half = mantissa >> shift;
+    const std::uint32_t remainder = mantissa & ((1U << shift) - 1U);
+    const std::uint32_t halfway = 1U << (shift - 1U);
+    if (remainder > halfway || (remainder == halfway && (half & 1U) != 0U)) {
+      ++half;
+    }
+    return sign | static_cast<std::uint16_t>(half);
+  }
+
+  // Normal; rebias exponent (127 -> 15) and round the dropped 13 bits
+  std::uint32_t half = (absBits - 0x38000000U) >> 13U;
+  const std::uint32_t remainder = absBits & 0x1FFFU;
+  if (remainder > 0x1000U || (remainder == 0x1000U && (half & 1U) != 0U)) {
+    ++half;
+  }
+  return sign | static_cast<std::uint16_t>(half);
+}
+
+float fromHalf(std::uint16_t half) {
+  const std::uint32_t sign = static_cast<std::uint32_t>(half & 0x8000U) << 16U;
+  const std::uint32_t exponent = (half >> 10U) & 0x1FU;
+  const std::uint32_t mantissa = half & 0x3FFU;
+
+  if (exponent == 0x1FU) { // Inf / NaN
+    return std::bit_cast<float>(sign | 0x7F800000U | (mantissa << 13U));
+  }
+  if (exponent == 0) { // Zero or subnormal; exact in float
+    const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+    return sign != 0 ? -magnitude : magnitude;
+  }
+  return std::bit_cast<float>(sign | ((exponent + 112U) << 23U) | (mantissa << 13U));
+}
+
+std::uint32_t toSnorm1010102(float x, float y, float z) {
+  auto pack = [](float value) {
+    const auto scaled = std::lround(std::clamp(value, -1.0F, 1.0F) * 511.0F);
+    return static_cast<std::uint32_t>(scaled) & 0x3FFU;
+  };
+  return pack(x) | (pack(y) << 10U) | (pack(z) << 20U); // w = 0
+}
+
+std::uint32_t toUnorm8x4(float r, float g, float b, float a) {
+  auto pack = [](float value) {
+    return static_cast<std::uint32_t>(std::lround(std::clamp(value, 0.0F, 1.0F) * 255.0F));
+  };
+  return pack(r) | (pack(g) << 8U) | (pack(b) << 16U) | (pack(a) << 24U);
+}
+
+namespace {
+struct Source {
+  const std::vector<float>* data = nullptr;
+  int components = 0;
+};
+
+Source sourceFor(const MeshData& meshData, Attrib attrib) {
+  switch (attrib) {
+  case Attrib::Position:
+    return {&meshData.positions, 3};
+  case Attrib::Uv:
+    return {&meshData.uvs, 2};
+  case Attrib::Normal:
+    return {&meshData.normals, 3};
+  default:
+    return {};
+  }
+}
+
+struct Target {
+  std::vector<float>* data = nullptr;
+  int components = 0;
+};
+
+Target targetFor(MeshData& meshData, Attrib attrib) {
+  switch (attrib) {
+  case Attrib::Position:
+    return {&meshData.positions, 3};
+  case Attrib::Uv:
+    return {&meshData.uvs, 2};
+  case Attrib::Normal:
+    return {&meshData.normals, 3};
+  default:
+    return {};
+  }
+}
+
+void readElement(const std::byte* src, VertexFormat format, float* values) {
+  switch (format) {
+  case VertexFormat::Float1:
+  case VertexFormat::Float2:
+  case VertexFormat::Float3:
+  case VertexFormat::Float4:
+    std::memcpy(values, src, VertexLayout::formatSize(format));
+    break;
+  case VertexFormat::Half2:
+  case VertexFormat::Half4: {
+    const int count = VertexLayout::componentCount(format);
+    for (int i = 0; i < count; ++i) {
+      std::uint16_t half = 0;
+      std::memcpy(&half, src + (i * sizeof(half)), sizeof(half));
+      values[i] = fromHalf(half);
+    }
+    break;
+  }
+  case VertexFormat::Unorm8x4: {
+    std::uint32_t packed = 0;
+    std::memcpy(&packed, src, sizeof(packed));
+    for (unsigned i = 0; i < 4; ++i) {
+      values[i] = static_cast<float>((packed >> (i * 8U)) & 0xFFU) / 255.0F;
+    }
+    break;
+  }
+  case VertexFormat::Snorm1010102: {
+    std::uint32_t packed = 0;
+    std::memcpy(&packed, src, sizeof(packed));
+    for (unsigned i = 0; i < 3; ++i) {
+      // Sign-extend 10 bits; -512 clamps to -1 as in GL
+      const auto raw = static_cast<std::int32_t>(((packed >> (i * 10U)) & 0x3FFU) << 22U) >> 22;
+      values[i] = std::max(static_cast<float>(raw) / 511.0F, -1.0F);
+    }
+    values[3] = 0.0F;
+    break;
+  }
+  }
+}
+
+void writeElement(std::byte* dst, VertexFormat format, const float* values) {
+  switch (format) {
+  case VertexFormat::Float1:
+  case VertexFormat::Float2:
+  case VertexFormat::Float3:
+  case VertexFormat::Float4:
+    std::memcpy(dst, values, VertexLayout::formatSize(format));
+    break;
+  case VertexFormat::Half2:
+  case VertexFormat::Half4: {
+    const int count = VertexLayout::componentCount(format);
+    for (int i = 0; i < count; ++i) {
+      const std::uint16_t half = toHalf(values[i]);
+      std::memcpy(dst + (i * sizeof(half)), &half, sizeof(half));
+    }
+    break;
+  }
+  case VertexFormat::Unorm8x4: {
+    const std::uint32_t packed = toUnorm8x4(values[0], values[1], values[2], values[3]);
+    std::memcpy(dst, &packed, sizeof(packed));
+    break;
+  }
+  case VertexFormat::Snorm1010102: {
+    const std::uint32_t packed = toSnorm1010102(values[0], values[1], values[2]);
+    std::memcpy(dst, &packed, sizeof(packed));
+    break;
+  }
+  }
+}
+} // namespace
+
+std::vector<std::byte> interleave(const MeshData& meshData, const VertexLayout& layout) {
+  const std::size_t vertexCount = meshData.positions.size() / 3;
+  std::vector<std::byte> out(vertexCount * layout.stride);
+
+  for (const auto& element : layout.elements) {
+    const Source source = sourceFor(meshData, element.attrib);
+    const bool hasSource =
+        source.data != nullptr && source.data->size() >= vertexCount * source.components;
+
+    for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+      // Missing components: 0, except w (and Color) default to 1
+      float values[4] = {0.0F, 0.0F, 0.0F, 1.0F}; // NOLINT
+      if (element.attrib == Attrib::Color) {
+        values[0] = values[1] = values[2] = 1.0F;
+      }
+      if (hasSource) {
+        const float* src = source.data->data() + (vertex * source.components);
+        std::copy_n(src, source.components, values);
+      }
+      writeElement(out.data() + (vertex * layout.stride) + element.offset, element.format, values);
+    }
+  }
+  return out;
+}
+
+MeshData deinterleave(std::span<const std::byte> vertices, const VertexLayout& layout) {
+  MeshData meshData;
+  if (layout.stride == 0) {
+    return meshData;
+  }
+  const std::size_t vertexCount = vertices.size() / layout.stride;
+
+  for (const auto& element : layout.elements) {
+    const Target target = targetFor(meshData, element.attrib);
+    if (target.data == nullptr) {
+      continue;
+    }
+    target.data->resize(vertexCount * target.components);
+    for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+      float values[4] = {0.0F, 0.0F, 0.0F, 0.0F}; // NOLINT
+      readElement(vertices.data() + (vertex * layout.stride) + element.offset, element.format,
+                  values);
+      std::copy_n(values, target.components, target.data->data() + (vertex * target.components));
+    }
+  }
+  return meshData;
+}
+
+bool narrowIndices(std::span<const std::uint32_t> indices, std::vector<std::uint16_t>& out) {
+  const bool fits = std::all_of(indices.begin(), indices.end(), [](std::uint32_t index) {
+    return index <= std::numeric_limits<std::uint16_t>::max();
+  });
+  if (!fits) {
+    return false;
+  }
+  out.assign(indices.begin(), indices.end());
+  return true;
+}
+
+} // namespace vertex_encode
+
+} // namespace blkhurst
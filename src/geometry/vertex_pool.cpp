@@ -0,0 +1,205 @@
+#include <blkhurst/geometry/vertex_pool.hpp>
+#include <blkhurst/renderer/uniform_blocks.hpp>
+
+#include <algorithm>
+#include <glad/gl.h>
+#include <spdlog/spdlog.h>
+#include <vector>
+
+namespace blkhurst {
+
+VertexPool::VertexPool()
+    : vertices_(std::make_unique<Buffer>(
+          nullptr, static_cast<intptr_t>(kInitialVertices * kFloatsPerVertex * sizeof(float)))),
+      indices_(std::make_unique<Buffer>(
+          nullptr, static_cast<intptr_t>(kInitialIndices * sizeof(std::uint32_t)))) {
+  vao_.setElementBuffer(indices_->id());
+  spdlog::debug("VertexPool created ({} vertices, {} indices)", kInitialVertices,
+                kInitialIndices);
+}
+
+VertexPool::~VertexPool() {
+  spdlog::debug("VertexPool destroyed");
+}
+
+std::shared_ptr<VertexPool> VertexPool::shared() {
+  static std::weak_ptr<VertexPool> current;
+  auto pool = current.lock();
+  if (!pool) {
+    pool = std::make_shared<VertexPool>();
+    current = pool;
+  }
+  return pool;
+}
+
+VertexPoolAllocation VertexPool::allocate(const MeshData& meshData,
+                                          std::span<const std::uint32_t> indices) {
+  const auto vertexCount = static_cast<std::uint32_t>(meshData.positions.size() / 3);
+  const auto indexCount = static_cast<std::uint32_t>(indices.size());
+
+  VertexPoolAllocation allocation;
+  allocation.vertices = {reserve_(freeVertices_, vertices_, vertexCount,
+                                  kFloatsPerVertex * sizeof(float)),
+                         vertexCount};
+  allocation.indices = {
+      reserve_(freeIndices_, indices_, indexCount, sizeof(std::uint32_t)), indexCount};
+  vao_.setElementBuffer(indices_->id()); // Replaced when the index buffer grew
+
+  const bool hasNormals = meshData.normals.size() >= meshData.positions.size();
+  const bool hasUvs = meshData.uvs.size() / 2 >= vertexCount;
+  std::vector<float> packed(static_cast<std::size_t>(vertexCount) * kFloatsPerVertex, 0.0F);
+  for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+    float* out = packed.data() + (vertex * kFloatsPerVertex);
+    std::copy_n(meshData.positions.data() + (vertex * 3), 3, out);
+    if (hasNormals) {
+      std::copy_n(meshData.normals.data() + (vertex * 3), 3, out + 3);
+    }
+    if (hasUvs) {
+      std::copy_n(meshData.uvs.data() + (vertex * 2), 2, out + 6);
+    }
+  }
+  if (vertexCount > 0) {
+    vertices_->setSubData(
+        static_cast<intptr_t>(allocation.vertices.first * kFloatsPerVertex * sizeof(float)),
+        packed.data(), static_cast<intptr_t>(packed.size() * sizeof(float)));
+  }
+  if (indexCount > 0) {
+    indices_->setSubData(static_cast<intptr_t>(allocation.indices.first * sizeof(std::uint32_t)),
+                         indices.data(), static_cast<intptr_t>(indices.size_bytes()));
+  }
+
+  spdlog::trace("VertexPool allocate vertices=[{}, +{}) indices=[{}, +{})",
+                allocation.vertices.first, vertexCount, allocation.indices.first, indexCount);
+  return allocation;
+}
+
+void VertexPool::release(const VertexPoolAllocation& allocation) {
+  freeVertices_.release(allocation.vertices.first, allocation.vertices.count);
+  freeIndices_.release(allocation.indices.first, allocation.indices.count);
+}
+
+MeshData VertexPool::read(const VertexPoolAllocation& allocation) const {
+  const std::size_t vertexCount = allocation.vertices.count;
+  std::vector<float> packed(vertexCount * kFloatsPerVertex);
+  MeshData meshData;
+  meshData.indices.resize(allocation.indices.count);
+  if (vertexCount > 0) {
+    vertices_->getSubData(
+        static_cast<intptr_t>(allocation.vertices.first * kFloatsPerVertex * sizeof(float)),
+        packed.data(), static_cast<intptr_t>(packed.size() * sizeof(float)));
+  }
+  if (!meshData.indices.empty()) {
+    indices_->getSubData(static_cast<intptr_t>(allocation.indices.first * sizeof(std::uint32_t)),
+                         meshData.indices.data(),
+                         static_cast<intptr_t>(meshData.indices.size() * sizeof(std::uint32_t)));
+  }
+
+  meshData.positions.resize(vertexCount * 3);
+  meshData.normals.resize(vertexCount * 3);
+  meshData.uvs.resize(vertexCount * 2);
+  for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+    const float* in = packed.data() + (vertex * kFloatsPerVertex);
+    std::copy_n(in, 3, meshData.positions.data() + (vertex * 3));
+    std::copy_n(in + 3, 3, meshData.normals.data() + (vertex * 3));
+    std::copy_n(in + 6, 2, meshData.uvs.data() + (vertex * 2));
+  }
+  return meshData;
+}
+
+void VertexPool::bind() const {
+  vao_.bind();
+  glBindBufferBase(GL_SHADER_STORAGE_BUFFER, static_cast<GLuint>(UniformBinding::Vertices),
+                   vertices_->id());
+}
+
+const VertexArray& VertexPool::vertexArray() const {
+  return vao_;
+}
+
+std::uint32_t VertexPool::vertexCapacity() const {
+  return freeVertices_.capacity();
+}
+
+std::uint32_t VertexPool::indexCapacity() const {
+  return freeIndices_.capacity();
+}
+
+std::uint32_t VertexPool::usedVertices() const {
+  return freeVertices_.used();
+}
+
+std::uint32_t VertexPool::usedIndices() const {
+  return freeIndices_.used();
+}
+
+// Grows buffer (doubling, copying the old contents on the GPU) until count fits
+std::uint32_t VertexPool::reserve_(FreeList& list, std::unique_ptr<Buffer>& buffer,
+                                   std::uint32_t count, std::size_t elementBytes) {
+  if (count == 0) {
+    return 0;
+  }
+  auto first = list.allocate(count);
+  while (!first) {
+    const std::uint32_t capacity = list.capacity();
+    const std::uint32_t newCapacity = std::max(capacity * 2, capacity + count);
+    auto grown =
+        std::make_unique<Buffer>(nullptr, static_cast<intptr_t>(newCapacity * elementBytes));
+    glCopyNamedBufferSubData(buffer->id(), grown->id(), 0, 0, buffer->size());
+    buffer = std::move(grown);
+    list.grow(newCapacity);
+    spdlog::debug("VertexPool grew {} -> {} elements", capacity, newCapacity);
+    first = list.allocate(count);
+  }
+  return *first;
+}
+
+// ------- FreeList -------
+VertexPool::FreeList::FreeList(std::uint32_t capacity)
+    : capacity_(capacity) {
+  free_.emplace(0, capacity);
+}
+
+std::optional<std::uint32_t> VertexPool::FreeList::allocate(std::uint32_t count) {
+  auto span = std::ranges::find_if(free_, [count](const auto& entry) {
+    return entry.second >= count;
+  });
+  if (span == free_.end()) {
+    return std::nullopt;
+  }
+  const auto [first, size] = *span;
+  free_.erase(span);
+  if (size > count) {
+    free_.emplace(first + count, size - count);
+  }
+  used_ += count;
+  return first;
+}
+
+void VertexPool::FreeList::release(std::uint32_t first, std::uint32_t count) {
+  if (count == 0) {
+    return;
+  }
+  used_ -= count;
+  auto inserted = free_.emplace(first, count).first;
+  // Merge with the following span, then the preceding one
+  if (auto next = std::next(inserted); next != free_.end() && first + count == next->first) {
+    inserted->second += next->second;
+    free_.erase(next);
+  }
+  if (inserted != free_.begin()) {
+    auto previous = std::prev(inserted);
+    if (previous->first + previous->second == first) {
+      previous->second += inserted->second;
+      free_.erase(inserted);
+    }
+  }
+}
+
+void VertexPool::FreeList::grow(std::uint32_t newCapacity) {
+  const std::uint32_t added = newCapacity - capacity_;
+  used_ += added; // release() subtracts it again
+  capacity_ = newCapacity;
+  release(newCapacity - added, added);
+}
+
+} // namespace blkhurst
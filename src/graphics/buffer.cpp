@@ -5,7 +5,8 @@
 namespace blkhurst {
 
 Buffer::Buffer(const void* data, GLsizeiptr sizeBytes, bool dynamic)
-    : size_(sizeBytes) {
+    : size_(sizeBytes),
+      dynamic_(dynamic) {
   glCreateBuffers(1, &id_);
   glNamedBufferData(id_, sizeBytes, data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
   spdlog::trace("Buffer({}) created size={}B dynamic={}", id_, sizeBytes, dynamic);
@@ -21,6 +22,7 @@ Buffer::~Buffer() {
 
 void Buffer::setData(const void* data, GLsizeiptr sizeBytes, bool dynamic) {
   size_ = sizeBytes;
+  dynamic_ = dynamic;
   glNamedBufferData(id_, sizeBytes, data, dynamic ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
   spdlog::trace("Buffer({}) setData size={}B dynamic={}", id_, sizeBytes, dynamic);
 }
@@ -31,4 +33,25 @@ void Buffer::setSubData(GLintptr offsetBytes, const void* data, GLsizeiptr sizeB
   spdlog::trace("Buffer({}) setSubData offset={}B size={}B", id_, offsetBytes, sizeBytes);
 }
 
+void Buffer::orphan() {
+  glNamedBufferData(id_, size_, nullptr, dynamic_ ? GL_DYNAMIC_DRAW : GL_STATIC_DRAW);
+  spdlog::trace("Buffer({}) orphaned size={}B", id_, size_);
+}
+
+void* Buffer::mapRange(GLintptr offsetBytes, GLsizeiptr sizeBytes) {
+  assert(offsetBytes + sizeBytes <= size_ && "mapRange out of range");
+  return glMapNamedBufferRange(id_, offsetBytes, sizeBytes, GL_MAP_WRITE_BIT);
+}
+
+void Buffer::unmap() {
+  if (glUnmapNamedBuffer(id_) == GL_FALSE) {
+    spdlog::warn("Buffer({}) contents lost while mapped", id_);
+  }
+}
+
+void Buffer::getSubData(GLintptr offsetBytes, void* data, GLsizeiptr sizeBytes) const {
+  assert(offsetBytes + sizeBytes <= size_ && "getSubData out of range");
+  glGetNamedBufferSubData(id_, offsetBytes, sizeBytes, data);
+}
+
 } // namespace blkhurst
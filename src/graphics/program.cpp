@@ -2,6 +2,7 @@
 #include <blkhurst/shaders/shader_preprocessor.hpp>
 #include <blkhurst/util/assets.hpp>
 
+#include <algorithm>
 #include <glad/gl.h>
 #include <spdlog/spdlog.h>
 #include <string>
@@ -59,6 +60,7 @@ void Program::addDefine(const std::string& define) {
   if (std::find(desc_.defines.begin(), desc_.defines.end(), define) == desc_.defines.end()) {
     desc_.defines.push_back(define);
     needsUpdate_ = true;
+    refreshVariants_();
     spdlog::trace("Program({}) addDefine({})", id_, define);
   }
 }
@@ -68,6 +70,7 @@ void Program::removeDefine(const std::string& define) {
   if (found != desc_.defines.end()) {
     desc_.defines.erase(found, desc_.defines.end());
     needsUpdate_ = true;
+    refreshVariants_();
     spdlog::trace("Program({}) removeDefine({})", id_, define);
   }
 }
@@ -78,17 +81,52 @@ void Program::setDefines(std::vector<std::string> defines) {
   if (defines != desc_.defines) {
     desc_.defines = std::move(defines);
     needsUpdate_ = true;
+    refreshVariants_();
     spdlog::trace("Program({}) setDefines(...)", id_);
   }
 }
 
+Program& Program::variant(std::string_view defines) {
+  if (auto found = variants_.find(defines); found != variants_.end()) {
+    return *found->second.program;
+  }
+
+  Variant entry;
+  std::size_t begin = 0;
+  while (begin < defines.size()) {
+    const std::size_t end = std::min(defines.find(' ', begin), defines.size());
+    if (end > begin) {
+      entry.defines.emplace_back(defines.substr(begin, end - begin));
+    }
+    begin = end + 1;
+  }
+  entry.program = std::make_unique<Program>(desc_);
+  entry.program->sourceKind_ = sourceKind_;
+  auto& variantDefines = entry.program->desc_.defines;
+  variantDefines.insert(variantDefines.end(), entry.defines.begin(), entry.defines.end());
+  spdlog::trace("Program({}) variant({}) created", id_, defines);
+
+  Program& program = *entry.program;
+  variants_.emplace(std::string(defines), std::move(entry));
+  return program;
+}
+
+void Program::refreshVariants_() {
+  for (auto& [key, entry] : variants_) {
+    auto& variantDefines = entry.program->desc_.defines;
+    variantDefines = desc_.defines;
+    variantDefines.insert(variantDefines.end(), entry.defines.begin(), entry.defines.end());
+    entry.program->needsUpdate_ = true;
+  }
+}
+
 // Cache response of "glGetUniformLocation" (expensive)
 int Program::uniformLocation(std::string_view name) const {
-  auto key = std::string(name);
-  auto found = uniformCache_.find(key);
+  auto found = uniformCache_.find(name);
   if (found != uniformCache_.end()) {
     return found->second;
   }
+  auto key = std::string(name);
   int loc = glGetUniformLocation(id_, key.c_str());
   uniformCache_.emplace(std::move(key), loc);
   return loc;
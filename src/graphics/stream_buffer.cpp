@@ -0,0 +1,121 @@
+#include <blkhurst/graphics/stream_buffer.hpp>
+#include <glad/gl.h>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+
+namespace {
+constexpr GLintptr kRegionAlignment = 256; // Covers vertex, uniform and storage offset alignment
+constexpr GLuint64 kWaitTimeoutNs = 1'000'000;
+std::uint64_t gDrawEpoch = 0; // NOLINT; advanced by StreamBuffer::markDrawn on the GL thread
+
+GLsync toSync(void* fence) {
+  return static_cast<GLsync>(fence);
+}
+} // namespace
+
+namespace blkhurst {
+
+StreamBuffer::StreamBuffer(const void* data, GLsizeiptr regionBytes, int regionCount)
+    : regionSize_(regionBytes),
+      regionStride_((regionBytes + kRegionAlignment - 1) / kRegionAlignment * kRegionAlignment),
+      regionCount_(std::max(1, regionCount)),
+      fences_(static_cast<std::size_t>(regionCount_), nullptr),
+      shadow_(static_cast<std::size_t>(regionBytes)) {
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  const GLsizeiptr totalBytes = regionStride_ * regionCount_;
+
+  glCreateBuffers(1, &id_);
+  glNamedBufferStorage(id_, totalBytes, nullptr, flags);
+  mapped_ = static_cast<std::byte*>(glMapNamedBufferRange(id_, 0, totalBytes, flags));
+  if (mapped_ == nullptr) {
+    spdlog::error("StreamBuffer({}) persistent map failed", id_);
+    return;
+  }
+  if (data != nullptr) {
+    std::memcpy(shadow_.data(), data, shadow_.size());
+  }
+  std::memcpy(region_(0), shadow_.data(), shadow_.size());
+  spdlog::trace("StreamBuffer({}) created region={}B regions={}", id_, regionSize_, regionCount_);
+}
+
+StreamBuffer::~StreamBuffer() {
+  for (auto* fence : fences_) {
+    if (fence != nullptr) {
+      glDeleteSync(toSync(fence));
+    }
+  }
+  if (id_ != 0U) {
+    if (mapped_ != nullptr) {
+      glUnmapNamedBuffer(id_);
+    }
+    glDeleteBuffers(1, &id_);
+    spdlog::trace("StreamBuffer({}) deleted", id_);
+  }
+}
+
+void StreamBuffer::write(GLintptr offsetBytes, const void* data, GLsizeiptr sizeBytes) {
+  assert(offsetBytes >= 0 && offsetBytes + sizeBytes <= regionSize_ && "write out of range");
+  if (mapped_ == nullptr) {
+    return;
+  }
+
+  // Writes with no draw in between patch one region, so many small updates cost one fence; the
+  // first write after a draw moves on, as that draw may still read the current region
+  std::memcpy(shadow_.data() + offsetBytes, data, static_cast<std::size_t>(sizeBytes));
+  if (writtenEpoch_ != gDrawEpoch) {
+    rotate_();
+    writtenEpoch_ = gDrawEpoch;
+    if (offsetBytes != 0 || sizeBytes != regionSize_) {
+      // Carry the rest over from the CPU copy; the mapping is write-only (and write-combined)
+      std::memcpy(region_(current_), shadow_.data(), shadow_.size());
+      return;
+    }
+  }
+  std::memcpy(region_(current_) + offsetBytes, data, static_cast<std::size_t>(sizeBytes));
+}
+
+void StreamBuffer::markDrawn() {
+  ++gDrawEpoch;
+}
+
+void StreamBuffer::rotate_() {
+  // Draws issued since the last rotation read the current region; fence it before moving on
+  if (fences_[current_] != nullptr) {
+    glDeleteSync(toSync(fences_[current_]));
+  }
+  fences_[current_] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+  current_ = (current_ + 1) % regionCount_;
+  waitRegion_(current_);
+}
+
+void StreamBuffer::waitRegion_(int region) {
+  auto* fence = fences_[region];
+  if (fence == nullptr) {
+    return;
+  }
+
+  // Flush on every wait so the fence is guaranteed to reach the GPU
+  GLenum result = glClientWaitSync(toSync(fence), 0, 0);
+  if (result != GL_ALREADY_SIGNALED) {
+    ++stalls_;
+    while (result == GL_TIMEOUT_EXPIRED) {
+      result = glClientWaitSync(toSync(fence), GL_SYNC_FLUSH_COMMANDS_BIT, kWaitTimeoutNs);
+    }
+    if (result == GL_WAIT_FAILED) {
+      spdlog::error("StreamBuffer({}) fence wait failed", id_);
+    }
+  }
+
+  glDeleteSync(toSync(fence));
+  fences_[region] = nullptr;
+}
+
+std::byte* StreamBuffer::region_(int region) const {
+  return mapped_ + (regionStride_ * region);
+}
+
+} // namespace blkhurst
@@ -46,6 +46,20 @@ void VertexArray::linkAttribFloat(GLuint attribIndex, GLuint bindingIndex, GLint
       attribIndex, bindingIndex, componentCount, normalised, relativeOffset);
 }
 
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void VertexArray::linkAttribFormat(GLuint attribIndex, GLuint bindingIndex, GLint componentCount,
+                                   GLenum glType, bool normalised, GLuint relativeOffset) const {
+  assert(componentCount >= 1 && componentCount <= 4);
+  const GLboolean norm = normalised ? GL_TRUE : GL_FALSE;
+
+  glEnableVertexArrayAttrib(id_, attribIndex);
+  glVertexArrayAttribBinding(id_, attribIndex, bindingIndex);
+  glVertexArrayAttribFormat(id_, attribIndex, componentCount, glType, norm, relativeOffset);
+  spdlog::trace("VertexArray({}) links attrib={} to binding={} | count={} type={:#x} normalised={} "
+                "relOffset={}",
+                id_, attribIndex, bindingIndex, componentCount, glType, normalised, relativeOffset);
+}
+
 void VertexArray::setElementBuffer(GLuint bufferId) {
   glVertexArrayElementBuffer(id_, bufferId);
   spdlog::trace("VertexArray({}) set ElementBuffer({})", id_, bufferId);
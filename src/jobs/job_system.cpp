@@ -0,0 +1,289 @@
+#include <blkhurst/jobs/job_system.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <utility>
+
+namespace blkhurst {
+
+namespace {
+// Worker identity; owner guards against several JobSystems in one process
+thread_local const JobSystem* tlsOwner = nullptr;
+thread_local std::size_t tlsWorkerIndex = 0;
+} // namespace
+
+// TaskGroup
+
+TaskGroup::TaskGroup()
+    : state_(std::make_shared<State>()) {
+}
+
+void TaskGroup::then(std::function<void()> continuation, TaskAffinity affinity) {
+  std::unique_lock lock(state_->continuationMutex);
+  if (state_->pending.load(std::memory_order_acquire) == 0) {
+    lock.unlock();
+    dispatch_(state_->system.load(std::memory_order_relaxed), std::move(continuation), affinity);
+    return;
+  }
+  state_->continuation = std::move(continuation);
+  state_->continuationAffinity = affinity;
+}
+
+bool TaskGroup::done() const {
+  return state_->pending.load(std::memory_order_acquire) == 0;
+}
+
+void TaskGroup::onTaskFinished_(State& state) {
+  if (state.pending.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+
+  std::unique_lock lock(state.continuationMutex);
+  auto continuation = std::exchange(state.continuation, nullptr);
+  const auto affinity = state.continuationAffinity;
+  lock.unlock();
+
+  if (continuation) {
+    dispatch_(state.system.load(std::memory_order_relaxed), std::move(continuation), affinity);
+  }
+}
+
+void TaskGroup::dispatch_(JobSystem* system, std::function<void()> continuation,
+                          TaskAffinity affinity) {
+  if (system == nullptr) {
+    continuation();
+  } else if (affinity == TaskAffinity::MainThread) {
+    system->submitMainThread(std::move(continuation));
+  } else {
+    system->submit(std::move(continuation));
+  }
+}
+
+// JobSystem
+
+JobSystem::JobSystem(int workerThreads)
+    : mainThreadId_(std::this_thread::get_id()) {
+  const auto count = static_cast<std::size_t>(std::max(0, workerThreads));
+  queues_.reserve(count + 1);
+  for (std::size_t i = 0; i < count + 1; ++i) {
+    queues_.push_back(std::make_unique<WorkQueue>());
+  }
+  workers_.reserve(count);
+  for (std::size_t i = 0; i < count; ++i) {
+    workers_.emplace_back([this, i]() { workerLoop_(i); });
+  }
+  spdlog::debug("JobSystem started {} worker threads", workers_.size());
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::scoped_lock lock(sleepMutex_);
+    stopping_ = true;
+  }
+  wakeCv_.notify_all();
+  for (auto& worker : workers_) {
+    worker.join();
+  }
+  // Workers only stop once the queues are empty; without any, whatever is left runs here
+  while (tryRunOne_(injectionIndex_())) {
+  }
+  if (!mainQueue_.empty()) {
+    spdlog::warn("JobSystem dropped {} pending main-thread tasks", mainQueue_.size());
+  }
+  spdlog::debug("JobSystem stopped");
+}
+
+void JobSystem::submit(Task task) {
+  push_(Job{std::move(task), nullptr});
+}
+
+void JobSystem::submit(TaskGroup& group, Task task) {
+  push_(Job{std::move(task), join_(group, this)});
+}
+
+void JobSystem::submitMainThread(Task task) {
+  std::scoped_lock lock(mainQueueMutex_);
+  mainQueue_.push_back(Job{std::move(task), nullptr});
+}
+
+void JobSystem::submitMainThread(TaskGroup& group, Task task) {
+  auto state = join_(group, this);
+  std::scoped_lock lock(mainQueueMutex_);
+  mainQueue_.push_back(Job{std::move(task), std::move(state)});
+}
+
+void JobSystem::wait(TaskGroup& group) {
+  const bool mainThread = isMainThread();
+  const std::size_t self = currentIndex_();
+  while (!group.done()) {
+    if (mainThread) {
+      runMainThreadTasks();
+    }
+    // Help instead of blocking; nested waits inside tasks cannot deadlock
+    if (!tryRunOne_(self)) {
+      std::this_thread::yield();
+    }
+  }
+}
+
+void JobSystem::parallelFor(std::size_t count, std::size_t grain,
+                            const std::function<void(std::size_t, std::size_t)>& func) {
+  if (count == 0) {
+    return;
+  }
+  grain = std::max<std::size_t>(1, grain);
+  if (workers_.empty() || count <= grain) {
+    // Serial, but keep the chunk contract; callers may size scratch by grain
+    for (std::size_t begin = 0; begin < count; begin += grain) {
+      func(begin, std::min(count, begin + grain));
+    }
+    return;
+  }
+
+  // Queue all but the first chunk, which the caller runs directly
+  TaskGroup group;
+  for (std::size_t begin = grain; begin < count; begin += grain) {
+    const std::size_t end = std::min(count, begin + grain);
+    submit(group, [&func, begin, end]() { func(begin, end); });
+  }
+  func(0, grain);
+  wait(group);
+}
+
+void JobSystem::parallelFor(std::size_t count, const std::function<void(std::size_t)>& func) {
+  // A few chunks per thread so stealing can even out uneven work
+  const std::size_t chunks = (workers_.size() + 1) * 4;
+  const std::size_t grain = std::max<std::size_t>(1, count / chunks);
+  parallelFor(count, grain, [&func](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      func(i);
+    }
+  });
+}
+
+void JobSystem::runMainThreadTasks() {
+  if (!isMainThread()) {
+    spdlog::error("JobSystem::runMainThreadTasks called off the main thread");
+    return;
+  }
+
+  // Without workers nothing else would run submit()ed tasks; those queued so far run first, so
+  // main-thread work they post (e.g. TextureLoader::loadAsync) completes in the same call
+  if (workers_.empty()) {
+    for (int queued = queuedJobs_.load(std::memory_order_acquire);
+         queued > 0 && tryRunOne_(injectionIndex_()); --queued) {
+    }
+  }
+
+  // Swap out; tasks queued while running are picked up next call
+  std::vector<Job> jobs;
+  {
+    std::scoped_lock lock(mainQueueMutex_);
+    jobs.swap(mainQueue_);
+  }
+  for (auto& job : jobs) {
+    run_(job);
+  }
+}
+
+int JobSystem::workerCount() const {
+  return static_cast<int>(workers_.size());
+}
+
+bool JobSystem::isMainThread() const {
+  return std::this_thread::get_id() == mainThreadId_;
+}
+
+// Internal
+
+void JobSystem::push_(Job job) {
+  {
+    auto& queue = *queues_[currentIndex_()];
+    std::scoped_lock lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  }
+  queuedJobs_.fetch_add(1, std::memory_order_release);
+
+  // Empty critical section orders the increment against a worker's predicate check
+  { std::scoped_lock lock(sleepMutex_); }
+  wakeCv_.notify_one();
+}
+
+std::shared_ptr<TaskGroup::State> JobSystem::join_(TaskGroup& group, JobSystem* system) {
+  group.state_->system.store(system, std::memory_order_relaxed);
+  group.state_->pending.fetch_add(1, std::memory_order_relaxed);
+  return group.state_;
+}
+
+bool JobSystem::tryRunOne_(std::size_t selfIndex) {
+  Job job;
+  if (!popOwn_(selfIndex, job) && !steal_(selfIndex, job)) {
+    return false;
+  }
+  queuedJobs_.fetch_sub(1, std::memory_order_relaxed);
+  run_(job);
+  return true;
+}
+
+bool JobSystem::popOwn_(std::size_t selfIndex, Job& out) {
+  auto& queue = *queues_[selfIndex];
+  std::scoped_lock lock(queue.mutex);
+  if (queue.jobs.empty()) {
+    return false;
+  }
+  // Newest first; its data is most likely still in cache
+  out = std::move(queue.jobs.back());
+  queue.jobs.pop_back();
+  return true;
+}
+
+bool JobSystem::steal_(std::size_t selfIndex, Job& out) {
+  const std::size_t queueCount = queues_.size();
+  for (std::size_t offset = 1; offset < queueCount; ++offset) {
+    auto& queue = *queues_[(selfIndex + offset) % queueCount];
+    std::scoped_lock lock(queue.mutex);
+    if (queue.jobs.empty()) {
+      continue;
+    }
+    // Oldest first; tends to be the largest remaining piece of work
+    out = std::move(queue.jobs.front());
+    queue.jobs.pop_front();
+    return true;
+  }
+  return false;
+}
+
+void JobSystem::run_(Job& job) {
+  job.task();
+  if (job.group != nullptr) {
+    TaskGroup::onTaskFinished_(*job.group);
+  }
+}
+
+void JobSystem::workerLoop_(std::size_t index) {
+  tlsOwner = this;
+  tlsWorkerIndex = index;
+
+  while (true) {
+    if (tryRunOne_(index)) {
+      continue;
+    }
+    std::unique_lock lock(sleepMutex_);
+    wakeCv_.wait(lock, [this]() {
+      return stopping_ || queuedJobs_.load(std::memory_order_acquire) > 0;
+    });
+    if (stopping_ && queuedJobs_.load(std::memory_order_acquire) == 0) {
+      return;
+    }
+  }
+}
+
+std::size_t JobSystem::injectionIndex_() const {
+  return queues_.size() - 1;
+}
+
+std::size_t JobSystem::currentIndex_() const {
+  return tlsOwner == this ? tlsWorkerIndex : injectionIndex_();
+}
+
+} // namespace blkhurst
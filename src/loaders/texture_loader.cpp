@@ -1,3 +1,4 @@
+#include <blkhurst/jobs/job_system.hpp>
 #include <blkhurst/loaders/texture_loader.hpp>
 #include <blkhurst/textures/texture.hpp>
 #include <blkhurst/util/assets.hpp>
@@ -28,7 +29,8 @@ LoadedPixels TextureLoader::readPixels(const std::string& absPath, bool flipY,
                                        int desiredChannels) {
   LoadedPixels out{};
 
-  stbi_set_flip_vertically_on_load(flipY ? 1 : 0);
+  // Per-thread flag; loaders may run on JobSystem workers
+  stbi_set_flip_vertically_on_load_thread(flipY ? 1 : 0);
 
   int width = 0;
   int height = 0;
@@ -74,6 +76,41 @@ std::shared_ptr<Texture> TextureLoader::load(const std::string& path,
     return makeFallback_();
   }
 
+  return createTexture_(pixels, *resolvedPath, desc);
+}
+
+void TextureLoader::loadAsync(JobSystem& jobs, const std::string& path,
+                              std::function<void(std::shared_ptr<Texture>)> onLoaded,
+                              const TextureLoaderDesc& desc) {
+  // Resolve on the caller; assets search paths are not synchronised
+  auto resolvedPath = assets::find(path);
+  if (!resolvedPath) {
+    spdlog::error("TextureLoader asset not found ({})", path);
+    onLoaded(makeFallback_());
+    return;
+  }
+
+  jobs.submit([&jobs, absPath = *resolvedPath, onLoaded = std::move(onLoaded), desc]() mutable {
+    const int outputChannels = 4;
+    LoadedPixels pixels = readPixels(absPath, desc.flipY, outputChannels);
+
+    // GL objects must be created on the main thread
+    jobs.submitMainThread([pixels, absPath = std::move(absPath), onLoaded = std::move(onLoaded),
+                           desc]() mutable {
+      if (!pixels.valid()) {
+        spdlog::error("TextureLoader failed to load ({})", absPath);
+        pixels.free();
+        onLoaded(makeFallback_());
+        return;
+      }
+      onLoaded(createTexture_(pixels, absPath, desc));
+    });
+  });
+}
+
+std::shared_ptr<Texture> TextureLoader::createTexture_(LoadedPixels& pixels,
+                                                       const std::string& absPath,
+                                                       const TextureLoaderDesc& desc) {
   // Pick Format
   TextureFormat outputFormat = desc.srgb ? TextureFormat::SRGB8_ALPHA8 : TextureFormat::RGBA8;
   if (pixels.isFloat) {
@@ -101,7 +138,7 @@ std::shared_ptr<Texture> TextureLoader::load(const std::string& path,
   // Free pixels
   pixels.free();
 
-  spdlog::debug("TextureLoader loaded '{}' ({}x{}, ch={}, hdr={}, srgb={})", *resolvedPath,
+  spdlog::debug("TextureLoader loaded '{}' ({}x{}, ch={}, hdr={}, srgb={})", absPath,
                 texture->width(), texture->height(), pixels.channels, pixels.isFloat, desc.srgb);
   return texture;
 }
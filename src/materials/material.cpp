@@ -22,14 +22,19 @@ std::shared_ptr<Material> Material::create(std::shared_ptr<Program> prog) {
 
 void Material::useProgram() const {
   // Program rebuilds if needed on use()
+  activeProgram_ = program_.get();
   program_->use();
 }
+void Material::useProgram(std::string_view variantDefines) const {
+  activeProgram_ = variantDefines.empty() ? program_.get() : &program_->variant(variantDefines);
+  activeProgram_->use();
+}
 void Material::applyUniformsAndResources() {
   applyResources();
   applyUniforms();
 }
 
-std::shared_ptr<Program> Material::program() const {
+const std::shared_ptr<Program>& Material::program() const {
   return program_;
 }
 const PipelineState& Material::pipeline() const {
@@ -50,30 +55,41 @@ void Material::setBlend(bool enabled) {
 void Material::setCullFace(CullFace face) {
   pipeline_.cull = face;
 }
+void Material::setDepthPrepass(bool enabled) {
+  pipeline_.depthPrepass = enabled;
+}
 
-void Material::setUniform(const std::string& name, int value) {
-  uniforms_[name] = value;
+void Material::setUniform(std::string_view name, int value) {
+  storeUniform_(name, value);
+}
+void Material::setUniform(std::string_view name, float value) {
+  storeUniform_(name, value);
 }
-void Material::setUniform(const std::string& name, float value) {
-  uniforms_[name] = value;
+void Material::setUniform(std::string_view name, const glm::vec2& value) {
+  storeUniform_(name, value);
 }
-void Material::setUniform(const std::string& name, const glm::vec2& value) {
-  uniforms_[name] = value;
+void Material::setUniform(std::string_view name, const glm::vec3& value) {
+  storeUniform_(name, value);
 }
-void Material::setUniform(const std::string& name, const glm::vec3& value) {
-  uniforms_[name] = value;
+void Material::setUniform(std::string_view name, const glm::vec4& value) {
+  storeUniform_(name, value);
 }
-void Material::setUniform(const std::string& name, const glm::vec4& value) {
-  uniforms_[name] = value;
+void Material::setUniform(std::string_view name, const glm::mat3& value) {
+  storeUniform_(name, value);
 }
-void Material::setUniform(const std::string& name, const glm::mat3& value) {
-  uniforms_[name] = value;
+void Material::setUniform(std::string_view name, const glm::mat2& value) {
+  storeUniform_(name, value);
 }
-void Material::setUniform(const std::string& name, const glm::mat2& value) {
-  uniforms_[name] = value;
+void Material::setUniform(std::string_view name, const glm::mat4& value) {
+  storeUniform_(name, value);
 }
-void Material::setUniform(const std::string& name, const glm::mat4& value) {
-  uniforms_[name] = value;
+
+void Material::storeUniform_(std::string_view name, const UniformValue& value) {
+  if (auto found = uniforms_.find(name); found != uniforms_.end()) {
+    found->second = value;
+    return;
+  }
+  uniforms_.emplace(std::string(name), value);
 }
 
 void Material::setDefine(const std::string& def, bool enabled) {
@@ -98,12 +114,13 @@ void Material::linkStorageBlock(const std::string& name, unsigned binding) const
 }
 
 void Material::applyUniforms() const {
+  Program& program = activeProgram_ != nullptr ? *activeProgram_ : *program_;
   for (const auto& [name, val] : uniforms_) {
-    applyUniform(*program_, name, val);
+    applyUniform(program, name, val);
   }
 }
 
-void Material::bindTextureUnit(const std::shared_ptr<Texture>& tex, const std::string& uniformName,
+void Material::bindTextureUnit(const std::shared_ptr<Texture>& tex, std::string_view uniformName,
                                int slot) {
   if (tex) {
     setUniform(uniformName, slot);
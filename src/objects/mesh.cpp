@@ -1,4 +1,5 @@
 #include <algorithm>
+#include <blkhurst/cameras/camera.hpp>
 #include <blkhurst/objects/mesh.hpp>
 #include <spdlog/spdlog.h>
 
@@ -17,11 +18,11 @@ Mesh::~Mesh() {
   spdlog::trace("Mesh({}) destroyed", uuid());
 }
 
-std::shared_ptr<Geometry> Mesh::geometry() const {
+const std::shared_ptr<Geometry>& Mesh::geometry() const {
   return geometry_;
 }
 
-std::shared_ptr<Material> Mesh::material() const {
+const std::shared_ptr<Material>& Mesh::material() const {
   return material_;
 }
 
@@ -33,8 +34,69 @@ bool Mesh::wireframe() const {
   return wireframe_;
 }
 
+bool Mesh::batched() const {
+  return batched_;
+}
+
+bool Mesh::occluder() const {
+  return occluder_;
+}
+
+const LodPolicy& Mesh::lodPolicy() const {
+  return lodPolicy_;
+}
+
+std::optional<Aabb> Mesh::worldBounds() const {
+  if (!geometry_ || geometry_->boundingSphere().radius <= 0.0F || instanceCount_ > 1) {
+    return std::nullopt;
+  }
+  const glm::mat4& world = worldMatrix();
+  const float scale = std::max({glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1])),
+                                glm::length(glm::vec3(world[2]))});
+  const auto& sphere = geometry_->boundingSphere();
+  const glm::vec3 center(world * glm::vec4(sphere.center, 1.0F));
+  const glm::vec3 radius(sphere.radius * scale);
+  return Aabb{center - radius, center + radius};
+}
+
+int Mesh::selectLod(const Camera& camera, float viewportHeight) const {
+  const int levels = geometry_ ? geometry_->lodCount() : 0;
+  if (levels <= 1 || !lodPolicy_.enabled) {
+    return 0;
+  }
+  if (lodPolicy_.forcedLevel >= 0) {
+    return std::min(lodPolicy_.forcedLevel, levels - 1);
+  }
+
+  // World-space size of one object-space unit; largest axis scale
+  const glm::mat4& world = worldMatrix();
+  const float scale = std::max({glm::length(glm::vec3(world[0])), glm::length(glm::vec3(world[1])),
+                                glm::length(glm::vec3(world[2]))});
+
+  // Pixels per world unit at the bounding sphere's nearest point
+  const float projectionScale = camera.projectionMatrix()[1][1] * 0.5F * viewportHeight;
+  float pixelsPerUnit = projectionScale;
+  if (!camera.isOrthographic()) {
+    const auto& sphere = geometry_->boundingSphere();
+    const glm::vec3 center = glm::vec3(world * glm::vec4(sphere.center, 1.0F));
+    const float distance = glm::length(center - camera.worldPosition()) - (sphere.radius * scale);
+    constexpr float kMinDistance = 1e-3F;
+    pixelsPerUnit /= std::max(distance, kMinDistance);
+  }
+
+  int level = 0;
+  for (int candidate = 1; candidate < levels; ++candidate) {
+    if (geometry_->lod(candidate).error * scale * pixelsPerUnit > lodPolicy_.maxPixelError) {
+      break;
+    }
+    level = candidate;
+  }
+  return level;
+}
+
 void Mesh::setGeometry(std::shared_ptr<Geometry> geometry) {
   geometry_ = std::move(geometry);
+  boundsChanged_();
   spdlog::trace("Mesh({}) setGeometry {}", uuid(), geometry_ ? "OK" : "null");
 }
 
@@ -45,6 +107,7 @@ void Mesh::setMaterial(std::shared_ptr<Material> material) {
 
 void Mesh::setInstanceCount(int count) {
   instanceCount_ = std::max(1, count);
+  boundsChanged_(); // Instanced meshes are not culled by bounds
   spdlog::trace("Mesh({}) setInstanceCount {}", uuid(), instanceCount_);
 }
 
@@ -53,18 +116,36 @@ void Mesh::setWireframe(bool enabled) {
   spdlog::trace("Mesh({}) setWireframe {}", uuid(), wireframe_);
 }
 
+void Mesh::setLodPolicy(const LodPolicy& policy) {
+  lodPolicy_ = policy;
+  spdlog::trace("Mesh({}) setLodPolicy enabled={} maxPixelError={:.2f}", uuid(), policy.enabled,
+                policy.maxPixelError);
+}
+
+void Mesh::setBatched(bool batched) {
+  batched_ = batched;
+}
+
+void Mesh::setOccluder(bool occluder) {
+  occluder_ = occluder;
+  spdlog::trace("Mesh({}) setOccluder {}", uuid(), occluder_);
+}
+
 // Shallow copy of Geometry and Material
 std::unique_ptr<Mesh> Mesh::clone(bool recursive) const {
   auto copy = std::make_unique<Mesh>(geometry_, material_);
   // Copy Object3D state
   copy->setName(name());
   copy->setVisible(visible());
+  copy->setStatic(isStatic()); // Not batched until the Scene is rebaked
   copy->setPosition(position());
   copy->setRotation(rotation());
   copy->setScale(scale());
   // Copy Mesh state; sets needsUpdate_ internally
   copy->setInstanceCount(instanceCount_);
   copy->setWireframe(wireframe_);
+  copy->setLodPolicy(lodPolicy_);
+  copy->setOccluder(occluder_);
 
   if (recursive) {
     for (const auto& child : children()) {
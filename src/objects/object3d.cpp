@@ -1,8 +1,10 @@
 #include <blkhurst/objects/object3d.hpp>
 #define GLM_ENABLE_EXPERIMENTAL
+#include <algorithm>
 #include <glm/gtx/orthonormalize.hpp>
 #include <random>
 #include <spdlog/spdlog.h>
+#include <utility>
 
 /**
  * Object3D
@@ -10,8 +12,10 @@
  * - Stores TRS (Translation, Rotation, Scale) independently to edit/interpolate
  *   without losing original state.
  * - worldMatrix = parent.worldMatrix * localModelMatrix, enabling grouping.
- * - needsUpdate propagates to children; world rebuilt lazily.
+ * - needsUpdate propagates to children; world rebuilt lazily, or eagerly via updateWorldMatrix.
  * - `lookAt` orients +Z towards target, -Z towards target for Cameras & Lights.
+ * - Attach/detach/rename notify the graph root, allowing Scene to keep lookup indices.
+ * - Transform changes notify the root per dirtied node (Scene spatial index refits).
  */
 
 namespace {
@@ -30,10 +34,79 @@ void Object3D::onUpdate(const RootState& /*state*/) {
   // Default
 }
 
+bool Object3D::updateEnabled() const {
+  return updateEnabled_;
+}
+
+void Object3D::setUpdateEnabled(bool enabled) {
+  if (updateEnabled_ == enabled) {
+    return;
+  }
+  updateEnabled_ = enabled;
+  if (parent_ != nullptr) {
+    root()->onNodeUpdateChanged_(*this);
+  }
+}
+
+bool Object3D::threadSafeUpdate() const {
+  return threadSafeUpdate_;
+}
+
+void Object3D::setThreadSafeUpdate(bool enabled) {
+  if (threadSafeUpdate_ == enabled) {
+    return;
+  }
+  threadSafeUpdate_ = enabled;
+  if (parent_ != nullptr) {
+    root()->onNodeUpdateChanged_(*this);
+  }
+}
+
+int Object3D::updateInterval() const {
+  return updateInterval_;
+}
+
+void Object3D::setUpdateInterval(int frames) {
+  frames = std::max(1, frames);
+  if (updateInterval_ == frames) {
+    return;
+  }
+  updateInterval_ = frames;
+  if (parent_ != nullptr) {
+    root()->onNodeUpdateChanged_(*this);
+  }
+}
+
+bool Object3D::distanceUpdateLod() const {
+  return distanceUpdateLod_;
+}
+
+void Object3D::setDistanceUpdateLod(bool enabled) {
+  if (distanceUpdateLod_ == enabled) {
+    return;
+  }
+  distanceUpdateLod_ = enabled;
+  if (parent_ != nullptr) {
+    root()->onNodeUpdateChanged_(*this);
+  }
+}
+
+bool Object3D::slicedUpdate() const {
+  return updateInterval_ > 1 || distanceUpdateLod_;
+}
+
 Object3D* Object3D::parent() const {
   return parent_;
 }
 
+Object3D* Object3D::root() {
+  Object3D* node = this;
+  while (node->parent_ != nullptr) {
+    node = node->parent_;
+  }
+  return node;
+}
+
 const std::vector<std::unique_ptr<Object3D>>& Object3D::children() const {
   return children_;
 }
@@ -53,6 +126,10 @@ bool Object3D::visible() const {
   return visible_;
 }
 
+bool Object3D::isStatic() const {
+  return static_;
+}
+
 const glm::vec3& Object3D::position() const {
   return position_;
 }
@@ -88,13 +165,20 @@ glm::vec3 Object3D::worldDirection() const {
 
 void Object3D::setName(std::string n) {
   spdlog::trace("Object3D({}) setName '{}'", uuid_, n);
-  name_ = std::move(n);
+  std::string previousName = std::exchange(name_, std::move(n));
+  if (parent_ != nullptr) {
+    root()->onNodeRenamed_(*this, previousName);
+  }
 }
 
 void Object3D::setVisible(bool visible) {
   visible_ = visible;
 }
 
+void Object3D::setStatic(bool enabled) {
+  static_ = enabled;
+}
+
 void Object3D::setPosition(const glm::vec3& position) {
   position_ = position;
   needsUpdate();
@@ -207,9 +291,26 @@ void Object3D::lookAt(const glm::vec3& targetWorld) {
 
 // Mark this node and children as requiring rebuild on next access.
 void Object3D::needsUpdate() {
+  markDirty_(*root());
+}
+
+void Object3D::markDirty_(Object3D& graphRoot) {
   needsUpdate_ = true;
+  graphRoot.onNodeBoundsChanged_(*this);
   for (auto& child : children_) {
-    child->needsUpdate();
+    child->markDirty_(graphRoot);
+  }
+}
+
+void Object3D::boundsChanged_() {
+  root()->onNodeBoundsChanged_(*this);
+}
+
+// Rebuild dirty matrices top-down, so later reads (possibly from other threads) do not write.
+void Object3D::updateWorldMatrix() const {
+  calculateMatrices();
+  for (const auto& child : children_) {
+    child->updateWorldMatrix();
   }
 }
 
@@ -240,6 +341,11 @@ std::unique_ptr<Object3D> Object3D::clone(bool recursive) const {
   auto copy = std::make_unique<Object3D>();
   copy->name_ = name_;
   copy->visible_ = visible_;
+  copy->static_ = static_;
+  copy->updateEnabled_ = updateEnabled_;
+  copy->threadSafeUpdate_ = threadSafeUpdate_;
+  copy->updateInterval_ = updateInterval_;
+  copy->distanceUpdateLod_ = distanceUpdateLod_;
   copy->position_ = position_;
   copy->rotation_ = rotation_;
   copy->scale_ = scale_;
@@ -264,7 +370,32 @@ Object3D* Object3D::addChild_(std::unique_ptr<Object3D> child) {
   child->needsUpdate();
   spdlog::trace("Object3D({}) add child Object3D({})", uuid_, child->uuid_);
   children_.push_back(std::move(child));
-  return children_.back().get();
+
+  // Notify root of every node in the attached subtree
+  Object3D* added = children_.back().get();
+  Object3D* graphRoot = root();
+  added->traverse([graphRoot](Object3D& node) { graphRoot->onNodeAttached_(node); });
+  return added;
+}
+
+// Detach and return ownership; nullptr if `child` is not a direct child.
+std::unique_ptr<Object3D> Object3D::removeChild(Object3D* child) {
+  auto found = std::find_if(children_.begin(), children_.end(),
+                            [child](const auto& owned) { return owned.get() == child; });
+  if (found == children_.end()) {
+    spdlog::warn("Object3D({}) removeChild called with non-child", uuid_);
+    return nullptr;
+  }
+
+  Object3D* graphRoot = root();
+  child->traverse([graphRoot](Object3D& node) { graphRoot->onNodeDetached_(node); });
+
+  std::unique_ptr<Object3D> removed = std::move(*found);
+  children_.erase(found);
+  removed->parent_ = nullptr;
+  removed->needsUpdate();
+  spdlog::trace("Object3D({}) remove child Object3D({})", uuid_, removed->uuid_);
+  return removed;
 }
 
 } // namespace blkhurst
@@ -0,0 +1,137 @@
+#include <blkhurst/renderer/gpu_picker.hpp>
+#include <blkhurst/renderer/render_target.hpp>
+
+#include <algorithm>
+#include <glad/gl.h>
+#include <limits>
+#include <spdlog/spdlog.h>
+
+namespace {
+GLsync toSync(void* fence) {
+  return static_cast<GLsync>(fence);
+}
+} // namespace
+
+namespace blkhurst {
+
+GpuPicker::GpuPicker(int radius)
+    : radius_(std::max(0, radius)) {
+  const int side = (2 * radius_) + 1;
+  const auto bytes = static_cast<GLsizeiptr>(side * side * sizeof(GLuint));
+  for (auto& slot : slots_) {
+    glCreateBuffers(1, &slot.pbo);
+    glNamedBufferStorage(slot.pbo, bytes, nullptr, GL_MAP_READ_BIT);
+  }
+  spdlog::trace("GpuPicker created region={}x{} slots={}", side, side, kSlots);
+}
+
+GpuPicker::~GpuPicker() {
+  for (auto& slot : slots_) {
+    if (slot.fence != nullptr) {
+      glDeleteSync(toSync(slot.fence));
+    }
+    if (slot.pbo != 0U) {
+      glDeleteBuffers(1, &slot.pbo);
+    }
+  }
+}
+
+bool GpuPicker::request(const RenderTarget& target, std::span<const std::uint64_t> objectIds,
+                        glm::ivec2 pixel) {
+  const auto texture = target.objectIdTexture();
+  if (!texture) {
+    spdlog::warn("GpuPicker::request RenderTarget({}) has no object id attachment", target.id());
+    return false;
+  }
+  if (pixel[0] < 0 || pixel[1] < 0 || pixel[0] >= target.width() || pixel[1] >= target.height()) {
+    return false;
+  }
+  auto free = std::ranges::find(slots_, nullptr, &Slot::fence);
+  if (free == slots_.end()) {
+    return false;
+  }
+
+  // Region clamped to the target
+  const glm::ivec2 lower = glm::max(pixel - radius_, glm::ivec2(0));
+  const glm::ivec2 upper =
+      glm::min(pixel + radius_, glm::ivec2(target.width() - 1, target.height() - 1));
+  Slot& slot = *free;
+  slot.sequence = nextSequence_++;
+  slot.pixel = pixel;
+  slot.origin = lower;
+  slot.size = upper - lower + 1;
+  slot.objectIds.assign(objectIds.begin(), objectIds.end());
+
+  // Into the pack buffer; the copy is queued behind the frame's draws
+  const auto bytes = static_cast<GLsizei>(slot.size[0] * slot.size[1] * sizeof(GLuint));
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.pbo);
+  glGetTextureSubImage(texture->id(), 0, lower[0], lower[1], 0, slot.size[0], slot.size[1], 1,
+                       GL_RED_INTEGER, GL_UNSIGNED_INT, bytes, nullptr);
+  glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+  slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+  return true;
+}
+
+std::optional<PickResult> GpuPicker::poll() {
+  std::optional<PickResult> newest;
+  std::uint64_t newestSequence = lastReturned_;
+  for (auto& slot : slots_) {
+    if (slot.fence == nullptr) {
+      continue;
+    }
+    // Zero timeout; the flush makes sure the fence eventually signals
+    const GLenum status = glClientWaitSync(toSync(slot.fence), GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+    if (status == GL_TIMEOUT_EXPIRED) {
+      continue;
+    }
+    if (status == GL_WAIT_FAILED) {
+      spdlog::error("GpuPicker fence wait failed");
+    } else if (slot.sequence > newestSequence) {
+      newest = resolve_(slot);
+      newestSequence = slot.sequence;
+    }
+    glDeleteSync(toSync(slot.fence));
+    slot.fence = nullptr;
+  }
+  lastReturned_ = newestSequence;
+  return newest;
+}
+
+int GpuPicker::pending() const {
+  return static_cast<int>(std::ranges::count_if(
+      slots_, [](const Slot& slot) { return slot.fence != nullptr; }));
+}
+
+PickResult GpuPicker::resolve_(const Slot& slot) const {
+  PickResult result{.uuid = 0, .pixel = slot.pixel};
+  const auto count = static_cast<GLsizeiptr>(slot.size[0] * slot.size[1]);
+  const auto* ids = static_cast<const GLuint*>(
+      glMapNamedBufferRange(slot.pbo, 0, count * static_cast<GLsizeiptr>(sizeof(GLuint)),
+                            GL_MAP_READ_BIT));
+  if (ids == nullptr) {
+    spdlog::error("GpuPicker readback map failed");
+    return result;
+  }
+
+  GLuint nearestId = 0;
+  int nearestDistance = std::numeric_limits<int>::max();
+  for (int row = 0; row < slot.size[1]; ++row) {
+    for (int column = 0; column < slot.size[0]; ++column) {
+      const GLuint id = ids[(row * slot.size[0]) + column];
+      const glm::ivec2 offset = slot.origin + glm::ivec2(column, row) - slot.pixel;
+      const int distance = (offset[0] * offset[0]) + (offset[1] * offset[1]);
+      if (id != 0U && distance < nearestDistance) {
+        nearestId = id;
+        nearestDistance = distance;
+      }
+    }
+  }
+  glUnmapNamedBuffer(slot.pbo);
+
+  if (nearestId != 0U && nearestId <= slot.objectIds.size()) {
+    result.uuid = slot.objectIds[nearestId - 1];
+  }
+  return result;
+}
+
+} // namespace blkhurst
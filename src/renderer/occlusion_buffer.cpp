@@ -0,0 +1,828 @@
+#include <blkhurst/jobs/job_system.hpp>
+#include <blkhurst/renderer/occlusion_buffer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define BLKHURST_OCCLUSION_SSE2
+#endif
+
+namespace {
+
+constexpr float kEmpty = std::numeric_limits<float>::infinity();
+constexpr float kMinArea = 1e-6F; // Twice the screen area, in pixels; thinner slivers are skipped
+constexpr float kMinW = 1e-6F;
+
+// Just enough of a lane abstraction for the row loops; one float per lane, masks as lanes
+#if defined(__AVX2__)
+constexpr int kLanes = 8;
+constexpr const char* kSimdPath = "AVX2";
+using Lanes = __m256;
+inline Lanes splat(float value) {
+  return _mm256_set1_ps(value);
+}
+inline Lanes ramp() { // Pixel centre offsets
+  return _mm256_setr_ps(0.5F, 1.5F, 2.5F, 3.5F, 4.5F, 5.5F, 6.5F, 7.5F);
+}
+inline Lanes load(const float* source) {
+  return _mm256_loadu_ps(source);
+}
+inline void store(float* target, Lanes value) {
+  _mm256_storeu_ps(target, value);
+}
+inline Lanes add(Lanes lhs, Lanes rhs) {
+  return _mm256_add_ps(lhs, rhs);
+}
+inline Lanes mul(Lanes lhs, Lanes rhs) {
+  return _mm256_mul_ps(lhs, rhs);
+}
+inline Lanes min(Lanes lhs, Lanes rhs) {
+  return _mm256_min_ps(lhs, rhs);
+}
+inline Lanes max(Lanes lhs, Lanes rhs) {
+  return _mm256_max_ps(lhs, rhs);
+}
+inline Lanes greaterEqual(Lanes lhs, Lanes rhs) {
+  return _mm256_cmp_ps(lhs, rhs, _CMP_GE_OQ);
+}
+inline Lanes both(Lanes lhs, Lanes rhs) {
+  return _mm256_and_ps(lhs, rhs);
+}
+inline Lanes either(Lanes lhs, Lanes rhs) {
+  return _mm256_or_ps(lhs, rhs);
+}
+inline Lanes without(Lanes mask, Lanes removed) {
+  return _mm256_andnot_ps(removed, mask);
+}
+inline Lanes select(Lanes mask, Lanes whenSet, Lanes otherwise) {
+  return _mm256_blendv_ps(otherwise, whenSet, mask);
+}
+inline bool any(Lanes mask) {
+  return _mm256_movemask_ps(mask) != 0;
+}
+#elif defined(BLKHURST_OCCLUSION_SSE2)
+constexpr int kLanes = 4;
+constexpr const char* kSimdPath = "SSE2";
+using Lanes = __m128;
+inline Lanes splat(float value) {
+  return _mm_set1_ps(value);
+}
+inline Lanes ramp() {
+  return _mm_setr_ps(0.5F, 1.5F, 2.5F, 3.5F);
+}
+inline Lanes load(const float* source) {
+  return _mm_loadu_ps(source);
+}
+inline void store(float* target, Lanes value) {
+  _mm_storeu_ps(target, value);
+}
+inline Lanes add(Lanes lhs, Lanes rhs) {
+  return _mm_add_ps(lhs, rhs);
+}
+inline Lanes mul(Lanes lhs, Lanes rhs) {
+  return _mm_mul_ps(lhs, rhs);
+}
+inline Lanes min(Lanes lhs, Lanes rhs) {
+  return _mm_min_ps(lhs, rhs);
+}
+inline Lanes max(Lanes lhs, Lanes rhs) {
+  return _mm_max_ps(lhs, rhs);
+}
+inline Lanes greaterEqual(Lanes lhs, Lanes rhs) {
+  return _mm_cmpge_ps(lhs, rhs);
+}
+inline Lanes both(Lanes lhs, Lanes rhs) {
+  return _mm_and_ps(lhs, rhs);
+}
+inline Lanes either(Lanes lhs, Lanes rhs) {
+  return _mm_or_ps(lhs, rhs);
+}
+inline Lanes without(Lanes mask, Lanes removed) {
+  return _mm_andnot_ps(removed, mask);
+}
+inline Lanes select(Lanes mask, Lanes whenSet, Lanes otherwise) { // No blendv before SSE4.1
+  return _mm_or_ps(_mm_and_ps(mask, whenSet), _mm_andnot_ps(mask, otherwise));
+}
+inline bool any(Lanes mask) {
+  return _mm_movemask_ps(mask) != 0;
+}
+#else
+constexpr int kLanes = 1;
+constexpr const char* kSimdPath = "Scalar";
+using Lanes = float;
+inline Lanes splat(float value) {
+  return value;
+}
+inline Lanes ramp() {
+  return 0.5F;
+}
+inline Lanes load(const float* source) {
+  return *source;
+}
+inline void store(float* target, Lanes value) {
+  *target = value;
+}
+inline Lanes add(Lanes lhs, Lanes rhs) {
+  return lhs + rhs;
+}
+inline Lanes mul(Lanes lhs, Lanes rhs) {
+  return lhs * rhs;
+}
+inline Lanes min(Lanes lhs, Lanes rhs) {
+  return std::min(lhs, rhs);
+}
+inline Lanes max(Lanes lhs, Lanes rhs) {
+  return std::max(lhs, rhs);
+}
+inline Lanes greaterEqual(Lanes lhs, Lanes rhs) {
+  return lhs >= rhs ? 1.0F : 0.0F;
+}
+inline Lanes both(Lanes lhs, Lanes rhs) {
+  return lhs * rhs;
+}
+inline Lanes either(Lanes lhs, Lanes rhs) {
+  return std::max(lhs, rhs);
+}
+inline Lanes without(Lanes mask, Lanes removed) {
+  return removed != 0.0F ? 0.0F : mask;
+}
+inline Lanes select(Lanes mask, Lanes whenSet, Lanes otherwise) {
+  return mask != 0.0F ? whenSet : otherwise;
+}
+inline bool any(Lanes mask) {
+  return mask != 0.0F;
+}
+#endif
+
+static_assert(blkhurst::OcclusionBuffer::kTileWidth % kLanes == 0);
+
+// A set mask lane as stored in memory: every bit for the vector paths, 1 for the scalar one
+#if defined(__AVX2__) || defined(BLKHURST_OCCLUSION_SSE2)
+const float kMaskSet = std::bit_cast<float>(0xFFFFFFFFU);
+#else
+constexpr float kMaskSet = 1.0F;
+#endif
+
+int roundUp(int value, int multiple) {
+  return ((std::max(value, 1) + multiple - 1) / multiple) * multiple;
+}
+
+// Homogeneous near plane (z >= -w); up to four vertices out. source[k] is the input edge, by
+// opposite vertex, that output edge k (vertex k to k + 1) lies on, or -1 along the near plane
+int clipNear(const std::array<glm::vec4, 3>& input, std::array<glm::vec4, 4>& output,
+             std::array<int, 4>& source) {
+  int count = 0;
+  for (std::size_t i = 0; i < 3; ++i) {
+    const glm::vec4& current = input[i];
+    const glm::vec4& next = input[(i + 1) % 3];
+    const int edge = static_cast<int>((i + 2) % 3);
+    const float currentDistance = current[2] + current[3];
+    const float nextDistance = next[2] + next[3];
+    if (currentDistance >= 0.0F) {
+      source[count] = edge;
+      output[count++] = current;
+    }
+    // Always from the inside vertex, so triangles sharing the edge get the same point
+    if ((currentDistance >= 0.0F) != (nextDistance >= 0.0F)) {
+      const bool currentInside = currentDistance >= 0.0F;
+      const glm::vec4& inside = currentInside ? current : next;
+      const glm::vec4& outside = currentInside ? next : current;
+      const float insideDistance = currentInside ? currentDistance : nextDistance;
+      const float outsideDistance = currentInside ? nextDistance : currentDistance;
+      const float t = insideDistance / (insideDistance - outsideDistance);
+      source[count] = currentInside ? -1 : edge;
+      output[count++] = inside + ((outside - inside) * t);
+    }
+  }
+  return count;
+}
+
+// Twice the signed screen area of a, b, c
+float doubleArea(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c) {
+  return ((b[0] - a[0]) * (c[1] - a[1])) - ((c[0] - a[0]) * (b[1] - a[1]));
+}
+
+// Depth plane through a, b, c as x slope, y slope and offset; raised by at most half a pixel of
+// each slope, so it gives the farthest depth over the pixel rather than at its centre
+glm::vec3 farthestDepthPlane(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c,
+                             float area) {
+  const float depthX = (((b[2] - a[2]) * (c[1] - a[1])) - ((c[2] - a[2]) * (b[1] - a[1]))) / area;
+  const float depthY = (((c[2] - a[2]) * (b[0] - a[0])) - ((b[2] - a[2]) * (c[0] - a[0]))) / area;
+  return {depthX, depthY,
+          a[2] - (depthX * a[0]) - (depthY * a[1]) +
+              (0.5F * (std::abs(depthX) + std::abs(depthY)))};
+}
+
+// Bit patterns order positions totally, NaNs included; adding zero folds -0 into +0
+std::array<std::uint32_t, 3> positionKey(std::span<const float> positions, std::uint32_t vertex) {
+  return {std::bit_cast<std::uint32_t>(positions[3 * vertex] + 0.0F),
+          std::bit_cast<std::uint32_t>(positions[(3 * vertex) + 1] + 0.0F),
+          std::bit_cast<std::uint32_t>(positions[(3 * vertex) + 2] + 0.0F)};
+}
+
+} // namespace
+
+namespace blkhurst {
+
+OcclusionBuffer::OcclusionBuffer(int width, int height) {
+  resize(width, height);
+}
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+void OcclusionBuffer::resize(int width, int height) {
+  width_ = roundUp(width, kTileWidth);
+  height_ = roundUp(height, kTileHeight);
+  tilesX_ = width_ / kTileWidth;
+  tilesY_ = height_ / kTileHeight;
+  depth_.resize(static_cast<std::size_t>(width_) * static_cast<std::size_t>(height_));
+  tileMax_.resize(static_cast<std::size_t>(tilesX_) * static_cast<std::size_t>(tilesY_));
+  const auto bands = static_cast<std::size_t>((height_ + kBandHeight - 1) / kBandHeight);
+  bins_.resize(bands);
+  silhouetteBins_.resize(bands);
+  scratch_.resize(bands);
+  const auto bandPixels = static_cast<std::size_t>(width_) * kBandHeight;
+  for (auto& scratch : scratch_) {
+    scratch.farthest.assign(bandPixels, std::numeric_limits<float>::lowest());
+    scratch.centre.assign(bandPixels, 0.0F);
+    scratch.blocked.assign(bandPixels, 0.0F);
+  }
+  clear();
+}
+
+void OcclusionBuffer::clear() {
+  std::ranges::fill(depth_, kEmpty);
+  std::ranges::fill(tileMax_, kEmpty);
+  triangles_.clear();
+  silhouettes_.clear();
+  occluderCount_ = 0;
+}
+
+OcclusionBuffer::Adjacency
+OcclusionBuffer::buildAdjacency(std::span<const float> positions,
+                                std::span<const std::uint32_t> indices) {
+  const std::size_t vertexCount = positions.size() / 3;
+  const std::size_t triangleCount = (indices.empty() ? vertexCount : indices.size()) / 3;
+  Adjacency adjacency;
+  adjacency.across.assign(3 * triangleCount, Adjacency::kOpen);
+  adjacency.weld.resize(vertexCount);
+
+  std::vector<std::uint32_t> order(vertexCount);
+  std::iota(order.begin(), order.end(), 0U);
+  std::ranges::sort(order, [&](std::uint32_t lhs, std::uint32_t rhs) {
+    return std::pair(positionKey(positions, lhs), lhs) <
+           std::pair(positionKey(positions, rhs), rhs);
+  });
+  for (std::size_t i = 0; i < vertexCount; ++i) {
+    const std::uint32_t vertex = order[i];
+    const bool same =
+        i > 0 && positionKey(positions, order[i - 1]) == positionKey(positions, vertex);
+    adjacency.weld[vertex] = same ? adjacency.weld[order[i - 1]] : vertex;
+  }
+
+  // Every edge by its welded endpoints; exactly two uses make a pair of neighbours, while open
+  // and non-manifold edges stay open
+  auto corner = [&](std::size_t slot) {
+    return indices.empty() ? static_cast<std::uint32_t>(slot) : indices[slot];
+  };
+  struct EdgeUse {
+    std::uint32_t low;
+    std::uint32_t high;
+    std::uint32_t slot; // 3 * triangle + the opposite corner
+    bool forward;       // Runs from low to high
+  };
+  std::vector<EdgeUse> uses;
+  uses.reserve(3 * triangleCount);
+  bool closed = triangleCount > 0;
+  for (std::size_t triangle = 0; triangle < triangleCount; ++triangle) {
+    const std::size_t first = 3 * triangle;
+    if (corner(first) >= vertexCount || corner(first + 1) >= vertexCount ||
+        corner(first + 2) >= vertexCount) {
+      closed = false;
+      continue;
+    }
+    for (std::size_t edge = 0; edge < 3; ++edge) {
+      const std::uint32_t from = adjacency.weld[corner(first + ((edge + 1) % 3))];
+      const std::uint32_t to = adjacency.weld[corner(first + ((edge + 2) % 3))];
+      if (from != to) {
+        uses.push_back({std::min(from, to), std::max(from, to),
+                        static_cast<std::uint32_t>(first + edge), from < to});
+      }
+    }
+  }
+  std::ranges::sort(uses, [](const EdgeUse& lhs, const EdgeUse& rhs) {
+    return std::tie(lhs.low, lhs.high, lhs.slot) < std::tie(rhs.low, rhs.high, rhs.slot);
+  });
+  for (std::size_t begin = 0; begin < uses.size();) {
+    std::size_t end = begin + 1;
+    while (end < uses.size() && uses[end].low == uses[begin].low &&
+           uses[end].high == uses[begin].high) {
+      ++end;
+    }
+    const EdgeUse& first = uses[begin];
+    const EdgeUse& second = uses[begin + 1 < end ? begin + 1 : begin];
+    if (end - begin == 2 && first.slot / 3 != second.slot / 3) {
+      adjacency.across[first.slot] = corner(second.slot);
+      adjacency.across[second.slot] = corner(first.slot);
+      closed = closed && first.forward != second.forward;
+    } else {
+      closed = false;
+    }
+    begin = end;
+  }
+  adjacency.closed = closed;
+  return adjacency;
+}
+
+void OcclusionBuffer::addOccluder(std::span<const float> positions,
+                                  std::span<const std::uint32_t> indices,
+                                  const glm::mat4& modelViewProjection,
+                                  const Adjacency* adjacency) {
+  const std::size_t vertexCount = positions.size() / 3;
+  const std::size_t triangleCount = (indices.empty() ? vertexCount : indices.size()) / 3;
+  if (adjacency == nullptr || adjacency->across.size() != 3 * triangleCount ||
+      adjacency->weld.size() != vertexCount) {
+    adjacencyScratch_ = buildAdjacency(positions, indices);
+    adjacency = &adjacencyScratch_;
+  }
+
+  clipScratch_.resize(vertexCount);
+  for (std::size_t i = 0; i < vertexCount; ++i) {
+    const glm::vec4 position(positions[3 * i], positions[(3 * i) + 1], positions[(3 * i) + 2],
+                             1.0F);
+    clipScratch_[i] = modelViewProjection * position;
+  }
+
+  for (std::size_t first = 0; first < 3 * triangleCount; first += 3) {
+    std::array<glm::vec4, 3> clip;
+    std::array<EdgeNeighbour, 3> edges;
+    bool valid = true;
+    for (std::size_t i = 0; i < 3 && valid; ++i) {
+      const std::size_t vertex = indices.empty() ? first + i : indices[first + i];
+      valid = vertex < vertexCount;
+      if (valid) {
+        clip[i] = clipScratch_[vertex];
+      }
+      const std::uint32_t across = adjacency->across[first + i];
+      if (across < vertexCount) {
+        edges[i] = {.kind = EdgeNeighbour::Kind::Across, .across = clipScratch_[across]};
+      }
+    }
+    if (valid) {
+      addTriangle_(clip, edges, adjacency->closed);
+    }
+  }
+  ++occluderCount_;
+}
+
+void OcclusionBuffer::addTriangle_(const std::array<glm::vec4, 3>& clip,
+                                   const std::array<EdgeNeighbour, 3>& edges, bool frontOnly) {
+  // Entirely outside one side plane
+  for (int axis = 0; axis < 2; ++axis) {
+    if ((clip[0][axis] > clip[0][3] && clip[1][axis] > clip[1][3] && clip[2][axis] > clip[2][3]) ||
+        (clip[0][axis] < -clip[0][3] && clip[1][axis] < -clip[1][3] &&
+         clip[2][axis] < -clip[2][3])) {
+      return;
+    }
+  }
+
+  const bool inFront = clip[0][2] >= -clip[0][3] && clip[1][2] >= -clip[1][3] &&
+                       clip[2][2] >= -clip[2][3];
+  if (inFront) {
+    setupTriangle_(clip, edges, frontOnly);
+    return;
+  }
+  std::array<glm::vec4, 4> clipped;
+  std::array<int, 4> source{};
+  const int count = clipNear(clip, clipped, source);
+  // Fanned from the first vertex: edges between the pieces lie inside the triangle, the others
+  // keep what was beyond the original edge, and the near plane cut is open
+  auto polygonEdge = [&](int index) {
+    return source[index] < 0 ? EdgeNeighbour{} : edges[source[index]];
+  };
+  const EdgeNeighbour coplanar{.kind = EdgeNeighbour::Kind::Coplanar};
+  for (int i = 1; i + 1 < count; ++i) {
+    setupTriangle_({clipped[0], clipped[i], clipped[i + 1]},
+                   {polygonEdge(i), i + 2 == count ? polygonEdge(count - 1) : coplanar,
+                    i == 1 ? polygonEdge(0) : coplanar},
+                   frontOnly);
+  }
+}
+
+void OcclusionBuffer::setupTriangle_(const std::array<glm::vec4, 3>& clip,
+                                     const std::array<EdgeNeighbour, 3>& edges, bool frontOnly) {
+  if (clip[0][3] < kMinW || clip[1][3] < kMinW || clip[2][3] < kMinW) {
+    return;
+  }
+  const glm::vec2 size(static_cast<float>(width_), static_cast<float>(height_));
+  auto toScreen = [&](const glm::vec4& position) {
+    const glm::vec3 ndc = glm::vec3(position) / position[3];
+    return glm::vec3(((glm::vec2(ndc) * 0.5F) + 0.5F) * size, ndc[2]);
+  };
+  const std::array<glm::vec3, 3> vertex{toScreen(clip[0]), toScreen(clip[1]), toScreen(clip[2])};
+
+  // A closed mesh's counter-clockwise triangles cover its whole outline, nearest surface first
+  const float area = doubleArea(vertex[0], vertex[1], vertex[2]);
+  if (std::abs(area) < kMinArea || (frontOnly && area < 0.0F)) {
+    return;
+  }
+
+  // Edge i is opposite vertex i; flipping by the winding makes inside positive either way, and
+  // triangles sharing an edge compute exactly negated values, so no centre on it is missed
+  const float sign = area > 0.0F ? 1.0F : -1.0F;
+  Triangle triangle{};
+  for (int i = 0; i < 3; ++i) {
+    const glm::vec3& from = vertex[(i + 1) % 3];
+    const glm::vec3& to = vertex[(i + 2) % 3];
+    triangle.edgeX[i] = sign * (from[1] - to[1]);
+    triangle.edgeY[i] = sign * (to[0] - from[0]);
+    triangle.edgeC[i] = sign * ((from[0] * to[1]) - (from[1] * to[0]));
+    triangle.inset[i] = 0.5F * (std::abs(triangle.edgeX[i]) + std::abs(triangle.edgeY[i]));
+  }
+  triangle.depth = farthestDepthPlane(vertex[0], vertex[1], vertex[2], area);
+  triangle.farthest = std::max({vertex[0][2], vertex[1][2], vertex[2][2]});
+  triangle.occluder = occluderCount_;
+
+  // Shared only when the neighbour is kept and lies on the far side on screen; one folding back
+  // over this triangle makes the edge part of the silhouette
+  std::array<bool, 3> shared{};
+  for (int i = 0; i < 3; ++i) {
+    if (edges[i].kind == EdgeNeighbour::Kind::Coplanar) {
+      shared[i] = true;
+      continue;
+    }
+    if (edges[i].kind != EdgeNeighbour::Kind::Across || edges[i].across[3] < kMinW) {
+      continue;
+    }
+    const glm::vec3 across = toScreen(edges[i].across);
+    const glm::vec3& from = vertex[(i + 1) % 3];
+    const glm::vec3& to = vertex[(i + 2) % 3];
+    const float acrossArea = sign * doubleArea(to, from, across); // Its own winding, times ours
+    shared[i] =
+        (triangle.edgeX[i] * across[0]) + (triangle.edgeY[i] * across[1]) + triangle.edgeC[i] <
+            0.0F &&
+        std::abs(acrossArea) >= kMinArea && (!frontOnly || acrossArea > 0.0F);
+  }
+  triangle.merged = shared[0] || shared[1] || shared[2];
+
+  // Lone triangles: pixels whose whole square lies in the triangle's rectangle. Merged ones:
+  // every pixel the rectangle reaches into
+  const float minX = std::min({vertex[0][0], vertex[1][0], vertex[2][0]});
+  const float maxX = std::max({vertex[0][0], vertex[1][0], vertex[2][0]});
+  const float minY = std::min({vertex[0][1], vertex[1][1], vertex[2][1]});
+  const float maxY = std::max({vertex[0][1], vertex[1][1], vertex[2][1]});
+  const glm::ivec4 bounds =
+      triangle.merged
+          ? glm::ivec4(std::max(0, static_cast<int>(std::floor(minX))),
+                       std::max(0, static_cast<int>(std::floor(minY))),
+                       std::min(width_ - 1, static_cast<int>(std::ceil(maxX)) - 1),
+                       std::min(height_ - 1, static_cast<int>(std::ceil(maxY)) - 1))
+          : glm::ivec4(std::max(0, static_cast<int>(std::ceil(minX))),
+                       std::max(0, static_cast<int>(std::ceil(minY))),
+                       std::min(width_ - 1, static_cast<int>(std::floor(maxX)) - 1),
+                       std::min(height_ - 1, static_cast<int>(std::floor(maxY)) - 1));
+  if (bounds[0] > bounds[2] || bounds[1] > bounds[3]) {
+    return;
+  }
+  triangle.bounds = bounds;
+  triangles_.push_back(triangle);
+  if (!triangle.merged) {
+    return;
+  }
+  for (int i = 0; i < 3; ++i) {
+    if (!shared[i]) {
+      silhouettes_.push_back({.from = glm::vec2(vertex[(i + 1) % 3]),
+                              .to = glm::vec2(vertex[(i + 2) % 3]),
+                              .occluder = occluderCount_});
+    }
+  }
+}
+
+void OcclusionBuffer::rasterize(JobSystem* jobs) {
+  for (auto& bin : bins_) {
+    bin.clear();
+  }
+  for (auto& bin : silhouetteBins_) {
+    bin.clear();
+  }
+  for (std::size_t index = 0; index < triangles_.size(); ++index) {
+    const glm::ivec4& bounds = triangles_[index].bounds;
+    for (int band = bounds[1] / kBandHeight; band <= bounds[3] / kBandHeight; ++band) {
+      bins_[static_cast<std::size_t>(band)].push_back(static_cast<std::uint32_t>(index));
+    }
+  }
+  for (std::size_t index = 0; index < silhouettes_.size(); ++index) {
+    const Silhouette& silhouette = silhouettes_[index];
+    const int row0 =
+        std::max(0, static_cast<int>(std::floor(std::min(silhouette.from[1], silhouette.to[1]))));
+    const int row1 =
+        std::min(height_ - 1,
+                 static_cast<int>(std::ceil(std::max(silhouette.from[1], silhouette.to[1]))) - 1);
+    for (int band = row0 / kBandHeight; band <= row1 / kBandHeight; ++band) {
+      silhouetteBins_[static_cast<std::size_t>(band)].push_back(static_cast<std::uint32_t>(index));
+    }
+  }
+
+  auto runBand = [this](std::size_t band) {
+    rasterizeBand_(static_cast<int>(band));
+    reduceTiles_(static_cast<int>(band));
+  };
+  if (jobs != nullptr && bins_.size() > 1) {
+    jobs->parallelFor(bins_.size(), runBand);
+  } else {
+    for (std::size_t band = 0; band < bins_.size(); ++band) {
+      runBand(band);
+    }
+  }
+}
+
+// Triangles and silhouettes arrive in occluder order. Lone triangles write straight away; merged
+// ones of one occluder gather in the band scratch, which resolves once the occluder is done
+void OcclusionBuffer::rasterizeBand_(int band) {
+  const int firstRow = band * kBandHeight;
+  const int lastRow = std::min(height_, firstRow + kBandHeight) - 1;
+  const auto& bin = bins_[static_cast<std::size_t>(band)];
+  const auto& silhouetteBin = silhouetteBins_[static_cast<std::size_t>(band)];
+  BandScratch& scratch = scratch_[static_cast<std::size_t>(band)];
+  std::size_t nextSilhouette = 0;
+  for (std::size_t next = 0; next < bin.size();) {
+    const std::uint32_t occluder = triangles_[bin[next]].occluder;
+    int mergedX0 = width_;
+    int mergedX1 = -1;
+    for (; next < bin.size() && triangles_[bin[next]].occluder == occluder; ++next) {
+      const Triangle& triangle = triangles_[bin[next]];
+      const int rowBegin = std::max(firstRow, triangle.bounds[1]);
+      const int rowEnd = std::min(lastRow, triangle.bounds[3]);
+      for (int row = rowBegin; row <= rowEnd; ++row) {
+        if (!triangle.merged) {
+          rasterizeRow_(triangle, row, triangle.bounds[0], triangle.bounds[2]);
+          continue;
+        }
+        const auto offset = static_cast<std::ptrdiff_t>(row - firstRow) * width_;
+        mergeRow_(triangle, row, triangle.bounds[0], triangle.bounds[2],
+                  scratch.farthest.data() + offset, scratch.centre.data() + offset);
+      }
+      if (triangle.merged) {
+        mergedX0 = std::min(mergedX0, triangle.bounds[0]);
+        mergedX1 = std::max(mergedX1, triangle.bounds[2]);
+      }
+    }
+    for (; nextSilhouette < silhouetteBin.size() &&
+           silhouettes_[silhouetteBin[nextSilhouette]].occluder <= occluder;
+         ++nextSilhouette) {
+      const Silhouette& silhouette = silhouettes_[silhouetteBin[nextSilhouette]];
+      if (silhouette.occluder == occluder) {
+        block_(silhouette, firstRow, lastRow, scratch.blocked.data());
+      }
+    }
+    if (mergedX0 <= mergedX1) {
+      resolve_(firstRow, lastRow, mergedX0, mergedX1, scratch);
+    }
+  }
+}
+
+// Whole lane groups from x0 rounded down; lanes outside the triangle fail its edge tests, and
+// rows are whole tiles wide, so the last group stays inside the row
+void OcclusionBuffer::rasterizeRow_(const Triangle& triangle, int row, int x0, int x1) {
+  const float centreY = static_cast<float>(row) + 0.5F;
+  const Lanes empty = splat(kEmpty);
+  const Lanes offsets = ramp();
+  // Separate values rather than an array: vector types drop their alignment in templates
+  const Lanes slope0 = splat(triangle.edgeX[0]);
+  const Lanes slope1 = splat(triangle.edgeX[1]);
+  const Lanes slope2 = splat(triangle.edgeX[2]);
+  const Lanes row0 = splat((triangle.edgeY[0] * centreY) + triangle.edgeC[0]);
+  const Lanes row1 = splat((triangle.edgeY[1] * centreY) + triangle.edgeC[1]);
+  const Lanes row2 = splat((triangle.edgeY[2] * centreY) + triangle.edgeC[2]);
+  const Lanes inset0 = splat(triangle.inset[0]);
+  const Lanes inset1 = splat(triangle.inset[1]);
+  const Lanes inset2 = splat(triangle.inset[2]);
+  const Lanes depthSlope = splat(triangle.depth[0]);
+  const Lanes depthRow = splat((triangle.depth[1] * centreY) + triangle.depth[2]);
+  const Lanes farthest = splat(triangle.farthest);
+
+  float* pixels = depth_.data() + (static_cast<std::ptrdiff_t>(row) * width_);
+  for (int x = x0 - (x0 % kLanes); x <= x1; x += kLanes) {
+    const Lanes centreX = add(splat(static_cast<float>(x)), offsets);
+    Lanes inside = greaterEqual(add(mul(slope0, centreX), row0), inset0);
+    inside = both(inside, greaterEqual(add(mul(slope1, centreX), row1), inset1));
+    inside = both(inside, greaterEqual(add(mul(slope2, centreX), row2), inset2));
+    if (!any(inside)) {
+      continue;
+    }
+    const Lanes depth = min(add(mul(depthSlope, centreX), depthRow), farthest);
+    store(pixels + x, min(load(pixels + x), select(inside, depth, empty)));
+  }
+}
+
+// Every pixel the triangle may reach into raises the farthest depth; centres inside it mark
+// coverage. Edges pushed out by their inset pass any pixel that meets them
+void OcclusionBuffer::mergeRow_(const Triangle& triangle, int row, int x0, int x1,
+                                float* farthest, float* centre) {
+  const float centreY = static_cast<float>(row) + 0.5F;
+  const Lanes zero = splat(0.0F);
+  const Lanes lowest = splat(std::numeric_limits<float>::lowest());
+  const Lanes offsets = ramp();
+  const Lanes slope0 = splat(triangle.edgeX[0]);
+  const Lanes slope1 = splat(triangle.edgeX[1]);
+  const Lanes slope2 = splat(triangle.edgeX[2]);
+  const Lanes row0 = splat((triangle.edgeY[0] * centreY) + triangle.edgeC[0]);
+  const Lanes row1 = splat((triangle.edgeY[1] * centreY) + triangle.edgeC[1]);
+  const Lanes row2 = splat((triangle.edgeY[2] * centreY) + triangle.edgeC[2]);
+  const Lanes reach0 = splat(-triangle.inset[0]);
+  const Lanes reach1 = splat(-triangle.inset[1]);
+  const Lanes reach2 = splat(-triangle.inset[2]);
+  const Lanes depthSlope = splat(triangle.depth[0]);
+  const Lanes depthRow = splat((triangle.depth[1] * centreY) + triangle.depth[2]);
+  const Lanes vertexFarthest = splat(triangle.farthest);
+
+  for (int x = x0 - (x0 % kLanes); x <= x1; x += kLanes) {
+    const Lanes centreX = add(splat(static_cast<float>(x)), offsets);
+    const Lanes edge0 = add(mul(slope0, centreX), row0);
+    const Lanes edge1 = add(mul(slope1, centreX), row1);
+    const Lanes edge2 = add(mul(slope2, centreX), row2);
+    Lanes touched = greaterEqual(edge0, reach0);
+    touched = both(touched, greaterEqual(edge1, reach1));
+    touched = both(touched, greaterEqual(edge2, reach2));
+    if (!any(touched)) {
+      continue;
+    }
+    Lanes inside = greaterEqual(edge0, zero);
+    inside = both(inside, greaterEqual(edge1, zero));
+    inside = both(inside, greaterEqual(edge2, zero));
+    const Lanes depth = min(add(mul(depthSlope, centreX), depthRow), vertexFarthest);
+    store(farthest + x, max(load(farthest + x), select(touched, depth, lowest)));
+    store(centre + x, either(load(centre + x), inside));
+  }
+}
+
+// Marks the pixels whose open square the edge passes through, one row slab at a time
+void OcclusionBuffer::block_(const Silhouette& silhouette, int firstRow, int lastRow,
+                             float* blocked) const {
+  const glm::vec2& from = silhouette.from;
+  const glm::vec2& to = silhouette.to;
+  const float minY = std::min(from[1], to[1]);
+  const float maxY = std::max(from[1], to[1]);
+  const int rowBegin = std::max(firstRow, static_cast<int>(std::floor(minY)));
+  const int rowEnd = std::min(lastRow, static_cast<int>(std::ceil(maxY)) - 1);
+  for (int row = rowBegin; row <= rowEnd; ++row) {
+    // Where the edge is within the row; all of it when level
+    float low = std::min(from[0], to[0]);
+    float high = std::max(from[0], to[0]);
+    if (to[1] != from[1]) {
+      auto xAt = [&](float ypos) {
+        return from[0] + ((ypos - from[1]) * (to[0] - from[0]) / (to[1] - from[1]));
+      };
+      const float atLow = xAt(std::max(static_cast<float>(row), minY));
+      const float atHigh = xAt(std::min(static_cast<float>(row + 1), maxY));
+      low = std::min(atLow, atHigh);
+      high = std::max(atLow, atHigh);
+    }
+    // One running down a pixel's side enters neither pixel
+    const int x0 = std::max(0, static_cast<int>(std::floor(low)));
+    const int x1 = std::min(width_ - 1, static_cast<int>(std::ceil(high)) - 1);
+    float* pixels = blocked + (static_cast<std::ptrdiff_t>(row - firstRow) * width_);
+    for (int x = x0; x <= x1; ++x) {
+      pixels[x] = kMaskSet;
+    }
+  }
+}
+
+// Writes covered, unblocked pixels of the gathered occluder and empties the scratch behind it
+void OcclusionBuffer::resolve_(int firstRow, int lastRow, int x0, int x1,
+                               BandScratch& scratch) {
+  const Lanes zero = splat(0.0F);
+  const Lanes lowest = splat(std::numeric_limits<float>::lowest());
+  const Lanes empty = splat(kEmpty);
+  for (int row = firstRow; row <= lastRow; ++row) {
+    const auto offset = static_cast<std::ptrdiff_t>(row - firstRow) * width_;
+    float* pixels = depth_.data() + (static_cast<std::ptrdiff_t>(row) * width_);
+    float* farthest = scratch.farthest.data() + offset;
+    float* centre = scratch.centre.data() + offset;
+    float* blocked = scratch.blocked.data() + offset;
+    for (int x = x0 - (x0 % kLanes); x <= x1; x += kLanes) {
+      const Lanes covered = without(load(centre + x), load(blocked + x));
+      store(pixels + x, min(load(pixels + x), select(covered, load(farthest + x), empty)));
+      store(farthest + x, lowest);
+      store(centre + x, zero);
+      store(blocked + x, zero);
+    }
+  }
+}
+
+void OcclusionBuffer::reduceTiles_(int band) {
+  const int firstTileRow = (band * kBandHeight) / kTileHeight;
+  const int lastTileRow = std::min(tilesY_, firstTileRow + (kBandHeight / kTileHeight));
+  for (int tileY = firstTileRow; tileY < lastTileRow; ++tileY) {
+    for (int tileX = 0; tileX < tilesX_; ++tileX) {
+      float farthest = std::numeric_limits<float>::lowest();
+      for (int row = tileY * kTileHeight; row < (tileY + 1) * kTileHeight; ++row) {
+        const float* pixels = depth_.data() + (static_cast<std::ptrdiff_t>(row) * width_) +
+                              (static_cast<std::ptrdiff_t>(tileX) * kTileWidth);
+        farthest = std::max(farthest, *std::max_element(pixels, pixels + kTileWidth));
+      }
+      tileMax_[(static_cast<std::size_t>(tileY) * tilesX_) + tileX] = farthest;
+    }
+  }
+}
+
+bool OcclusionBuffer::occluded(const Aabb& bounds, const glm::mat4& viewProjection) const {
+  if (bounds.empty()) {
+    return false;
+  }
+  glm::vec2 lower(std::numeric_limits<float>::max());
+  glm::vec2 upper(std::numeric_limits<float>::lowest());
+  float nearest = std::numeric_limits<float>::max();
+  for (int corner = 0; corner < 8; ++corner) {
+    const glm::vec4 point((corner & 1) != 0 ? bounds.max[0] : bounds.min[0],
+                          (corner & 2) != 0 ? bounds.max[1] : bounds.min[1],
+                          (corner & 4) != 0 ? bounds.max[2] : bounds.min[2], 1.0F);
+    const glm::vec4 clip = viewProjection * point;
+    if (clip[3] < kMinW || clip[2] < -clip[3]) {
+      return false;
+    }
+    const glm::vec3 ndc = glm::vec3(clip) / clip[3];
+    lower = glm::min(lower, glm::vec2(ndc));
+    upper = glm::max(upper, glm::vec2(ndc));
+    nearest = std::min(nearest, ndc[2]);
+  }
+
+  // Every pixel the rectangle touches, not only those whose centre it covers
+  const glm::vec2 size(static_cast<float>(width_), static_cast<float>(height_));
+  const glm::vec2 screenLower = ((lower * 0.5F) + 0.5F) * size;
+  const glm::vec2 screenUpper = ((upper * 0.5F) + 0.5F) * size;
+  if (screenUpper[0] < 0.0F || screenUpper[1] < 0.0F || screenLower[0] >= size[0] ||
+      screenLower[1] >= size[1]) {
+    return false;
+  }
+  const int x0 = std::max(0, static_cast<int>(std::floor(screenLower[0])));
+  const int y0 = std::max(0, static_cast<int>(std::floor(screenLower[1])));
+  const int x1 = std::min(width_ - 1, static_cast<int>(std::floor(screenUpper[0])));
+  const int y1 = std::min(height_ - 1, static_cast<int>(std::floor(screenUpper[1])));
+
+  for (int tileY = y0 / kTileHeight; tileY <= y1 / kTileHeight; ++tileY) {
+    for (int tileX = x0 / kTileWidth; tileX <= x1 / kTileWidth; ++tileX) {
+      if (tileMax_[(static_cast<std::size_t>(tileY) * tilesX_) + tileX] < nearest) {
+        continue; // Whole tile in front of the box
+      }
+      const int rowBegin = std::max(y0, tileY * kTileHeight);
+      const int rowEnd = std::min(y1, ((tileY + 1) * kTileHeight) - 1);
+      const int columnBegin = std::max(x0, tileX * kTileWidth);
+      const int columnEnd = std::min(x1, ((tileX + 1) * kTileWidth) - 1);
+      for (int row = rowBegin; row <= rowEnd; ++row) {
+        if (!rowOccluded_(row, columnBegin, columnEnd, nearest)) {
+          return false;
+        }
+      }
+    }
+  }
+  return true;
+}
+
+bool OcclusionBuffer::rowOccluded_(int row, int x0, int x1, float nearest) const {
+  const float* pixels = depth_.data() + (static_cast<std::ptrdiff_t>(row) * width_);
+  const Lanes threshold = splat(nearest);
+  int x = x0;
+  for (; x + kLanes - 1 <= x1; x += kLanes) {
+    if (any(greaterEqual(load(pixels + x), threshold))) {
+      return false;
+    }
+  }
+  for (; x <= x1; ++x) {
+    if (pixels[x] >= nearest) {
+      return false;
+    }
+  }
+  return true;
+}
+
+int OcclusionBuffer::width() const {
+  return width_;
+}
+
+int OcclusionBuffer::height() const {
+  return height_;
+}
+
+float OcclusionBuffer::depth(int xpos, int ypos) const {
+  return depth_[(static_cast<std::size_t>(ypos) * width_) + xpos];
+}
+
+std::size_t OcclusionBuffer::triangleCount() const {
+  return triangles_.size();
+}
+
+const char* OcclusionBuffer::simdPath() {
+  return kSimdPath;
+}
+
+} // namespace blkhurst
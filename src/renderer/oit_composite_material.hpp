@@ -0,0 +1,45 @@
+#pragma once
+
+#include <blkhurst/materials/material.hpp>
+#include <blkhurst/textures/texture.hpp>
+
+#include <memory>
+#include <utility>
+
+namespace blkhurst {
+
+// Fullscreen resolve of the Renderer's weighted blended transparency pass
+class OitCompositeMaterial : public Material {
+public:
+  OitCompositeMaterial()
+      : Material(Program::createFromRegistry({
+            .vert = "fullscreen_vert",
+            .frag = "oit_composite_frag",
+        })) {
+    setDepthTest(false);
+    setDepthWrite(false);
+    setBlend(true);
+    setCullFace(CullFace::None);
+  }
+
+  static std::shared_ptr<OitCompositeMaterial> create() {
+    return std::make_shared<OitCompositeMaterial>();
+  }
+
+  void setTextures(std::shared_ptr<Texture> accumulation, std::shared_ptr<Texture> revealage) {
+    accumulation_ = std::move(accumulation);
+    revealage_ = std::move(revealage);
+  }
+
+protected:
+  void applyResources() override {
+    bindTextureUnit(accumulation_, "uAccumulation", 0);
+    bindTextureUnit(revealage_, "uRevealage", 1);
+  }
+
+private:
+  std::shared_ptr<Texture> accumulation_;
+  std::shared_ptr<Texture> revealage_;
+};
+
+} // namespace blkhurst
@@ -62,6 +62,10 @@ std::shared_ptr<Texture> RenderTarget::depthTexture() const {
   return depthTexture_;
 }
 
+std::shared_ptr<Texture> RenderTarget::objectIdTexture() const {
+  return objectIdTexture_;
+}
+
 const std::vector<std::shared_ptr<Texture>>& RenderTarget::textures() const {
   return textures_;
 }
@@ -75,8 +79,10 @@ void RenderTarget::rebuildAttachments_() {
   textures_.clear();
   textures_.reserve(desc_.colorAttachmentCount);
   for (int i = 0; i < desc_.colorAttachmentCount; ++i) {
+    const auto index = static_cast<std::size_t>(i);
     TextureDesc colorDesc{
-        .format = desc_.colorDesc.format,
+        .format = index < desc_.colorFormats.size() ? desc_.colorFormats[index]
+                                                    : desc_.colorDesc.format,
         .minFilter = desc_.colorDesc.minFilter,
         .magFilter = desc_.colorDesc.magFilter,
         .wrapS = desc_.colorDesc.wrapS,
@@ -88,13 +94,38 @@ void RenderTarget::rebuildAttachments_() {
     textures_.push_back(std::move(texture));
   }
 
+  // Create object id attachment; its draw buffer sits past the color ones (GL_NONE between)
+  objectIdTexture_.reset();
+  if (desc_.objectIdAttachment) {
+    if (desc_.colorAttachmentCount > kObjectIdLocation) {
+      spdlog::error("RenderTarget objectIdAttachment needs colorAttachmentCount <= {}",
+                    kObjectIdLocation);
+    } else {
+      const TextureDesc idDesc{
+          .format = TextureFormat::R32UI,
+          .minFilter = TextureFilter::Nearest,
+          .magFilter = TextureFilter::Nearest,
+          .wrapS = TextureWrap::ClampToEdge,
+          .wrapT = TextureWrap::ClampToEdge,
+          .generateMipmaps = false,
+      };
+      objectIdTexture_ = Texture::create(width_, height_, idDesc);
+      glNamedFramebufferTexture(framebufferId_, GL_COLOR_ATTACHMENT0 + kObjectIdLocation,
+                                objectIdTexture_->id(), 0);
+    }
+  }
+
   // Set draw buffers
-  if (!textures_.empty()) {
+  if (!textures_.empty() || objectIdTexture_) {
     std::vector<GLenum> buffers;
     buffers.reserve(textures_.size());
     for (int i = 0; i < static_cast<int>(textures_.size()); ++i) {
       buffers.push_back(GL_COLOR_ATTACHMENT0 + i);
     }
+    if (objectIdTexture_) {
+      buffers.resize(kObjectIdLocation, GL_NONE);
+      buffers.push_back(GL_COLOR_ATTACHMENT0 + kObjectIdLocation);
+    }
     glNamedFramebufferDrawBuffers(framebufferId_, static_cast<int>(buffers.size()), buffers.data());
   } else {
     glNamedFramebufferDrawBuffer(framebufferId_, GL_NONE);
@@ -132,8 +163,9 @@ void RenderTarget::rebuildAttachments_() {
   if (status != GL_FRAMEBUFFER_COMPLETE) {
     spdlog::error("RenderTarget FBO incomplete after rebuild (0x{:X})", status);
   } else {
-    spdlog::trace("RenderTarget({}) {}x{} created: colors={} depth={}", framebufferId_, width_,
-                  height_, textures_.size(), depthTexture_ ? "yes" : "no");
+    spdlog::trace("RenderTarget({}) {}x{} created: colors={} depth={} objectId={}", framebufferId_,
+                  width_, height_, textures_.size(), depthTexture_ ? "yes" : "no",
+                  objectIdTexture_ ? "yes" : "no");
   }
 }
 
@@ -1,14 +1,86 @@
+#include "renderer/oit_composite_material.hpp"
+#include "renderer/tone_mapping_material.hpp"
 #include <blkhurst/geometry/box_geometry.hpp>
+#include <blkhurst/geometry/plane_geometry.hpp>
+#include <blkhurst/graphics/stream_buffer.hpp>
+#include <blkhurst/jobs/job_system.hpp>
 #include <blkhurst/materials/material.hpp>
 #include <blkhurst/materials/skybox_material.hpp>
+#include <blkhurst/materials/uniforms.hpp>
 #include <blkhurst/renderer/cube_render_target.hpp>
 #include <blkhurst/renderer/renderer.hpp>
 #include <blkhurst/scene/scene.hpp>
+#include <blkhurst/util/frustum.hpp>
 
+#include <algorithm>
+#include <cmath>
 #include <glad/gl.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <memory_resource>
+#include <optional>
 #include <spdlog/spdlog.h>
+#include <string_view>
+#include <utility>
 #include <vector>
 
+namespace {
+// GL 4.6 / ARB_pipeline_statistics_query; not in the 4.5 loader
+constexpr GLenum kFragmentShaderInvocations = 0x82F4;
+
+// Core since 4.6; listed as an extension before that
+bool hasPipelineStatistics() {
+  GLint major = 0;
+  GLint minor = 0;
+  glGetIntegerv(GL_MAJOR_VERSION, &major);
+  glGetIntegerv(GL_MINOR_VERSION, &minor);
+  if (major > 4 || (major == 4 && minor >= 6)) {
+    return true;
+  }
+  constexpr std::string_view kExtension = "GL_ARB_pipeline_statistics_query";
+  GLint count = 0;
+  glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+  for (GLint index = 0; index < count; ++index) {
+    const auto* extension =
+        // NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast)
+        reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, static_cast<GLuint>(index)));
+    if (extension != nullptr && kExtension == extension) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Depth buffer format of a framebuffer (0 for the default one), for blits that need a match
+std::optional<blkhurst::TextureFormat> depthFormatOf(GLuint framebuffer) {
+  using blkhurst::TextureFormat;
+  const GLenum depth = framebuffer == 0U ? GL_DEPTH : GL_DEPTH_ATTACHMENT;
+  const GLenum stencil = framebuffer == 0U ? GL_STENCIL : GL_STENCIL_ATTACHMENT;
+  GLint type = GL_NONE;
+  glGetNamedFramebufferAttachmentParameteriv(framebuffer, depth,
+                                             GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &type);
+  if (type == GL_NONE) {
+    return std::nullopt;
+  }
+  GLint depthBits = 0;
+  GLint componentType = GL_NONE;
+  GLint stencilType = GL_NONE;
+  glGetNamedFramebufferAttachmentParameteriv(framebuffer, depth,
+                                             GL_FRAMEBUFFER_ATTACHMENT_DEPTH_SIZE, &depthBits);
+  glGetNamedFramebufferAttachmentParameteriv(
+      framebuffer, depth, GL_FRAMEBUFFER_ATTACHMENT_COMPONENT_TYPE, &componentType);
+  glGetNamedFramebufferAttachmentParameteriv(framebuffer, stencil,
+                                             GL_FRAMEBUFFER_ATTACHMENT_OBJECT_TYPE, &stencilType);
+  const bool hasStencil = stencilType != GL_NONE;
+  if (componentType == GL_FLOAT) {
+    return hasStencil ? TextureFormat::Depth32FStencil8 : TextureFormat::Depth32F;
+  }
+  if (depthBits <= 16) { // NOLINT(readability-magic-numbers)
+    return TextureFormat::Depth16;
+  }
+  return hasStencil ? TextureFormat::Depth24Stencil8 : TextureFormat::Depth24;
+}
+} // namespace
+
 namespace blkhurst {
 
 Renderer::Renderer() {
@@ -19,15 +91,23 @@ Renderer::Renderer() {
   spdlog::debug("Renderer constructed");
 }
 
+Renderer::~Renderer() {
+  waitSoftwareOcclusion_();
+  releaseOcclusionQueries_();
+  releaseStatisticsQueries_();
+  releaseTimerQueries_();
+}
+
 void Renderer::setFrameUniforms(const FrameUniforms& frameUniforms) {
   frameUniforms_ = frameUniforms;
 }
 
 void Renderer::setRenderTarget(const RenderTarget* target) {
   bool bindDefaultFramebuffer = (target == nullptr);
+  renderTarget_ = target;
+  defaultFramebuffer_ = bindDefaultFramebuffer;
   if (bindDefaultFramebuffer) {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    setViewport(0, 0, framebufferSize_[0], framebufferSize_[1]);
+    bindDefaultFramebuffer_();
     return;
   }
 
@@ -37,10 +117,11 @@ void Renderer::setRenderTarget(const RenderTarget* target) {
 
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
 void Renderer::setRenderTarget(const CubeRenderTarget* target, int face, int mip) {
+  renderTarget_ = nullptr;
   bool bindDefaultFramebuffer = (target == nullptr);
+  defaultFramebuffer_ = bindDefaultFramebuffer;
   if (bindDefaultFramebuffer) {
-    glBindFramebuffer(GL_FRAMEBUFFER, 0);
-    setViewport(0, 0, framebufferSize_[0], framebufferSize_[1]);
+    bindDefaultFramebuffer_();
     return;
   }
 
@@ -64,35 +145,172 @@ void Renderer::setRenderTarget(const CubeRenderTarget* target, int face, int mip
   setViewport(0, 0, size, size);
 }
 
+// Nested renders (e.g. fromEquirect) rebind the default framebuffer, which stays the scene
+// target (at the outer render's viewport) until the outermost render() resolves it
+void Renderer::bindDefaultFramebuffer_() {
+  if (sceneTargetBound_) {
+    glBindFramebuffer(GL_FRAMEBUFFER, sceneTarget_->id());
+    setViewport(sceneViewport_[0], sceneViewport_[1], sceneViewport_[2], sceneViewport_[3]);
+    return;
+  }
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  setViewport(0, 0, framebufferSize_[0], framebufferSize_[1]);
+}
+
 void Renderer::render(Object3D& root, Camera& camera) {
+  // The outermost render into the backbuffer draws into the scene target instead
+  const bool resolve = usesSceneTarget_() && defaultFramebuffer_ && !sceneTargetBound_;
+  const bool timed = resolve && dynamicResolution_.enabled && gpuTimer_ && beginTimer_();
+  if (resolve) {
+    beginSceneTarget_();
+  }
+  const bool sceneTarget = sceneTargetBound_ && defaultFramebuffer_;
+  // This render's defines go after any outer render's and only they are read, so nesting never
+  // copies the string; both are restored on the way out
+  const std::size_t outerDefinesSize = passDefines_.size();
+  const std::size_t outerDefinesBegin = std::exchange(passDefinesBegin_, outerDefinesSize);
+  if (sceneTarget && toneMappingPass_) {
+    passDefines_ += defines::ToneMappingPass;
+  }
+
   if (autoClear_) {
     clear();
   }
 
   applyPerFrameUniforms(camera);
+  boundVertexArray_ = nullptr; // Nested renders (e.g. fromEquirect) leave other state bound
+
+  // Fragment shader invocations of this render(); nested renders count towards the outer one
+  const bool statistics = pipelineStatistics_ && !statisticsActive_ && beginStatistics_();
+
+  // Id renders draw batched meshes themselves so each keeps its own id; batches are skipped
+  writeObjectIds_ = renderTarget_ != nullptr && renderTarget_->objectIdTexture();
+  objectIds_.clear();
 
-  // Build Node List
-  std::vector<Mesh*> meshList;
-  root.traverse([&](Object3D& node) {
+  // Build Node List (frame arena; released when the Engine resets it)
+  std::pmr::vector<Mesh*> meshList(frameResource_());
+  auto collect = [&](Object3D& node) {
     if (!node.visible()) {
       return;
     }
     if (node.kind() == NodeKind::Mesh) {
       auto* mesh = dynamic_cast<Mesh*>(&node);
-      meshList.push_back(mesh);
+      if (!mesh->batched() || writeObjectIds_) { // Otherwise drawn by its Scene static batch
+        meshList.push_back(mesh);
+      }
     }
     if (node.kind() == NodeKind::Light) {
       // ...
     }
-  });
+  };
 
-  if (auto* scene = dynamic_cast<Scene*>(&root)) {
+  auto* scene = dynamic_cast<Scene*>(&root);
+  const Frustum frustum = Frustum::fromMatrix(camera.projectionMatrix() * camera.viewMatrix());
+  if (scene != nullptr && frustumCulling_) {
+    scene->updateSpatialIndex();
+    std::size_t inFrustum = 0;
+    scene->spatialIndex().query(frustum, [&](Object3D* node, int /*proxy*/) {
+      ++inFrustum;
+      collect(*node);
+    });
+    stats_.meshesCulled += scene->spatialIndex().size() - inFrustum;
+    for (Mesh* mesh : scene->unboundedMeshes()) {
+      collect(*mesh);
+    }
+    sortByDrawOrder_(meshList, *scene); // Hits arrive in tree order; Blended relies on this
+  } else {
+    root.traverse(collect);
+  }
+
+  if (scene != nullptr) {
     renderBackground(*scene, camera);
+    static const std::vector<std::unique_ptr<Mesh>> kNoBatches;
+    // Id renders collected the batched meshes instead
+    for (const auto& batch : writeObjectIds_ ? kNoBatches : scene->staticBatches()) {
+      const auto bounds = batch->worldBounds();
+      if (frustumCulling_ && bounds && !frustum.intersectsBox(bounds->min, bounds->max)) {
+        ++stats_.meshesCulled;
+        continue;
+      }
+      meshList.push_back(batch.get());
+    }
+  }
+
+  if (softwareOcclusion_) {
+    cullSoftwareOccluded_(meshList, root, camera);
+  }
+
+  // Weighted blended transparency draws blending meshes last, in one unsorted pass
+  std::span<Mesh* const> opaque(meshList);
+  std::span<Mesh* const> transparent;
+  if (scene != nullptr && scene->transparency() == TransparencyMode::WeightedBlended) {
+    const auto blended = std::stable_partition(meshList.begin(), meshList.end(), [](Mesh* mesh) {
+      return !mesh->material() || !mesh->material()->pipeline().blend;
+    });
+    const auto opaqueCount = static_cast<std::size_t>(blended - meshList.begin());
+    opaque = opaque.first(opaqueCount);
+    transparent = std::span<Mesh* const>(meshList).subspan(opaqueCount);
+  }
+
+  if (occlusionCulling_) {
+    renderOcclusionCulled_(opaque, camera);
+  } else {
+    if (depthPrepass_) {
+      renderDepthPrepass_(opaque, camera);
+    }
+    prepassShading_ = depthPrepass_;
+    for (auto* mesh : opaque) {
+      renderMesh(*mesh, camera, nextObjectId_(*mesh));
+    }
+    prepassShading_ = false;
+  }
+  if (!transparent.empty()) {
+    renderWeightedBlended_(transparent, camera);
+  }
+
+  if (statistics) {
+    glEndQuery(kFragmentShaderInvocations);
+    statisticsActive_ = false;
+  }
+  VertexArray::unbind();
+  boundVertexArray_ = nullptr;
+
+  passDefines_.resize(outerDefinesSize);
+  passDefinesBegin_ = outerDefinesBegin;
+  if (resolve) {
+    resolveSceneTarget_();
   }
+  if (timed) {
+    glEndQuery(GL_TIME_ELAPSED);
+  }
+}
+
+void Renderer::sortByDrawOrder_(std::pmr::vector<Mesh*>& meshes, const Scene& scene) const {
+  std::pmr::vector<std::pair<std::uint32_t, Mesh*>> keyed(frameResource_());
+  keyed.reserve(meshes.size());
+  for (Mesh* mesh : meshes) {
+    keyed.emplace_back(scene.drawOrder(*mesh), mesh);
+  }
+  std::ranges::sort(keyed, {}, &std::pair<std::uint32_t, Mesh*>::first);
+  for (std::size_t i = 0; i < keyed.size(); ++i) {
+    meshes[i] = keyed[i].second;
+  }
+}
+
+void Renderer::setFrameArena(FrameArena* arena) {
+  frameArena_ = arena;
+}
 
-  for (auto* mesh : meshList) {
-    renderMesh(*mesh, camera);
+void Renderer::setJobSystem(JobSystem* jobs) {
+  waitSoftwareOcclusion_();
+  jobs_ = jobs;
+}
+
+std::pmr::memory_resource* Renderer::frameResource_() const {
+  if (frameArena_ != nullptr) {
+    return frameArena_;
   }
+  return std::pmr::get_default_resource();
 }
 
 void Renderer::setAutoClear(bool enabled) {
@@ -117,6 +335,13 @@ void Renderer::clear(bool color, bool depth, bool stencil) {
     mask |= GL_STENCIL_BUFFER_BIT;
   }
   glClear(mask);
+
+  // glClear leaves integer attachments undefined
+  if (color && renderTarget_ != nullptr && renderTarget_->objectIdTexture()) {
+    constexpr GLuint kNoObject = 0;
+    glClearNamedFramebufferuiv(renderTarget_->id(), GL_COLOR, RenderTarget::kObjectIdLocation,
+                               &kNoObject);
+  }
 }
 
 void Renderer::clearColor() {
@@ -138,8 +363,8 @@ void Renderer::setDefaultFramebufferSize(int width, int height) {
   setViewport(0, 0, width, height);
 }
 
-// NOLINTNEXTLINE(readability-convert-member-functions-to-static)
 void Renderer::setViewport(int xpos, int ypos, int width, int height) {
+  viewport_ = {xpos, ypos, width, height};
   glViewport(xpos, ypos, width, height);
 }
 
@@ -169,6 +394,645 @@ void Renderer::setOutputColorSpace(OutputColorSpace space) {
   outputColorSpace_ = space;
 }
 
+void Renderer::setToneMappingPass(bool enabled) {
+  toneMappingPass_ = enabled;
+  if (!usesSceneTarget_()) {
+    sceneTarget_.reset();
+  }
+}
+
+void Renderer::setDynamicResolution(const DynamicResolutionDesc& desc) {
+  constexpr float kSmallestScale = 0.1F;
+  dynamicResolution_ = desc;
+  dynamicResolution_.maxScale = std::clamp(desc.maxScale, kSmallestScale, 1.0F);
+  dynamicResolution_.minScale =
+      std::clamp(desc.minScale, kSmallestScale, dynamicResolution_.maxScale);
+  if (dynamicResolution_.minScale != desc.minScale ||
+      dynamicResolution_.maxScale != desc.maxScale) {
+    spdlog::warn("Renderer dynamic resolution scales clamped to [{}, {}]",
+                 dynamicResolution_.minScale, dynamicResolution_.maxScale);
+  }
+  resolutionScale_ = desc.enabled ? dynamicResolution_.maxScale : 1.0F;
+  gpuFrameMs_ = -1.0F;
+  releaseTimerQueries_();
+  if (desc.enabled) {
+    GLint bits = 0;
+    glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &bits);
+    gpuTimer_ = bits > 0;
+    if (!gpuTimer_) {
+      spdlog::warn("Renderer GPU timer queries unavailable; dynamic resolution uses frame time");
+    }
+  }
+  if (!usesSceneTarget_()) {
+    sceneTarget_.reset();
+  }
+}
+
+// Cost follows the pixel count (scale squared), so the ideal scale is the current one times the
+// square root of budget over cost; a fraction of the way is taken per frame against the lag of
+// the timings, and a small band around the budget is left alone
+void Renderer::updateDynamicResolution(float frameMs) {
+  if (!dynamicResolution_.enabled) {
+    return;
+  }
+  for (auto& slot : timerQueries_) {
+    if (!slot.pending) {
+      continue;
+    }
+    GLint available = 0;
+    glGetQueryObjectiv(slot.query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available != 0) {
+      GLuint64 nanoseconds = 0;
+      glGetQueryObjectui64v(slot.query, GL_QUERY_RESULT, &nanoseconds);
+      constexpr double kNanosecondsPerMs = 1e6;
+      gpuFrameMs_ = static_cast<float>(static_cast<double>(nanoseconds) / kNanosecondsPerMs);
+      slot.pending = false;
+    }
+  }
+  stats_.gpuFrameMs = std::max(gpuFrameMs_, 0.0F);
+
+  const float measured = gpuFrameMs_ >= 0.0F ? gpuFrameMs_ : frameMs;
+  const float budget = dynamicResolution_.targetFrameMs;
+  constexpr float kDeadband = 0.05F; // Of the budget
+  constexpr float kResponse = 0.25F; // Of the way to the ideal scale per frame
+  if (measured <= 0.0F || budget <= 0.0F || std::abs(measured - budget) < kDeadband * budget) {
+    return;
+  }
+  const float ideal = resolutionScale_ * std::sqrt(budget / measured);
+  resolutionScale_ = std::clamp(resolutionScale_ + ((ideal - resolutionScale_) * kResponse),
+                                dynamicResolution_.minScale, dynamicResolution_.maxScale);
+}
+
+float Renderer::resolutionScale() const {
+  return dynamicResolution_.enabled ? resolutionScale_ : 1.0F;
+}
+
+bool Renderer::usesSceneTarget_() const {
+  return toneMappingPass_ || dynamicResolution_.enabled;
+}
+
+void Renderer::setMeshletCulling(bool enabled) {
+  meshletCulling_ = enabled;
+}
+
+void Renderer::setFrustumCulling(bool enabled) {
+  frustumCulling_ = enabled;
+}
+
+std::span<const std::uint64_t> Renderer::objectIds() const {
+  return objectIds_;
+}
+
+// Ids index objectIds_ (offset by one; 0 clears to "nothing")
+int Renderer::nextObjectId_(const Mesh& mesh) {
+  if (!writeObjectIds_) {
+    return 0;
+  }
+  objectIds_.push_back(mesh.uuid());
+  return static_cast<int>(objectIds_.size());
+}
+
+void Renderer::setOcclusionCulling(bool enabled) {
+  occlusionCulling_ = enabled;
+  if (!enabled) {
+    releaseOcclusionQueries_();
+  }
+}
+
+// Last frame's visible set draws first and lays down depth; meshes hidden last frame are then
+// tested with bounding boxes, and drawn under a conditional render of that same query so the
+// GPU resolves it (no CPU wait, no popping when they reappear). Results are read back a frame
+// later, only once available. Visible meshes re-test their real draw every few frames
+void Renderer::renderOcclusionCulled_(std::span<Mesh* const> meshes, const Camera& camera) {
+  ++occlusionFrame_;
+  if (!occlusionBox_) {
+    occlusionBox_ = BoxGeometry::create({.width = 1.0F, .height = 1.0F, .depth = 1.0F});
+    occlusionMaterial_ = Material::create(Program::createFromRegistry(
+        {.vert = "occlusion_box_vert", .frag = "occlusion_box_frag"}));
+  }
+
+  // Boxes crossing the near plane would clip away (and may contain the camera); always drawn
+  Frustum nearOnly;
+  nearOnly.planes.fill(
+      Frustum::fromMatrix(camera.projectionMatrix() * camera.viewMatrix()).planes[4]);
+  struct Hidden {
+    Mesh* mesh;
+    OcclusionState* state;
+    Aabb bounds;
+  };
+  std::pmr::vector<Hidden> hidden(frameResource_());
+
+  for (Mesh* mesh : meshes) {
+    const std::optional<Aabb> bounds = mesh->worldBounds();
+    if (!bounds || !nearOnly.containsBox(bounds->min, bounds->max)) {
+      renderMesh(*mesh, camera, nextObjectId_(*mesh));
+      continue;
+    }
+
+    OcclusionState& state = occlusionStates_[mesh->uuid()];
+    if (state.query == 0U) {
+      glCreateQueries(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, 1, &state.query);
+    }
+    state.lastFrame = occlusionFrame_;
+    if (state.pending) {
+      GLint available = 0;
+      glGetQueryObjectiv(state.query, GL_QUERY_RESULT_AVAILABLE, &available);
+      if (available != 0) {
+        GLint samplesPassed = 0;
+        glGetQueryObjectiv(state.query, GL_QUERY_RESULT, &samplesPassed);
+        state.visible = samplesPassed != 0;
+        state.pending = false;
+      }
+    }
+
+    if (!state.visible) {
+      hidden.push_back({mesh, &state, *bounds});
+      continue;
+    }
+    // Staggered by uuid so re-tests spread over frames
+    const bool retest =
+        !state.pending && (occlusionFrame_ + mesh->uuid()) % kVisibleRetestInterval == 0;
+    if (retest) {
+      glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, state.query);
+    }
+    renderMesh(*mesh, camera, nextObjectId_(*mesh));
+    if (retest) {
+      glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+      state.pending = true;
+      ++stats_.occlusionQueries;
+    }
+  }
+  stats_.meshesOccluded += hidden.size();
+
+  if (!hidden.empty()) {
+    // Depth-tested boxes, both faces, no writes; queries batched ahead of the draws they gate
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+    glEnable(GL_DEPTH_TEST);
+    glDepthFunc(GL_LEQUAL);
+    glDisable(GL_CULL_FACE);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+    occlusionMaterial_->useProgram();
+    occlusionMaterial_->setUniform("uView", frameUniforms_.uView);
+    occlusionMaterial_->setUniform("uProjection", frameUniforms_.uProjection);
+    bindGeometry(*occlusionBox_);
+    for (const Hidden& entry : hidden) {
+      const glm::mat4 boxMatrix = glm::scale(glm::translate(glm::mat4(1.0F), entry.bounds.center()),
+                                             entry.bounds.extent());
+      occlusionMaterial_->setUniform("uModel", boxMatrix);
+      occlusionMaterial_->applyUniformsAndResources();
+      glBeginQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE, entry.state->query);
+      drawGeometry(*occlusionBox_, occlusionBox_->drawRange(), 1);
+      glEndQuery(GL_ANY_SAMPLES_PASSED_CONSERVATIVE);
+      entry.state->pending = true;
+      ++stats_.occlusionQueries;
+    }
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+
+    for (const Hidden& entry : hidden) {
+      glBeginConditionalRender(entry.state->query, GL_QUERY_WAIT);
+      renderMesh(*entry.mesh, camera, nextObjectId_(*entry.mesh));
+      glEndConditionalRender();
+    }
+  }
+
+  // Forget meshes not drawn for a while (removed, or long outside the frustum)
+  if (occlusionFrame_ % kOcclusionPruneInterval == 0) {
+    std::erase_if(occlusionStates_, [&](auto& entry) {
+      if (entry.second.lastFrame + kOcclusionPruneInterval >= occlusionFrame_) {
+        return false;
+      }
+      glDeleteQueries(1, &entry.second.query);
+      return true;
+    });
+  }
+}
+
+void Renderer::setDepthPrepass(bool enabled) {
+  depthPrepass_ = enabled;
+}
+
+void Renderer::setPipelineStatistics(bool enabled) {
+  if (enabled && !hasPipelineStatistics()) {
+    spdlog::warn("Renderer pipeline statistics unavailable (GL_ARB_pipeline_statistics_query)");
+    enabled = false;
+  }
+  pipelineStatistics_ = enabled;
+  if (!enabled) {
+    releaseStatisticsQueries_();
+  }
+}
+
+bool Renderer::prepassEligible_(const Mesh& mesh) {
+  const Material* material = mesh.material().get();
+  const Geometry* geometry = mesh.geometry().get();
+  if (material == nullptr || geometry == nullptr) {
+    return false;
+  }
+  const PipelineState& state = material->pipeline();
+  const bool depthOrdered = state.depthFunc == DepthFunc::Less ||
+                            state.depthFunc == DepthFunc::Lequal;
+  return state.depthPrepass && state.depthTest && state.depthWrite && !state.blend &&
+         depthOrdered && !mesh.wireframe() && mesh.instanceCount() == 1 &&
+         geometry->primitive() == PrimitiveMode::Triangles;
+}
+
+// Depth only (colour writes off) with each material's own depth test and culling; position
+// streams where the Geometry has one, the regular (or pooled) vertex arrays otherwise
+void Renderer::renderDepthPrepass_(std::span<Mesh* const> meshes, const Camera& camera) {
+  if (!depthMaterial_) {
+    depthMaterial_ = Material::create(Program::createFromRegistry(
+        {.vert = "depth_prepass_vert", .frag = "depth_prepass_frag"}));
+  }
+  glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+  depthMaterial_->useProgram();
+  depthMaterial_->setUniform("uView", frameUniforms_.uView);
+  depthMaterial_->setUniform("uProjection", frameUniforms_.uProjection);
+
+  for (const Mesh* mesh : meshes) {
+    if (!prepassEligible_(*mesh)) {
+      continue;
+    }
+    const Geometry& geometry = *mesh->geometry();
+    applyPipeline(mesh->material()->pipeline(), false);
+    depthMaterial_->setUniform("uModel", mesh->worldMatrix());
+    depthMaterial_->setUniform("uVertexPulling", static_cast<int>(geometry.isPooled()));
+    depthMaterial_->applyUniformsAndResources();
+
+    const VertexArray* positions = geometry.positionArray();
+    if (positions == nullptr) {
+      bindGeometry(geometry);
+    } else if (boundVertexArray_ != positions) {
+      positions->bind();
+      boundVertexArray_ = positions;
+      ++stats_.vertexArrayBinds;
+    }
+    drawLevel_(*mesh, geometry, camera, false);
+    ++stats_.depthPrepassDraws;
+  }
+  glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+}
+
+// Drawn at the current viewport's size into oitTarget_, depth tested (not written) against a
+// blit of the current depth buffer, then composited over the current target's viewport
+void Renderer::renderWeightedBlended_(std::span<Mesh* const> meshes, const Camera& camera) {
+  GLint bound = 0;
+  glGetIntegerv(GL_DRAW_FRAMEBUFFER_BINDING, &bound);
+  const auto framebuffer = static_cast<GLuint>(bound);
+  const glm::ivec4 viewport = viewport_;
+  const int width = std::max(1, viewport[2]);
+  const int height = std::max(1, viewport[3]);
+
+  const std::optional<TextureFormat> depthFormat = depthFormatOf(framebuffer);
+  if (!oitTarget_ || oitDepthFormat_ != depthFormat) {
+    RenderTargetDesc desc{};
+    desc.colorAttachmentCount = 2;
+    desc.colorDesc.minFilter = TextureFilter::Nearest;
+    desc.colorDesc.magFilter = TextureFilter::Nearest;
+    desc.colorFormats = {TextureFormat::RGBA16F, TextureFormat::R16F};
+    desc.depthAttachment = depthFormat.has_value();
+    desc.depthDesc.format = depthFormat.value_or(desc.depthDesc.format);
+    oitTarget_ = RenderTarget::create(width, height, desc);
+    oitDepthFormat_ = depthFormat;
+  } else {
+    oitTarget_->setSize(width, height);
+  }
+  if (!oitComposite_) {
+    oitComposite_ = OitCompositeMaterial::create();
+  }
+
+  const unsigned target = oitTarget_->id();
+  if (depthFormat) {
+    glBlitNamedFramebuffer(framebuffer, target, viewport[0], viewport[1], viewport[0] + width,
+                           viewport[1] + height, 0, 0, width, height, GL_DEPTH_BUFFER_BIT,
+                           GL_NEAREST);
+  }
+  constexpr std::array<GLfloat, 4> kNoAccumulation{0.0F, 0.0F, 0.0F, 0.0F};
+  constexpr std::array<GLfloat, 4> kRevealed{1.0F, 1.0F, 1.0F, 1.0F};
+  glClearNamedFramebufferfv(target, GL_COLOR, 0, kNoAccumulation.data());
+  glClearNamedFramebufferfv(target, GL_COLOR, 1, kRevealed.data());
+
+  // viewport_ is left alone; LOD selection sees the same height
+  glBindFramebuffer(GL_FRAMEBUFFER, target);
+  glViewport(0, 0, width, height);
+  const std::size_t definesSize = passDefines_.size();
+  passDefines_ += passDefines_.size() == passDefinesBegin_ ? "" : " ";
+  passDefines_ += defines::WeightedBlendedOit;
+  weightedBlendedPass_ = true;
+  for (Mesh* mesh : meshes) {
+    renderMesh(*mesh, camera, nextObjectId_(*mesh));
+    ++stats_.weightedBlendedDraws;
+  }
+  weightedBlendedPass_ = false;
+  passDefines_.resize(definesSize);
+
+  glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+  glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+  if (writeObjectIds_) { // Keep the ids of opaque surfaces behind
+    glColorMaski(RenderTarget::kObjectIdLocation, GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+  }
+  oitComposite_->setTextures(oitTarget_->textures()[0], oitTarget_->textures()[1]);
+  drawFullscreen_(*oitComposite_);
+  if (writeObjectIds_) {
+    glColorMaski(RenderTarget::kObjectIdLocation, GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+  }
+}
+
+// Clip space quad over the current viewport (fullscreen_vert), with material's pipeline state
+void Renderer::drawFullscreen_(Material& material) {
+  if (!fullscreenQuad_) {
+    fullscreenQuad_ = PlaneGeometry::create({2.0F, 2.0F});
+  }
+  applyPipeline(material.pipeline(), false);
+  material.useProgram();
+  material.applyUniformsAndResources();
+  bindGeometry(*fullscreenQuad_);
+  drawGeometry(*fullscreenQuad_, fullscreenQuad_->drawRange(), 1);
+}
+
+// Allocated at maxScale of the backbuffer and drawn into its scaled viewport, so scale changes
+// never reallocate
+void Renderer::beginSceneTarget_() {
+  const float capacity = dynamicResolution_.enabled ? dynamicResolution_.maxScale : 1.0F;
+  const float scale = resolutionScale();
+  const int width = std::max(1, static_cast<int>(std::ceil(framebufferSize_[0] * capacity)));
+  const int height = std::max(1, static_cast<int>(std::ceil(framebufferSize_[1] * capacity)));
+  const TextureFormat format = toneMappingPass_ ? TextureFormat::RGBA16F : TextureFormat::RGBA8;
+  if (!sceneTarget_ || sceneTarget_->texture()->desc().format != format) {
+    RenderTargetDesc desc{};
+    desc.colorDesc.format = format;
+    desc.depthDesc.format = TextureFormat::Depth24Stencil8; // As the default framebuffer
+    sceneTarget_ = RenderTarget::create(width, height, desc);
+  } else {
+    sceneTarget_->setSize(width, height);
+  }
+  sceneTargetBound_ = true;
+  glBindFramebuffer(GL_FRAMEBUFFER, sceneTarget_->id());
+
+  outerViewport_ = viewport_;
+  const glm::ivec4 scaled(glm::round(glm::vec4(viewport_) * scale));
+  setViewport(scaled[0], scaled[1], std::max(1, scaled[2]), std::max(1, scaled[3]));
+  sceneViewport_ = viewport_;
+}
+
+// Over the outer viewport of the backbuffer; bilinear from the scaled region, kept half a texel
+// inside it. Without the tone mapping pass this is a plain copy
+void Renderer::resolveSceneTarget_() {
+  sceneTargetBound_ = false;
+  glBindFramebuffer(GL_FRAMEBUFFER, 0);
+  setViewport(outerViewport_[0], outerViewport_[1], outerViewport_[2], outerViewport_[3]);
+  if (!toneMappingMaterial_) {
+    toneMappingMaterial_ = ToneMappingMaterial::create();
+  }
+
+  const glm::vec2 size(static_cast<float>(sceneTarget_->width()),
+                       static_cast<float>(sceneTarget_->height()));
+  const glm::vec4 region = glm::vec4(sceneViewport_) / glm::vec4(size, size);
+  const ToneMappingMode mode = toneMappingPass_ ? toneMappingMode_ : ToneMappingMode::None;
+  const OutputColorSpace space = toneMappingPass_ ? outputColorSpace_ : OutputColorSpace::Linear;
+  toneMappingMaterial_->setSceneColor(sceneTarget_->texture());
+  toneMappingMaterial_->setUniform("uSourceRegion", region);
+  toneMappingMaterial_->setUniform("uSourceTexel", glm::vec2(1.0F) / size);
+  toneMappingMaterial_->setUniform("uToneMappingExposure", toneMappingExposure_);
+  toneMappingMaterial_->setUniform("uToneMappingMode", static_cast<int>(mode));
+  toneMappingMaterial_->setUniform("uOutputColorSpace", static_cast<int>(space));
+  drawFullscreen_(*toneMappingMaterial_);
+  VertexArray::unbind();
+  boundVertexArray_ = nullptr;
+}
+
+bool Renderer::beginTimer_() {
+  auto free = std::ranges::find(timerQueries_, false, &PendingQuery::pending);
+  if (free == timerQueries_.end()) {
+    return false;
+  }
+  if (free->query == 0U) {
+    glCreateQueries(GL_TIME_ELAPSED, 1, &free->query);
+  }
+  glBeginQuery(GL_TIME_ELAPSED, free->query);
+  free->pending = true;
+  return true;
+}
+
+void Renderer::releaseTimerQueries_() {
+  for (auto& slot : timerQueries_) {
+    if (slot.query != 0U) {
+      glDeleteQueries(1, &slot.query);
+    }
+    slot = {};
+  }
+}
+
+// Results are read once available, never waited on, so they land a frame or two late
+bool Renderer::beginStatistics_() {
+  for (auto& slot : statisticsQueries_) {
+    if (!slot.pending) {
+      continue;
+    }
+    GLint available = 0;
+    glGetQueryObjectiv(slot.query, GL_QUERY_RESULT_AVAILABLE, &available);
+    if (available != 0) {
+      GLuint64 invocations = 0;
+      glGetQueryObjectui64v(slot.query, GL_QUERY_RESULT, &invocations);
+      lastFragmentInvocations_ = invocations;
+      slot.pending = false;
+    }
+  }
+  stats_.fragmentInvocations = lastFragmentInvocations_; // Survives resetStats() between results
+
+  auto free = std::ranges::find(statisticsQueries_, false, &PendingQuery::pending);
+  if (free == statisticsQueries_.end()) {
+    return false;
+  }
+  if (free->query == 0U) {
+    glCreateQueries(kFragmentShaderInvocations, 1, &free->query);
+  }
+  glBeginQuery(kFragmentShaderInvocations, free->query);
+  free->pending = true;
+  statisticsActive_ = true;
+  return true;
+}
+
+void Renderer::releaseStatisticsQueries_() {
+  for (auto& slot : statisticsQueries_) {
+    if (slot.query != 0U) {
+      glDeleteQueries(1, &slot.query);
+    }
+    slot = {};
+  }
+  lastFragmentInvocations_ = 0;
+}
+
+void Renderer::setSoftwareOcclusion(bool enabled) {
+  softwareOcclusion_ = enabled;
+  if (!enabled) {
+    waitSoftwareOcclusion_();
+    occlusionPrepared_ = false;
+    occluderDraws_.clear();
+    occluderSources_.clear();
+  }
+}
+
+void Renderer::prepareSoftwareOcclusion(Object3D& root, const Camera& camera) {
+  if (!softwareOcclusion_) {
+    return;
+  }
+  waitSoftwareOcclusion_(); // Prepared and never rendered
+  const glm::mat4 viewProjection = camera.projectionMatrix() * camera.viewMatrix();
+
+  // Snapshot on this thread; the task never touches the graph
+  occluderDraws_.clear();
+  auto gather = [&](Object3D& node) {
+    if (node.kind() != NodeKind::Mesh || !node.visible()) {
+      return;
+    }
+    const auto* mesh = dynamic_cast<const Mesh*>(&node);
+    if (!mesh->occluder() || mesh->instanceCount() > 1) {
+      return;
+    }
+    if (auto source = occluderSource_(mesh->geometry())) {
+      occluderDraws_.push_back({.source = std::move(source),
+                                .modelViewProjection = viewProjection * mesh->worldMatrix(),
+                                .uuid = mesh->uuid(),
+                                .world = mesh->worldMatrix(),
+                                .geometry = mesh->geometry()->handle()});
+    }
+  };
+  auto* scene = dynamic_cast<Scene*>(&root);
+  if (scene != nullptr && frustumCulling_) {
+    scene->updateSpatialIndex();
+    scene->spatialIndex().query(Frustum::fromMatrix(viewProjection),
+                                [&](Object3D* node, int /*proxy*/) { gather(*node); });
+  } else {
+    root.traverse(gather);
+  }
+
+  occlusionCamera_ = &camera;
+  occlusionViewProjection_ = viewProjection;
+  occlusionPrepared_ = true;
+  auto rasterize = [this] {
+    occlusionBuffer_.clear();
+    for (const auto& draw : occluderDraws_) {
+      occlusionBuffer_.addOccluder(draw.source->data.positions, draw.source->data.indices,
+                                   draw.modelViewProjection, &draw.source->adjacency);
+    }
+    occlusionBuffer_.rasterize(jobs_);
+  };
+  if (jobs_ == nullptr) {
+    rasterize();
+    return;
+  }
+  if (!occlusionTask_) {
+    occlusionTask_ = std::make_unique<TaskGroup>();
+  }
+  jobs_->submit(*occlusionTask_, rasterize);
+}
+
+const OcclusionBuffer& Renderer::occlusionBuffer() const {
+  return occlusionBuffer_;
+}
+
+// Triangle lists only; read back once and shared by every mesh using the Geometry
+std::shared_ptr<const Renderer::OccluderSource>
+Renderer::occluderSource_(const std::shared_ptr<Geometry>& geometry) {
+  if (!geometry || geometry->primitive() != PrimitiveMode::Triangles) {
+    return nullptr;
+  }
+  if (auto found = occluderSources_.find(geometry->handle()); found != occluderSources_.end()) {
+    return found->second;
+  }
+  if (occluderSources_.size() >= 64) { // Occasionally drop sources whose Geometry is gone
+    std::erase_if(occluderSources_, [](const auto& entry) {
+      return Geometry::fromHandle(entry.first) == nullptr;
+    });
+  }
+  MeshData data = geometry->readMeshData();
+  OcclusionBuffer::Adjacency adjacency = OcclusionBuffer::buildAdjacency(data.positions,
+                                                                         data.indices);
+  auto source = std::make_shared<const OccluderSource>(
+      OccluderSource{.data = std::move(data), .adjacency = std::move(adjacency)});
+  occluderSources_.emplace(geometry->handle(), source);
+  spdlog::debug("Renderer occluder source read back, {} triangles, {}",
+                (source->data.indices.empty() ? source->data.positions.size()
+                                              : source->data.indices.size() * 3) /
+                    9,
+                source->adjacency.closed ? "closed" : "open");
+  return source;
+}
+
+// Compared with the snapshot while the task may still read it; both sides only read
+bool Renderer::occludersChanged_(const Object3D& root) const {
+  const auto* scene = dynamic_cast<const Scene*>(&root);
+  if (scene == nullptr) {
+    return !occluderDraws_.empty();
+  }
+  return std::ranges::any_of(occluderDraws_, [scene](const OccluderDraw& draw) {
+    const auto* mesh = dynamic_cast<const Mesh*>(scene->findByUuid(draw.uuid));
+    return mesh == nullptr || !mesh->visible() || !mesh->occluder() || !mesh->geometry() ||
+           mesh->geometry()->handle() != draw.geometry || mesh->worldMatrix() != draw.world;
+  });
+}
+
+void Renderer::cullSoftwareOccluded_(std::pmr::vector<Mesh*>& meshes, Object3D& root,
+                                     const Camera& camera) {
+  const glm::mat4 viewProjection = camera.projectionMatrix() * camera.viewMatrix();
+  if (occlusionPrepared_ && occlusionCamera_ != &camera) {
+    return; // Prepared for another camera; a nested render (probe, cube face) leaves it be
+  }
+  if (!occlusionPrepared_ || occlusionViewProjection_ != viewProjection ||
+      occludersChanged_(root)) {
+    prepareSoftwareOcclusion(root, camera);
+  }
+  waitSoftwareOcclusion_();
+  occlusionPrepared_ = false;
+  stats_.occluderTriangles += occlusionBuffer_.triangleCount();
+  if (occlusionBuffer_.triangleCount() == 0) {
+    return;
+  }
+
+  // Bounds on this thread (world matrices update lazily); only the tests run in parallel
+  std::pmr::vector<std::optional<Aabb>> bounds(meshes.size(), frameResource_());
+  for (std::size_t i = 0; i < meshes.size(); ++i) {
+    if (!meshes[i]->occluder()) {
+      bounds[i] = meshes[i]->worldBounds();
+    }
+  }
+  std::pmr::vector<std::uint8_t> hidden(meshes.size(), 0, frameResource_());
+  auto test = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i = begin; i < end; ++i) {
+      hidden[i] = bounds[i] && occlusionBuffer_.occluded(*bounds[i], viewProjection) ? 1 : 0;
+    }
+  };
+  constexpr std::size_t kGrain = 256;
+  if (jobs_ != nullptr && meshes.size() > kGrain) {
+    jobs_->parallelFor(meshes.size(), kGrain, test);
+  } else {
+    test(0, meshes.size());
+  }
+
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < meshes.size(); ++i) {
+    if (hidden[i] == 0) {
+      meshes[kept++] = meshes[i];
+    }
+  }
+  stats_.meshesSoftwareOccluded += meshes.size() - kept;
+  meshes.resize(kept);
+}
+
+void Renderer::waitSoftwareOcclusion_() {
+  if (jobs_ != nullptr && occlusionTask_) {
+    jobs_->wait(*occlusionTask_);
+  }
+}
+
+void Renderer::releaseOcclusionQueries_() {
+  for (auto& [uuid, state] : occlusionStates_) {
+    glDeleteQueries(1, &state.query);
+  }
+  occlusionStates_.clear();
+}
+
 void Renderer::resetState() {
   autoClear_ = true;
   clearColor_ = defaults::window::clearColor;
@@ -180,25 +1044,85 @@ void Renderer::resetState() {
   spdlog::debug("Renderer state reset");
 }
 
-void Renderer::renderMesh(const Mesh& mesh, const Camera& camera) {
-  const auto geometry = mesh.geometry();
-  const auto material = mesh.material();
-  if (!geometry || !material) {
+const RenderStats& Renderer::stats() const {
+  return stats_;
+}
+
+void Renderer::resetStats() {
+  stats_ = {};
+}
+
+void Renderer::renderMesh(const Mesh& mesh, const Camera& camera, int objectId) {
+  // Raw pointers; Mesh keeps ownership for the duration of the draw
+  const Geometry* geometry = mesh.geometry().get();
+  Material* material = mesh.material().get();
+  if ((geometry == nullptr) || (material == nullptr)) {
     spdlog::warn("Renderer: Mesh missing Geometry/Material");
     return;
   }
 
-  // Apply PipelineState and use shader Program.
-  applyPipeline(material->pipeline(), mesh.wireframe());
-  material->useProgram();
+  // Apply PipelineState and use shader Program; after a depth pre-pass only equal depths shade
+  PipelineState state = material->pipeline();
+  if (prepassShading_ && prepassEligible_(mesh)) {
+    state.depthWrite = false;
+    state.depthFunc = DepthFunc::Lequal;
+  }
+  if (weightedBlendedPass_) {
+    state.depthWrite = false;
+  }
+  applyPipeline(state, mesh.wireframe());
+  if (weightedBlendedPass_) {
+    glBlendFunci(0, GL_ONE, GL_ONE);                  // Accumulation
+    glBlendFunci(1, GL_ZERO, GL_ONE_MINUS_SRC_COLOR); // Revealage
+  }
+  material->useProgram(std::string_view(passDefines_).substr(passDefinesBegin_));
 
   // Per-draw Uniforms
-  applyPerDrawUniforms(mesh, camera);
+  applyPerDrawUniforms(mesh, camera, objectId);
 
   // Bind VertexArray & Draw
-  geometry->vertexArray().bind();
-  drawGeometry(*geometry, mesh.instanceCount());
-  VertexArray::unbind();
+  bindGeometry(*geometry);
+  drawLevel_(mesh, *geometry, camera, true);
+}
+
+// Level of detail from projected size; level 0 keeps any user draw range. Meshlets cull level 0
+// per cluster (single instance only), clipped to that range. The depth pre-pass draws the same
+// triangles
+void Renderer::drawLevel_(const Mesh& mesh, const Geometry& geometry, const Camera& camera,
+                          bool countLodSavings) {
+  DrawRange range = geometry.drawRange();
+  const int level = mesh.selectLod(camera, static_cast<float>(viewport_[3]));
+  if (level > 0) {
+    range = geometry.lod(level).range;
+    const auto saved = (geometry.lod(0).range.count - range.count) / 3;
+    if (countLodSavings) {
+      stats_.trianglesSavedByLod += static_cast<std::size_t>(saved) * mesh.instanceCount();
+    }
+  }
+
+  const bool useMeshlets = meshletCulling_ && level == 0 && mesh.instanceCount() == 1 &&
+                           !geometry.meshlets().empty();
+  if (useMeshlets) {
+    drawMeshlets(geometry, range, mesh, camera);
+  } else {
+    drawGeometry(geometry, range, mesh.instanceCount());
+  }
+}
+
+// Pooled geometry shares the VertexPool VAO; consecutive pooled draws bind nothing
+void Renderer::bindGeometry(const Geometry& geom) {
+  const VertexPool* pool = geom.vertexPool();
+  const VertexArray& vertexArray = pool != nullptr ? pool->vertexArray() : geom.vertexArray();
+  if (boundVertexArray_ == &vertexArray) {
+    return;
+  }
+  if (pool != nullptr) {
+    pool->bind();
+  } else {
+    vertexArray.bind();
+  }
+  boundVertexArray_ = &vertexArray;
+  ++stats_.vertexArrayBinds;
 }
 
 void Renderer::applyPipeline(const PipelineState& state, bool wireframe) {
@@ -243,8 +1167,8 @@ void Renderer::applyPerFrameUniforms(const Camera& camera) {
   // TODO: Update/bind UBO/SSBO if needsUpdate. Possible "global" textures (shadow, env, etc).
 }
 
-void Renderer::applyPerDrawUniforms(const Mesh& mesh, const Camera& camera) const {
-  auto material = mesh.material();
+void Renderer::applyPerDrawUniforms(const Mesh& mesh, const Camera& camera, int objectId) const {
+  Material* material = mesh.material().get();
 
   // Per-frame Uniforms
   // TODO: Moveto applyPerFrameUniforms with UBO
@@ -262,31 +1186,122 @@ void Renderer::applyPerDrawUniforms(const Mesh& mesh, const Camera& camera) cons
 
   // Per-draw Uniforms
   material->setUniform("uModel", mesh.worldMatrix());
+  material->setUniform("uVertexPulling", static_cast<int>(mesh.geometry()->isPooled()));
+  material->setUniform("uObjectId", objectId);
 
   // Apply Uniforms & Resources
   material->applyUniformsAndResources();
 }
 
-void Renderer::drawGeometry(const Geometry& geom, int instanceCount) {
-  const DrawRange range = geom.drawRange();
+void Renderer::drawGeometry(const Geometry& geom, DrawRange range, int instanceCount) {
   const GLenum primitive = toGlPrimitive(geom.primitive());
 
+  ++stats_.drawCalls;
+  StreamBuffer::markDrawn();
+  if (geom.primitive() == PrimitiveMode::Triangles) {
+    stats_.triangles += static_cast<std::size_t>(range.count / 3) * instanceCount;
+  }
+
+  // Pooled geometry offsets into the shared buffers; zero otherwise
+  const VertexPoolAllocation& pooled = geom.poolAllocation();
+  const auto baseVertex = static_cast<GLint>(pooled.vertices.first);
+
   if (geom.isIndexed()) {
-    auto offsetBytes = range.start * sizeof(std::uint32_t);
+    auto offsetBytes = (pooled.indices.first + range.start) * geom.indexSize();
     const void* indexOffset = std::bit_cast<const void*>(offsetBytes);
+    const GLenum indexType =
+        geom.indexType() == IndexType::Uint16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
 
     if (instanceCount > 1) {
-      glDrawElementsInstanced(primitive, range.count, GL_UNSIGNED_INT, indexOffset, instanceCount);
+      glDrawElementsInstancedBaseVertex(primitive, range.count, indexType, indexOffset,
+                                        instanceCount, baseVertex);
     } else {
-      glDrawElements(primitive, range.count, GL_UNSIGNED_INT, indexOffset);
+      glDrawElementsBaseVertex(primitive, range.count, indexType, indexOffset, baseVertex);
     }
   } else {
     if (instanceCount > 1) {
-      glDrawArraysInstanced(primitive, range.start, range.count, instanceCount);
+      glDrawArraysInstanced(primitive, baseVertex + range.start, range.count, instanceCount);
+    } else {
+      glDrawArrays(primitive, baseVertex + range.start, range.count);
+    }
+  }
+}
+
+void Renderer::drawMeshlets(const Geometry& geom, DrawRange range, const Mesh& mesh,
+                            const Camera& camera) {
+  const glm::mat4& model = mesh.worldMatrix();
+
+  // Cull in object space; no per-meshlet transforms
+  const Frustum frustum =
+      Frustum::fromMatrix(camera.projectionMatrix() * camera.viewMatrix() * model);
+  const glm::vec3 eye = glm::vec3(glm::inverse(model) * glm::vec4(camera.worldPosition(), 1.0F));
+
+  // The cone test drops clusters GL would cull as back faces: only for materials culling back
+  // faces, filled, unmirrored (a negative determinant flips the winding), and it is only
+  // conservative for perspective views and uniform scale
+  const float scaleX = glm::length(glm::vec3(model[0]));
+  const float scaleY = glm::length(glm::vec3(model[1]));
+  const float scaleZ = glm::length(glm::vec3(model[2]));
+  constexpr float kScaleTolerance = 1e-3F;
+  const bool cullsBack = mesh.material() && mesh.material()->pipeline().cull == CullFace::Back;
+  const bool coneCulling = cullsBack && !mesh.wireframe() &&
+                           glm::determinant(glm::mat3(model)) > 0.0F &&
+                           !camera.isOrthographic() &&
+                           std::abs(scaleX - scaleY) <= kScaleTolerance * scaleX &&
+                           std::abs(scaleX - scaleZ) <= kScaleTolerance * scaleX;
+
+  // Survivors; adjacent ranges merge into one draw
+  const auto meshlets = geom.meshlets();
+  const std::size_t indexBase = geom.poolAllocation().indices.first;
+  std::pmr::vector<GLsizei> counts(frameResource_());
+  std::pmr::vector<const void*> offsets(frameResource_());
+  counts.reserve(meshlets.size());
+  offsets.reserve(meshlets.size());
+  // Clusters outside the draw range are skipped, those straddling it are trimmed
+  const auto drawBegin = static_cast<std::uint32_t>(range.start);
+  const auto drawEnd = static_cast<std::uint32_t>(range.start + range.count);
+  std::uint32_t rangeEnd = 0;
+  std::size_t survivingIndices = 0;
+  for (const auto& meshlet : meshlets) {
+    const std::uint32_t begin = std::max(meshlet.indexOffset, drawBegin);
+    const std::uint32_t end = std::min(meshlet.indexOffset + meshlet.indexCount, drawEnd);
+    if (begin >= end) {
+      continue;
+    }
+    ++stats_.meshletsTested;
+    const bool visible = frustum.intersectsSphere(meshlet.center, meshlet.radius) &&
+                         !(coneCulling && meshlet.backfacing(eye));
+    if (!visible) {
+      ++stats_.meshletsCulled;
+      continue;
+    }
+    if (!counts.empty() && rangeEnd == begin) {
+      counts.back() += static_cast<GLsizei>(end - begin);
     } else {
-      glDrawArrays(primitive, range.start, range.count);
+      counts.push_back(static_cast<GLsizei>(end - begin));
+      offsets.push_back(std::bit_cast<const void*>((indexBase + begin) * geom.indexSize()));
     }
+    rangeEnd = end;
+    survivingIndices += end - begin;
+  }
+  if (counts.empty()) {
+    return;
+  }
+
+  const GLenum indexType =
+      geom.indexType() == IndexType::Uint16 ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+  if (geom.isPooled()) {
+    const std::pmr::vector<GLint> baseVertices(
+        counts.size(), static_cast<GLint>(geom.poolAllocation().vertices.first), frameResource_());
+    glMultiDrawElementsBaseVertex(GL_TRIANGLES, counts.data(), indexType, offsets.data(),
+                                  static_cast<GLsizei>(counts.size()), baseVertices.data());
+  } else {
+    glMultiDrawElements(GL_TRIANGLES, counts.data(), indexType, offsets.data(),
+                        static_cast<GLsizei>(counts.size()));
   }
+  ++stats_.drawCalls;
+  StreamBuffer::markDrawn();
+  stats_.triangles += survivingIndices / 3;
 }
 
 void Renderer::renderBackground(Scene& scene, Camera& camera) {
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <blkhurst/materials/material.hpp>
+#include <blkhurst/textures/texture.hpp>
+
+#include <memory>
+#include <utility>
+
+namespace blkhurst {
+
+// Fullscreen resolve of the Renderer's scene target: upscale, tone mapping and output colour space
+class ToneMappingMaterial : public Material {
+public:
+  ToneMappingMaterial()
+      : Material(Program::createFromRegistry({
+            .vert = "fullscreen_vert",
+            .frag = "tone_mapping_frag",
+        })) {
+    setDepthTest(false);
+    setDepthWrite(false);
+    setCullFace(CullFace::None);
+  }
+
+  static std::shared_ptr<ToneMappingMaterial> create() {
+    return std::make_shared<ToneMappingMaterial>();
+  }
+
+  void setSceneColor(std::shared_ptr<Texture> sceneColor) {
+    sceneColor_ = std::move(sceneColor);
+  }
+
+protected:
+  void applyResources() override {
+    bindTextureUnit(sceneColor_, "uSceneColor", 0);
+  }
+
+private:
+  std::shared_ptr<Texture> sceneColor_;
+};
+
+} // namespace blkhurst
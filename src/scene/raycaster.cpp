@@ -0,0 +1,134 @@
+#include <blkhurst/cameras/camera.hpp>
+#include <blkhurst/jobs/job_system.hpp>
+#include <blkhurst/objects/mesh.hpp>
+#include <blkhurst/scene/raycaster.hpp>
+
+#include <algorithm>
+#include <spdlog/spdlog.h>
+
+namespace blkhurst {
+
+Raycaster::Raycaster(JobSystem* jobs)
+    : jobs_(jobs) {
+}
+
+void Raycaster::build(Object3D& root) {
+  std::vector<RaycastTarget> targets;
+  root.traverse([&](Object3D& node) {
+    if (node.kind() != NodeKind::Mesh || !node.visible()) {
+      return;
+    }
+    auto* mesh = dynamic_cast<Mesh*>(&node);
+    const auto& geometry = mesh->geometry();
+    if (!geometry || geometry->primitive() != PrimitiveMode::Triangles) {
+      return;
+    }
+    geometry->ensureBvh(jobs_);
+    targets.push_back({mesh, geometry->bvh(), mesh->worldMatrix()});
+  });
+  build(targets);
+}
+
+void Raycaster::build(std::span<const RaycastTarget> targets) {
+  entries_.clear();
+  for (const auto& target : targets) {
+    if (target.bvh && !target.bvh->bvh().empty()) {
+      entries_.push_back({target.mesh, target.bvh, target.world, glm::inverse(target.world)});
+    }
+  }
+
+  std::vector<Aabb> bounds;
+  bounds.reserve(entries_.size());
+  for (const auto& entry : entries_) {
+    bounds.push_back(entry.bvh->bounds().transformed(entry.objectToWorld));
+  }
+  topLevel_ = Bvh::build(bounds, jobs_);
+  spdlog::debug("Raycaster built over {} meshes", entries_.size());
+}
+
+void Raycaster::setRay(const Ray& ray) {
+  ray_ = {ray.origin, glm::normalize(ray.direction)};
+}
+
+void Raycaster::setFromCamera(const glm::vec2& ndc, const Camera& camera) {
+  const glm::mat4 inverseViewProjection =
+      glm::inverse(camera.projectionMatrix() * camera.viewMatrix());
+  auto unproject = [&](float depth) {
+    const glm::vec4 point = inverseViewProjection * glm::vec4(ndc[0], ndc[1], depth, 1.0F);
+    return glm::vec3(point) / point[3];
+  };
+  const glm::vec3 nearPoint = unproject(-1.0F);
+  setRay({nearPoint, unproject(1.0F) - nearPoint});
+}
+
+const Ray& Raycaster::ray() const {
+  return ray_;
+}
+
+std::optional<RaycastHit> Raycaster::intersectNearest(float maxDistance) const {
+  return nearest_(ray_, maxDistance);
+}
+
+std::vector<RaycastHit> Raycaster::intersectAll(float maxDistance) const {
+  std::vector<RaycastHit> hits;
+  std::vector<TriangleHit> triangleHits;
+  topLevel_.traverse(ray_, maxDistance, [&](std::uint32_t slot, float tMax) {
+    const Entry& entry = entries_[topLevel_.primitives()[slot]];
+    const Ray local = toObject_(entry, ray_);
+    triangleHits.clear();
+    entry.bvh->intersectAll(local, tMax, triangleHits);
+    for (const auto& hit : triangleHits) {
+      hits.push_back(toHit_(entry, ray_, hit));
+    }
+    return tMax;
+  });
+  std::ranges::sort(hits, {}, &RaycastHit::distance);
+  return hits;
+}
+
+void Raycaster::intersectNearest(std::span<const Ray> rays,
+                                 std::span<std::optional<RaycastHit>> hits,
+                                 float maxDistance) const {
+  const std::size_t count = std::min(rays.size(), hits.size());
+  auto castRange = [&](std::size_t begin, std::size_t end) {
+    for (std::size_t index = begin; index < end; ++index) {
+      hits[index] = nearest_(rays[index], maxDistance);
+    }
+  };
+  constexpr std::size_t kGrain = 256;
+  if (jobs_ != nullptr && count > kGrain) {
+    jobs_->parallelFor(count, kGrain, castRange);
+  } else {
+    castRange(0, count);
+  }
+}
+
+std::size_t Raycaster::meshCount() const {
+  return entries_.size();
+}
+
+std::optional<RaycastHit> Raycaster::nearest_(const Ray& ray, float maxDistance) const {
+  std::optional<RaycastHit> nearest;
+  topLevel_.traverse(ray, maxDistance, [&](std::uint32_t slot, float tMax) {
+    const Entry& entry = entries_[topLevel_.primitives()[slot]];
+    TriangleHit hit;
+    if (entry.bvh->intersectNearest(toObject_(entry, ray), tMax, hit)) {
+      nearest = toHit_(entry, ray, hit);
+      return hit.distance;
+    }
+    return tMax;
+  });
+  return nearest;
+}
+
+// Direction is not renormalised, so object-space distances equal world-space ones
+Ray Raycaster::toObject_(const Entry& entry, const Ray& ray) {
+  return {glm::vec3(entry.worldToObject * glm::vec4(ray.origin, 1.0F)),
+          glm::vec3(entry.worldToObject * glm::vec4(ray.direction, 0.0F))};
+}
+
+RaycastHit Raycaster::toHit_(const Entry& entry, const Ray& ray, const TriangleHit& hit) {
+  return {entry.mesh, hit.distance, ray.at(hit.distance), hit.barycentric, hit.triangle};
+}
+
+} // namespace blkhurst
@@ -1,9 +1,111 @@
 #include "blkhurst/textures/cube_texture.hpp"
 #include <blkhurst/scene/scene.hpp>
 
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <span>
 #include <spdlog/spdlog.h>
+#include <unordered_map>
 #include <utility>
 
+namespace {
+// Appends source to merged in world space; mirrored transforms flip the winding back
+void appendTransformed(blkhurst::MeshData& merged, const blkhurst::MeshData& source,
+                       const glm::mat4& world) {
+  const auto base = static_cast<std::uint32_t>(merged.positions.size() / 3);
+  const std::size_t vertexCount = source.positions.size() / 3;
+  const bool hasNormals = source.normals.size() >= vertexCount * 3;
+  const bool hasUvs = source.uvs.size() >= vertexCount * 2;
+  const glm::mat3 linear(world);
+  const glm::mat3 normalMatrix = glm::transpose(glm::inverse(linear));
+  const bool mirrored = glm::determinant(linear) < 0.0F;
+
+  for (std::size_t vertex = 0; vertex < vertexCount; ++vertex) {
+    const float* position = source.positions.data() + (vertex * 3);
+    const glm::vec4 worldPosition = world * glm::vec4(position[0], position[1], position[2], 1.0F);
+    merged.positions.insert(merged.positions.end(),
+                            {worldPosition[0], worldPosition[1], worldPosition[2]});
+
+    glm::vec3 normal(0.0F);
+    if (hasNormals) {
+      const float* sourceNormal = source.normals.data() + (vertex * 3);
+      normal = normalMatrix * glm::vec3(sourceNormal[0], sourceNormal[1], sourceNormal[2]);
+      const float length = glm::length(normal);
+      normal = length > 0.0F ? normal / length : normal;
+    }
+    merged.normals.insert(merged.normals.end(), {normal[0], normal[1], normal[2]});
+
+    const float* uv = hasUvs ? source.uvs.data() + (vertex * 2) : nullptr;
+    merged.uvs.insert(merged.uvs.end(), {uv ? uv[0] : 0.0F, uv ? uv[1] : 0.0F});
+  }
+
+  const std::size_t indexCount = source.indices.empty() ? vertexCount : source.indices.size();
+  for (std::size_t corner = 0; corner + 2 < indexCount; corner += 3) {
+    std::uint32_t triangle[3]; // NOLINT
+    for (std::size_t i = 0; i < 3; ++i) {
+      triangle[i] = source.indices.empty() ? static_cast<std::uint32_t>(corner + i)
+                                           : source.indices[corner + i];
+    }
+    if (mirrored) {
+      std::swap(triangle[1], triangle[2]);
+    }
+    merged.indices.insert(merged.indices.end(),
+                          {base + triangle[0], base + triangle[1], base + triangle[2]});
+  }
+}
+
+struct BatchCandidate {
+  blkhurst::Mesh* mesh = nullptr;
+  const blkhurst::MeshData* source = nullptr;
+  glm::vec3 center{0.0F}; // World bounds centre; the split key
+  std::size_t order = 0;  // Traversal order within its group
+};
+
+// Median split along the widest axis of the cell's mesh centres until every cell fits
+// maxVertices and (when set) maxExtent; a single mesh is always its own cell
+void splitBatchCell(std::span<BatchCandidate> cell, const blkhurst::StaticBatchDesc& desc,
+                    std::vector<std::span<BatchCandidate>>& cells) {
+  if (cell.empty()) {
+    return;
+  }
+  std::size_t vertices = 0;
+  blkhurst::Aabb bounds;
+  blkhurst::Aabb centers;
+  for (const auto& candidate : cell) {
+    vertices += candidate.source->positions.size() / 3;
+    if (auto meshBounds = candidate.mesh->worldBounds()) {
+      bounds.expand(*meshBounds);
+    }
+    centers.expand(candidate.center);
+  }
+  const glm::vec3 size = bounds.extent();
+  const float widest = std::max({size[0], size[1], size[2]});
+  const bool fits =
+      vertices <= desc.maxVertices && (desc.maxExtent <= 0.0F || widest <= desc.maxExtent);
+  if (fits || cell.size() == 1) {
+    cells.push_back(cell);
+    return;
+  }
+
+  const glm::vec3 spread = centers.extent();
+  int axis = 0;
+  for (int candidateAxis = 1; candidateAxis < 3; ++candidateAxis) {
+    if (spread[candidateAxis] > spread[axis]) {
+      axis = candidateAxis;
+    }
+  }
+  // Coincident centres split by count; still bounded by maxVertices
+  const auto middle = cell.begin() + static_cast<std::ptrdiff_t>(cell.size() / 2);
+  std::ranges::nth_element(cell, middle, {}, [axis](const BatchCandidate& candidate) {
+    return candidate.center[axis];
+  });
+  const auto half = static_cast<std::size_t>(middle - cell.begin());
+  splitBatchCell(cell.first(half), desc, cells);
+  splitBatchCell(cell.subspan(half), desc, cells);
+}
+} // namespace
+
 namespace blkhurst {
 
 Scene::Scene() {
@@ -54,6 +156,15 @@ void Scene::setBackgroundIntensity(float intensity) {
   spdlog::trace("Scene({}) setBackgroundIntensity({})", uuid(), intensity);
 }
 
+TransparencyMode Scene::transparency() const {
+  return transparency_;
+}
+
+void Scene::setTransparency(TransparencyMode mode) {
+  transparency_ = mode;
+  spdlog::trace("Scene({}) setTransparency({})", uuid(), static_cast<int>(mode));
+}
+
 // const SceneEnvironment& Scene::environment() const {
 //   return environment_;
 // }
@@ -122,4 +233,256 @@ void Scene::addUiEntry(std::shared_ptr<UiEntry> entry) {
   uiEntries_.push_back(std::move(entry));
 }
 
+Object3D* Scene::findByUuid(std::uint64_t uuid) const {
+  auto found = uuidIndex_.find(uuid);
+  return (found == uuidIndex_.end()) ? nullptr : found->second;
+}
+
+Object3D* Scene::findByName(std::string_view name) const {
+  auto found = nameIndex_.find(name);
+  return (found == nameIndex_.end()) ? nullptr : found->second.front();
+}
+
+const std::vector<Object3D*>& Scene::findAllByName(std::string_view name) const {
+  static const std::vector<Object3D*> kEmpty;
+  auto found = nameIndex_.find(name);
+  return (found == nameIndex_.end()) ? kEmpty : found->second;
+}
+
+int Scene::bakeStatic(const StaticBatchDesc& desc) {
+  clearStaticBatches();
+
+  // Candidates grouped by Material and wireframe mode, in traversal order
+  std::map<std::pair<Material*, bool>, std::vector<Mesh*>> groups;
+  traverse([&](Object3D& node) {
+    if (node.kind() != NodeKind::Mesh || !node.isStatic() || !node.visible()) {
+      return;
+    }
+    auto* mesh = dynamic_cast<Mesh*>(&node);
+    const bool batchable = mesh->geometry() && mesh->material() && mesh->instanceCount() == 1 &&
+                           mesh->geometry()->primitive() == PrimitiveMode::Triangles;
+    if (batchable) {
+      groups[{mesh->material().get(), mesh->wireframe()}].push_back(mesh);
+    }
+  });
+
+  // Shared Geometry (e.g. cached primitives) is read back once
+  std::unordered_map<const Geometry*, MeshData> sources;
+  std::size_t batchedMeshes = 0;
+  for (const auto& [key, meshes] : groups) {
+    std::vector<BatchCandidate> candidates;
+    candidates.reserve(meshes.size());
+    for (auto* mesh : meshes) {
+      const Geometry* geometry = mesh->geometry().get();
+      auto source = sources.find(geometry);
+      if (source == sources.end()) {
+        source = sources.emplace(geometry, geometry->readMeshData()).first;
+      }
+      if (source->second.positions.empty()) {
+        continue;
+      }
+      const std::optional<Aabb> bounds = mesh->worldBounds();
+      candidates.push_back({.mesh = mesh,
+                            .source = &source->second,
+                            .center = bounds ? bounds->center() : mesh->worldPosition(),
+                            .order = candidates.size()});
+    }
+
+    std::vector<std::span<BatchCandidate>> cells;
+    splitBatchCell(candidates, desc, cells);
+    for (auto cell : cells) {
+      // Traversal order inside a batch; the split reorders candidates
+      std::ranges::sort(cell, {}, &BatchCandidate::order);
+      MeshData merged;
+      for (const auto& candidate : cell) {
+        appendTransformed(merged, *candidate.source, candidate.mesh->worldMatrix());
+        candidate.mesh->setBatched(true);
+      }
+      auto batch = Mesh::create(Geometry::from(merged, desc.geometry), meshes.front()->material());
+      batch->setName("StaticBatch");
+      batch->setWireframe(key.second);
+      batchedMeshes += cell.size();
+      staticBatches_.push_back(std::move(batch));
+    }
+  }
+
+  spdlog::info("Scene({}) bakeStatic: {} meshes -> {} batches", uuid(), batchedMeshes,
+               staticBatches_.size());
+  return static_cast<int>(staticBatches_.size());
+}
+
+void Scene::clearStaticBatches() {
+  traverse([](Object3D& node) {
+    if (node.kind() == NodeKind::Mesh) {
+      dynamic_cast<Mesh&>(node).setBatched(false);
+    }
+  });
+  staticBatches_.clear();
+}
+
+const std::vector<std::unique_ptr<Mesh>>& Scene::staticBatches() const {
+  return staticBatches_;
+}
+
+void Scene::updateSpatialIndex() {
+  // Renumber only after structural changes; traversal itself is not per frame
+  if (drawOrderDirty_) {
+    std::uint32_t order = 0;
+    traverse([&](Object3D& node) {
+      if (auto found = spatialEntries_.find(&node); found != spatialEntries_.end()) {
+        found->second.drawOrder = order++;
+      }
+    });
+    drawOrderDirty_ = false;
+  }
+
+  std::vector<Mesh*> inserts;
+  std::vector<Aabb> insertBounds;
+  for (Mesh* mesh : spatialQueue_) {
+    auto found = spatialEntries_.find(mesh);
+    if (found == spatialEntries_.end() || !found->second.queued.exchange(false)) {
+      continue; // Detached since, or a duplicate from a re-attach
+    }
+    SpatialEntry& entry = found->second;
+
+    const std::optional<Aabb> bounds = mesh->worldBounds();
+    const bool wasUnbounded = entry.proxy == SpatialIndex::kNull;
+    if (!bounds) {
+      if (!wasUnbounded) {
+        spatialIndex_.remove(entry.proxy);
+        entry.proxy = SpatialIndex::kNull;
+      }
+      if (std::ranges::find(unboundedMeshes_, mesh) == unboundedMeshes_.end()) {
+        unboundedMeshes_.push_back(mesh);
+      }
+      continue;
+    }
+    if (wasUnbounded) {
+      std::erase(unboundedMeshes_, mesh);
+      inserts.push_back(mesh);
+      insertBounds.push_back(*bounds);
+    } else {
+      spatialIndex_.move(entry.proxy, *bounds);
+    }
+  }
+  spatialQueue_.clear();
+
+  // Incremental inserts while the index is mostly built; otherwise one top-down rebuild
+  if (inserts.size() > spatialIndex_.size()) {
+    std::vector<int> proxies(inserts.size());
+    const std::vector<Object3D*> objects(inserts.begin(), inserts.end());
+    spatialIndex_.insert(insertBounds, objects, proxies);
+    for (std::size_t i = 0; i < inserts.size(); ++i) {
+      spatialEntries_[inserts[i]].proxy = proxies[i];
+    }
+    spdlog::debug("Scene({}) spatial index bulk loaded {} meshes (height {})", uuid(),
+                  inserts.size(), spatialIndex_.height());
+  } else {
+    for (std::size_t i = 0; i < inserts.size(); ++i) {
+      spatialEntries_[inserts[i]].proxy = spatialIndex_.insert(insertBounds[i], inserts[i]);
+    }
+  }
+}
+
+const SpatialIndex& Scene::spatialIndex() const {
+  return spatialIndex_;
+}
+
+const std::vector<Mesh*>& Scene::unboundedMeshes() const {
+  return unboundedMeshes_;
+}
+
+std::uint32_t Scene::drawOrder(const Mesh& mesh) const {
+  auto found = spatialEntries_.find(&mesh);
+  return found == spatialEntries_.end() ? UINT32_MAX : found->second.drawOrder;
+}
+
+const std::vector<Object3D*>& Scene::updateList() const {
+  return updateList_;
+}
+
+std::uint64_t Scene::updateListVersion() const {
+  return updateListVersion_;
+}
+
+void Scene::onNodeAttached_(Object3D& node) {
+  uuidIndex_[node.uuid()] = &node;
+  indexName_(node, node.name());
+  if (node.kind() == NodeKind::Mesh) {
+    SpatialEntry& entry = spatialEntries_[&node];
+    entry.proxy = SpatialIndex::kNull;
+    entry.queued.store(true);
+    spatialQueue_.push_back(dynamic_cast<Mesh*>(&node));
+    drawOrderDirty_ = true;
+  }
+  if (node.updateEnabled()) {
+    updateList_.push_back(&node);
+    ++updateListVersion_;
+  }
+}
+
+void Scene::onNodeDetached_(Object3D& node) {
+  if (node.kind() == NodeKind::Mesh && dynamic_cast<Mesh&>(node).batched()) {
+    spdlog::warn("Scene({}) detached batched Mesh({}); bakeStatic() to drop it from its batch",
+                 uuid(), node.uuid());
+  }
+  uuidIndex_.erase(node.uuid());
+  unindexName_(node, node.name());
+  if (auto entry = spatialEntries_.find(&node); entry != spatialEntries_.end()) {
+    if (entry->second.proxy != SpatialIndex::kNull) {
+      spatialIndex_.remove(entry->second.proxy);
+    }
+    std::erase(unboundedMeshes_, &node);
+    spatialEntries_.erase(entry);
+    drawOrderDirty_ = true;
+  }
+  if (node.updateEnabled()) {
+    std::erase(updateList_, &node);
+    ++updateListVersion_;
+  }
+}
+
+void Scene::onNodeRenamed_(Object3D& node, const std::string& previousName) {
+  unindexName_(node, previousName);
+  indexName_(node, node.name());
+}
+
+// Also raised for thread-safety changes; re-insert rather than duplicate
+void Scene::onNodeUpdateChanged_(Object3D& node) {
+  std::erase(updateList_, &node);
+  if (node.updateEnabled()) {
+    updateList_.push_back(&node);
+  }
+  ++updateListVersion_;
+}
+
+// Only the first change per node between updates takes the lock; may run on update workers
+void Scene::onNodeBoundsChanged_(Object3D& node) {
+  auto entry = spatialEntries_.find(&node);
+  if (entry == spatialEntries_.end() || entry->second.queued.exchange(true)) {
+    return;
+  }
+  const std::lock_guard lock(spatialQueueMutex_);
+  spatialQueue_.push_back(dynamic_cast<Mesh*>(&node));
+}
+
+void Scene::indexName_(Object3D& node, const std::string& name) {
+  if (name.empty()) {
+    return;
+  }
+  nameIndex_[name].push_back(&node);
+}
+
+void Scene::unindexName_(Object3D& node, const std::string& name) {
+  auto found = nameIndex_.find(name);
+  if (found == nameIndex_.end()) {
+    return;
+  }
+  std::erase(found->second, &node);
+  // Never keep empty buckets; findByName relies on front()
+  if (found->second.empty()) {
+    nameIndex_.erase(found);
+  }
+}
+
 } // namespace blkhurst
@@ -16,6 +16,7 @@ void SceneManager::registerFactory(const std::string& name,
 
   const int index = static_cast<int>(sceneEntries_.size());
   sceneEntries_.push_back(std::move(entry));
+  names_.push_back(name);
 
   if (kEagerLoadScenes) {
     ensureConstructed(index);
@@ -91,13 +92,8 @@ int SceneManager::currentIndex() const {
   return currentIndex_;
 }
 
-std::vector<std::string> SceneManager::names() const {
-  std::vector<std::string> out;
-  out.reserve(sceneEntries_.size());
-  for (const auto& sceneEntry : sceneEntries_) {
-    out.push_back(sceneEntry.name);
-  }
-  return out;
+const std::vector<std::string>& SceneManager::names() const {
+  return names_;
 }
 
 int SceneManager::indexOf(const std::string& name) const {
@@ -30,7 +30,7 @@ public:
 
   [[nodiscard]] Scene* currentScene() const;
   [[nodiscard]] int currentIndex() const;
-  [[nodiscard]] std::vector<std::string> names() const;
+  [[nodiscard]] const std::vector<std::string>& names() const;
 
 private:
   struct SceneEntry {
@@ -43,6 +43,7 @@ private:
   void ensureConstructed(int index);
 
   std::vector<SceneEntry> sceneEntries_;
+  std::vector<std::string> names_; // Parallel to sceneEntries_; RootState views it every frame
   int currentIndex_ = -1;
 };
 
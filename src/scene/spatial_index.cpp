@@ -0,0 +1,313 @@
+#include <blkhurst/scene/spatial_index.hpp>
+
+#include <algorithm>
+#include <cassert>
+
+namespace blkhurst {
+
+namespace {
+Aabb merged(const Aabb& first, const Aabb& second) {
+  Aabb out = first;
+  out.expand(second);
+  return out;
+}
+} // namespace
+
+int SpatialIndex::insert(const Aabb& bounds, Object3D* object) {
+  const int leaf = allocateLeaf_(bounds, object);
+  insertLeaf_(leaf);
+  return leaf;
+}
+
+void SpatialIndex::insert(std::span<const Aabb> bounds, std::span<Object3D* const> objects,
+                          std::span<int> proxies) {
+  assert(bounds.size() == objects.size() && proxies.size() >= objects.size());
+  nodes_.reserve(nodes_.size() + (2 * objects.size()));
+  for (std::size_t i = 0; i < objects.size(); ++i) {
+    proxies[i] = allocateLeaf_(bounds[i], objects[i]);
+  }
+  rebuild();
+}
+
+void SpatialIndex::remove(int proxy) {
+  assert(proxy >= 0 && proxy < static_cast<int>(nodes_.size()) && nodes_[proxy].leaf());
+  removeLeaf_(proxy);
+  freeNode_(proxy);
+  --proxyCount_;
+}
+
+bool SpatialIndex::move(int proxy, const Aabb& bounds) {
+  assert(proxy >= 0 && proxy < static_cast<int>(nodes_.size()) && nodes_[proxy].leaf());
+  Node& node = nodes_[proxy];
+  node.tight = bounds;
+
+  // Still inside, and not so loose (an object that shrank or stopped) that it hurts culling
+  constexpr float kLooseScale = 4.0F;
+  if (node.fat.contains(bounds) && fatten_(bounds, kLooseScale).contains(node.fat)) {
+    return false;
+  }
+  removeLeaf_(proxy);
+  nodes_[proxy].fat = fatten_(bounds, 1.0F);
+  insertLeaf_(proxy);
+  return true;
+}
+
+void SpatialIndex::rebuild() {
+  std::vector<int> leaves;
+  leaves.reserve(proxyCount_);
+  for (int index = 0; index < static_cast<int>(nodes_.size()); ++index) {
+    Node& node = nodes_[index];
+    if (node.height < 0) {
+      continue;
+    }
+    if (node.leaf()) {
+      node.parent = kNull;
+      leaves.push_back(index);
+    } else {
+      freeNode_(index);
+    }
+  }
+  root_ = leaves.empty() ? kNull : buildTopDown_(leaves, 0, leaves.size());
+  if (root_ != kNull) {
+    nodes_[root_].parent = kNull;
+  }
+}
+
+void SpatialIndex::clear() {
+  nodes_.clear();
+  root_ = kNull;
+  freeList_ = kNull;
+  proxyCount_ = 0;
+}
+
+Object3D* SpatialIndex::object(int proxy) const {
+  return nodes_[proxy].object;
+}
+
+const Aabb& SpatialIndex::bounds(int proxy) const {
+  return nodes_[proxy].tight;
+}
+
+const Aabb& SpatialIndex::fatBounds(int proxy) const {
+  return nodes_[proxy].fat;
+}
+
+std::size_t SpatialIndex::size() const {
+  return proxyCount_;
+}
+
+int SpatialIndex::height() const {
+  return root_ == kNull ? -1 : nodes_[root_].height;
+}
+
+int SpatialIndex::allocateLeaf_(const Aabb& bounds, Object3D* object) {
+  const int leaf = allocateNode_();
+  Node& node = nodes_[leaf];
+  node.tight = bounds;
+  node.fat = fatten_(bounds, 1.0F);
+  node.object = object;
+  node.height = 0;
+  ++proxyCount_;
+  return leaf;
+}
+
+int SpatialIndex::allocateNode_() {
+  if (freeList_ == kNull) {
+    nodes_.emplace_back();
+    return static_cast<int>(nodes_.size()) - 1;
+  }
+  const int index = freeList_;
+  freeList_ = nodes_[index].parent;
+  nodes_[index] = Node{};
+  return index;
+}
+
+void SpatialIndex::freeNode_(int index) {
+  nodes_[index] = Node{};
+  nodes_[index].parent = freeList_;
+  freeList_ = index;
+}
+
+// Descend towards the cheapest sibling: cost of a new parent over it versus pushing further down
+void SpatialIndex::insertLeaf_(int leaf) {
+  if (root_ == kNull) {
+    root_ = leaf;
+    nodes_[leaf].parent = kNull;
+    return;
+  }
+
+  const Aabb leafBounds = nodes_[leaf].fat;
+  int index = root_;
+  while (!nodes_[index].leaf()) {
+    const Node& node = nodes_[index];
+    const float area = node.fat.surfaceArea();
+    const float combinedArea = merged(node.fat, leafBounds).surfaceArea();
+    const float siblingCost = 2.0F * combinedArea;
+    const float inheritanceCost = 2.0F * (combinedArea - area);
+
+    auto descendCost = [&](int child) {
+      const Aabb& bounds = nodes_[child].fat;
+      const float enlarged = merged(bounds, leafBounds).surfaceArea();
+      return nodes_[child].leaf() ? enlarged + inheritanceCost
+                                  : enlarged - bounds.surfaceArea() + inheritanceCost;
+    };
+    const float cost1 = descendCost(node.child1);
+    const float cost2 = descendCost(node.child2);
+    if (siblingCost < cost1 && siblingCost < cost2) {
+      break;
+    }
+    index = cost1 < cost2 ? node.child1 : node.child2;
+  }
+
+  const int sibling = index;
+  const int oldParent = nodes_[sibling].parent;
+  const int newParent = allocateNode_();
+  nodes_[newParent].parent = oldParent;
+  nodes_[newParent].fat = merged(nodes_[sibling].fat, leafBounds);
+  nodes_[newParent].height = nodes_[sibling].height + 1;
+  nodes_[newParent].child1 = sibling;
+  nodes_[newParent].child2 = leaf;
+  nodes_[sibling].parent = newParent;
+  nodes_[leaf].parent = newParent;
+
+  if (oldParent == kNull) {
+    root_ = newParent;
+  } else if (nodes_[oldParent].child1 == sibling) {
+    nodes_[oldParent].child1 = newParent;
+  } else {
+    nodes_[oldParent].child2 = newParent;
+  }
+  refitUpwards_(nodes_[leaf].parent);
+}
+
+void SpatialIndex::removeLeaf_(int leaf) {
+  if (leaf == root_) {
+    root_ = kNull;
+    return;
+  }
+
+  const int parent = nodes_[leaf].parent;
+  const int grandParent = nodes_[parent].parent;
+  const int sibling =
+      nodes_[parent].child1 == leaf ? nodes_[parent].child2 : nodes_[parent].child1;
+
+  if (grandParent == kNull) {
+    root_ = sibling;
+    nodes_[sibling].parent = kNull;
+    freeNode_(parent);
+  } else {
+    if (nodes_[grandParent].child1 == parent) {
+      nodes_[grandParent].child1 = sibling;
+    } else {
+      nodes_[grandParent].child2 = sibling;
+    }
+    nodes_[sibling].parent = grandParent;
+    freeNode_(parent);
+    refitUpwards_(grandParent);
+  }
+  nodes_[leaf].parent = kNull;
+}
+
+void SpatialIndex::refitUpwards_(int index) {
+  while (index != kNull) {
+    index = balance_(index);
+    Node& node = nodes_[index];
+    const Node& child1 = nodes_[node.child1];
+    const Node& child2 = nodes_[node.child2];
+    node.height = 1 + std::max(child1.height, child2.height);
+    node.fat = merged(child1.fat, child2.fat);
+    index = node.parent;
+  }
+}
+
+// Rotates the taller grandchild pair up when the children's heights differ by more than one;
+// returns the node now in index's place
+int SpatialIndex::balance_(int index) {
+  const int a = index; // NOLINT(readability-identifier-length)
+  if (nodes_[a].leaf() || nodes_[a].height < 2) {
+    return a;
+  }
+  const int b = nodes_[a].child1; // NOLINT(readability-identifier-length)
+  const int c = nodes_[a].child2; // NOLINT(readability-identifier-length)
+  const int balance = nodes_[c].height - nodes_[b].height;
+  if (balance >= -1 && balance <= 1) {
+    return a;
+  }
+
+  // Promote the taller child (up) and hand its shorter grandchild to a
+  const bool rightHeavy = balance > 1;
+  const int up = rightHeavy ? c : b;
+  const int other = rightHeavy ? b : c;
+  const int f = nodes_[up].child1; // NOLINT(readability-identifier-length)
+  const int g = nodes_[up].child2; // NOLINT(readability-identifier-length)
+
+  nodes_[up].child1 = a;
+  nodes_[up].parent = nodes_[a].parent;
+  nodes_[a].parent = up;
+  if (nodes_[up].parent == kNull) {
+    root_ = up;
+  } else if (nodes_[nodes_[up].parent].child1 == a) {
+    nodes_[nodes_[up].parent].child1 = up;
+  } else {
+    nodes_[nodes_[up].parent].child2 = up;
+  }
+
+  const bool keepF = nodes_[f].height > nodes_[g].height;
+  const int kept = keepF ? f : g;
+  const int given = keepF ? g : f;
+  nodes_[up].child2 = kept;
+  if (rightHeavy) {
+    nodes_[a].child2 = given;
+  } else {
+    nodes_[a].child1 = given;
+  }
+  nodes_[given].parent = a;
+
+  nodes_[a].fat = merged(nodes_[other].fat, nodes_[given].fat);
+  nodes_[a].height = 1 + std::max(nodes_[other].height, nodes_[given].height);
+  nodes_[up].fat = merged(nodes_[a].fat, nodes_[kept].fat);
+  nodes_[up].height = 1 + std::max(nodes_[a].height, nodes_[kept].height);
+  return up;
+}
+
+int SpatialIndex::buildTopDown_(std::vector<int>& leaves, std::size_t begin, std::size_t end) {
+  if (end - begin == 1) {
+    return leaves[begin];
+  }
+
+  Aabb centroids;
+  for (std::size_t i = begin; i < end; ++i) {
+    centroids.expand(nodes_[leaves[i]].fat.center());
+  }
+  const glm::vec3 size = centroids.extent();
+  int axis = size[1] > size[0] ? 1 : 0;
+  axis = size[2] > size[axis] ? 2 : axis;
+
+  const std::size_t middle = begin + ((end - begin) / 2);
+  const auto first = leaves.begin() + static_cast<std::ptrdiff_t>(begin);
+  std::nth_element(first, leaves.begin() + static_cast<std::ptrdiff_t>(middle),
+                   leaves.begin() + static_cast<std::ptrdiff_t>(end), [&](int lhs, int rhs) {
+                     return nodes_[lhs].fat.center()[axis] < nodes_[rhs].fat.center()[axis];
+                   });
+
+  const int child1 = buildTopDown_(leaves, begin, middle);
+  const int child2 = buildTopDown_(leaves, middle, end);
+  const int index = allocateNode_();
+  Node& node = nodes_[index];
+  node.child1 = child1;
+  node.child2 = child2;
+  node.fat = merged(nodes_[child1].fat, nodes_[child2].fat);
+  node.height = 1 + std::max(nodes_[child1].height, nodes_[child2].height);
+  nodes_[child1].parent = index;
+  nodes_[child2].parent = index;
+  return index;
+}
+
+Aabb SpatialIndex::fatten_(const Aabb& bounds, float scale) {
+  const glm::vec3 size = bounds.extent();
+  const float largest = std::max({size[0], size[1], size[2]});
+  const glm::vec3 margin(std::max(kMinMargin, kMarginFraction * largest) * scale);
+  return {bounds.min - margin, bounds.max + margin};
+}
+
+} // namespace blkhurst
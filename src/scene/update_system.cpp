@@ -0,0 +1,157 @@
+#include "scene/update_system.hpp"
+#include <blkhurst/cameras/camera.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <unordered_map>
+
+namespace blkhurst {
+
+UpdateSystem::UpdateSystem(JobSystem& jobs, bool parallel, const UpdateConfig& config)
+    : jobs_(jobs),
+      parallel_(parallel),
+      config_(config) {
+}
+
+void UpdateSystem::update(Scene& scene, const RootState& state) {
+  // Root always updates; descendants only if registered in the Scene's update list
+  scene.onUpdate(state);
+
+  if (cachedSceneUuid_ != scene.uuid() || cachedVersion_ != scene.updateListVersion()) {
+    rebuild_(scene, state);
+  }
+
+  if (parallel_) {
+    // Subtrees only share the Scene as an ancestor; build its matrix before workers read it
+    scene.worldMatrix();
+
+    // Thread-safe subtrees; barrier, then propagate their transforms; barrier
+    jobs_.parallelFor(subtreeNodes_.size(), [&](std::size_t group) {
+      for (Object3D* node : subtreeNodes_[group]) {
+        node->onUpdate(state);
+      }
+    });
+    jobs_.parallelFor(subtreeRoots_.size(),
+                      [&](std::size_t group) { subtreeRoots_[group]->updateWorldMatrix(); });
+  }
+
+  // GL thread; index loop over the live list, onUpdate may add or remove nodes
+  const auto& updateList = scene.updateList();
+  for (std::size_t i = 0; i < updateList.size(); ++i) {
+    Object3D* node = updateList[i];
+    if (node->slicedUpdate() || (parallel_ && node->threadSafeUpdate())) {
+      continue;
+    }
+    node->onUpdate(state);
+  }
+
+  updateSliced_(scene, state);
+  ++frame_;
+}
+
+void UpdateSystem::rebuild_(const Scene& scene, const RootState& state) {
+  if (parallel_) {
+    partition_(scene);
+  }
+
+  // Keep schedule of surviving sliced nodes; stagger new ones across their interval
+  std::unordered_map<const Object3D*, SlicedEntry> previous;
+  if (cachedSceneUuid_ == scene.uuid()) {
+    for (const auto& entry : sliced_) {
+      previous.emplace(entry.node, entry);
+    }
+  }
+  sliced_.clear();
+  for (Object3D* node : scene.updateList()) {
+    if (!node->slicedUpdate()) {
+      continue;
+    }
+    if (auto found = previous.find(node); found != previous.end()) {
+      sliced_.push_back(found->second);
+      continue;
+    }
+    const auto stagger = static_cast<std::uint64_t>(sliced_.size()) %
+                         static_cast<std::uint64_t>(node->updateInterval());
+    sliced_.push_back({node, frame_ + stagger, state.elapsed - state.delta});
+  }
+  slicedCursor_ = 0;
+
+  cachedSceneUuid_ = scene.uuid();
+  cachedVersion_ = scene.updateListVersion();
+}
+
+void UpdateSystem::partition_(const Scene& scene) {
+  subtreeRoots_.clear();
+  subtreeNodes_.clear();
+
+  std::unordered_map<Object3D*, std::size_t> groupOf;
+  for (Object3D* node : scene.updateList()) {
+    if (!node->threadSafeUpdate() || node->slicedUpdate()) {
+      continue;
+    }
+    Object3D* subtreeRoot = subtreeRootOf_(*node, scene);
+    auto [found, inserted] = groupOf.try_emplace(subtreeRoot, subtreeNodes_.size());
+    if (inserted) {
+      subtreeRoots_.push_back(subtreeRoot);
+      subtreeNodes_.emplace_back();
+    }
+    subtreeNodes_[found->second].push_back(node);
+  }
+
+  spdlog::debug("UpdateSystem partitioned Scene({}) into {} thread-safe subtrees", scene.uuid(),
+                subtreeNodes_.size());
+}
+
+void UpdateSystem::updateSliced_(const Scene& scene, const RootState& state) {
+  if (sliced_.empty() || cachedVersion_ != scene.updateListVersion()) {
+    return; // List changed this frame; rebuilt next frame
+  }
+
+  const std::size_t budget = config_.slicedBudget > 0
+                                 ? static_cast<std::size_t>(config_.slicedBudget)
+                                 : sliced_.size();
+  RootState slicedState = state;
+
+  // Round-robin from the cursor so nodes skipped by the budget go first next frame
+  std::size_t updated = 0;
+  std::size_t visited = 0;
+  const std::size_t count = sliced_.size();
+  while (visited < count && updated < budget) {
+    auto& entry = sliced_[(slicedCursor_ + visited) % count];
+    ++visited;
+    if (entry.dueFrame > frame_) {
+      continue;
+    }
+
+    slicedState.delta = state.elapsed - entry.lastElapsed;
+    entry.lastElapsed = state.elapsed;
+    entry.dueFrame = frame_ + static_cast<std::uint64_t>(effectiveInterval_(*entry.node, state));
+    entry.node->onUpdate(slicedState);
+    ++updated;
+
+    if (cachedVersion_ != scene.updateListVersion()) {
+      return; // onUpdate changed the list; entries may dangle
+    }
+  }
+  slicedCursor_ = (slicedCursor_ + visited) % count;
+}
+
+int UpdateSystem::effectiveInterval_(const Object3D& node, const RootState& state) const {
+  int interval = node.updateInterval();
+  if (!node.distanceUpdateLod() || state.camera == nullptr || config_.lodDistance <= 0.0F) {
+    return interval;
+  }
+  const float distance = glm::distance(node.worldPosition(), state.camera->worldPosition());
+  interval += static_cast<int>(distance / config_.lodDistance);
+  return std::min(interval, std::max(node.updateInterval(), config_.maxLodInterval));
+}
+
+Object3D* UpdateSystem::subtreeRootOf_(Object3D& node, const Scene& scene) {
+  Object3D* current = &node;
+  while (current->parent() != nullptr && current->parent() != &scene) {
+    current = current->parent();
+  }
+  return current;
+}
+
+} // namespace blkhurst
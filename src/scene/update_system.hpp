@@ -0,0 +1,52 @@
+#pragma once
+
+#include <blkhurst/engine/config/update.hpp>
+#include <blkhurst/engine/root_state.hpp>
+#include <blkhurst/jobs/job_system.hpp>
+#include <blkhurst/scene/scene.hpp>
+
+#include <cstdint>
+#include <vector>
+
+namespace blkhurst {
+
+// Ticks a Scene's update list.
+// Parallel mode groups thread-safe nodes by top-level subtree (a child of the Scene) and runs
+// groups on the JobSystem, then propagates their transforms after a barrier. Remaining nodes
+// run afterwards on the calling (GL) thread.
+// Sliced nodes (Object3D::slicedUpdate) run last, on the calling thread, when due and within
+// UpdateConfig::slicedBudget; each receives the time since its previous update as delta.
+class UpdateSystem {
+public:
+  UpdateSystem(JobSystem& jobs, bool parallel, const UpdateConfig& config);
+
+  void update(Scene& scene, const RootState& state);
+
+private:
+  struct SlicedEntry {
+    Object3D* node = nullptr;
+    std::uint64_t dueFrame = 0;
+    float lastElapsed = 0.0F;
+  };
+
+  JobSystem& jobs_;
+  bool parallel_;
+  UpdateConfig config_;
+  std::uint64_t frame_ = 0;
+
+  // Caches; rebuilt when the Scene or its update list version changes
+  std::uint64_t cachedSceneUuid_ = 0; // Scene addresses are reused after reload
+  std::uint64_t cachedVersion_ = 0;
+  std::vector<Object3D*> subtreeRoots_;
+  std::vector<std::vector<Object3D*>> subtreeNodes_;
+  std::vector<SlicedEntry> sliced_;
+  std::size_t slicedCursor_ = 0;
+
+  void rebuild_(const Scene& scene, const RootState& state);
+  void partition_(const Scene& scene);
+  void updateSliced_(const Scene& scene, const RootState& state);
+  [[nodiscard]] int effectiveInterval_(const Object3D& node, const RootState& state) const;
+  static Object3D* subtreeRootOf_(Object3D& node, const Scene& scene);
+};
+
+} // namespace blkhurst
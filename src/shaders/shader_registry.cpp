@@ -2,12 +2,16 @@
 #include <spdlog/spdlog.h>
 
 #include <blkhurst/shaders/builtin/basic.glsl.hpp>
+#include <blkhurst/shaders/builtin/depth_prepass.glsl.hpp>
 #include <blkhurst/shaders/builtin/equirect.glsl.hpp>
 #include <blkhurst/shaders/builtin/fullscreen.glsl.hpp>
 #include <blkhurst/shaders/builtin/ibl/brdf_lut.glsl.hpp>
 #include <blkhurst/shaders/builtin/ibl/irradiance.glsl.hpp>
 #include <blkhurst/shaders/builtin/ibl/prefilter_ggx.glsl.hpp>
+#include <blkhurst/shaders/builtin/occlusion_box.glsl.hpp>
+#include <blkhurst/shaders/builtin/oit_composite.glsl.hpp>
 #include <blkhurst/shaders/builtin/skybox.glsl.hpp>
+#include <blkhurst/shaders/builtin/tone_mapping.glsl.hpp>
 #include <blkhurst/shaders/chunks/color_fragment.glsl.hpp>
 #include <blkhurst/shaders/chunks/colorspace_fragment.glsl.hpp>
 #include <blkhurst/shaders/chunks/common.glsl.hpp>
@@ -75,6 +79,20 @@ void ShaderRegistry::registerBuiltinShaders() {
   // Fullscreen
   ShaderRegistry::registerSource("fullscreen_vert", shaders::fullscreen_vert);
 
+  // Renderer occlusion queries
+  ShaderRegistry::registerSource("occlusion_box_vert", shaders::occlusion_box_vert);
+  ShaderRegistry::registerSource("occlusion_box_frag", shaders::occlusion_box_frag);
+
+  // Renderer depth pre-pass
+  ShaderRegistry::registerSource("depth_prepass_vert", shaders::depth_prepass_vert);
+  ShaderRegistry::registerSource("depth_prepass_frag", shaders::depth_prepass_frag);
+
+  // Renderer weighted blended transparency
+  ShaderRegistry::registerSource("oit_composite_frag", shaders::oit_composite_frag);
+
+  // Renderer tone mapping pass
+  ShaderRegistry::registerSource("tone_mapping_frag", shaders::tone_mapping_frag);
+
   // IBL
   ShaderRegistry::registerSource("pbr_common", shaders::pbr_common);
   ShaderRegistry::registerSource("brdf_lut_frag", shaders::brdf_lut_frag);
@@ -167,6 +167,9 @@ GLenum Texture::toGLInternal(TextureFormat format) {
   case TextureFormat::SRGB8_ALPHA8:
     return GL_SRGB8_ALPHA8;
 
+  case TextureFormat::R32UI:
+    return GL_R32UI;
+
   case TextureFormat::Depth16:
     return GL_DEPTH_COMPONENT16;
   case TextureFormat::Depth24:
@@ -272,6 +275,11 @@ void Texture::pixelFormatAndType(TextureFormat format, GLenum& outFormat, GLenum
     outType = GL_UNSIGNED_BYTE;
     break;
 
+  case TextureFormat::R32UI:
+    outFormat = GL_RED_INTEGER;
+    outType = GL_UNSIGNED_INT;
+    break;
+
   case TextureFormat::Depth16:
     outFormat = GL_DEPTH_COMPONENT;
     outType = GL_UNSIGNED_SHORT;
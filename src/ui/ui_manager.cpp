@@ -1,6 +1,7 @@
 #include "ui/ui_manager.hpp"
 #include "ui/fonts/inter/inter_variable_ttf.hpp"
 #include <blkhurst/events/events.hpp>
+#include <blkhurst/renderer/renderer.hpp>
 #include <blkhurst/util/assets.hpp>
 
 #include <cstdio>
@@ -133,6 +134,34 @@ void UiManager::drawStatsHeader(const RootState& state) {
     ImGui::SameLine();
     ImGui::Text("MS: %.2f", state.ms);
 
+    if (state.renderer != nullptr) {
+      const auto& stats = state.renderer->stats();
+      ImGui::Text("Draws: %d  Tris: %zu  LOD saved: %zu", stats.drawCalls, stats.triangles,
+                  stats.trianglesSavedByLod);
+      ImGui::Text("VAO binds: %d  Meshes culled: %zu", stats.vertexArrayBinds,
+                  stats.meshesCulled);
+      if (stats.occlusionQueries > 0) {
+        ImGui::Text("Occluded: %zu  Queries: %zu", stats.meshesOccluded, stats.occlusionQueries);
+      }
+      if (stats.occluderTriangles > 0) {
+        ImGui::Text("CPU occluded: %zu  Occluder tris: %zu", stats.meshesSoftwareOccluded,
+                    stats.occluderTriangles);
+      }
+      const float pixels = state.windowFramebufferSize.x * state.windowFramebufferSize.y;
+      if (stats.fragmentInvocations > 0 && pixels > 0.0F) {
+        ImGui::Text("Overdraw: %.2f  Pre-pass draws: %d",
+                    static_cast<double>(stats.fragmentInvocations) / pixels,
+                    stats.depthPrepassDraws);
+      }
+      if (state.resolutionScale < 1.0F || stats.gpuFrameMs > 0.0F) {
+        ImGui::Text("Resolution scale: %.2f  GPU: %.2f ms", state.resolutionScale,
+                    stats.gpuFrameMs);
+      }
+      if (stats.meshletsTested > 0) {
+        ImGui::Text("Meshlets culled: %zu / %zu", stats.meshletsCulled, stats.meshletsTested);
+      }
+    }
+
     // Event Manager Fullscreen Event
     static bool useFullscreen = false;
     if (ImGui::Checkbox("Fullscreen", &useFullscreen)) {
@@ -0,0 +1,55 @@
+#include <blkhurst/util/aabb.hpp>
+
+namespace blkhurst {
+
+void Aabb::expand(const glm::vec3& point) {
+  min = glm::min(min, point);
+  max = glm::max(max, point);
+}
+
+void Aabb::expand(const Aabb& box) {
+  min = glm::min(min, box.min);
+  max = glm::max(max, box.max);
+}
+
+bool Aabb::empty() const {
+  return min[0] > max[0] || min[1] > max[1] || min[2] > max[2];
+}
+
+glm::vec3 Aabb::center() const {
+  return (min + max) * 0.5F;
+}
+
+glm::vec3 Aabb::extent() const {
+  return empty() ? glm::vec3(0.0F) : max - min;
+}
+
+float Aabb::surfaceArea() const {
+  const glm::vec3 size = extent();
+  return 2.0F * ((size[0] * size[1]) + (size[1] * size[2]) + (size[2] * size[0]));
+}
+
+bool Aabb::overlaps(const Aabb& box) const {
+  return min[0] <= box.max[0] && max[0] >= box.min[0] && min[1] <= box.max[1] &&
+         max[1] >= box.min[1] && min[2] <= box.max[2] && max[2] >= box.min[2];
+}
+
+bool Aabb::contains(const Aabb& box) const {
+  return min[0] <= box.min[0] && min[1] <= box.min[1] && min[2] <= box.min[2] &&
+         max[0] >= box.max[0] && max[1] >= box.max[1] && max[2] >= box.max[2];
+}
+
+Aabb Aabb::transformed(const glm::mat4& matrix) const {
+  Aabb out;
+  if (empty()) {
+    return out;
+  }
+  for (int corner = 0; corner < 8; ++corner) {
+    const glm::vec3 point((corner & 1) != 0 ? max[0] : min[0], (corner & 2) != 0 ? max[1] : min[1],
+                          (corner & 4) != 0 ? max[2] : min[2]);
+    out.expand(glm::vec3(matrix * glm::vec4(point, 1.0F)));
+  }
+  return out;
+}
+
+} // namespace blkhurst
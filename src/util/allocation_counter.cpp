@@ -0,0 +1,69 @@
+#include <blkhurst/util/allocation_counter.hpp>
+
+#ifdef BLKHURST_TRACK_ALLOCATIONS
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+std::atomic<std::uint64_t> gAllocations{0}; // NOLINT
+
+void* countedAlloc(std::size_t size) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* ptr = std::malloc(size == 0 ? 1 : size)) { // NOLINT
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void* countedAlignedAlloc(std::size_t size, std::align_val_t alignment) {
+  gAllocations.fetch_add(1, std::memory_order_relaxed);
+  const auto align = static_cast<std::size_t>(alignment);
+  const std::size_t rounded = ((size + align - 1) / align) * align; // aligned_alloc requirement
+  if (void* ptr = std::aligned_alloc(align, rounded == 0 ? align : rounded)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+} // namespace
+
+// Array and nothrow forms forward to these in the standard library
+void* operator new(std::size_t size) {
+  return countedAlloc(size);
+}
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return countedAlignedAlloc(size, alignment);
+}
+void operator delete(void* ptr) noexcept {
+  std::free(ptr); // NOLINT
+}
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+  std::free(ptr); // NOLINT
+}
+void operator delete(void* ptr, std::align_val_t /*alignment*/) noexcept {
+  std::free(ptr); // NOLINT
+}
+void operator delete(void* ptr, std::size_t /*size*/, std::align_val_t /*alignment*/) noexcept {
+  std::free(ptr); // NOLINT
+}
+#endif
+
+namespace blkhurst::allocation_counter {
+
+bool enabled() {
+#ifdef BLKHURST_TRACK_ALLOCATIONS
+  return true;
+#else
+  return false;
+#endif
+}
+
+std::uint64_t count() {
+#ifdef BLKHURST_TRACK_ALLOCATIONS
+  return gAllocations.load(std::memory_order_relaxed);
+#else
+  return 0;
+#endif
+}
+
+} // namespace blkhurst::allocation_counter
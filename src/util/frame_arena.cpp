@@ -0,0 +1,108 @@
+#include <blkhurst/util/frame_arena.hpp>
+#include <spdlog/spdlog.h>
+
+#include <algorithm>
+#include <cstdint>
+
+namespace blkhurst {
+
+namespace {
+constexpr std::size_t kBlockAlignment = alignof(std::max_align_t);
+} // namespace
+
+FrameArena::FrameArena(std::size_t initialCapacity, std::pmr::memory_resource* upstream)
+    : upstream_(upstream) {
+  if (initialCapacity > 0) {
+    block_.data = static_cast<std::byte*>(upstream_->allocate(initialCapacity, kBlockAlignment));
+    block_.size = initialCapacity;
+  }
+  overflow_.reserve(8);
+}
+
+FrameArena::~FrameArena() {
+  for (auto& block : overflow_) {
+    upstream_->deallocate(block.data, block.size, kBlockAlignment);
+  }
+  if (block_.data != nullptr) {
+    upstream_->deallocate(block_.data, block_.size, kBlockAlignment);
+  }
+}
+
+void FrameArena::reset() {
+  highWater_ = std::max(highWater_, frameBytes_);
+
+  if (!overflow_.empty()) {
+    // Frame outgrew the block; replace it with one that fits the whole frame
+    for (auto& block : overflow_) {
+      upstream_->deallocate(block.data, block.size, kBlockAlignment);
+    }
+    overflow_.clear();
+
+    const std::size_t newSize = std::max(highWater_ + (highWater_ / 2), block_.size * 2);
+    if (block_.data != nullptr) {
+      upstream_->deallocate(block_.data, block_.size, kBlockAlignment);
+    }
+    block_.data = static_cast<std::byte*>(upstream_->allocate(newSize, kBlockAlignment));
+    block_.size = newSize;
+    spdlog::debug("FrameArena grown to {} bytes", newSize);
+  }
+
+  offset_ = 0;
+  overflowOffset_ = 0;
+  frameBytes_ = 0;
+}
+
+std::size_t FrameArena::bytesUsed() const {
+  return frameBytes_;
+}
+
+std::size_t FrameArena::capacity() const {
+  return block_.size;
+}
+
+std::size_t FrameArena::highWaterMark() const {
+  return std::max(highWater_, frameBytes_);
+}
+
+void* FrameArena::do_allocate(std::size_t bytes, std::size_t alignment) {
+  frameBytes_ += bytes;
+  if (void* ptr = bump_(block_, offset_, bytes, alignment)) {
+    return ptr;
+  }
+  if (!overflow_.empty()) {
+    if (void* ptr = bump_(overflow_.back(), overflowOffset_, bytes, alignment)) {
+      return ptr;
+    }
+  }
+
+  // New overflow block, at least as large as the main block
+  const std::size_t size = std::max({bytes + alignment, block_.size, std::size_t{4096}});
+  overflow_.push_back({static_cast<std::byte*>(upstream_->allocate(size, kBlockAlignment)), size});
+  overflowOffset_ = 0;
+  return bump_(overflow_.back(), overflowOffset_, bytes, alignment);
+}
+
+void FrameArena::do_deallocate(void* /*ptr*/, std::size_t /*bytes*/, std::size_t /*alignment*/) {
+  // Reclaimed by reset()
+}
+
+bool FrameArena::do_is_equal(const std::pmr::memory_resource& other) const noexcept {
+  return this == &other;
+}
+
+void* FrameArena::bump_(Block& block, std::size_t& offset, std::size_t bytes,
+                        std::size_t alignment) {
+  if (block.data == nullptr) {
+    return nullptr;
+  }
+  const auto base = reinterpret_cast<std::uintptr_t>(block.data); // NOLINT
+  const std::uintptr_t aligned = (base + offset + alignment - 1) & ~(std::uintptr_t{alignment} - 1);
+  const std::size_t end = static_cast<std::size_t>(aligned - base) + bytes;
+  if (end > block.size) {
+    return nullptr;
+  }
+  offset = end;
+  return reinterpret_cast<void*>(aligned); // NOLINT
+}
+
+} // namespace blkhurst
@@ -0,0 +1,56 @@
+#include <blkhurst/util/frustum.hpp>
+
+namespace blkhurst {
+
+// Gribb & Hartmann; rows of the clip matrix combined per plane
+Frustum Frustum::fromMatrix(const glm::mat4& clip) {
+  const glm::vec4 row0(clip[0][0], clip[1][0], clip[2][0], clip[3][0]);
+  const glm::vec4 row1(clip[0][1], clip[1][1], clip[2][1], clip[3][1]);
+  const glm::vec4 row2(clip[0][2], clip[1][2], clip[2][2], clip[3][2]);
+  const glm::vec4 row3(clip[0][3], clip[1][3], clip[2][3], clip[3][3]);
+
+  Frustum frustum;
+  frustum.planes = {row3 + row0, row3 - row0, row3 + row1, row3 - row1, row3 + row2, row3 - row2};
+  for (auto& plane : frustum.planes) {
+    const float length = glm::length(glm::vec3(plane));
+    if (length > 0.0F) {
+      plane /= length;
+    }
+  }
+  return frustum;
+}
+
+bool Frustum::intersectsSphere(const glm::vec3& center, float radius) const {
+  for (const auto& plane : planes) {
+    if (glm::dot(glm::vec3(plane), center) + plane.w < -radius) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Frustum::intersectsBox(const glm::vec3& min, const glm::vec3& max) const {
+  for (const auto& plane : planes) {
+    // Corner farthest along the plane normal
+    const glm::vec3 positive(plane.x >= 0.0F ? max.x : min.x, plane.y >= 0.0F ? max.y : min.y,
+                             plane.z >= 0.0F ? max.z : min.z);
+    if (glm::dot(glm::vec3(plane), positive) + plane.w < 0.0F) {
+      return false;
+    }
+  }
+  return true;
+}
+
+bool Frustum::containsBox(const glm::vec3& min, const glm::vec3& max) const {
+  for (const auto& plane : planes) {
+    // Corner farthest against the plane normal
+    const glm::vec3 negative(plane.x >= 0.0F ? min.x : max.x, plane.y >= 0.0F ? min.y : max.y,
+                             plane.z >= 0.0F ? min.z : max.z);
+    if (glm::dot(glm::vec3(plane), negative) + plane.w < 0.0F) {
+      return false;
+    }
+  }
+  return true;
+}
+
+} // namespace blkhurst
@@ -0,0 +1,103 @@
+#include <blkhurst/cameras/perspective_camera.hpp>
+#include <blkhurst/engine.hpp>
+#include <blkhurst/engine/config.hpp>
+#include <blkhurst/engine/root_state.hpp>
+#include <blkhurst/geometry/box_geometry.hpp>
+#include <blkhurst/materials/basic_material.hpp>
+#include <blkhurst/objects/mesh.hpp>
+#include <blkhurst/scene/scene.hpp>
+#include <blkhurst/util/allocation_counter.hpp>
+
+#include <GLFW/glfw3.h>
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+// Runs the full Engine frame loop over a small scene and checks that, after warm-up, a run of
+// frames performs no global heap allocations. Needs a library built with
+// BLKHURST_TRACK_ALLOCATIONS and a GL 4.5 context; skipped otherwise.
+
+using namespace blkhurst; // NOLINT
+
+namespace {
+
+constexpr int kWarmupFrames = 180; // Longer than the Engine's own post-load warm-up
+constexpr int kMeasuredFrames = 240;
+
+struct FrameCounts {
+  std::uint64_t atWarmup = 0;
+  std::uint64_t atEnd = 0;
+  int frames = 0;
+};
+
+FrameCounts gCounts; // NOLINT
+
+class Spinner : public Mesh {
+public:
+  using Mesh::Mesh;
+
+  void onUpdate(const RootState& state) override {
+    rotateY(state.delta);
+  }
+};
+
+// Grid of boxes, a few of them animated; closes the window once measured
+class AllocationScene : public Scene {
+public:
+  AllocationScene() {
+    auto camera = PerspectiveCamera::create();
+    camera->setPosition({0.0F, 4.0F, 12.0F});
+    setActiveCamera(camera);
+
+    auto geometry = BoxGeometry::create();
+    auto material = BasicMaterial::create();
+    for (int x = -4; x <= 4; ++x) {
+      for (int z = -4; z <= 4; ++z) {
+        Mesh* mesh = (x + z) % 3 == 0 ? addChild<Spinner>(geometry, material)
+                                      : addChild<Mesh>(geometry, material);
+        mesh->setPosition({static_cast<float>(x) * 1.5F, 0.0F, static_cast<float>(z) * 1.5F});
+      }
+    }
+  }
+
+  void onUpdate(const RootState& /*state*/) override {
+    ++gCounts.frames;
+    if (gCounts.frames == kWarmupFrames) {
+      gCounts.atWarmup = allocation_counter::count();
+    } else if (gCounts.frames == kWarmupFrames + kMeasuredFrames) {
+      gCounts.atEnd = allocation_counter::count();
+      glfwSetWindowShouldClose(glfwGetCurrentContext(), GLFW_TRUE);
+    }
+  }
+};
+
+} // namespace
+
+TEST(FrameAllocations, SteadyStateFramesDoNotAllocate) {
+  if (!allocation_counter::enabled()) {
+    GTEST_SKIP() << "library built without BLKHURST_TRACK_ALLOCATIONS";
+  }
+  if (glfwInit() == GLFW_FALSE) {
+    GTEST_SKIP() << "no display available";
+  }
+  glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+
+  EngineConfig config;
+  config.windowConfig.title = "frame_allocation_test";
+  config.windowConfig.enableVSync = false;
+
+  std::unique_ptr<Engine> engine;
+  try {
+    engine = std::make_unique<Engine>(config);
+  } catch (const std::runtime_error& error) {
+    GTEST_SKIP() << "no OpenGL context: " << error.what();
+  }
+  engine->registerScene<AllocationScene>("allocation");
+  engine->run();
+
+  ASSERT_EQ(gCounts.frames, kWarmupFrames + kMeasuredFrames);
+  EXPECT_EQ(gCounts.atEnd - gCounts.atWarmup, 0U)
+      << "heap allocations over " << kMeasuredFrames << " steady-state frames";
+}
@@ -0,0 +1,216 @@
+#include <blkhurst/geometry/bvh.hpp>
+#include <blkhurst/jobs/job_system.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <random>
+#include <vector>
+
+using blkhurst::JobSystem;
+using blkhurst::MeshBvh;
+using blkhurst::Ray;
+using blkhurst::TriangleHit;
+
+namespace {
+
+// Barycentric slack for rays grazing an edge, where float and double may disagree
+constexpr double kEdgeSlack = 1e-4;
+
+struct Soup {
+  std::vector<float> positions;
+  std::vector<std::uint32_t> indices;
+};
+
+// Small random triangles in a cube; indexed through a shuffled index buffer
+Soup randomSoup(int triangles, unsigned seed) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> centre(-10.0F, 10.0F);
+  std::uniform_real_distribution<float> offset(-1.0F, 1.0F);
+  Soup soup;
+  for (int triangle = 0; triangle < triangles; ++triangle) {
+    const float x = centre(random);
+    const float y = centre(random);
+    const float z = centre(random);
+    for (int vertex = 0; vertex < 3; ++vertex) {
+      soup.positions.insert(soup.positions.end(),
+                            {x + offset(random), y + offset(random), z + offset(random)});
+    }
+  }
+  std::vector<std::uint32_t> order(static_cast<std::size_t>(triangles));
+  std::iota(order.begin(), order.end(), 0U);
+  std::shuffle(order.begin(), order.end(), random);
+  for (const std::uint32_t triangle : order) {
+    soup.indices.insert(soup.indices.end(), {triangle * 3, (triangle * 3) + 1, (triangle * 3) + 2});
+  }
+  return soup;
+}
+
+std::vector<Ray> randomRays(int count, unsigned seed) {
+  std::mt19937 random(seed);
+  std::uniform_real_distribution<float> position(-12.0F, 12.0F);
+  std::uniform_real_distribution<float> direction(-1.0F, 1.0F);
+  std::vector<Ray> rays;
+  for (int i = 0; i < count; ++i) {
+    glm::vec3 towards(direction(random), direction(random), direction(random));
+    if (glm::dot(towards, towards) < 1e-4F) {
+      towards = glm::vec3(0.0F, 0.0F, 1.0F);
+    }
+    rays.push_back({.origin = glm::vec3(position(random), position(random), position(random)),
+                    .direction = glm::normalize(towards)});
+  }
+  return rays;
+}
+
+struct ReferenceHit {
+  double distance = 0.0;
+  double margin = 0.0; // Smallest barycentric weight; negative just outside an edge
+};
+
+// Brute-force Moller-Trumbore in double precision, both faces
+std::optional<ReferenceHit> referenceHit(const Soup& soup, std::uint32_t triangle,
+                                         const Ray& ray) {
+  auto corner = [&](std::uint32_t vertex) {
+    const std::size_t base = static_cast<std::size_t>(soup.indices[(triangle * 3) + vertex]) * 3;
+    return glm::dvec3(soup.positions[base], soup.positions[base + 1], soup.positions[base + 2]);
+  };
+  const glm::dvec3 v0 = corner(0);
+  const glm::dvec3 edge1 = corner(1) - v0;
+  const glm::dvec3 edge2 = corner(2) - v0;
+  const glm::dvec3 direction(ray.direction);
+  const glm::dvec3 pvec = glm::cross(direction, edge2);
+  const double det = glm::dot(edge1, pvec);
+  if (std::abs(det) < 1e-12) {
+    return std::nullopt;
+  }
+  const glm::dvec3 tvec = glm::dvec3(ray.origin) - v0;
+  const double u = glm::dot(tvec, pvec) / det;
+  const glm::dvec3 qvec = glm::cross(tvec, edge1);
+  const double v = glm::dot(direction, qvec) / det;
+  const double distance = glm::dot(edge2, qvec) / det;
+  if (distance < 0.0) {
+    return std::nullopt;
+  }
+  return ReferenceHit{distance, std::min({u, v, 1.0 - u - v})};
+}
+
+// Checks nearest and all hits of every ray against the brute-force reference
+void expectMatchesReference(const Soup& soup, const MeshBvh& bvh, const std::vector<Ray>& rays,
+                            float tMax) {
+  const auto triangles = static_cast<std::uint32_t>(soup.indices.size() / 3);
+  std::vector<TriangleHit> all;
+  int hitRays = 0;
+  for (const Ray& ray : rays) {
+    std::vector<std::optional<ReferenceHit>> reference(triangles);
+    std::optional<double> nearestCertain;
+    for (std::uint32_t triangle = 0; triangle < triangles; ++triangle) {
+      reference[triangle] = referenceHit(soup, triangle, ray);
+      const auto& hit = reference[triangle];
+      if (hit && hit->margin > kEdgeSlack && hit->distance < tMax * (1.0 - 1e-5)) {
+        nearestCertain = std::min(nearestCertain.value_or(hit->distance), hit->distance);
+      }
+    }
+    auto possible = [&](const TriangleHit& hit) {
+      if (hit.triangle >= triangles) {
+        return false;
+      }
+      const auto& expected = reference[hit.triangle];
+      return expected && expected->margin > -kEdgeSlack &&
+             std::abs(expected->distance - hit.distance) < 1e-3 * (1.0 + expected->distance);
+    };
+
+    TriangleHit nearest;
+    const bool found = bvh.intersectNearest(ray, tMax, nearest);
+    if (nearestCertain) {
+      ASSERT_TRUE(found);
+      EXPECT_LE(nearest.distance, *nearestCertain + 1e-3 * (1.0 + *nearestCertain));
+      ++hitRays;
+    }
+    if (found) {
+      EXPECT_TRUE(possible(nearest)) << "triangle " << nearest.triangle;
+      EXPECT_LE(nearest.distance, tMax);
+      EXPECT_NEAR(nearest.barycentric.x + nearest.barycentric.y + nearest.barycentric.z, 1.0F,
+                  1e-4F);
+    }
+
+    all.clear();
+    bvh.intersectAll(ray, tMax, all);
+    for (const TriangleHit& hit : all) {
+      EXPECT_TRUE(possible(hit)) << "triangle " << hit.triangle;
+    }
+    for (std::uint32_t triangle = 0; triangle < triangles; ++triangle) {
+      const auto& expected = reference[triangle];
+      if (expected && expected->margin > kEdgeSlack && expected->distance < tMax * (1.0 - 1e-5)) {
+        EXPECT_TRUE(std::any_of(all.begin(), all.end(), [&](const TriangleHit& hit) {
+          return hit.triangle == triangle;
+        })) << "missed triangle " << triangle;
+      }
+    }
+  }
+  // Guards against a degenerate scene where nothing is compared
+  EXPECT_GT(hitRays, static_cast<int>(rays.size()) / 10);
+}
+
+} // namespace
+
+TEST(MeshBvh, MatchesBruteForce) {
+  const Soup soup = randomSoup(2000, 1);
+  const auto bvh = MeshBvh::build(soup.positions, soup.indices);
+  ASSERT_EQ(bvh->triangleCount(), 2000U);
+  expectMatchesReference(soup, *bvh, randomRays(500, 2), std::numeric_limits<float>::infinity());
+}
+
+TEST(MeshBvh, RespectsMaxDistance) {
+  const Soup soup = randomSoup(2000, 3);
+  const auto bvh = MeshBvh::build(soup.positions, soup.indices);
+  expectMatchesReference(soup, *bvh, randomRays(500, 4), 6.0F);
+}
+
+// Above kParallelPrimitives, so subtrees are built as tasks and stitched together
+TEST(MeshBvh, ParallelBuildMatchesBruteForce) {
+  const int triangles = static_cast<int>(blkhurst::Bvh::kParallelPrimitives) + 4000;
+  const Soup soup = randomSoup(triangles, 5);
+  JobSystem jobs(3);
+  const auto bvh = MeshBvh::build(soup.positions, soup.indices, &jobs);
+  ASSERT_EQ(bvh->triangleCount(), static_cast<std::size_t>(triangles));
+  expectMatchesReference(soup, *bvh, randomRays(64, 6), std::numeric_limits<float>::infinity());
+}
+
+TEST(MeshBvh, NonIndexedUsesConsecutivePositions) {
+  Soup soup = randomSoup(500, 7);
+  const auto bvh = MeshBvh::build(soup.positions, {});
+  // Triangle i is positions 3i..3i+2
+  soup.indices.resize(soup.positions.size() / 3);
+  std::iota(soup.indices.begin(), soup.indices.end(), 0U);
+  expectMatchesReference(soup, *bvh, randomRays(300, 8), std::numeric_limits<float>::infinity());
+}
+
+TEST(MeshBvh, HitsBothFaces) {
+  const std::vector<float> positions{-1.0F, -1.0F, 0.0F, 1.0F, -1.0F, 0.0F, 0.0F, 1.0F, 0.0F};
+  const auto bvh = MeshBvh::build(positions, {});
+  for (const float side : {1.0F, -1.0F}) {
+    TriangleHit hit;
+    const Ray ray{.origin = glm::vec3(0.0F, 0.0F, 2.0F * side),
+                  .direction = glm::vec3(0.0F, 0.0F, -side)};
+    ASSERT_TRUE(bvh->intersectNearest(ray, std::numeric_limits<float>::infinity(), hit));
+    EXPECT_FLOAT_EQ(hit.distance, 2.0F);
+    EXPECT_EQ(hit.triangle, 0U);
+  }
+  // Pointing away from it
+  TriangleHit hit;
+  const Ray away{.origin = glm::vec3(0.0F, 0.0F, 2.0F), .direction = glm::vec3(0.0F, 0.0F, 1.0F)};
+  EXPECT_FALSE(bvh->intersectNearest(away, std::numeric_limits<float>::infinity(), hit));
+}
+
+TEST(MeshBvh, EmptyMeshHitsNothing) {
+  const auto bvh = MeshBvh::build({}, {});
+  EXPECT_EQ(bvh->triangleCount(), 0U);
+  TriangleHit hit;
+  const Ray ray{.origin = glm::vec3(0.0F), .direction = glm::vec3(0.0F, 0.0F, 1.0F)};
+  EXPECT_FALSE(bvh->intersectNearest(ray, std::numeric_limits<float>::infinity(), hit));
+}
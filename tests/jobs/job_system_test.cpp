@@ -0,0 +1,206 @@
+#include <blkhurst/jobs/job_system.hpp>
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using blkhurst::JobSystem;
+using blkhurst::TaskAffinity;
+using blkhurst::TaskGroup;
+
+namespace {
+
+class JobSystemWorkers : public ::testing::TestWithParam<int> {};
+
+std::vector<int> toCounts(const std::vector<std::atomic<int>>& hits) {
+  std::vector<int> counts;
+  counts.reserve(hits.size());
+  for (const auto& hit : hits) {
+    counts.push_back(hit.load());
+  }
+  return counts;
+}
+
+} // namespace
+
+TEST_P(JobSystemWorkers, ParallelForVisitsEveryIndexOnce) {
+  JobSystem jobs(GetParam());
+  for (std::size_t count : {0, 1, 7, 64, 1000, 1001}) {
+    std::vector<std::atomic<int>> hits(count);
+    jobs.parallelFor(count, [&](std::size_t i) { hits[i].fetch_add(1); });
+    EXPECT_EQ(toCounts(hits), std::vector<int>(count, 1)) << "count " << count;
+  }
+}
+
+TEST_P(JobSystemWorkers, ParallelForChunksTileTheRange) {
+  JobSystem jobs(GetParam());
+  for (std::size_t grain : {1, 3, 16, 5000}) {
+    std::vector<std::atomic<int>> hits(1000);
+    std::atomic<int> oversized{0};
+    jobs.parallelFor(hits.size(), grain, [&](std::size_t begin, std::size_t end) {
+      if (end - begin > grain || begin >= end) {
+        oversized.fetch_add(1);
+      }
+      for (std::size_t i = begin; i < end; ++i) {
+        hits[i].fetch_add(1);
+      }
+    });
+    EXPECT_EQ(oversized.load(), 0) << "grain " << grain;
+    EXPECT_EQ(toCounts(hits), std::vector<int>(hits.size(), 1)) << "grain " << grain;
+  }
+}
+
+TEST_P(JobSystemWorkers, NestedSubmitAndWait) {
+  JobSystem jobs(GetParam());
+  constexpr int kOuter = 16;
+  constexpr int kInner = 32;
+  std::atomic<int> innerRuns{0};
+  std::atomic<int> outerDone{0};
+
+  // Every outer task waits on its own inner group from inside a task
+  TaskGroup outer;
+  for (int i = 0; i < kOuter; ++i) {
+    jobs.submit(outer, [&]() {
+      TaskGroup inner;
+      for (int j = 0; j < kInner; ++j) {
+        jobs.submit(inner, [&]() { innerRuns.fetch_add(1); });
+      }
+      jobs.wait(inner);
+      outerDone.fetch_add(1);
+    });
+  }
+  jobs.wait(outer);
+
+  EXPECT_TRUE(outer.done());
+  EXPECT_EQ(outerDone.load(), kOuter);
+  EXPECT_EQ(innerRuns.load(), kOuter * kInner);
+}
+
+TEST_P(JobSystemWorkers, NestedParallelFor) {
+  JobSystem jobs(GetParam());
+  std::vector<std::atomic<int>> hits(64 * 64);
+  jobs.parallelFor(64, [&](std::size_t row) {
+    jobs.parallelFor(64, [&](std::size_t column) { hits[row * 64 + column].fetch_add(1); });
+  });
+  EXPECT_EQ(toCounts(hits), std::vector<int>(hits.size(), 1));
+}
+
+TEST_P(JobSystemWorkers, ContinuationRunsOnceAfterGroup) {
+  JobSystem jobs(GetParam());
+  std::atomic<int> runs{0};
+  std::atomic<int> continuations{0};
+  std::atomic<int> runsSeenByContinuation{-1};
+
+  TaskGroup group;
+  for (int i = 0; i < 100; ++i) {
+    jobs.submit(group, [&]() { runs.fetch_add(1); });
+  }
+  group.then(
+      [&]() {
+        runsSeenByContinuation.store(runs.load());
+        continuations.fetch_add(1);
+      },
+      TaskAffinity::MainThread);
+  jobs.wait(group);
+
+  // The last task dispatches the continuation after the group reads as done
+  while (continuations.load() == 0) {
+    jobs.runMainThreadTasks();
+    std::this_thread::yield();
+  }
+  jobs.runMainThreadTasks();
+
+  EXPECT_EQ(continuations.load(), 1);
+  EXPECT_EQ(runsSeenByContinuation.load(), 100);
+}
+
+TEST_P(JobSystemWorkers, MainThreadTasksRunOnMainThread) {
+  JobSystem jobs(GetParam());
+  std::atomic<int> offMainThread{0};
+  std::atomic<int> runs{0};
+
+  TaskGroup group;
+  for (int i = 0; i < 8; ++i) {
+    jobs.submitMainThread(group, [&]() {
+      offMainThread.fetch_add(jobs.isMainThread() ? 0 : 1);
+      runs.fetch_add(1);
+    });
+  }
+  // wait() on the main thread drains the main queue
+  jobs.wait(group);
+
+  EXPECT_EQ(runs.load(), 8);
+  EXPECT_EQ(offMainThread.load(), 0);
+}
+
+TEST_P(JobSystemWorkers, ShutdownDrainsQueuedTasks) {
+  constexpr int kTasks = 2000;
+  std::atomic<int> runs{0};
+  {
+    JobSystem jobs(GetParam());
+    for (int i = 0; i < kTasks; ++i) {
+      jobs.submit([&]() { runs.fetch_add(1); });
+    }
+  }
+  EXPECT_EQ(runs.load(), kTasks);
+}
+
+// Fire-and-forget work nobody waits on, as TextureLoader::loadAsync submits it
+TEST_P(JobSystemWorkers, UnwaitedTasksCompleteThroughMainThreadTasks) {
+  JobSystem jobs(GetParam());
+  std::atomic<int> loaded{0};
+  for (int i = 0; i < 10; ++i) {
+    jobs.submit([&]() { jobs.submitMainThread([&]() { loaded.fetch_add(1); }); });
+  }
+  for (int frame = 0; frame < 10000 && loaded.load() < 10; ++frame) {
+    jobs.runMainThreadTasks();
+    std::this_thread::yield();
+  }
+  EXPECT_EQ(loaded.load(), 10);
+}
+
+TEST_P(JobSystemWorkers, MainThreadTasksRunOnlyWhatWasQueued) {
+  std::atomic<int> runs{0};
+  std::function<void()> again;
+  JobSystem jobs(GetParam()); // Destroyed first; its destructor still runs `again`
+  // Resubmits itself; each runMainThreadTasks() must still return
+  again = [&]() {
+    if (runs.fetch_add(1) < 100) {
+      jobs.submit(again);
+    }
+  };
+  jobs.submit(again);
+  for (int frame = 0; frame < 3; ++frame) {
+    jobs.runMainThreadTasks();
+  }
+  if (GetParam() == 0) {
+    EXPECT_EQ(runs.load(), 3); // One generation per call
+  }
+}
+
+INSTANTIATE_TEST_SUITE_P(Workers, JobSystemWorkers, ::testing::Values(0, 1, 3));
+
+TEST(JobSystem, ShutdownWithIdleWorkers) {
+  for (int workers : {0, 1, 4}) {
+    JobSystem jobs(workers);
+    EXPECT_EQ(jobs.workerCount(), workers);
+  }
+}
+
+TEST(JobSystem, ZeroWorkersRunOnWaitingThread) {
+  JobSystem jobs(0);
+  std::atomic<int> offMainThread{0};
+
+  TaskGroup group;
+  for (int i = 0; i < 10; ++i) {
+    jobs.submit(group, [&]() { offMainThread.fetch_add(jobs.isMainThread() ? 0 : 1); });
+  }
+  EXPECT_FALSE(group.done());
+  jobs.wait(group);
+
+  EXPECT_TRUE(group.done());
+  EXPECT_EQ(offMainThread.load(), 0);
+}
@@ -0,0 +1,601 @@
+#include <blkhurst/jobs/job_system.hpp>
+#include <blkhurst/renderer/occlusion_buffer.hpp>
+#include <glm/glm.hpp>
+#include <glm/gtc/constants.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+using blkhurst::Aabb;
+using blkhurst::JobSystem;
+using blkhurst::OcclusionBuffer;
+
+namespace {
+
+constexpr int kWidth = 64;
+constexpr int kHeight = 32;
+constexpr float kInf = std::numeric_limits<float>::infinity();
+const glm::mat4 kIdentity(1.0F); // Positions are clip space with w = 1, so NDC
+
+float ndcX(float pixel, int width = kWidth) {
+  return ((pixel / static_cast<float>(width)) * 2.0F) - 1.0F;
+}
+
+float ndcY(float pixel, int height = kHeight) {
+  return ((pixel / static_cast<float>(height)) * 2.0F) - 1.0F;
+}
+
+// Pixel rectangle as two triangles split along the x0,y0 - x1,y1 diagonal
+void addRect(OcclusionBuffer& buffer, float x0, float y0, float x1, float y1, float depth) {
+  const std::vector<float> positions{ndcX(x0), ndcY(y0), depth, ndcX(x1), ndcY(y0), depth,
+                                     ndcX(x1), ndcY(y1), depth, ndcX(x0), ndcY(y1), depth};
+  const std::vector<std::uint32_t> indices{0, 1, 2, 0, 2, 3};
+  buffer.addOccluder(positions, indices, kIdentity);
+}
+
+Aabb pixelBox(float x0, float y0, float x1, float y1, float nearDepth, float farDepth) {
+  return {.min = {ndcX(x0), ndcY(y0), nearDepth}, .max = {ndcX(x1), ndcY(y1), farDepth}};
+}
+
+// Per-pixel reference in double precision, from whole-pixel coverage tested at the four
+// corners; margin > 0 needs corners strictly inside, < 0 accepts corners just outside
+struct ScreenTriangle {
+  std::array<glm::dvec3, 3> vertices; // Screen x, y and NDC z
+};
+
+double edgeDistance(const glm::dvec3& from, const glm::dvec3& to, double xpos, double ypos,
+                    double sign) {
+  const double length = std::hypot(to[0] - from[0], to[1] - from[1]);
+  return sign * (((to[0] - from[0]) * (ypos - from[1])) - ((to[1] - from[1]) * (xpos - from[0]))) /
+         length;
+}
+
+std::vector<double> referenceDepth(const std::vector<ScreenTriangle>& triangles, int width,
+                                   int height, double margin) {
+  std::vector<double> depth(static_cast<std::size_t>(width) * height, kInf);
+  for (const auto& triangle : triangles) {
+    const auto& [v0, v1, v2] = triangle.vertices;
+    const double area = ((v1[0] - v0[0]) * (v2[1] - v0[1])) - ((v2[0] - v0[0]) * (v1[1] - v0[1]));
+    if (std::abs(area) < 1e-6) {
+      continue;
+    }
+    const double sign = area > 0.0 ? 1.0 : -1.0;
+    for (int ypos = 0; ypos < height; ++ypos) {
+      for (int xpos = 0; xpos < width; ++xpos) {
+        bool inside = true;
+        double farthest = -kInf;
+        for (int corner = 0; corner < 4 && inside; ++corner) {
+          const double cornerX = xpos + (corner & 1);
+          const double cornerY = ypos + (corner >> 1);
+          inside = edgeDistance(v1, v2, cornerX, cornerY, sign) >= margin &&
+                   edgeDistance(v2, v0, cornerX, cornerY, sign) >= margin &&
+                   edgeDistance(v0, v1, cornerX, cornerY, sign) >= margin;
+          const double weight1 =
+              (((cornerX - v0[0]) * (v2[1] - v0[1])) - ((v2[0] - v0[0]) * (cornerY - v0[1]))) /
+              area;
+          const double weight2 =
+              (((v1[0] - v0[0]) * (cornerY - v0[1])) - ((cornerX - v0[0]) * (v1[1] - v0[1]))) /
+              area;
+          farthest = std::max(farthest, v0[2] + (weight1 * (v1[2] - v0[2])) +
+                                            (weight2 * (v2[2] - v0[2])));
+        }
+        double& pixel = depth[(static_cast<std::size_t>(ypos) * width) + xpos];
+        if (inside) {
+          pixel = std::min(pixel, farthest);
+        }
+      }
+    }
+  }
+  return depth;
+}
+
+// Indexed occluder in model space
+struct Mesh {
+  std::vector<float> positions;
+  std::vector<std::uint32_t> indices;
+  glm::mat4 model{1.0F};
+};
+
+// Four vertices per face, as a box split for normals has
+Mesh splitBox(const glm::vec3& size) {
+  Mesh mesh;
+  const glm::vec3 half = size * 0.5F;
+  for (int axis = 0; axis < 3; ++axis) {
+    for (const float side : {-1.0F, 1.0F}) {
+      const int uAxis = (axis + 1) % 3;
+      const int vAxis = (axis + 2) % 3;
+      const auto first = static_cast<std::uint32_t>(mesh.positions.size() / 3);
+      for (const auto [u, v] : std::array<std::array<float, 2>, 4>{
+               {{-1.0F, -1.0F}, {1.0F, -1.0F}, {1.0F, 1.0F}, {-1.0F, 1.0F}}}) {
+        glm::vec3 corner;
+        corner[axis] = side * half[axis];
+        corner[uAxis] = u * half[uAxis];
+        corner[vAxis] = v * side * half[vAxis];
+        mesh.positions.insert(mesh.positions.end(), {corner[0], corner[1], corner[2]});
+      }
+      mesh.indices.insert(mesh.indices.end(),
+                          {first, first + 1, first + 2, first, first + 2, first + 3});
+    }
+  }
+  return mesh;
+}
+
+// Latitude rows with a duplicated seam column and one pole vertex per column
+Mesh uvSphere(float radius, int segments, int rings) {
+  Mesh mesh;
+  for (int ring = 0; ring <= rings; ++ring) {
+    const float theta = glm::pi<float>() * static_cast<float>(ring) / static_cast<float>(rings);
+    for (int segment = 0; segment <= segments; ++segment) {
+      const float phi =
+          2.0F * glm::pi<float>() * static_cast<float>(segment) / static_cast<float>(segments);
+      // Poles and the seam exactly, as a generator evaluating sin(pi) would not
+      const float sinTheta = ring == 0 || ring == rings ? 0.0F : std::sin(theta);
+      const float cosTheta = ring == 0 ? 1.0F : ring == rings ? -1.0F : std::cos(theta);
+      const float sinPhi = segment == segments ? 0.0F : std::sin(phi);
+      const float cosPhi = segment == segments ? 1.0F : std::cos(phi);
+      mesh.positions.insert(mesh.positions.end(), {radius * sinTheta * cosPhi,
+                                                   radius * cosTheta, radius * sinTheta * sinPhi});
+    }
+  }
+  const auto row = static_cast<std::uint32_t>(segments + 1);
+  for (std::uint32_t ring = 0; ring < static_cast<std::uint32_t>(rings); ++ring) {
+    for (std::uint32_t segment = 0; segment < static_cast<std::uint32_t>(segments); ++segment) {
+      const std::uint32_t a = (ring * row) + segment;
+      const std::uint32_t b = a + row;
+      if (ring != 0) {
+        mesh.indices.insert(mesh.indices.end(), {a, b, a + 1});
+      }
+      if (ring + 1 != static_cast<std::uint32_t>(rings)) {
+        mesh.indices.insert(mesh.indices.end(), {a + 1, b, b + 1});
+      }
+    }
+  }
+  return mesh;
+}
+
+std::vector<ScreenTriangle> project(const Mesh& mesh, const glm::mat4& modelViewProjection,
+                                    int width, int height) {
+  std::vector<ScreenTriangle> screen;
+  for (std::size_t i = 0; i + 2 < mesh.indices.size(); i += 3) {
+    ScreenTriangle triangle;
+    for (std::size_t vertex = 0; vertex < 3; ++vertex) {
+      const float* position = &mesh.positions[3 * mesh.indices[i + vertex]];
+      const glm::vec4 clip =
+          modelViewProjection * glm::vec4(position[0], position[1], position[2], 1.0F);
+      const double clipW = clip[3];
+      triangle.vertices[vertex] = {((clip[0] / clipW * 0.5) + 0.5) * width,
+                                   ((clip[1] / clipW * 0.5) + 0.5) * height, clip[2] / clipW};
+    }
+    screen.push_back(triangle);
+  }
+  return screen;
+}
+
+// Nearest surface of one occluder on a grid of kSamples x kSamples cells per pixel, corners
+// included; per pixel the farthest of its samples, infinite unless all are covered. A lower
+// bound on the depth the occluder reaches over the pixel
+std::vector<double> sampledDepth(const std::vector<ScreenTriangle>& triangles, int width,
+                                 int height, double margin) {
+  constexpr int kSamples = 4;
+  const int columns = (width * kSamples) + 1;
+  const int rows = (height * kSamples) + 1;
+  std::vector<double> nearest(static_cast<std::size_t>(columns) * rows, kInf);
+  for (const auto& triangle : triangles) {
+    const auto& [v0, v1, v2] = triangle.vertices;
+    const double area = ((v1[0] - v0[0]) * (v2[1] - v0[1])) - ((v2[0] - v0[0]) * (v1[1] - v0[1]));
+    if (std::abs(area) < 1e-9) {
+      continue;
+    }
+    const double sign = area > 0.0 ? 1.0 : -1.0;
+    const int column0 = std::max(0, static_cast<int>(std::floor(
+                                        std::min({v0[0], v1[0], v2[0]}) * kSamples)));
+    const int column1 = std::min(columns - 1, static_cast<int>(std::ceil(
+                                                  std::max({v0[0], v1[0], v2[0]}) * kSamples)));
+    const int row0 = std::max(0, static_cast<int>(std::floor(
+                                     std::min({v0[1], v1[1], v2[1]}) * kSamples)));
+    const int row1 = std::min(rows - 1, static_cast<int>(std::ceil(
+                                            std::max({v0[1], v1[1], v2[1]}) * kSamples)));
+    for (int row = row0; row <= row1; ++row) {
+      for (int column = column0; column <= column1; ++column) {
+        const double xpos = static_cast<double>(column) / kSamples;
+        const double ypos = static_cast<double>(row) / kSamples;
+        if (edgeDistance(v1, v2, xpos, ypos, sign) < margin ||
+            edgeDistance(v2, v0, xpos, ypos, sign) < margin ||
+            edgeDistance(v0, v1, xpos, ypos, sign) < margin) {
+          continue;
+        }
+        const double weight1 =
+            (((xpos - v0[0]) * (v2[1] - v0[1])) - ((v2[0] - v0[0]) * (ypos - v0[1]))) / area;
+        const double weight2 =
+            (((v1[0] - v0[0]) * (ypos - v0[1])) - ((xpos - v0[0]) * (v1[1] - v0[1]))) / area;
+        double& sample = nearest[(static_cast<std::size_t>(row) * columns) + column];
+        sample = std::min(sample, v0[2] + (weight1 * (v1[2] - v0[2])) +
+                                      (weight2 * (v2[2] - v0[2])));
+      }
+    }
+  }
+
+  std::vector<double> depth(static_cast<std::size_t>(width) * height, kInf);
+  for (int ypos = 0; ypos < height; ++ypos) {
+    for (int xpos = 0; xpos < width; ++xpos) {
+      double farthest = -kInf;
+      for (int row = ypos * kSamples; row <= (ypos + 1) * kSamples; ++row) {
+        for (int column = xpos * kSamples; column <= (xpos + 1) * kSamples; ++column) {
+          farthest =
+              std::max(farthest, nearest[(static_cast<std::size_t>(row) * columns) + column]);
+        }
+      }
+      depth[(static_cast<std::size_t>(ypos) * width) + xpos] = farthest;
+    }
+  }
+  return depth;
+}
+
+// Screen rectangle and nearest depth of a box, as OcclusionBuffer::occluded projects it
+struct BoxFootprint {
+  bool testable = false;
+  int x0 = 0;
+  int y0 = 0;
+  int x1 = -1;
+  int y1 = -1;
+  float nearest = kInf;
+};
+
+BoxFootprint footprint(const Aabb& box, const glm::mat4& viewProjection, int width, int height) {
+  BoxFootprint result;
+  glm::vec2 lower(std::numeric_limits<float>::max());
+  glm::vec2 upper(std::numeric_limits<float>::lowest());
+  for (int corner = 0; corner < 8; ++corner) {
+    const glm::vec4 clip = viewProjection * glm::vec4((corner & 1) != 0 ? box.max[0] : box.min[0],
+                                                      (corner & 2) != 0 ? box.max[1] : box.min[1],
+                                                      (corner & 4) != 0 ? box.max[2] : box.min[2],
+                                                      1.0F);
+    if (clip[3] < 1e-6F || clip[2] < -clip[3]) {
+      return result;
+    }
+    const glm::vec3 ndc = glm::vec3(clip) / clip[3];
+    lower = glm::min(lower, glm::vec2(ndc));
+    upper = glm::max(upper, glm::vec2(ndc));
+    result.nearest = std::min(result.nearest, ndc[2]);
+  }
+  const glm::vec2 size(static_cast<float>(width), static_cast<float>(height));
+  const glm::vec2 screenLower = ((lower * 0.5F) + 0.5F) * size;
+  const glm::vec2 screenUpper = ((upper * 0.5F) + 0.5F) * size;
+  if (screenUpper[0] < 0.0F || screenUpper[1] < 0.0F || screenLower[0] >= size[0] ||
+      screenLower[1] >= size[1]) {
+    return result;
+  }
+  result.testable = true;
+  result.x0 = std::max(0, static_cast<int>(std::floor(screenLower[0])));
+  result.y0 = std::max(0, static_cast<int>(std::floor(screenLower[1])));
+  result.x1 = std::min(width - 1, static_cast<int>(std::floor(screenUpper[0])));
+  result.y1 = std::min(height - 1, static_cast<int>(std::floor(screenUpper[1])));
+  return result;
+}
+
+bool referenceOccluded(const std::vector<double>& depth, int width, const BoxFootprint& box,
+                       double bias) {
+  if (!box.testable) {
+    return false;
+  }
+  for (int ypos = box.y0; ypos <= box.y1; ++ypos) {
+    for (int xpos = box.x0; xpos <= box.x1; ++xpos) {
+      if (depth[(static_cast<std::size_t>(ypos) * width) + xpos] + bias >= box.nearest) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+} // namespace
+
+TEST(OcclusionBuffer, EmptyUntilRasterised) {
+  OcclusionBuffer buffer(kWidth, kHeight);
+  addRect(buffer, 8.0F, 4.0F, 56.0F, 28.0F, 0.0F);
+  EXPECT_EQ(buffer.triangleCount(), 2U);
+  EXPECT_EQ(buffer.depth(40, 8), kInf);
+
+  buffer.rasterize();
+  EXPECT_FLOAT_EQ(buffer.depth(40, 8), 0.0F);
+  buffer.clear();
+  EXPECT_EQ(buffer.triangleCount(), 0U);
+  EXPECT_EQ(buffer.depth(40, 8), kInf);
+}
+
+TEST(OcclusionBuffer, RoundsUpToWholeTiles) {
+  const OcclusionBuffer buffer(61, 30);
+  EXPECT_EQ(buffer.width() % OcclusionBuffer::kTileWidth, 0);
+  EXPECT_EQ(buffer.height() % OcclusionBuffer::kTileHeight, 0);
+  EXPECT_GE(buffer.width(), 61);
+  EXPECT_GE(buffer.height(), 30);
+}
+
+TEST(OcclusionBuffer, NearestOccluderWinsInEitherOrder) {
+  for (const bool farFirst : {true, false}) {
+    OcclusionBuffer buffer(kWidth, kHeight);
+    for (const float depth : farFirst ? std::array{0.5F, -0.25F} : std::array{-0.25F, 0.5F}) {
+      addRect(buffer, 8.0F, 4.0F, 56.0F, 28.0F, depth);
+    }
+    buffer.rasterize();
+    EXPECT_FLOAT_EQ(buffer.depth(40, 8), -0.25F);
+
+    // Pixels 40..47 x 5..7, well clear of the split diagonal
+    EXPECT_TRUE(buffer.occluded(pixelBox(40.2F, 5.2F, 47.8F, 7.8F, 0.6F, 0.7F), kIdentity));
+    EXPECT_TRUE(buffer.occluded(pixelBox(40.2F, 5.2F, 47.8F, 7.8F, 0.0F, 0.1F), kIdentity));
+    EXPECT_FALSE(buffer.occluded(pixelBox(40.2F, 5.2F, 47.8F, 7.8F, -0.5F, -0.4F), kIdentity));
+    EXPECT_FALSE(buffer.occluded(pixelBox(40.2F, 5.2F, 47.8F, 7.8F, -0.25F, 0.1F), kIdentity));
+    // Reaching past the occluder's edge
+    EXPECT_FALSE(buffer.occluded(pixelBox(50.2F, 5.2F, 57.8F, 7.8F, 0.6F, 0.7F), kIdentity));
+  }
+}
+
+TEST(OcclusionBuffer, WritesOnlyWhollyCoveredPixels) {
+  OcclusionBuffer buffer(kWidth, kHeight);
+  // Edges through pixel centres: columns 10 and 40, rows 6 and 20 are only half covered
+  addRect(buffer, 10.5F, 6.5F, 40.5F, 20.5F, 0.0F);
+  buffer.rasterize();
+  for (int ypos = 0; ypos < kHeight; ++ypos) {
+    for (int xpos = 0; xpos < kWidth; ++xpos) {
+      if (xpos <= 10 || xpos >= 40 || ypos <= 6 || ypos >= 20) {
+        EXPECT_EQ(buffer.depth(xpos, ypos), kInf) << xpos << ", " << ypos;
+      }
+    }
+  }
+  // A box over the half covered column is not hidden, one just inside it is
+  EXPECT_FALSE(buffer.occluded(pixelBox(10.2F, 12.2F, 12.8F, 12.8F, 0.5F, 0.6F), kIdentity));
+  EXPECT_TRUE(buffer.occluded(pixelBox(11.2F, 12.2F, 12.8F, 12.8F, 0.5F, 0.6F), kIdentity));
+}
+
+TEST(OcclusionBuffer, DepthIsFarthestOverThePixel) {
+  OcclusionBuffer buffer(kWidth, kHeight);
+  // Depth rises by 0.01 per pixel along x
+  const std::vector<float> positions{-1.0F, -1.0F, 0.0F,  1.0F,  -1.0F, 0.64F,
+                                     1.0F,  1.0F,  0.64F, -1.0F, 1.0F,  0.0F};
+  const std::vector<std::uint32_t> indices{0, 1, 2, 0, 2, 3};
+  buffer.addOccluder(positions, indices, kIdentity);
+  buffer.rasterize();
+  EXPECT_NEAR(buffer.depth(20, 4), 0.21F, 1e-5F); // Right edge of pixel 20, not its centre
+  // A box whose nearest point is behind the pixel centre but in front of its far edge
+  EXPECT_FALSE(buffer.occluded(pixelBox(20.2F, 4.2F, 20.8F, 4.8F, 0.206F, 0.3F), kIdentity));
+  EXPECT_TRUE(buffer.occluded(pixelBox(20.2F, 4.2F, 20.8F, 4.8F, 0.211F, 0.3F), kIdentity));
+}
+
+// Triangles sharing an edge cover it between them: every pixel of the pair, and nothing else
+TEST(OcclusionBuffer, SharedEdgesAreWatertight) {
+  OcclusionBuffer buffer(kWidth, kHeight);
+  addRect(buffer, 8.0F, 4.0F, 32.0F, 28.0F, 0.0F); // Diagonal at 45 degrees through corners
+  buffer.rasterize();
+  for (int ypos = 0; ypos < kHeight; ++ypos) {
+    for (int xpos = 0; xpos < kWidth; ++xpos) {
+      const bool inside = xpos >= 8 && xpos < 32 && ypos >= 4 && ypos < 28;
+      EXPECT_EQ(buffer.depth(xpos, ypos), inside ? 0.0F : kInf) << xpos << ", " << ypos;
+    }
+  }
+}
+
+TEST(OcclusionBuffer, QuadOccludesBoxStraddlingItsDiagonal) {
+  OcclusionBuffer buffer(kWidth, kHeight);
+  addRect(buffer, 8.0F, 4.0F, 56.0F, 28.0F, 0.0F); // Diagonal through 28, 14
+  buffer.rasterize();
+  EXPECT_TRUE(buffer.occluded(pixelBox(20.2F, 8.2F, 35.8F, 19.8F, 0.5F, 0.6F), kIdentity));
+  EXPECT_FALSE(buffer.occluded(pixelBox(20.2F, 8.2F, 35.8F, 19.8F, -0.5F, -0.4F), kIdentity));
+
+  // The same quad without its indices has no shared edge, so the diagonal stays open
+  const std::vector<float> unindexed{ndcX(8.0F),  ndcY(4.0F),  0.0F, ndcX(56.0F), ndcY(4.0F),
+                                     0.0F,        ndcX(56.0F), ndcY(28.0F), 0.0F, ndcX(8.0F),
+                                     ndcY(4.0F),  0.0F,        ndcX(56.0F), ndcY(28.0F), 0.0F,
+                                     ndcX(8.0F),  ndcY(28.0F), 0.0F};
+  const OcclusionBuffer::Adjacency open{
+      .across = std::vector<std::uint32_t>(6, OcclusionBuffer::Adjacency::kOpen),
+      .weld = {0, 1, 2, 3, 4, 5}};
+  OcclusionBuffer seamed(kWidth, kHeight);
+  seamed.addOccluder(unindexed, {}, kIdentity, &open);
+  seamed.rasterize();
+  EXPECT_FALSE(seamed.occluded(pixelBox(20.2F, 8.2F, 35.8F, 19.8F, 0.5F, 0.6F), kIdentity));
+}
+
+TEST(OcclusionBuffer, WeldsVerticesByPosition) {
+  // Two triangles over one edge, its ends duplicated as split vertices would be
+  const std::vector<float> positions{0.0F, 0.0F, 0.0F, 1.0F, 0.0F, 0.0F, 1.0F, 1.0F, 0.0F,
+                                     0.0F, 0.0F, 0.0F, 1.0F, 1.0F, 0.0F, 0.0F, 1.0F, 0.0F};
+  const OcclusionBuffer::Adjacency adjacency = OcclusionBuffer::buildAdjacency(positions, {});
+  EXPECT_EQ(adjacency.weld, (std::vector<std::uint32_t>{0, 1, 2, 0, 2, 5}));
+  // Edge 1 of the first triangle (vertices 2 - 0) faces vertex 5; edge 2 of the second
+  // (vertices 3 - 4) faces vertex 1
+  constexpr std::uint32_t kOpen = OcclusionBuffer::Adjacency::kOpen;
+  EXPECT_EQ(adjacency.across, (std::vector<std::uint32_t>{kOpen, 5, kOpen, kOpen, kOpen, 1}));
+}
+
+// Closed meshes with split vertices, seen in perspective: never nearer than the surface reaches
+// over any pixel, and still solid where the reference is
+TEST(OcclusionBuffer, ClosedMeshesMatchSampledReference) {
+  constexpr int kBufferWidth = 128;
+  constexpr int kBufferHeight = 64;
+  constexpr double kMargin = 1e-3;
+  constexpr double kDepthBias = 1e-5;
+
+  const glm::mat4 projection = glm::perspective(glm::radians(60.0F), 2.0F, 0.5F, 50.0F);
+  const glm::mat4 view =
+      glm::lookAt(glm::vec3(0.0F, 1.0F, 0.0F), glm::vec3(0.0F, 0.5F, -10.0F),
+                  glm::vec3(0.0F, 1.0F, 0.0F));
+  const glm::mat4 viewProjection = projection * view;
+
+  std::mt19937 random(11);
+  auto uniform = [&](float low, float high) {
+    return std::uniform_real_distribution<float>(low, high)(random);
+  };
+  std::vector<Mesh> meshes;
+  for (int i = 0; i < 12; ++i) {
+    Mesh mesh = i % 3 == 0 ? uvSphere(uniform(1.0F, 2.5F), 16, 8)
+                           : splitBox(glm::vec3(uniform(0.5F, 2.0F), uniform(0.5F, 2.0F),
+                                                uniform(0.5F, 2.0F)));
+    const glm::vec3 axis = glm::normalize(glm::vec3(uniform(-1.0F, 1.0F), uniform(-1.0F, 1.0F),
+                                                    uniform(0.1F, 1.0F)));
+    EXPECT_TRUE(OcclusionBuffer::buildAdjacency(mesh.positions, mesh.indices).closed) << i;
+    mesh.model = glm::translate(glm::mat4(1.0F), glm::vec3(uniform(-7.0F, 7.0F),
+                                                           uniform(-3.0F, 4.0F),
+                                                           -uniform(6.0F, 16.0F))) *
+                 glm::rotate(glm::mat4(1.0F), uniform(0.0F, 3.0F), axis);
+    meshes.push_back(std::move(mesh));
+  }
+
+  OcclusionBuffer buffer(kBufferWidth, kBufferHeight);
+  std::vector<double> loose(static_cast<std::size_t>(kBufferWidth) * kBufferHeight, kInf);
+  std::vector<double> strict = loose;
+  for (const Mesh& mesh : meshes) {
+    buffer.addOccluder(mesh.positions, mesh.indices, viewProjection * mesh.model);
+    const std::vector<ScreenTriangle> screen =
+        project(mesh, viewProjection * mesh.model, kBufferWidth, kBufferHeight);
+    const std::vector<double> meshLoose =
+        sampledDepth(screen, kBufferWidth, kBufferHeight, -kMargin);
+    const std::vector<double> meshStrict =
+        sampledDepth(screen, kBufferWidth, kBufferHeight, kMargin);
+    for (std::size_t i = 0; i < loose.size(); ++i) {
+      loose[i] = std::min(loose[i], meshLoose[i]);
+      strict[i] = std::min(strict[i], meshStrict[i]);
+    }
+  }
+  buffer.rasterize();
+
+  int covered = 0;
+  int solid = 0;
+  for (int ypos = 0; ypos < kBufferHeight; ++ypos) {
+    for (int xpos = 0; xpos < kBufferWidth; ++xpos) {
+      const std::size_t index = (static_cast<std::size_t>(ypos) * kBufferWidth) + xpos;
+      const double depth = buffer.depth(xpos, ypos);
+      EXPECT_GE(depth, loose[index] - kDepthBias) << xpos << ", " << ypos;
+      covered += depth != kInf ? 1 : 0;
+      solid += strict[index] != kInf ? 1 : 0;
+    }
+  }
+  EXPECT_GT(solid, kBufferWidth * kBufferHeight / 8);
+  EXPECT_GE(covered, solid * 97 / 100);
+}
+
+TEST(OcclusionBuffer, ClipsAtTheNearPlane) {
+  OcclusionBuffer buffer(kWidth, kHeight);
+  // Entirely behind the near plane (z < -w)
+  const std::vector<float> behind{-0.8F, -0.8F, -2.0F, 0.8F, -0.8F, -1.5F, 0.0F, 0.8F, -3.0F};
+  buffer.addOccluder(behind, {}, kIdentity);
+  EXPECT_EQ(buffer.triangleCount(), 0U);
+
+  // One vertex behind: clipped to a quad, nothing written nearer than the plane
+  const std::vector<float> crossing{-0.8F, -0.8F, -2.0F, 0.8F, -0.8F, 0.5F, 0.0F, 0.8F, 0.5F};
+  buffer.addOccluder(crossing, {}, kIdentity);
+  EXPECT_EQ(buffer.triangleCount(), 2U);
+  buffer.rasterize();
+  int covered = 0;
+  for (int ypos = 0; ypos < kHeight; ++ypos) {
+    for (int xpos = 0; xpos < kWidth; ++xpos) {
+      const float depth = buffer.depth(xpos, ypos);
+      if (depth != kInf) {
+        ++covered;
+        EXPECT_GE(depth, -1.0F - 1e-5F);
+        EXPECT_LE(depth, 0.5F + 1e-5F);
+      }
+    }
+  }
+  EXPECT_GT(covered, 0);
+
+  // Boxes reaching behind the near plane are never reported occluded
+  EXPECT_FALSE(buffer.occluded({.min = {-0.1F, 0.0F, -1.5F}, .max = {0.1F, 0.1F, 0.9F}},
+                               kIdentity));
+}
+
+TEST(OcclusionBuffer, MatchesBruteForceReference) {
+  constexpr int kBufferWidth = 128;
+  constexpr int kBufferHeight = 64;
+  constexpr double kMargin = 1e-3; // Pixels; coverage within this of an edge may go either way
+  constexpr double kDepthBias = 1e-5;
+
+  const glm::mat4 projection = glm::perspective(glm::radians(60.0F), 2.0F, 0.5F, 50.0F);
+  const glm::mat4 view =
+      glm::lookAt(glm::vec3(0.0F, 1.0F, 0.0F), glm::vec3(0.0F, 0.5F, -10.0F),
+                  glm::vec3(0.0F, 1.0F, 0.0F));
+  const glm::mat4 viewProjection = projection * view;
+
+  std::mt19937 random(7);
+  auto uniform = [&](float low, float high) {
+    return std::uniform_real_distribution<float>(low, high)(random);
+  };
+  std::vector<float> positions;
+  for (int triangle = 0; triangle < 60; ++triangle) {
+    const glm::vec3 centre(uniform(-6.0F, 6.0F), uniform(-3.0F, 4.0F), -uniform(4.0F, 14.0F));
+    for (int vertex = 0; vertex < 3; ++vertex) {
+      positions.insert(positions.end(), {centre[0] + uniform(-3.0F, 3.0F),
+                                         centre[1] + uniform(-3.0F, 3.0F),
+                                         centre[2] + uniform(-1.5F, 1.5F)});
+    }
+  }
+
+  OcclusionBuffer buffer(kBufferWidth, kBufferHeight);
+  buffer.addOccluder(positions, {}, viewProjection);
+  buffer.rasterize();
+
+  std::vector<ScreenTriangle> screen;
+  for (std::size_t i = 0; i < positions.size(); i += 9) {
+    ScreenTriangle triangle;
+    for (std::size_t vertex = 0; vertex < 3; ++vertex) {
+      const glm::vec4 clip =
+          viewProjection * glm::vec4(positions[i + (3 * vertex)], positions[i + (3 * vertex) + 1],
+                                     positions[i + (3 * vertex) + 2], 1.0F);
+      const double clipW = clip[3];
+      triangle.vertices[vertex] = {((clip[0] / clipW * 0.5) + 0.5) * kBufferWidth,
+                                   ((clip[1] / clipW * 0.5) + 0.5) * kBufferHeight,
+                                   clip[2] / clipW};
+    }
+    screen.push_back(triangle);
+  }
+  const std::vector<double> loose = referenceDepth(screen, kBufferWidth, kBufferHeight, -kMargin);
+  const std::vector<double> strict = referenceDepth(screen, kBufferWidth, kBufferHeight, kMargin);
+
+  // Never nearer, nor covering more, than some triangle wholly over the pixel allows; never
+  // missing a pixel a triangle clearly covers
+  int covered = 0;
+  for (int ypos = 0; ypos < kBufferHeight; ++ypos) {
+    for (int xpos = 0; xpos < kBufferWidth; ++xpos) {
+      const std::size_t index = (static_cast<std::size_t>(ypos) * kBufferWidth) + xpos;
+      const double depth = buffer.depth(xpos, ypos);
+      covered += depth != kInf ? 1 : 0;
+      EXPECT_GE(depth, loose[index] - kDepthBias) << xpos << ", " << ypos;
+      EXPECT_LE(depth, strict[index] + kDepthBias) << xpos << ", " << ypos;
+    }
+  }
+  EXPECT_GT(covered, kBufferWidth * kBufferHeight / 4);
+
+  int hidden = 0;
+  for (int box = 0; box < 20000; ++box) {
+    const glm::vec3 centre(uniform(-9.0F, 9.0F), uniform(-4.0F, 5.0F), -uniform(5.0F, 22.0F));
+    const glm::vec3 half(uniform(0.05F, 1.0F), uniform(0.05F, 1.0F), uniform(0.05F, 1.0F));
+    const Aabb bounds{.min = centre - half, .max = centre + half};
+    const BoxFootprint projected = footprint(bounds, viewProjection, kBufferWidth, kBufferHeight);
+    const bool occluded = buffer.occluded(bounds, viewProjection);
+    hidden += occluded ? 1 : 0;
+    if (occluded) {
+      EXPECT_TRUE(referenceOccluded(loose, kBufferWidth, projected, -kDepthBias)) << box;
+    } else {
+      EXPECT_FALSE(referenceOccluded(strict, kBufferWidth, projected, kDepthBias)) << box;
+    }
+  }
+  EXPECT_GT(hidden, 1000);
+
+  // Parallel bands write the same pixels
+  JobSystem jobs(2);
+  OcclusionBuffer parallel(kBufferWidth, kBufferHeight);
+  parallel.addOccluder(positions, {}, viewProjection);
+  parallel.rasterize(&jobs);
+  for (int ypos = 0; ypos < kBufferHeight; ++ypos) {
+    for (int xpos = 0; xpos < kBufferWidth; ++xpos) {
+      ASSERT_EQ(parallel.depth(xpos, ypos), buffer.depth(xpos, ypos)) << xpos << ", " << ypos;
+    }
+  }
+}
@@ -0,0 +1,66 @@
+#include <blkhurst/util/handle.hpp>
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <unordered_map>
+
+using blkhurst::Handle;
+using blkhurst::Handled;
+using blkhurst::HandlePool;
+
+namespace {
+
+struct Resource : Handled<Resource> {
+  int value = 0;
+};
+
+} // namespace
+
+TEST(Handle, NullByDefault) {
+  const Handle<Resource> handle;
+  EXPECT_FALSE(handle.valid());
+  EXPECT_EQ(Resource::fromHandle(handle), nullptr);
+}
+
+TEST(Handle, ResolvesWhileAlive) {
+  auto resource = std::make_unique<Resource>();
+  const auto handle = resource->handle();
+  EXPECT_TRUE(handle.valid());
+  EXPECT_EQ(Resource::fromHandle(handle), resource.get());
+
+  resource.reset();
+  EXPECT_EQ(Resource::fromHandle(handle), nullptr);
+}
+
+TEST(Handle, ReusedSlotDoesNotResolveOldHandle) {
+  auto first = std::make_unique<Resource>();
+  const auto stale = first->handle();
+  first.reset();
+
+  // The free slot is reused with a new generation
+  auto second = std::make_unique<Resource>();
+  EXPECT_EQ(second->handle().index(), stale.index());
+  EXPECT_NE(second->handle(), stale);
+  EXPECT_EQ(Resource::fromHandle(stale), nullptr);
+  EXPECT_EQ(Resource::fromHandle(second->handle()), second.get());
+}
+
+TEST(Handle, LiveCountTracksResources) {
+  const auto before = HandlePool<Resource>::instance().liveCount();
+  {
+    Resource first;
+    Resource second;
+    EXPECT_EQ(HandlePool<Resource>::instance().liveCount(), before + 2);
+  }
+  EXPECT_EQ(HandlePool<Resource>::instance().liveCount(), before);
+}
+
+TEST(Handle, HashableAsKey) {
+  Resource first;
+  Resource second;
+  std::unordered_map<Handle<Resource>, int> values;
+  values[first.handle()] = 1;
+  values[second.handle()] = 2;
+  EXPECT_EQ(values.at(first.handle()), 1);
+  EXPECT_EQ(values.at(second.handle()), 2);
+}